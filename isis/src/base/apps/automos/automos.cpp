@@ -64,6 +64,7 @@ namespace Isis {
     m.SetHighSaturationFlag(ui.GetBoolean("HIGHSATURATION"));
     m.SetLowSaturationFlag(ui.GetBoolean("LOWSATURATION"));
     m.SetNullFlag(ui.GetBoolean("NULL"));
+    m.SetTileLines(ui.GetInteger("TILELINES"));
 
     // Loop for each input file and place it in the output mosaic
 
@@ -169,6 +169,15 @@ void IsisMain() {
         + toString(winSize) + "].  Must be an odd number (Default = 5)";
       throw IException(IException::User, msg, _FILEINFO_);
     }
+
+    // Only write the method when it is not the default
+    QString method = ui.GetString("SURFACEMETHOD");
+    if (method == "PARABOLOID") {
+      surfaceModel += PvlKeyword("Method", "Paraboloid");
+    }
+    else if (method == "PARABOLA") {
+      surfaceModel += PvlKeyword("Method", "Parabola");
+    }
     autoreg.addGroup(surfaceModel);
   }
 
@@ -73,6 +73,9 @@ void IsisMain() {
         else if (solveMethod == "SPARSE") {
           methodType = LeastSquares::SPARSE;
         }
+        else if (solveMethod == "CG") {
+          methodType = LeastSquares::CG;
+        }
 
         equalizer.calculateStatistics(sampPercent, mincnt, wtopt, methodType);
       }
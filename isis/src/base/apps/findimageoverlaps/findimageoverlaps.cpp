@@ -48,6 +48,7 @@ namespace Isis {
 
     // Now we want the ImageOverlapSet to calculate our overlaps
     ImageOverlapSet overlaps(true, useThread);
+    overlaps.SetTiles(ui.GetInteger("TILES"));
 
     // Use multi-threading to create the overlaps
     overlaps.FindImageOverlaps(serialNumbers,
@@ -0,0 +1,365 @@
+#include "footprintmerge.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include <QThread>
+
+#include "geos/geom/Geometry.h"
+#include "geos/geom/GeometryCollection.h"
+#include "geos/geom/GeometryFactory.h"
+#include "geos/geom/MultiPolygon.h"
+#include "geos/geom/Polygon.h"
+#include "geos/geom/prep/PreparedPolygon.h"
+#include "geos/index/strtree/STRtree.h"
+#include "geos/operation/union/CascadedPolygonUnion.h"
+#include "geos/util/GEOSException.h"
+
+#include "ConcurrentLoop.h"
+#include "Cube.h"
+#include "FileList.h"
+#include "FileName.h"
+#include "IException.h"
+#include "IString.h"
+#include "ImagePolygon.h"
+#include "PolygonTools.h"
+#include "Progress.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+
+using namespace std;
+
+namespace Isis {
+
+  static int islandRoot(vector<int> &parents, int part);
+  static std::function<void (int)> reportGeosErrors(const std::function<void (int)> &work);
+
+
+  /**
+   * Finds the footprint islands of a list of cubes, the groups of cubes whose footprints
+   * overlap each other.
+   *
+   * The polygons of the footprints are indexed by their envelopes, so each polygon is only
+   * tested against the polygons it can intersect. The polygons that intersect are joined into
+   * groups, and the polygons of each group are merged with a cascaded union. Each polygon of a
+   * merged group is an island. Testing the polygons and merging the groups run on up to
+   * MAXTHREADS threads. GEOS geometry factories are not thread safe, so each group is merged
+   * with copies of its polygons made by a factory of its own, and the merged groups are copied
+   * back into the global factory once every group is done.
+   *
+   * @param ui The User Interface to parse the parameters from
+   * @param log The log to write the number of islands to in BRIEF mode
+   */
+  void footprintmerge(UserInterface &ui, Pvl *log) {
+    FileList imageList;
+    imageList.read(ui.GetFileName("FROMLIST"));
+    if(imageList.size() < 1) {
+      QString msg = "The list file [" + ui.GetFileName("FROMLIST") +
+                        "] does not contain any data";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    int threads = ui.GetInteger("MAXTHREADS");
+    if (threads <= 0) threads = QThread::idealThreadCount();
+    threads = max(1, threads);
+
+    Progress prog;
+    prog.SetText("Merging footprints");
+    prog.SetMaximumSteps(imageList.size());
+    prog.CheckStatus();
+
+    //  For this first loop read all image polygons
+    vector<geos::geom::Geometry *> allPolys;
+    vector<QString> files;
+    bool conv360 = false;
+
+    for(int img = 0; img < imageList.size(); img++) {
+
+      Cube cube;
+      cube.open(imageList[img].toString());
+
+      // Make sure cube has been run through spiceinit
+      try {
+        cube.camera();
+      }
+      catch(IException &e) {
+        QString msg = "Spiceinit must be run prior to running footprintmerge";
+        msg += " for cube [" + imageList[img].toString() + "]";
+        throw IException(e, IException::User, msg, _FILEINFO_);
+      }
+
+      //  Make sure cube has been run through footprintinit
+      ImagePolygon poly = cube.readFootprint();
+      cube.close();
+
+      //  If more than 1 poly, set conv360 for later conversion to 180 and merging
+      if(poly.Polys()->getNumGeometries() > 1) conv360 = true;
+
+      allPolys.push_back(PolygonTools::CopyMultiPolygon(poly.Polys()));
+
+      files.push_back(imageList[img].toString());
+
+      prog.CheckStatus();
+
+    }
+
+    //  If any islands are on the 0/360 boundary convert to -180/180 and merge
+    //  any polys that were split on the boundary.
+    if(conv360) {
+      for(unsigned int i = 0; i < allPolys.size(); i++) {
+        geos::geom::MultiPolygon *m = PolygonTools::MakeMultiPolygon(allPolys[i]);
+        if(m->getNumGeometries() > 1 ||
+            m->getCoordinates()->minCoordinate()->x > 180.) {
+          geos::geom::MultiPolygon *poly = PolygonTools::To180(m);
+          delete allPolys[i];
+          allPolys[i] = poly;
+        }
+        delete m;
+      }
+    }
+
+    //  Index the envelopes of the polygons of every footprint
+    vector<const geos::geom::Geometry *> parts;
+    vector<int> partFiles;
+    for(unsigned int i = 0; i < allPolys.size(); i++) {
+      for(unsigned int g = 0; g < allPolys[i]->getNumGeometries(); g++) {
+        const geos::geom::Geometry *part = allPolys[i]->getGeometryN(g);
+        if(part->isEmpty()) continue;
+        parts.push_back(part);
+        partFiles.push_back(i);
+      }
+    }
+
+    vector<int> partIds(parts.size());
+    geos::index::strtree::STRtree partIndex;
+    for(unsigned int p = 0; p < parts.size(); p++) {
+      partIds[p] = p;
+      partIndex.insert(parts[p]->getEnvelopeInternal(), &partIds[p]);
+    }
+
+    //  Once the index is built, queries do not change it, so the threads can share it
+    if(!parts.empty()) partIndex.build();
+
+    //  Find the polygons that intersect each polygon
+    prog.SetText("Finding overlapping footprints");
+    prog.SetMaximumSteps(parts.size());
+    prog.CheckStatus();
+
+    vector< vector<int> > neighbors(parts.size());
+    ConcurrentLoop::run(parts.size(), threads, reportGeosErrors([&](int p) {
+      vector<void *> candidates;
+      partIndex.query(parts[p]->getEnvelopeInternal(), candidates);
+
+      geos::geom::prep::PreparedPolygon prepared(parts[p]);
+      for(unsigned int c = 0; c < candidates.size(); c++) {
+        int candidate = *static_cast<int *>(candidates[c]);
+        if(candidate > p && prepared.intersects(parts[candidate])) {
+          neighbors[p].push_back(candidate);
+        }
+      }
+    }), [&]() { prog.CheckStatus(); });
+
+    //  Join the polygons that intersect into groups
+    vector<int> parents(parts.size());
+    for(unsigned int p = 0; p < parts.size(); p++) {
+      parents[p] = p;
+    }
+    for(unsigned int p = 0; p < parts.size(); p++) {
+      for(unsigned int n = 0; n < neighbors[p].size(); n++) {
+        int a = islandRoot(parents, p);
+        int b = islandRoot(parents, neighbors[p][n]);
+        if(a != b) parents[max(a, b)] = min(a, b);
+      }
+    }
+
+    vector<int> partGroups(parts.size());
+    vector< vector<int> > groups;
+    vector<int> groupOfRoot(parts.size(), -1);
+    for(unsigned int p = 0; p < parts.size(); p++) {
+      int root = islandRoot(parents, p);
+      if(groupOfRoot[root] < 0) {
+        groupOfRoot[root] = groups.size();
+        groups.push_back(vector<int>());
+      }
+      partGroups[p] = groupOfRoot[root];
+      groups[partGroups[p]].push_back(p);
+    }
+
+    //  Merge the polygons of each group
+    prog.SetText("Unioning footprints");
+    prog.SetMaximumSteps(groups.size());
+    prog.CheckStatus();
+
+    vector<geos::geom::Geometry *> unions(groups.size(), NULL);
+    vector<geos::geom::GeometryFactory::Ptr> groupFactories(groups.size());
+    ConcurrentLoop::run(groups.size(), threads, reportGeosErrors([&](int g) {
+      groupFactories[g] = geos::geom::GeometryFactory::create();
+      const geos::geom::GeometryFactory *factory = groupFactories[g].get();
+
+      vector<geos::geom::Geometry *> pieces;
+      for(unsigned int p = 0; p < groups[g].size(); p++) {
+        pieces.push_back(factory->createGeometry(parts[groups[g][p]]));
+      }
+
+      try {
+        vector<geos::geom::Polygon *> polygons;
+        for(unsigned int p = 0; p < pieces.size(); p++) {
+          polygons.push_back(dynamic_cast<geos::geom::Polygon *>(pieces[p]));
+        }
+        unions[g] = geos::operation::geounion::CascadedPolygonUnion::Union(&polygons);
+        for(unsigned int p = 0; p < pieces.size(); p++) {
+          delete pieces[p];
+        }
+      }
+      catch(geos::util::GEOSException &) {
+        //  Buffering the whole group repairs invalid footprints the cascaded union can not merge
+        geos::geom::GeometryCollection *collection =
+          factory->createGeometryCollection(new vector<geos::geom::Geometry *>(pieces));
+        unions[g] = collection->buffer(0);
+        delete collection;
+      }
+    }), [&]() { prog.CheckStatus(); });
+
+    for(unsigned int g = 0; g < unions.size(); g++) {
+      geos::geom::Geometry *merged = unions[g];
+      unions[g] = Isis::globalFactory->createGeometry(merged);
+      delete merged;
+    }
+    groupFactories.clear();
+
+    //  Each polygon of a merged group is an island
+    vector<const geos::geom::Geometry *> islandPolys;
+    vector< vector<int> > groupIslands(groups.size());
+    for(unsigned int g = 0; g < unions.size(); g++) {
+      for(unsigned int i = 0; i < unions[g]->getNumGeometries(); i++) {
+        const geos::geom::Geometry *island = unions[g]->getGeometryN(i);
+        if(island->isEmpty()) continue;
+        groupIslands[g].push_back(islandPolys.size());
+        islandPolys.push_back(island);
+      }
+    }
+
+    if(islandPolys.size() == 1) {
+      //  There are no islands, all cubes are in a single cluster
+      std::cout << "NO ISLANDS, ALL CUBES OVERLAP" << std::endl;
+    }
+    else {
+      // Intersect each input poly with the islands made from its polygons, and keep
+      // track of which images are in each island.
+      prog.SetText("Intersecting footprints");
+      prog.SetMaximumSteps(allPolys.size());
+      prog.CheckStatus();
+
+      typedef std::vector<QString> islandFiles;
+      std::vector< islandFiles > islands;
+      islands.resize(islandPolys.size());
+
+      vector<int> fileGroups;
+      unsigned int part = 0;
+      for(unsigned int i = 0; i < allPolys.size(); i++) {
+        fileGroups.clear();
+        for(; part < parts.size() && partFiles[part] == (int) i; part++) {
+          fileGroups.push_back(partGroups[part]);
+        }
+        sort(fileGroups.begin(), fileGroups.end());
+        fileGroups.erase(unique(fileGroups.begin(), fileGroups.end()), fileGroups.end());
+
+        for(unsigned int g = 0; g < fileGroups.size(); g++) {
+          const vector<int> &candidates = groupIslands[fileGroups[g]];
+          for(unsigned int c = 0; c < candidates.size(); c++) {
+            //  The only island of a group covers every polygon in it
+            if(candidates.size() == 1 || allPolys[i]->intersects(islandPolys[candidates[c]])) {
+              islands[candidates[c]].push_back(files[i]);
+            }
+          }
+        }
+        prog.CheckStatus();
+      }
+
+      QString mode = ui.GetString("MODE");
+
+      //  print out island statistics
+      // Brief
+      if(mode == "BRIEF") {
+        PvlGroup results("Results");
+        results += PvlKeyword("NumberOfIslands", toString((int)islandPolys.size()));
+        if(log) {
+          log->addLogGroup(results);
+        }
+      }
+      else if(mode == "FULL") {
+        QString out = ui.GetFileName("TO");
+        PvlObject results("Results");
+        for(unsigned int p = 0; p < islandPolys.size(); p++) {
+          int numFiles = islands[p].size();
+          QString isle = "FootprintIsland_" + toString((int)p + 1);
+          PvlGroup island(isle);
+          island += PvlKeyword("NumberFiles", toString(numFiles));
+          PvlKeyword files("Files");
+          for(int f = 0; f < numFiles; f++) {
+            files.addValue(islands[p][f]);
+          }
+          island.addKeyword(files);
+          results.addGroup(island);
+        }
+        Pvl temp;
+        temp.addObject(results);
+        if(FileName(out).fileExists()) {
+          temp.append(out);
+        }
+        else {
+          temp.write(out);
+        }
+      }
+    }
+
+    for(unsigned int g = 0; g < unions.size(); g++) {
+      delete unions[g];
+    }
+    for(unsigned int i = 0; i < allPolys.size(); i++) {
+      delete allPolys[i];
+    }
+  }
+
+
+  /**
+   * Finds the first polygon of the group a polygon has been joined to, shortening the path to
+   * it along the way.
+   *
+   * @param parents The polygon each polygon was joined to, itself if it was not joined
+   * @param part The polygon to look up
+   *
+   * @return int The first polygon of the group
+   */
+  static int islandRoot(vector<int> &parents, int part) {
+    while(parents[part] != part) {
+      parents[part] = parents[parents[part]];
+      part = parents[part];
+    }
+    return part;
+  }
+
+
+  /**
+   * Wraps the work on one index so GEOS errors are reported as IExceptions, which
+   * ConcurrentLoop passes back to the calling thread.
+   *
+   * @param work Processes one index
+   *
+   * @return std::function<void (int)> The work, throwing an IException if GEOS fails
+   */
+  static std::function<void (int)> reportGeosErrors(const std::function<void (int)> &work) {
+    return [work](int i) {
+      try {
+        work(i);
+      }
+      catch(geos::util::GEOSException &exc) {
+        QString msg = "Merging footprints failed: " + QString(exc.what());
+        throw IException(IException::Unknown, msg, _FILEINFO_);
+      }
+    };
+  }
+}
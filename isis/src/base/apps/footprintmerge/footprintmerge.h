@@ -0,0 +1,11 @@
+#ifndef footprintmerge_h
+#define footprintmerge_h
+
+#include "Pvl.h"
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void footprintmerge(UserInterface &ui, Pvl *log=nullptr);
+}
+
+#endif
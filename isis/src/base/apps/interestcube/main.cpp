@@ -19,8 +19,6 @@ UniversalGroundMap *unvGMap;
 void IsisMain() {
   // We will be processing by brick
   ProcessByBrick p;
-  p.SetBrickSize(1, 1, 1);
-  p.SetOutputBrickSize(1, 1, 1);
   UserInterface &ui = Application::GetUserInterface();
   
   //initialize the global variables
@@ -39,6 +37,10 @@ void IsisMain() {
 
   cube.open(ui.GetCubeName("FROM"));
 
+  // Process whole lines at a time so the interest of a brick can be calculated at once
+  p.SetBrickSize(cube.sampleCount(), 64, 1);
+  p.SetOutputBrickSize(cube.sampleCount(), 64, 1);
+
   try {
     // Get info from the operator group
     // Set the pvlkeywords that need to be set to zero
@@ -71,16 +73,10 @@ void IsisMain() {
   cube.close();
 }
 
-// Call Operate once per pixel to get the interest for every pixel in the input cube.
+// Call Operate once per brick to get the interest for every pixel of the brick.
 void Operate(Isis::Buffer &in, Isis::Buffer &out) {
   try {
-    int sample = in.Sample();
-    int line = in.Line();
-
-    iop->Operate(cube, *unvGMap, sample, line);
-
-    out[0] = iop->InterestAmount();
-
+    iop->Operate(cube, *unvGMap, out);
   }
   catch(IException &e) {
     e.print();
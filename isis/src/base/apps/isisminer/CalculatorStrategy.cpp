@@ -32,6 +32,7 @@
 #include "PvlFlatMap.h"
 #include "PvlObject.h"
 #include "Resource.h"
+#include "ResourceColumns.h"
 #include "SpecialPixel.h"
 
 using namespace std;
@@ -45,7 +46,8 @@ namespace Isis {
                                          Strategy("Calculator", "Calculator"), 
                                          m_equations(), m_initializers(0), 
                                          m_initArgs(), m_calculator(0), 
-                                         m_result(0.0) { }
+                                         m_result(0.0), m_columns(0),
+                                         m_row(0) { }
   
   /**
    * @brief Constructor loads from a Strategy object CalculatorStrategy
@@ -63,7 +65,8 @@ namespace Isis {
                                          Strategy(definition, globals), 
                                          m_equations(), m_initializers(0), 
                                          m_initArgs(), m_calculator(0),
-                                         m_result(0.0) {
+                                         m_result(0.0), m_columns(0),
+                                         m_row(0) {
 
     if ( getDefinition().hasGroup("Initializers") ) {
       const PvlObject &keydefs = getDefinition();
@@ -132,15 +135,22 @@ namespace Isis {
   int CalculatorStrategy::apply(SharedResource &resource, const ResourceList &globals) {  
 
     int nInits = initialize(resource, globals); 
-    ResourceList variables = getGlobals(resource, globals);
+    ResourceList variables;
+    if ( !m_columns ) {
+      variables = getGlobals(resource, globals);
+    }
 
     int ntotal = 0;
     BOOST_FOREACH ( Equation eqn, m_equations) {
       try {
         m_calculator = eqn.calculator;
-        m_result = calculate(variables);
+        m_result = ( m_columns ) ? calculate(*m_columns, m_row, globals) :
+                                   calculate(variables);
         if ( !eqn.store.isEmpty() ) {
           resource->add(eqn.store, QString::number(m_result));
+          if ( m_columns ) {
+            m_columns->update(m_row, eqn.store);
+          }
         }
         ntotal++;
       }
@@ -163,6 +173,47 @@ namespace Isis {
   }
   
   
+  /**
+   * @brief Calculates the results for a list of Resources
+   *
+   * Applies the equations to each Resource in the list, as applyToResources()
+   * does. The variables of the equations are converted to numbers once for
+   * all of the Resources, the first time each variable is used, rather than
+   * every time an equation uses them. Variables that are not found in a
+   * Resource are taken from the globals.
+   *
+   * @param resources List of Resources to calculate
+   * @param globals   Global Resource of keywords
+   *
+   * @return int The number of Resources written to
+   */
+  int CalculatorStrategy::apply(ResourceList &resources, const ResourceList &globals) {
+    ResourceColumns columns(resources);
+    m_columns = &columns;
+
+    initProgress( ( isApplyToDiscarded() ) ? resources.size() : countActive(resources) );
+
+    int result = 0;
+    try {
+      for (m_row = 0 ; m_row < resources.size() ; m_row++) {
+        SharedResource resource = resources[m_row];
+        if ( resource->isDiscarded() && !isApplyToDiscarded() ) {
+          continue;
+        }
+        result += apply(resource, globals);
+        processed();
+      }
+    }
+    catch (...) {
+      m_columns = 0;
+      throw;
+    }
+
+    m_columns = 0;
+    return (result);
+  }
+
+
   /** 
    * Returns the result of the calculation.
    *
@@ -200,6 +251,9 @@ namespace Isis {
           }
         }
         resource->add(newkey); 
+        if ( m_columns ) {
+          m_columns->update(m_row, newkey.name());
+        }
         ntotal++;
       }
     }
@@ -237,6 +291,24 @@ namespace Isis {
   }
 
   
+  /**
+   * Calculates the result of the equation for the Resource in a row of
+   * ResourceColumns and returns the result.
+   *
+   * @param columns The columns of the Resources
+   * @param row     The row of the Resource
+   * @param globals Global Resources searched for variables not in the Resource
+   *
+   * @return double The result of the calculation.
+   */
+  double CalculatorStrategy::calculate(ResourceColumns &columns, const int &row,
+                                       const ResourceList &globals) {
+    ResourceColumnsCalculatorVariablePool vars(columns, row, globals);
+    QVector<double> values = m_calculator->evaluate(&vars);
+    return (values[0]);
+  }
+
+
   /** 
    * @brief Initializes a PvlFlatMap.
    *
@@ -340,6 +412,74 @@ namespace Isis {
   }
 
 
+  /**
+   * Construct ResourceColumnsCalculatorVariablePool for a row of a
+   * ResourceColumns.
+   *
+   * @param columns The columns of the Resources
+   * @param row     The row of the Resource to get variables from
+   * @param globals Resources searched for variables not in the Resource
+   */
+  ResourceColumnsCalculatorVariablePool::ResourceColumnsCalculatorVariablePool(
+      ResourceColumns &columns, const int &row, const ResourceList &globals) :
+      m_columns(columns), m_row(row), m_globals(globals) {
+  }
+
+
+  /**
+   * Destruct ResourceColumnsCalculatorVariablePool.
+   */
+  ResourceColumnsCalculatorVariablePool::~ResourceColumnsCalculatorVariablePool() {
+  }
+
+
+  /**
+   * Checks if the variable exists in the Resource or the globals.
+   *
+   * @param variable The variable to check for
+   *
+   * @return bool True if the variable exists
+   */
+  bool ResourceColumnsCalculatorVariablePool::exists(const QString &variable) const {
+    if ( m_columns.exists(m_row, variable) ) {
+      return (true);
+    }
+    BOOST_FOREACH ( SharedResource resource, m_globals ) {
+      if ( resource->exists(variable) ) {
+        return (true);
+      }
+    }
+    return (false);
+  }
+
+
+  /**
+   * Returns the value of a variable, from the column of the Resource if it
+   * has the variable, otherwise from the first global that has it.
+   *
+   * @param variable The variable to get the value of
+   * @param index    The keyword value index of the variable
+   *
+   * @return QVector<double> The value of the variable
+   */
+  QVector<double> ResourceColumnsCalculatorVariablePool::value(const QString &variable,
+                                                               const int &index) const {
+    QVector<double> vars;
+    if ( m_columns.exists(m_row, variable) ) {
+      vars.push_back(m_columns.value(m_row, variable, index));
+      return (vars);
+    }
+
+    BOOST_FOREACH ( SharedResource resource, m_globals ) {
+      if ( resource->exists(variable) ) {
+         vars.push_back(toDouble(resource->value(variable, index)));
+         break;
+      }
+    }
+    return (vars);
+  }
+
+
   /** 
    * Construct PvlFlatMapCalculatorVariablePool with a PvlFlatMap.
    *
@@ -41,6 +41,7 @@
 namespace Isis {
 
   class PvlObject;
+  class ResourceColumns;
   struct Equation;
 
   /**
@@ -98,6 +99,7 @@ namespace Isis {
       CalculatorStrategy(const PvlObject &definition, const ResourceList &globals);
       virtual ~CalculatorStrategy();
   
+      virtual int apply(ResourceList &resources, const ResourceList &globals);
       virtual int apply(SharedResource &resource, const ResourceList &globals);
 
       double  result() const;
@@ -106,6 +108,7 @@ namespace Isis {
       int    initialize(SharedResource &resource, const ResourceList &globals);
       double calculate(SharedResource &resource);
       double calculate(ResourceList &resources);
+      double calculate(ResourceColumns &columns, const int &row, const ResourceList &globals);
   
       int    initialize(PvlFlatMap &pvl);
       double calculate(PvlFlatMap &pvl);
@@ -117,6 +120,9 @@ namespace Isis {
       QSharedPointer<InlineCalculator>  m_calculator;   /**!< The current calculator to use in
                                                               calculations */
       double                            m_result;       //!< The result of the calculation
+      ResourceColumns                  *m_columns;      /**!< The columns of the Resources being
+                                                              calculated, if any */
+      int                               m_row;          //!< The row of the current Resource
   };
 
 
@@ -147,6 +153,30 @@ namespace Isis {
   };
 
 
+  /**
+   * @brief Provides ResourceColumns wrapper for variables to Calculator class
+   *
+   * This small class provides the interface to the InlineCalculator class to
+   * lookup and provide variables in equations from a row of ResourceColumns,
+   * so variable values are converted to numbers once per list of Resources.
+   * Variables not found in the row are looked up in a list of global
+   * Resources.
+   */
+  class ResourceColumnsCalculatorVariablePool : public CalculatorVariablePool {
+    public:
+      ResourceColumnsCalculatorVariablePool(ResourceColumns &columns, const int &row,
+                                            const ResourceList &globals);
+      virtual ~ResourceColumnsCalculatorVariablePool();
+      virtual bool exists(const QString &variable) const;
+      virtual QVector<double> value(const QString &variable,
+                                    const int &index = 0) const;
+    private:
+      ResourceColumns    &m_columns; //!< The columns of the Resources
+      int                 m_row;     //!< The row of the Resource
+      const ResourceList &m_globals; //!< Resources searched after the row
+  };
+
+
   /**
    * @brief Provides PvlFlatMap wrapper for variables to Calculator class 
    *  
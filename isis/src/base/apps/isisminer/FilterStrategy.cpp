@@ -37,7 +37,8 @@ namespace Isis {
    */
   FilterStrategy::FilterStrategy() : Strategy("Filter", "Filter"), m_key(), 
                                      m_checkAll(true), m_includes(), 
-                                     m_excludes(), m_regexp()  { 
+                                     m_excludes(), m_regexp(), 
+                                     m_dispositions() { 
   }
   
 
@@ -57,7 +58,7 @@ namespace Isis {
                                         Strategy(definition, globals), 
                                         m_key(), m_checkAll(true), 
                                         m_includes(), m_excludes(), 
-                                        m_regexp() {
+                                        m_regexp(), m_dispositions() {
   
     // Flatten Filter Strategy object definition
     PvlFlatMap parms( getDefinitionMap() );
@@ -115,21 +116,13 @@ namespace Isis {
   
     for (int i = 0 ; i < nvals ; i++) {
   
-      QString rvalue = resource->value(m_key, i);
-  
-      // Check include list
-      bool hasVal = m_includes.contains(rvalue, Qt::CaseInsensitive);
-      if ( hasVal ) { return (1); }  // If in include, keep it - we're done
+      Disposition check = disposition(resource->value(m_key, i));
 
+      // If in include or matches the regular expression, keep it - we're done
+      if ( Keep == check ) { return (1); }
 
-      // Test if a regular expression is used
-      if ( !m_regexp.isEmpty() ) {
-        if ( rvalue.contains( m_regexp ) ) {  return (1);  }
-      }
-  
-      // Check exclude list
-      hasVal = m_excludes.contains(rvalue, Qt::CaseInsensitive);
-      if ( hasVal ) {  // if in the exclude list, discard - we're done
+      // if in the exclude list, discard - we're done
+      if ( Discard == check ) {
         resource->discard();
         return (0);
       }
@@ -157,5 +150,39 @@ namespace Isis {
     //  Keeps the Resource
     return (1);
   }
+
+
+  /**
+   * @brief Determine the disposition of a keyword value
+   *
+   * The include list is checked first, then the regular expression, then the
+   * exclude list. Catalogs usually repeat a small number of values, so the
+   * disposition of each distinct value is determined once and kept for the
+   * rest of the Resources.
+   *
+   * @param value Keyword value to check
+   *
+   * @return FilterStrategy::Disposition The disposition of Resources with the value
+   */
+  FilterStrategy::Disposition FilterStrategy::disposition(const QString &value) {
+    QHash<QString, Disposition>::const_iterator known = m_dispositions.constFind(value);
+    if ( known != m_dispositions.constEnd() ) {
+      return (known.value());
+    }
+
+    Disposition check = Undecided;
+    if ( m_includes.contains(value, Qt::CaseInsensitive) ) {
+      check = Keep;
+    }
+    else if ( !m_regexp.isEmpty() && value.contains(m_regexp) ) {
+      check = Keep;
+    }
+    else if ( m_excludes.contains(value, Qt::CaseInsensitive) ) {
+      check = Discard;
+    }
+
+    m_dispositions.insert(value, check);
+    return (check);
+  }
   
 }  //namespace Isis
@@ -28,6 +28,7 @@
 #include "Strategy.h"
 
 // Qt library
+#include <QHash>
 #include <QRegExp>
 #include <QString>
 #include <QStringList>
@@ -80,11 +81,21 @@ namespace Isis {
       virtual int apply(SharedResource &resource, const ResourceList &globals);
   
     private:
+      /** The disposition of a Resource with a keyword value */
+      enum Disposition {
+        Keep,     //!< The value is included or matches the regular expression
+        Discard,  //!< The value is excluded
+        Undecided //!< The value is in neither list
+      };
+
+      Disposition disposition(const QString &value);
+
       QString     m_key;      //!< 
       bool        m_checkAll; //!< 
       QStringList m_includes; //!< 
       QStringList m_excludes; //!< 
       QRegExp     m_regexp;   //!< Regular expression
+      QHash<QString, Disposition> m_dispositions; //!< Dispositions of the values checked so far
   
   };
 
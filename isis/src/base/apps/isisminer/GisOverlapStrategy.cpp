@@ -25,15 +25,18 @@
 
 // std library
 #include <cmath>
+#include <vector>
 
 // boost library
 #include <boost/foreach.hpp>
 
 // Qt library
 #include <QScopedPointer>
+#include <QSet>
 #include <QtGlobal>
 
 // other ISIS
+#include "GisGeometry.h"
 #include "IException.h"
 #include "IString.h"
 #include "NaifStatus.h"
@@ -226,32 +229,67 @@ namespace Isis {
       }
 
     //----------------------------------------------------------
-    // For each resource in the active set, run an overlap search
-    // and process the results
+    // For each resource in the active set, run an overlap search. The
+    // searches only compare envelopes, so they take little time compared to
+    // the overlap ratios computed from them.
+    std::vector<ResourceList> overlaps(v_active.size());
+    for ( int i = 0 ; i < v_active.size() ; i++ ) {
+      if ( v_active[i]->hasValidGeometry() ) {
+        GEOSSTRtree_query(rtree, v_active[i]->geometry()->geometry(), 
+                          &queryCallback, &overlaps[i]);
+      }
+    }
+  
+    // Done with the query tree
+    GEOSSTRtree_destroy(rtree);
 
-    // Set up progress for building tree
+    // The overlap ratios only depend on the geometries, so they can be
+    // computed concurrently. Each geometry is validated and measured once
+    // instead of once for every pair it is in.
+    GeometryAreas areas = geometryAreas(v_active + goodones);
+    std::vector<OverlapRatioList> ratios(v_active.size());
+    initProgress(v_active.size());
+    runConcurrently(v_active.size(), [&](const int &i) {
+      if ( v_active.at(i)->hasValidGeometry() ) {
+        ratios[i] = overlapRatios(v_active.at(i), overlaps[i], areas);
+      }
+    });
+
+    // processOverlaps() picks these up for the overlaps passed to it below
+    m_computedRatios.clear();
+    for ( int i = 0 ; i < v_active.size() ; i++ ) {
+      if ( v_active[i]->hasValidGeometry() ) {
+        ComputedRatios computed;
+        computed.overlaps = overlaps[i];
+        computed.ratios = ratios[i];
+        m_computedRatios.insert(v_active[i].data(), computed);
+      }
+    }
+    ratios.clear();
+
+    //----------------------------------------------------------
+    // Process the overlaps of each resource in the active set in order
+
+    // Set up progress for processing the overlaps
     initProgress(v_active.size());
     int npaired = 0;
     ResourceList noPairs;
-    BOOST_FOREACH ( SharedResource resource, v_active ) {
+    for ( int i = 0 ; i < v_active.size() ; i++ ) {
+      SharedResource resource = v_active[i];
       if ( isDebug() ) {
         cout << "\n===> Running Overlap query for " << resource->name() << "\n";
       }
 
       // Check for valid geometry
       if ( resource->hasValidGeometry() ) {
-        ResourceList overlaps;
-        GEOSSTRtree_query(rtree, resource->geometry()->geometry(), 
-                          &queryCallback, &overlaps);
-  
         if ( isDebug() ) {
-          cout << "  Query returned " << overlaps.size()  << " candidates.\n";
+          cout << "  Query returned " << overlaps[i].size()  << " candidates.\n";
         }
 
         // Process the primary Resource and the resulting overlap Resourcelist.
         // Virtual implementations must confirm addition overlapping conditions 
         // are met.
-        ResourceList aList = processOverlaps(resource, overlaps, globals);
+        ResourceList aList = processOverlaps(resource, overlaps[i], globals);
 
         if ( isDebug() ) {
           cout << "  Valid overlaps returned for storage: " << aList.size()  << "\n";
@@ -281,9 +319,7 @@ namespace Isis {
 
       processed();
     }
-  
-    // Done with the query tree
-    GEOSSTRtree_destroy(rtree);
+    m_computedRatios.clear();
 
    // Restore save states
     activateList(v_active);
@@ -357,6 +393,9 @@ namespace Isis {
  * dispatched to the virtual processOverlap() method, which may be reimplemented
  * by inheriting classes. 
  *  
+ * When apply() has already computed the ratios of resource for the same 
+ * overlaps, they are used instead of being computed again. 
+ *  
  * @author 2015-03-27 Kris Becker
  * 
  * @param resource Current resource for which to determine overlap candidates.
@@ -369,31 +408,145 @@ namespace Isis {
   ResourceList GisOverlapStrategy::processOverlaps(SharedResource &resource,
                                                    ResourceList &overlaps,
                                                    const ResourceList &globals)  {
-    ResourceList matches;
+    QHash<const Resource *, ComputedRatios>::const_iterator computed = 
+        m_computedRatios.constFind(resource.data());
+    if ( (computed != m_computedRatios.constEnd()) && (computed->overlaps == overlaps) ) {
+      return (processOverlapRatios(resource, computed->ratios, globals));
+    }
+
+    ResourceList geometries = overlaps;
+    geometries.append(resource);
+    OverlapRatioList ratios = overlapRatios(resource, overlaps, 
+                                            geometryAreas(geometries));
+    return (processOverlapRatios(resource, ratios, globals));
+  }
+
+
+/**
+ * @brief Validate and measure the geometries of Resources 
+ *  
+ * The geometry of each Resource is validated and its area computed once, 
+ * concurrently when MaxThreads is more than 1. Resources that share a 
+ * geometry share its entry. 
+ *  
+ * @param resources Resources to measure the geometries of
+ * 
+ * @return GeometryAreas Area of each valid geometry. Invalid geometries are 
+ *         not included.
+ */
+  GisOverlapStrategy::GeometryAreas GisOverlapStrategy::geometryAreas(
+                                                 const ResourceList &resources) {
+    QList<const GisGeometry *> geometries;
+    QSet<const GisGeometry *> found;
+    BOOST_FOREACH ( SharedResource resource, resources ) {
+      const GisGeometry *geom = resource->geometry().data();
+      if ( geom && !found.contains(geom) ) {
+        found.insert(geom);
+        geometries.append(geom);
+      }
+    }
+
+    std::vector<double> areas(geometries.size(), -1.0);
+    initProgress(geometries.size());
+    runConcurrently(geometries.size(), [&](const int &i) {
+      if ( geometries.at(i)->isValid() ) {
+        areas[i] = geometries.at(i)->area();
+      }
+    });
+
+    GeometryAreas valid;
+    for ( int i = 0 ; i < geometries.size() ; i++ ) {
+      if ( areas[i] >= 0.0 ) { valid.insert(geometries.at(i), areas[i]); }
+    }
+    return (valid);
+  }
+
+
+/**
+ * @brief Compute the overlap ratios of a Resource and its candidates
+ *  
+ * The intersection of the Resource and each candidate is computed once and 
+ * divided by the area of each of them. A ratio is 0 if either geometry is 
+ * invalid or its own area is 0, as in GisGeometry::intersectRatio(). 
+ *  
+ * This only uses GEOS and the given Resources, so it can be called for 
+ * different Resources at the same time. 
+ *  
+ * @param resource Primary Resource
+ * @param overlaps Candidates that may overlap resource. The resource itself 
+ *                 is skipped.
+ * @param areas    Areas of the valid geometries, from geometryAreas()
+ * 
+ * @return OverlapRatioList Ratios of each candidate in the order given
+ */
+  GisOverlapStrategy::OverlapRatioList GisOverlapStrategy::overlapRatios(
+                                                const SharedResource &resource,
+                                                const ResourceList &overlaps,
+                                                const GeometryAreas &areas) const {
+    OverlapRatioList ratios;
     SharedGisGeometry rgeom(resource->geometry());
+    double areaA = areas.value(rgeom.data(), -1.0);
     BOOST_FOREACH ( SharedResource candidate, overlaps ) {
 
       // Must ensure we do not consider the original resource itself
       if ( !resource->isEqual(*candidate)) {
-        double ratioA = rgeom->intersectRatio(*candidate->geometry()); 
-        double ratioB = candidate->geometry()->intersectRatio(*rgeom); 
-
-        if ( isDebug() ) {
-          cout << "\nSource " << resource->name() << " overlaps "
-               << candidate->name() << " with ratio of " << ratioA << ", " 
-               << ratioB << "\n";
+        OverlapRatio ratio;
+        ratio.candidate = candidate;
+        ratio.ratioA = 0.0;
+        ratio.ratioB = 0.0;
+
+        SharedGisGeometry cgeom(candidate->geometry());
+        double areaB = areas.value(cgeom.data(), -1.0);
+        if ( (areaA >= 0.0) && (areaB >= 0.0) && ((areaA > 0.0) || (areaB > 0.0)) ) {
+          QScopedPointer<GisGeometry> inCommon(rgeom->intersection(*cgeom));
+          double common = inCommon->area();
+          if ( areaA > 0.0 ) { ratio.ratioA = common / areaA; }
+          if ( areaB > 0.0 ) { ratio.ratioB = common / areaB; }
         }
+        ratios.append(ratio);
+      }
+    }
+  
+    return (ratios);
+  }
 
-        // For efficiency, if 0 is returned it is assumed to not intersect at all
-        // no matter what the OverlapMinimum is set to. Note a NULL Resource may
-        // be returned by processOverlap() so make sure we check validity.
-        if ( ratioA > 0.0 ) {
-          if ( (ratioA >= m_overlapMin) && (ratioA <= m_overlapMax) ) {
-            SharedResource composite = processOverlap(resource, candidate, 
-                                                      ratioA, ratioB,
-                                                      globals);
-            if ( !composite.isNull() ) { matches.append(composite); }
-          }
+
+/**
+ * @brief Process the overlaps of a Resource from their ratios 
+ *  
+ * Each candidate whose ratio with resource is within OverlapMinimum and 
+ * OverlapMaximum is passed to processOverlap(), in order. 
+ *  
+ * @param resource Primary Resource
+ * @param ratios   Overlap ratios of the candidates, from overlapRatios()
+ * @param globals  List of global keywords to use in argument substitutions
+ * 
+ * @return ResourceList List of processed overlaps that are found to satisfy 
+ *         constraints and additional processing by processOverlap().
+ */
+  ResourceList GisOverlapStrategy::processOverlapRatios(SharedResource &resource,
+                                                        const OverlapRatioList &ratios,
+                                                        const ResourceList &globals) {
+    ResourceList matches;
+    BOOST_FOREACH ( OverlapRatio ratio, ratios ) {
+      double ratioA = ratio.ratioA;
+      double ratioB = ratio.ratioB;
+
+      if ( isDebug() ) {
+        cout << "\nSource " << resource->name() << " overlaps "
+             << ratio.candidate->name() << " with ratio of " << ratioA << ", " 
+             << ratioB << "\n";
+      }
+
+      // For efficiency, if 0 is returned it is assumed to not intersect at all
+      // no matter what the OverlapMinimum is set to. Note a NULL Resource may
+      // be returned by processOverlap() so make sure we check validity.
+      if ( ratioA > 0.0 ) {
+        if ( (ratioA >= m_overlapMin) && (ratioA <= m_overlapMax) ) {
+          SharedResource composite = processOverlap(resource, ratio.candidate, 
+                                                    ratioA, ratioB,
+                                                    globals);
+          if ( !composite.isNull() ) { matches.append(composite); }
         }
       }
     }
@@ -28,6 +28,8 @@
 #include "CalculatorStrategy.h"
 
 // Qt library
+#include <QHash>
+#include <QList>
 #include <QMap>
 #include <QString>
 #include <QStringList>
@@ -40,6 +42,7 @@
 
 namespace Isis {
 
+  class GisGeometry;
   class PvlKeyword;
   class PvlObject;
 
@@ -56,6 +59,13 @@ namespace Isis {
    * methods that can be reimplemented by the inheriting class. See 
    * processOverlaps() and processOverlap(). 
    *  
+   * The overlap ratios of all the active Resources are computed before any of 
+   * the overlaps are processed. When MaxThreads is more than 1, they are 
+   * computed concurrently. processOverlaps(), processOverlap() and the Overlap 
+   * strategies are still applied one Resource at a time, in order. The 
+   * default processOverlaps() uses the ratios computed ahead for the overlaps 
+   * apply() passes it. 
+   *  
    * @author 2015-03-26 Kris Becker 
    * @internal 
    *   @history 2015-03-26 Kris Becker - Original version.
@@ -84,6 +94,25 @@ namespace Isis {
       GisMergeOption mergeOption() const;
       void setAssetName(const QString &assetName);
 
+      /** Overlap ratios of a candidate Resource with a primary Resource */
+      struct OverlapRatio {
+        SharedResource candidate; //!< Resource that may overlap the primary Resource
+        double ratioA;            //!< Common area over the area of the primary Resource
+        double ratioB;            //!< Common area over the area of the candidate
+      };
+      //! List of the overlap ratios of the candidates of a Resource
+      typedef QList<OverlapRatio> OverlapRatioList;
+      //! Areas of the valid geometries of Resources
+      typedef QHash<const GisGeometry *, double> GeometryAreas;
+
+      GeometryAreas geometryAreas(const ResourceList &resources);
+      OverlapRatioList overlapRatios(const SharedResource &resource,
+                                     const ResourceList &overlaps,
+                                     const GeometryAreas &areas) const;
+      ResourceList processOverlapRatios(SharedResource &resource,
+                                        const OverlapRatioList &ratios,
+                                        const ResourceList &globals);
+
       // These methods can be overridden by the deriving class if so desired
       virtual ResourceList overlapCandidates(ResourceList &resources,
                                              const ResourceList &globals);
@@ -113,6 +142,14 @@ namespace Isis {
       StrategyList   m_pairStrategies; //!< Candidate selection strategies
       StrategyList   m_overlapStrategies; //!< Process each overlap set as it is determined
 
+      /** Overlap ratios computed by apply() before the overlaps are processed */
+      struct ComputedRatios {
+        ResourceList     overlaps; //!< Candidates the ratios were computed for
+        OverlapRatioList ratios;   //!< Ratios of the candidates
+      };
+      //! Ratios computed ahead for each active Resource, while apply() runs
+      QHash<const Resource *, ComputedRatios> m_computedRatios;
+
   };
 
 } // Namespace Isis
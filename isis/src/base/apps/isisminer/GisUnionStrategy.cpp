@@ -23,8 +23,19 @@
  */ 
 #include "GisUnionStrategy.h"
 
+// std library
+#include <vector>
+
+// boost library
+#include <boost/foreach.hpp>
+
+// geos library
+#include <geos_c.h>
+
 // other ISIS
 #include "GisGeometry.h"
+#include "GisTopology.h"
+#include "IException.h"
 #include "Resource.h"
 #include "Strategy.h"
 
@@ -50,7 +61,7 @@ namespace Isis {
                                      const ResourceList &globals) : 
                                      Strategy(definition, globals),
                                      m_overlapMin(0.0), m_overlapMax(100.0),
-                                     m_ratioKey(""), m_union(0) {
+                                     m_ratioKey(""), m_union() {
   
      PvlFlatMap parms( getDefinitionMap() );
      m_overlapMin = toDouble(parms.get("OverlapMinimum", "0.0"));
@@ -67,39 +78,205 @@ namespace Isis {
   
 
   /** 
-   * Union all geometries that satisfy overlap percentages
+   * @brief Union all geometries that satisfy overlap percentages 
+   *  
+   * The Resources are added to the union in order, as if apply(SharedResource &) 
+   * were called for each one, but the union is never built. The ratio of a 
+   * geometry is the area of its intersections with the geometries already in 
+   * the union over its own area. The intersections are only computed with 
+   * geometries whose envelopes overlap it, and they are computed concurrently 
+   * when MaxThreads is more than 1. The intersections that are kept are then 
+   * joined with a cascaded union, so overlapping geometries are not counted 
+   * twice. 
+   *  
+   * @param resources List of Resources to union
+   * @param globals   List of global keywords to use in argument substitutions
+   * @return int Number of Resources processed
+   */
+  int GisUnionStrategy::apply(ResourceList &resources, 
+                              const ResourceList &globals) {
+    ResourceList targets;
+    BOOST_FOREACH ( SharedResource resource, resources ) {
+      if ( !resource->isDiscarded() || isApplyToDiscarded() ) {
+        targets.append(resource);
+      }
+    }
+    return (unionResources(targets));
+  }
+
+
+  /** 
+   * Union a geometry if it satisfies overlap percentages 
+   *  
    * @param resource
    * @param globals   List of global keywords to use in argument substitutions
    * @return int 
    */
   int GisUnionStrategy::apply(SharedResource &resource,
                               const ResourceList &globals) {
-  
-    if ( resource->hasValidGeometry() ) {
-      SharedGisGeometry geom(resource->geometry());
-      if ( !m_union.isNull() ) {
-        // Union geometry is present and good
-        double ratio = geom->intersectRatio(*m_union);
+    ResourceList targets;
+    targets.append(resource);
+    return (unionResources(targets));
+  }
+
+
+  /** 
+   * @brief Add Resources to the union in order 
+   *  
+   * @param targets Resources to union, in order
+   * @return int Number of Resources processed
+   */
+  int GisUnionStrategy::unionResources(const ResourceList &targets) {
+
+    // The geometries that can be in the union: the ones already in it, then
+    // the valid geometries of the targets
+    QList<SharedGisGeometry> geoms = m_union;
+    int nunion = geoms.size();
+    std::vector<int> targetGeom(targets.size(), -1);
+    for ( int k = 0 ; k < targets.size() ; k++ ) {
+      if ( targets[k]->hasValidGeometry() ) {
+        targetGeom[k] = geoms.size();
+        geoms.append(targets[k]->geometry());
+      }
+    }
+
+    // Find the earlier geometries whose envelopes overlap each target
+    std::vector<int> ids(geoms.size());
+    GEOSSTRtree *rtree = GEOSSTRtree_create(qMax(geoms.size(), 2));
+    if ( !rtree ) {
+      QString mess = "GEOS RTree allocation failed for " +
+                     toString(geoms.size()) + " geometries.";
+      throw IException(IException::Programmer, mess, _FILEINFO_);
+    }
+    for ( int j = 0 ; j < geoms.size() ; j++ ) {
+      ids[j] = j;
+      GEOSSTRtree_insert(rtree, geoms[j]->geometry(), &ids[j]);
+    }
+
+    std::vector< QList<int> > candidates(targets.size());
+    for ( int k = 0 ; k < targets.size() ; k++ ) {
+      if ( targetGeom[k] >= 0 ) {
+        GEOSSTRtree_query(rtree, geoms[targetGeom[k]]->geometry(), 
+                          &indexCallback, &candidates[k]);
+      }
+    }
+    GEOSSTRtree_destroy(rtree);
+
+    // Intersect each target with the earlier geometries it may overlap. These
+    // do not depend on which geometries end up in the union.
+    std::vector< QList<Intersection> > intersections(targets.size());
+    initProgress(targets.size());
+    runConcurrently(targets.size(), [&](const int &k) {
+      if ( targetGeom[k] < 0 ) { return; }
+      const GisGeometry &geom = *geoms.at(targetGeom[k]);
+      BOOST_FOREACH ( int j, candidates[k] ) {
+        if ( j < targetGeom[k] ) {
+          Intersection common;
+          common.index = j;
+          common.geometry = SharedGisGeometry(geom.intersection(*geoms.at(j)));
+          if ( !common.geometry->isEmpty() ) {
+            intersections[k].append(common);
+          }
+        }
+      }
+    });
+
+    // Now add the targets to the union in order
+    std::vector<char> inUnion(geoms.size(), 0);
+    for ( int j = 0 ; j < nunion ; j++ ) {
+      inUnion[j] = 1;
+    }
+
+    for ( int k = 0 ; k < targets.size() ; k++ ) {
+      SharedResource resource = targets[k];
+      int index = targetGeom[k];
+      if ( index < 0 ) {
+        // Geometry is invalid
+        resource->discard();
+      }
+      else if ( m_union.isEmpty() ) {
+        // Union geometry needs initializing
+        m_union.append(geoms[index]);
+        inUnion[index] = 1;
+        resource->add(m_ratioKey, "1.0");
+      }
+      else {
+        QList<SharedGisGeometry> pieces;
+        BOOST_FOREACH ( Intersection common, intersections[k] ) {
+          if ( inUnion[common.index] ) {
+            pieces.append(common.geometry);
+          }
+        }
+
+        double ratio = unionRatio(*geoms[index], pieces);
         resource->add(m_ratioKey, toString(ratio));
         if ( (ratio >= m_overlapMin) && (ratio <= m_overlapMax) ) {
-           m_union = SharedGisGeometry(m_union->g_union(*geom));
+          m_union.append(geoms[index]);
+          inUnion[index] = 1;
         }
         else {
           // Geometry does not satisfy overlap ratio constraints
           resource->discard();
         }
       }
-      else {
-        // Union geometry needs initializing or is not good.
-        m_union = SharedGisGeometry(geom->clone());
-        resource->add(m_ratioKey, "1.0");
-      }
     }
-    else {
-      // Geometry is invalid
-      resource->discard();
+
+    return (targets.size());
+  }
+
+
+  /** 
+   * @brief Compute the ratio of a geometry that is covered by the union 
+   *  
+   * The pieces are joined with a cascaded union before their area is computed. 
+   *  
+   * @param geom   Geometry to compute the ratio of
+   * @param pieces Intersections of geom with the geometries in the union
+   * @return double Area of the union of the pieces over the area of geom. 0 
+   *                if geom has no area.
+   */
+  double GisUnionStrategy::unionRatio(const GisGeometry &geom, 
+                                      const QList<SharedGisGeometry> &pieces) const {
+    double area = geom.area();
+    if ( (area == 0.0) || pieces.isEmpty() ) {
+      return (0.0);
+    }
+    if ( 1 == pieces.size() ) {
+      return (pieces[0]->area() / area);
+    }
+
+    GisTopology *gis = GisTopology::instance();
+    std::vector<GEOSGeometry *> parts;
+    BOOST_FOREACH ( SharedGisGeometry piece, pieces ) {
+      parts.push_back(gis->clone(piece->geometry()));
+    }
+
+    // The collection takes ownership of the parts
+    GEOSContextHandle_t context = gis->context();
+    GEOSGeometry *collection = GEOSGeom_createCollection_r(context, GEOS_GEOMETRYCOLLECTION,
+                                                           &parts[0], parts.size());
+    GEOSGeometry *joined = GEOSUnaryUnion_r(context, collection);
+    gis->destroy(collection);
+
+    double common = 0.0;
+    if ( joined ) {
+      if ( 1 != GEOSArea_r(context, joined, &common) ) { common = 0.0; }
+      gis->destroy(joined);
     }
-    return (1);
+    return (common / area);
+  }
+
+
+  /** 
+   * @brief GEOS query callback that collects geometry indexes 
+   *  
+   * @param item     Index of the geometry found
+   * @param userdata QList<int> to add the index to
+   */
+  void GisUnionStrategy::indexCallback(void *item, void *userdata) {
+    QList<int> *indexes = (QList<int> *) userdata;
+    indexes->append(*(int *) item);
+    return;
   }
 
 }  //namespace Isis
@@ -28,6 +28,7 @@
 #include "Strategy.h"
 
 // Qt library
+#include <QList>
 #include <QString>
 
 // SharedGisGeometry and SharedResource typedefs
@@ -45,6 +46,10 @@ namespace Isis {
    *   Name = GisUnion
    * EndObject
    *  
+   * Resources are added to the union in order. The union itself is never 
+   * built; each overlap ratio is computed from the intersections of the 
+   * Resource with the geometries already in the union. 
+   *  
    * @author 2012-07-15 Kris Becker
    * @internal 
    *   @history 2012-07-15 Kris Becker - Original version.
@@ -61,13 +66,25 @@ namespace Isis {
                        const ResourceList &globals);
       virtual ~GisUnionStrategy();
   
+      int apply(ResourceList &resources, const ResourceList &globals);
       int apply(SharedResource &resource, const ResourceList &globals);
   
     private:
+      /** Intersection of a geometry with an earlier geometry */
+      struct Intersection {
+        int index;                  //!< Index of the earlier geometry
+        SharedGisGeometry geometry; //!< The intersection of the two
+      };
+
+      int unionResources(const ResourceList &targets);
+      double unionRatio(const GisGeometry &geom,
+                        const QList<SharedGisGeometry> &pieces) const;
+      static void indexCallback(void *item, void *userdata);
+
       double  m_overlapMin;      //!< 
       double  m_overlapMax;      //!< 
       QString m_ratioKey;        //!< 
-      SharedGisGeometry m_union; //!< 
+      QList<SharedGisGeometry> m_union; //!< Geometries that make up the union
   };
 
 } // Namespace Isis
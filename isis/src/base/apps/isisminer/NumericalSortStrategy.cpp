@@ -31,6 +31,7 @@
 #include "PvlFlatMap.h"
 #include "PvlObject.h"
 #include "Resource.h"
+#include "ResourceColumns.h"
 #include "Strategy.h"
 
 using namespace std;
@@ -97,6 +98,10 @@ namespace Isis {
    * This Strategy sorts a list of Resources in ascending or descending order.
    * The sort operates according to the SortKey keyword value provided in the 
    * PVL object definition.
+   *
+   * The SortKey value of each Resource is converted once, before the sort,
+   * and the rows of the Resources are sorted by the converted values. The
+   * order is the same as sorting the Resources themselves.
    * 
    * @author 2013-02-19 Kris Becker
    * 
@@ -107,11 +112,23 @@ namespace Isis {
    */
   int NumericalSortStrategy::apply(ResourceList &resources, 
                                    const ResourceList &globals) { 
+    ResourceColumns columns(resources);
+    const ResourceColumns::Column &keys = columns.column(m_sortKey);
+
+    QVector<int> rows(resources.size());
+    for (int row = 0 ; row < rows.size() ; row++) {
+      rows[row] = row;
+    }
+
     if ( "ascending" == m_order) {
-      qSort(resources.begin(), resources.end(), SortAscending(m_sortKey));
+      qSort(rows.begin(), rows.end(), SortAscending(columns, keys));
     }
     else {  // ("descending" == m_order) 
-      qSort(resources.begin(), resources.end(), SortDescending(m_sortKey));
+      qSort(rows.begin(), rows.end(), SortDescending(columns, keys));
+    }
+
+    for (int i = 0 ; i < rows.size() ; i++) {
+      resources[i] = columns.resource(rows[i]);
     }
   
     //  Keeps the Resource by just running the counter
@@ -120,9 +137,12 @@ namespace Isis {
   
   
   /** 
-   * @param sortKey
+   * @param columns The Resources being sorted
+   * @param keys    The SortKey values of the Resources
    */  
-  SortAscending::SortAscending(const QString &sortKey) : m_sortKey(sortKey) { 
+  SortAscending::SortAscending(const ResourceColumns &columns, 
+                               const ResourceColumns::Column &keys) : 
+                               m_columns(columns), m_keys(keys) { 
   }
 
 
@@ -139,27 +159,30 @@ namespace Isis {
    * Compares two SharedResources using the greater than operator. If the first SharedResource
    * is discarded, then the order is unsatisfied (i.e. returns false).
    * 
-   * @param a The SharedResources to compare
-   * @param b The SharedResources to compare
+   * @param a The row of the first SharedResource to compare
+   * @param b The row of the second SharedResource to compare
    * 
    * @return bool Returns true if the first SharedResource's value
    * is less than the second SharedResource's value
    */
-  bool SortAscending::operator()(const SharedResource &a, const SharedResource &b) const {
-    if ( a->isDiscarded() ) { 
+  bool SortAscending::operator()(const int &a, const int &b) const {
+    if ( m_columns.resource(a)->isDiscarded() ) { 
       return (false); 
     }
-    if ( b->isDiscarded() ) { 
+    if ( m_columns.resource(b)->isDiscarded() ) { 
       return (true);  
     }
-    return (toDouble(a->value(m_sortKey)) < toDouble(b->value(m_sortKey)));
+    return (m_keys.value(a) < m_keys.value(b));
   }
   
     
   /** 
-   * @param sortKey 
+   * @param columns The Resources being sorted
+   * @param keys    The SortKey values of the Resources
    */  
-  SortDescending::SortDescending(const QString &sortKey) : m_sortKey(sortKey) { 
+  SortDescending::SortDescending(const ResourceColumns &columns, 
+                                 const ResourceColumns::Column &keys) : 
+                                 m_columns(columns), m_keys(keys) { 
   }
   
   
@@ -176,20 +199,20 @@ namespace Isis {
    * Compares two SharedResources using the greater than operator. If the first SharedResource
    * is discarded, then the order is unsatisfied (i.e. returns false).
    * 
-   * @param a The SharedResources to compare
-   * @param b The SharedResources to compare
+   * @param a The row of the first SharedResource to compare
+   * @param b The row of the second SharedResource to compare
    * 
    * @return bool Returns true if the first SharedResource's value
    * is greater than the second SharedResource's values
    */
-  bool SortDescending::operator()(const SharedResource &a, const SharedResource &b) const {
-    if ( a->isDiscarded() ) { 
+  bool SortDescending::operator()(const int &a, const int &b) const {
+    if ( m_columns.resource(a)->isDiscarded() ) { 
       return (false);
     }
-    if ( b->isDiscarded() ) { 
+    if ( m_columns.resource(b)->isDiscarded() ) { 
       return (true);  
     }
-    return (toDouble(a->value(m_sortKey)) > toDouble(b->value(m_sortKey)));
+    return (m_keys.value(a) > m_keys.value(b));
   }  
 
 }  //namespace Isis
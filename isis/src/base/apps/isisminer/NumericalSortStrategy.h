@@ -32,6 +32,7 @@
 
 // SharedResource and ResourceList typedefs
 #include "Resource.h"
+#include "ResourceColumns.h"
 
 namespace Isis {
 
@@ -84,7 +85,8 @@ namespace Isis {
    * @brief Ascending order sort functor
    * 
    * Determines the ascending order of two Resources by comparing the numerical values of the
-   * SortKey keyword and using the less than operator.
+   * SortKey keyword and using the less than operator. The Resources are
+   * compared by their rows in a ResourceColumns.
    * 
    * @author 2012-07-25 Kris Becker
    * @internal
@@ -92,12 +94,13 @@ namespace Isis {
    */
   class SortAscending {
     public:
-      SortAscending(const QString &sortKey);
+      SortAscending(const ResourceColumns &columns, const ResourceColumns::Column &keys);
       ~SortAscending();
-      bool operator()(const SharedResource &a, const SharedResource &b) const;
+      bool operator()(const int &a, const int &b) const;
       
     private:
-      QString m_sortKey; //!< 
+      const ResourceColumns         &m_columns; //!< The Resources being sorted
+      const ResourceColumns::Column &m_keys;    //!< The SortKey values of the Resources
   };
   
   
@@ -105,7 +108,8 @@ namespace Isis {
    * @brief Descending order sort functor
    * 
    * Determines the descending order of two Resources by comparing the numerical values of the
-   * SortKey keyword and using the greater than operator.
+   * SortKey keyword and using the greater than operator. The Resources are
+   * compared by their rows in a ResourceColumns.
    * 
    * @author 2012-07-25 Kris Becker
    * @internal
@@ -113,12 +117,13 @@ namespace Isis {
    */
   class SortDescending {
     public:
-      SortDescending(const QString &sortKey);
+      SortDescending(const ResourceColumns &columns, const ResourceColumns::Column &keys);
       ~SortDescending();
-      bool operator()(const SharedResource &a, const SharedResource &b) const;
+      bool operator()(const int &a, const int &b) const;
       
     private:
-      QString m_sortKey; //!< 
+      const ResourceColumns         &m_columns; //!< The Resources being sorted
+      const ResourceColumns::Column &m_keys;    //!< The SortKey values of the Resources
   };
 
 } // Namespace Isis
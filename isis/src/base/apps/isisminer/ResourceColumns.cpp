@@ -0,0 +1,200 @@
+/** This is free and unencumbered software released into the public domain.
+
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "ResourceColumns.h"
+
+// other ISIS
+#include "IException.h"
+#include "IString.h"
+#include "PvlFlatMap.h"
+#include "PvlKeyword.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Converts the values of a keyword for every Resource in a list.
+   *
+   * @param resources The Resources to read the values from
+   * @param key       The keyword name
+   * @param index     The keyword value index
+   */
+  ResourceColumns::Column::Column(const ResourceList &resources, const QString &key,
+                                  const int &index) : m_resources(resources), m_key(key),
+                                  m_lowerKey(key.toLower()), m_index(index),
+                                  m_values(resources.size(), 0.0),
+                                  m_status(resources.size(), Missing) {
+    for (int row = 0 ; row < m_resources.size() ; row++) {
+      update(row);
+    }
+  }
+
+
+  /**
+   * Checks if the Resource in a row has the keyword of the column.
+   *
+   * @param row The row of the Resource
+   *
+   * @return bool True if the keyword exists in the Resource
+   */
+  bool ResourceColumns::Column::exists(const int &row) const {
+    return (m_status[row] != Missing);
+  }
+
+
+  /**
+   * Returns the value of the column for the Resource in a row.
+   *
+   * @param row The row of the Resource
+   *
+   * @return double The keyword value
+   *
+   * @throws IException If the keyword does not exist or its value is not a number, the
+   *                    exception thrown converting the value
+   */
+  double ResourceColumns::Column::value(const int &row) const {
+    if ( Valid == m_status[row] ) {
+      return (m_values[row]);
+    }
+
+    // Convert the value again to throw the conversion error
+    return (toDouble(m_resources[row]->value(m_key, m_index)));
+  }
+
+
+  /**
+   * Converts the keyword value of the Resource in a row again, after it changed.
+   *
+   * @param row The row of the Resource
+   */
+  void ResourceColumns::Column::update(const int &row) {
+    const PvlFlatMap &keys = m_resources[row]->keys();
+    PvlFlatMap::const_iterator keyword = keys.find(m_lowerKey);
+    if ( keys.end() == keyword ) {
+      m_status[row] = Missing;
+      return;
+    }
+
+    m_status[row] = Invalid;
+    if ( m_index < keyword.value().size() ) {
+      try {
+        m_values[row] = toDouble(keyword.value()[m_index]);
+        m_status[row] = Valid;
+      }
+      catch (IException &) {
+        // Left Invalid, value() throws the conversion error when it is asked for
+      }
+    }
+    return;
+  }
+
+
+  /**
+   * Constructs the columns of a list of Resources. No values are converted until a column
+   * is asked for.
+   *
+   * @param resources The Resources, the row of each is its position in the list
+   */
+  ResourceColumns::ResourceColumns(const ResourceList &resources) : m_resources(resources),
+                                                                    m_columns() {
+  }
+
+
+  /**
+   * Destroys the columns.
+   */
+  ResourceColumns::~ResourceColumns() {
+  }
+
+
+  /**
+   * @return int The number of Resources (rows)
+   */
+  int ResourceColumns::size() const {
+    return (m_resources.size());
+  }
+
+
+  /**
+   * Returns the Resource in a row.
+   *
+   * @param row The row of the Resource
+   *
+   * @return const SharedResource& The Resource
+   */
+  const SharedResource &ResourceColumns::resource(const int &row) const {
+    return (m_resources[row]);
+  }
+
+
+  /**
+   * Returns the column of a keyword value index, converting the values of every Resource the
+   * first time it is asked for.
+   *
+   * @param key   The keyword name
+   * @param index The keyword value index
+   *
+   * @return const Column& The column
+   */
+  const ResourceColumns::Column &ResourceColumns::column(const QString &key, const int &index) {
+    ColumnKey columnKey(key.toLower(), index);
+    QSharedPointer<Column> &column = m_columns[columnKey];
+    if ( column.isNull() ) {
+      column = QSharedPointer<Column>(new Column(m_resources, key, index));
+    }
+    return (*column);
+  }
+
+
+  /**
+   * Checks if the Resource in a row has a keyword.
+   *
+   * @param row   The row of the Resource
+   * @param key   The keyword name
+   * @param index The keyword value index
+   *
+   * @return bool True if the keyword exists in the Resource
+   */
+  bool ResourceColumns::exists(const int &row, const QString &key, const int &index) {
+    return (column(key, index).exists(row));
+  }
+
+
+  /**
+   * Returns a keyword value of the Resource in a row as a double.
+   *
+   * @param row   The row of the Resource
+   * @param key   The keyword name
+   * @param index The keyword value index
+   *
+   * @return double The keyword value
+   */
+  double ResourceColumns::value(const int &row, const QString &key, const int &index) {
+    return (column(key, index).value(row));
+  }
+
+
+  /**
+   * Converts the values of a keyword of the Resource in a row again, after the keyword was
+   * added or changed. Columns that have not been asked for yet are read when they are.
+   *
+   * @param row The row of the Resource
+   * @param key The keyword name
+   */
+  void ResourceColumns::update(const int &row, const QString &key) {
+    QString lowerKey = key.toLower();
+    QHash<ColumnKey, QSharedPointer<Column> >::iterator column;
+    for (column = m_columns.begin() ; column != m_columns.end() ; ++column) {
+      if ( column.key().first == lowerKey ) {
+        column.value()->update(row);
+      }
+    }
+    return;
+  }
+
+} // namespace Isis
@@ -0,0 +1,91 @@
+#ifndef ResourceColumns_h
+#define ResourceColumns_h
+
+/** This is free and unencumbered software released into the public domain.
+
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+// Qt library
+#include <QHash>
+#include <QPair>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+// SharedResource and ResourceList typedefs
+#include "Resource.h"
+
+namespace Isis {
+
+  /**
+   * @brief Numeric keyword values of a list of Resources, stored by column
+   *
+   * Resources keep their keywords as strings, so strategies that use keyword values as numbers
+   * convert them every time they are used. This class converts the values of a keyword for
+   * every Resource in a list once, the first time the keyword is asked for, and keeps them in
+   * an array indexed by the position (row) of the Resource in the list.
+   *
+   * A value is only usable if the keyword exists in the Resource and converts to a double.
+   * Asking for a value that is not usable throws the same exception the conversion of the
+   * keyword value does.
+   *
+   * Strategies that change keywords of the Resources while using the columns must call
+   * update() so the columns follow the changes.
+   */
+  class ResourceColumns {
+    public:
+      /** The state of a value in a column */
+      enum Status {
+        Missing, //!< The Resource does not have the keyword
+        Invalid, //!< The keyword value is not a number
+        Valid    //!< The keyword value was converted
+      };
+
+      /**
+       * The values of one keyword value index for every Resource in the list
+       */
+      class Column {
+        public:
+          Column(const ResourceList &resources, const QString &key, const int &index);
+
+          bool exists(const int &row) const;
+          double value(const int &row) const;
+          void update(const int &row);
+
+        private:
+          const ResourceList &m_resources; //!< The Resources the values come from
+          QString             m_key;       //!< The keyword name
+          QString             m_lowerKey;  //!< The keyword name as stored in PvlFlatMap
+          int                 m_index;     //!< The keyword value index
+          QVector<double>     m_values;    //!< The values, valid where m_status is Valid
+          QVector<Status>     m_status;    //!< The state of each value
+      };
+
+      ResourceColumns(const ResourceList &resources);
+      virtual ~ResourceColumns();
+
+      int size() const;
+      const SharedResource &resource(const int &row) const;
+
+      const Column &column(const QString &key, const int &index = 0);
+      bool exists(const int &row, const QString &key, const int &index = 0);
+      double value(const int &row, const QString &key, const int &index = 0);
+
+      void update(const int &row, const QString &key);
+
+    private:
+      Q_DISABLE_COPY(ResourceColumns)
+
+      typedef QPair<QString, int> ColumnKey; //!< Lower case keyword name and value index
+
+      ResourceList                                 m_resources; //!< The Resources, by row
+      QHash<ColumnKey, QSharedPointer<Column> >    m_columns;   //!< Columns read so far
+  };
+
+} // Namespace Isis
+
+#endif
@@ -94,6 +94,7 @@ namespace Isis {
     m.SetHighSaturationFlag(ui.GetBoolean("HIGHSATURATION"));
     m.SetLowSaturationFlag(ui.GetBoolean("LOWSATURATION"));
     m.SetNullFlag(ui.GetBoolean("NULL"));
+    m.SetTileLines(ui.GetInteger("TILELINES"));
 
     // Start Process  
     if(!m.StartProcess(sInputFile)) {
@@ -0,0 +1,361 @@
+#include "noseam.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <map>
+#include <vector>
+
+#include <QList>
+#include <QPoint>
+
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "FileList.h"
+#include "IException.h"
+#include "LineManager.h"
+#include "ProcessMapMosaic.h"
+#include "Progress.h"
+#include "QuickFilter.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Moves a boxcar down one band of a cube a line at a time, the same way ProcessByQuickFilter
+   * does. Lines above the top and below the bottom of the cube are mirrored. Only the lines
+   * the boxcar still needs are kept, so the lines of the cube that the boxcar has moved past
+   * can be overwritten while the stream is in use.
+   */
+  class FilterStream {
+    public:
+      FilterStream(Cube *cube, int band, int boxSamples, int boxLines);
+
+      void seek(int line);
+      const double *center();
+      QuickFilter &filter();
+
+    private:
+      const double *read(int line);
+      int mirror(int line) const;
+
+      Cube *m_cube;          //!< The cube being filtered
+      int m_band;            //!< The band being filtered
+      int m_halfHeight;      //!< Lines in the boxcar above and below its center
+      int m_center;          //!< The line in the center of the boxcar, 0 before the first seek
+      QuickFilter m_filter;  //!< The boxcar sums
+      LineManager m_line;    //!< Reads lines from the cube
+      map< int, vector<double> > m_lines; //!< The lines the boxcar still needs, by line number
+  };
+
+
+  /**
+   * Constructs a stream positioned before the first line of the band.
+   *
+   * @param cube The cube to filter
+   * @param band The band to filter
+   * @param boxSamples Number of samples in the boxcar
+   * @param boxLines Number of lines in the boxcar
+   */
+  FilterStream::FilterStream(Cube *cube, int band, int boxSamples, int boxLines) :
+      m_filter(cube->sampleCount(), boxSamples, boxLines), m_line(*cube) {
+    m_cube = cube;
+    m_band = band;
+    m_halfHeight = boxLines / 2;
+    m_center = 0;
+
+    m_filter.SetMinMax(-DBL_MAX, DBL_MAX);
+    m_filter.SetMinimumPixels(1);
+  }
+
+
+  /**
+   * Moves the center of the boxcar down to a line. The stream can not move back up.
+   *
+   * @param line The line to center the boxcar on
+   */
+  void FilterStream::seek(int line) {
+    if (m_center == 0) {
+      m_filter.Reset();
+      for (int bot = 1 - m_halfHeight; bot <= 1 + m_halfHeight; bot++) {
+        m_filter.AddLine(read(mirror(bot)));
+      }
+      m_center = 1;
+    }
+
+    while (m_center < line) {
+      m_filter.RemoveLine(read(mirror(m_center - m_halfHeight)));
+      m_filter.AddLine(read(mirror(m_center + m_halfHeight + 1)));
+      m_center++;
+
+      // Every line the boxcar can still reach, mirrored lines included, is at or below this one
+      m_lines.erase(m_lines.begin(), m_lines.lower_bound(m_center - m_halfHeight - 1));
+    }
+  }
+
+
+  /**
+   * @return const double* The line in the center of the boxcar
+   */
+  const double *FilterStream::center() {
+    return read(m_center);
+  }
+
+
+  /**
+   * @return QuickFilter& The boxcar centered on the current line
+   */
+  QuickFilter &FilterStream::filter() {
+    return m_filter;
+  }
+
+
+  /**
+   * Returns a line of the band, reading it from the cube the first time it is needed.
+   *
+   * @param line The line to return
+   *
+   * @return const double* The pixels of the line
+   */
+  const double *FilterStream::read(int line) {
+    map< int, vector<double> >::iterator it = m_lines.find(line);
+    if (it == m_lines.end()) {
+      m_line.SetLine(line, m_band);
+      m_cube->read(m_line);
+      it = m_lines.insert(make_pair(line,
+          vector<double>(m_line.DoubleBuffer(), m_line.DoubleBuffer() + m_line.size()))).first;
+    }
+    return &it->second[0];
+  }
+
+
+  /**
+   * Mirrors lines above the top and below the bottom of the cube back into the cube.
+   *
+   * @param line The line to mirror
+   *
+   * @return int The line in the cube
+   */
+  int FilterStream::mirror(int line) const {
+    if (line <= 0) return -line + 2;
+    if (line > m_cube->lineCount()) return 2 * m_cube->lineCount() - line;
+    return line;
+  }
+
+
+  /**
+   * An input cube and where it was placed in the mosaic.
+   */
+  struct Placement {
+    QString fileName;         //!< The input as listed in FROMLIST, attributes included
+    QList<QPoint> locations;  //!< Mosaic sample and line of the first input pixel, per placement
+    int samples;              //!< Samples in the input
+    int lines;                //!< Lines in the input
+    int bands;                //!< Bands in the input
+    Cube *cube;               //!< The input while the boxcar is on it
+    FilterStream *stream;     //!< The boxcar while it is on the input
+  };
+
+
+  static Cube *openInput(const QString &fileName);
+  static void checkBoxcar(Cube *cube, int boxSamples, int boxLines);
+
+
+  /**
+   * Creates a mosaic with the seams between the inputs removed. The result is the lowpass of the
+   * mosaic of the inputs plus the mosaic of the highpasses of the inputs, both with a
+   * SAMPLES x LINES boxcar.
+   *
+   * The inputs are mosaicked into TO first, with the automos defaults. The filtered mosaic then
+   * replaces it line by line. The boxcars of the mosaic and of each input are moved down together,
+   * so no intermediate cubes are written and only the lines in the boxcars are kept in memory.
+   *
+   * @param ui The User Interface to parse the parameters from
+   */
+  void noseam(UserInterface &ui) {
+    FileList list;
+    list.read(FileName(ui.GetFileName("FROMLIST")));
+
+    int boxSamples = ui.GetInteger("SAMPLES");
+    int boxLines = ui.GetInteger("LINES");
+    QString toFile = ui.GetCubeName("TO");
+
+    // Mosaic the original images
+    ProcessMapMosaic m;
+    m.SetCreateFlag(true);
+    m.SetTrackFlag(false);
+    m.SetImageOverlay(ProcessMosaic::PlaceImagesOnTop);
+    m.SetOutputCube(list, ui.GetOutputAttribute("TO"), toFile);
+    m.SetBandBinMatch(ui.GetBoolean("MATCHBANDBIN"));
+
+    QList<Placement> placements;
+    for (int i = 0; i < list.size(); i++) {
+      if (!m.StartProcess(list[i].toString())) continue;
+      m.SetCreateFlag(false);
+
+      Cube *cube = openInput(list[i].toString());
+      try {
+        checkBoxcar(cube, boxSamples, boxLines);
+      }
+      catch (IException &e) {
+        delete cube;
+        throw;
+      }
+
+      Placement placement;
+      placement.fileName = list[i].toString();
+      placement.locations = m.MosaicLocations(*cube);
+      placement.samples = cube->sampleCount();
+      placement.lines = cube->lineCount();
+      placement.bands = cube->bandCount();
+      placement.cube = NULL;
+      placement.stream = NULL;
+      placements.append(placement);
+      delete cube;
+    }
+    m.EndProcess();
+
+    if (placements.isEmpty()) {
+      QString msg = "None of the cubes in [" + ui.GetFileName("FROMLIST") +
+                    "] are inside the mosaic";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    Cube mosaic;
+    mosaic.open(toFile, "rw");
+    checkBoxcar(&mosaic, boxSamples, boxLines);
+
+    int ns = mosaic.sampleCount();
+    int nl = mosaic.lineCount();
+    int nb = mosaic.bandCount();
+
+    Progress progress;
+    progress.SetText("Removing seams");
+    progress.SetMaximumSteps(nb * nl);
+    progress.CheckStatus();
+
+    LineManager out(mosaic);
+    vector<double> highpass(ns);
+    for (int band = 1; band <= nb; band++) {
+      FilterStream original(&mosaic, band, boxSamples, boxLines);
+
+      for (int line = 1; line <= nl; line++) {
+        original.seek(line);
+
+        // Mosaic the highpasses of the inputs on this line, the last input on top
+        fill(highpass.begin(), highpass.end(), Null);
+        for (int i = 0; i < placements.size(); i++) {
+          Placement &placement = placements[i];
+          int inputLine = line - placement.locations[0].y() + 1;
+          if (band > placement.bands || inputLine < 1 || inputLine > placement.lines) continue;
+
+          if (!placement.stream) {
+            placement.cube = openInput(placement.fileName);
+            placement.stream = new FilterStream(placement.cube, band, boxSamples, boxLines);
+          }
+          placement.stream->seek(inputLine);
+          const double *in = placement.stream->center();
+          QuickFilter &filter = placement.stream->filter();
+
+          for (int j = 0; j < placement.locations.size(); j++) {
+            int startSample = placement.locations[j].x();
+            int first = max(1, 2 - startSample);
+            int last = min(placement.samples, ns - startSample + 1);
+            for (int is = first; is <= last; is++) {
+              // Special pixels propagate through highpass, and are not placed on the mosaic
+              if (IsSpecial(in[is - 1])) continue;
+              double average = filter.Average(is - 1);
+              if (IsSpecial(average)) continue;
+              highpass[startSample + is - 2] = in[is - 1] - average;
+            }
+          }
+
+          if (inputLine == placement.lines) {
+            delete placement.stream;
+            delete placement.cube;
+            placement.stream = NULL;
+            placement.cube = NULL;
+          }
+        }
+
+        // Add the highpass to the lowpass of the original mosaic
+        const double *in = original.center();
+        QuickFilter &filter = original.filter();
+        out.SetLine(line, band);
+        for (int s = 0; s < ns; s++) {
+          double lowpass = (filter.Count(s) >= 1) ? filter.Average(s) : in[s];
+          if (IsSpecial(highpass[s])) {
+            out[s] = highpass[s];
+          }
+          else if (IsSpecial(lowpass)) {
+            out[s] = Null;
+          }
+          else {
+            out[s] = highpass[s] + lowpass;
+          }
+        }
+        mosaic.write(out);
+        progress.CheckStatus();
+      }
+
+      // Inputs that extend below the mosaic are still open
+      for (int i = 0; i < placements.size(); i++) {
+        delete placements[i].stream;
+        delete placements[i].cube;
+        placements[i].stream = NULL;
+        placements[i].cube = NULL;
+      }
+    }
+
+    mosaic.close();
+  }
+
+
+  /**
+   * Opens an input cube listed in FROMLIST, honoring its band attributes.
+   *
+   * @param fileName The input as listed in FROMLIST
+   *
+   * @return Cube* The opened input, owned by the caller
+   */
+  static Cube *openInput(const QString &fileName) {
+    CubeAttributeInput att(fileName);
+    Cube *cube = new Cube;
+    if (att.bands().size() != 0) {
+      vector<QString> bands = att.bands();
+      cube->setVirtualBands(bands);
+    }
+
+    try {
+      cube->open(FileName(fileName).expanded());
+    }
+    catch (IException &e) {
+      delete cube;
+      throw;
+    }
+    return cube;
+  }
+
+
+  /**
+   * Makes sure a boxcar fits in a cube once its edges are mirrored, as ProcessByQuickFilter does.
+   *
+   * @param cube The cube to filter
+   * @param boxSamples Number of samples in the boxcar
+   * @param boxLines Number of lines in the boxcar
+   *
+   * @throws IException::User "Boxcar width is too big for cube size"
+   * @throws IException::User "Boxcar height is too big for cube size"
+   */
+  static void checkBoxcar(Cube *cube, int boxSamples, int boxLines) {
+    if (cube->sampleCount() * 2 - 1 < boxSamples) {
+      QString msg = "Boxcar width is too big for cube [" + cube->fileName() + "] size";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+    if (cube->lineCount() * 2 - 1 < boxLines) {
+      QString msg = "Boxcar height is too big for cube [" + cube->fileName() + "] size";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+  }
+}
@@ -0,0 +1,10 @@
+#ifndef noseam_h
+#define noseam_h
+
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void noseam(UserInterface &ui);
+}
+
+#endif
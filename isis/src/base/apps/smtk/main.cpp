@@ -2,7 +2,10 @@
 
 #include "Isis.h"
 
+#include <QSet>
+#include <QThreadPool>
 #include <QTime>
+#include <QVector>
 
 #include "Chip.h"
 #include "ControlMeasure.h"
@@ -92,6 +95,56 @@ void WriteCnet(const QString &netfile, SmtkQStack &points,
 }
 
 
+/** Function that registers a batch of grid points and stacks the valid ones */
+void RegisterGrid(SmtkMatcher &matcher, QVector<SmtkQPair> &grid,
+                  SmtkQStack &points, Statistics &eigens, Progress &prog) {
+  QVector<Coordinate> lpnts;
+  for (int i = 0 ; i < grid.size() ; i++) {
+    lpnts.append(Coordinate(grid[i].first, grid[i].second));
+  }
+
+  QVector<SmtkPoint> spnts = matcher.Register(lpnts);
+  for (int i = 0 ; i < spnts.size() ; i++) {
+    if ( spnts[i].isValid() ) {
+      matcher.isValid(spnts[i]);
+      points.insert(grid[i], spnts[i]);
+      eigens.AddData(spnts[i].GoodnessOfFit());
+    }
+    prog.CheckStatus();
+  }
+
+  grid.clear();
+  return;
+}
+
+
+/**
+ * Function that finds the points with the smallest eigen values on a stack.
+ * Points with the same eigen value are taken in the order of the stack, so
+ * the first key is the point found by SmtkMatcher::FindSmallestEV.
+ */
+QVector<SmtkQPair> FindSmallestEVs(const SmtkQStack &stack, int count) {
+  QVector<SmtkQPair> keys;
+  QVector<double> eigens;
+  SmtkQStackConstIter current = stack.begin();
+  while ( current != stack.end() ) {
+    double eigen = current.value().GoodnessOfFit();
+    if ( (keys.size() < count) || (eigen < eigens.last()) ) {
+      int pos = keys.size();
+      while ( (pos > 0) && (eigen < eigens[pos-1]) ) pos--;
+      keys.insert(pos, current.key());
+      eigens.insert(pos, eigen);
+      if (keys.size() > count) {
+        keys.removeLast();
+        eigens.removeLast();
+      }
+    }
+    ++current;
+  }
+  return (keys);
+}
+
+
 /** The ISIS smtk main application */
 void IsisMain() {
   // 2016-10-14 Ian Humphrey -
@@ -229,19 +282,20 @@ void IsisMain() {
     Statistics temp_mev;
 
     // Loop through grid of points and get statistics to compute
-    // initial set of points
+    // initial set of points.  The points are registered concurrently in
+    // batches.
+    int gridBatch = QThreadPool::globalInstance()->maxThreadCount() * 16;
+    QVector<SmtkQPair> grid;
     for (int line = linc / 2 + 1; line < nl; line += linc) {
       for (int samp = sinc / 2 + 1 ; samp < ns; samp += sinc) {
         numAttemptedInitialPoints ++;
-        SmtkPoint spnt = matcher.Register(Coordinate(line,samp));
-        if ( spnt.isValid() ) {
-          matcher.isValid(spnt);
-          fpass.insert(qMakePair(line, samp), spnt);
-          temp_mev.AddData(spnt.GoodnessOfFit());
+        grid.append(qMakePair(line, samp));
+        if (grid.size() >= gridBatch) {
+          RegisterGrid(matcher, grid, fpass, temp_mev, prog);
         }
-        prog.CheckStatus();
       }
     }
+    RegisterGrid(matcher, grid, fpass, temp_mev, prog);
 
     //  Now select a subset of fpass points as the seed points
     cout << "Number of Potential Seed Points: " << fpass.size() << "\n";
@@ -314,35 +368,51 @@ void IsisMain() {
 
   int subcbox = ui.GetInteger("SUBCBOX");
   int halfBox((subcbox-1)/2);
+
+  // The best points on the stack are registered concurrently in batches.  A
+  // batch size of 1 grows the points one at a time.
+  int growBatch = ui.GetInteger("GROWBATCH");
   while (!gstack.isEmpty()) {
 
-    SmtkQStackIter cstack = matcher.FindSmallestEV(gstack);
+    QVector<SmtkQPair> keys = FindSmallestEVs(gstack, growBatch);
+
+    // Test to see if already determined
+    QVector<SmtkQPair> batchKeys;
+    QVector<SmtkPoint> batch;
+    for (int b = 0 ; b < keys.size() ; b++) {
+      SmtkQStackIter cstack = gstack.find(keys[b]);
+
+      // Print number on stack
+      if (((gstack.size() - b) % 1000) == 0) {
+        cout << "Number on Stack: " << gstack.size() - b
+             << ". " << cstack.value().GoodnessOfFit() << "\n";
+      }
 
-    // Print number on stack
-    if ((gstack.size() % 1000) == 0) {
-      cout << "Number on Stack: " << gstack.size()
-           << ". " << cstack.value().GoodnessOfFit() << "\n";
+      if (!bmf.contains(keys[b])) {
+        // Its not in the final stack, process it
+        batchKeys.append(keys[b]);
+        batch.append(cstack.value());
+      }
     }
 
-    // Test to see if already determined
-    SmtkQStackIter bmfPt = bmf.find(cstack.key());
-    if (bmfPt == bmf.end()) {
-      // Its not in the final stack, process it
+    //  Register the points that are not already registered
+    batch = matcher.Register(batch);
+
+    QSet<SmtkQPair> regrown;
+    for (int b = 0 ; b < batch.size() ; b++) {
+      // A point grown earlier in the batch may have determined this one
+      if (bmf.contains(batchKeys[b])) continue;
 
       //  Retrieve the point
-      SmtkPoint spnt = cstack.value();
-      //  Register if its not already registered
-      if (!spnt.isRegistered()) {
-        spnt = matcher.Register(spnt, spnt.getAffine());
-      }
+      const SmtkPoint &spnt = batch[b];
 
       // Still must check for validity if the point was just registered,
       // otherwise should be good
       if ( spnt.isValid() ) {
         passpix2++;
-        bmf.insert(cstack.key(), spnt);  // inserts (0,0) offset excluded below
-        int line   = cstack.key().first;
-        int sample = cstack.key().second;
+        bmf.insert(batchKeys[b], spnt);  // inserts (0,0) offset excluded below
+        int line   = batchKeys[b].first;
+        int sample = batchKeys[b].second;
 
         //  Determine match points
         double eigen(spnt.GoodnessOfFit());
@@ -391,6 +461,7 @@ void IsisMain() {
                 SmtkQStackIter temp = bmf.find(growpt);
                 if (temp == bmf.end()) {
                   gstack.insert(growpt, gpnt);
+                  regrown.insert(growpt);
                 }
               }
             }
@@ -399,8 +470,13 @@ void IsisMain() {
       }
     }
 
-    // Remove the current point from the grow stack (hole)
-    gstack.erase(cstack);
+    // Remove the current points from the grow stack (hole), unless another
+    // point in the batch grew a new point at the same place
+    for (int b = 0 ; b < keys.size() ; b++) {
+      if (!regrown.contains(keys[b])) {
+        gstack.remove(keys[b]);
+      }
+    }
   }
 
 /////////////////////////////////////////////////////////////////////////
@@ -18,6 +18,10 @@ find files of those names at the top level of this repository. **/
 #include "Plugin.h"
 #include "PolynomialBivariate.h"
 #include "Pvl.h"
+#include "SubpixelPeak.h"
+
+#include <algorithm>
+#include <vector>
 
 using namespace std;
 namespace Isis {
@@ -49,11 +53,14 @@ namespace Isis {
    *       <li>Tolerance = Isis::Null
    *       <li>SubpixelAccuracy = True
    *       <li>ReductionFactor = 1
+   *       <li>PyramidLevels = 1
+   *       <li>PyramidCandidates = 3
    *     </ul>
    *  <li> SurfaceModel
    *     <ul>
    *       <li>DistanceTolerance = 1.5
    *       <li>WindowSize = 5
+   *       <li>Method = CenterOfMass
    *     </ul>
    * </ul>
    * The reduced chips are initially set to the same size as their corresponding
@@ -83,8 +90,11 @@ namespace Isis {
     SetSubPixelAccuracy(true);
     SetSurfaceModelDistanceTolerance(1.5);
     SetSurfaceModelWindowSize(5);
+    p_surfaceModelMethod = CenterOfMass;
 
     SetReductionFactor(1);
+    SetPyramidLevels(1);
+    SetPyramidCandidates(3);
 
     // Clear statistics
     //TODO: Delete these after control net refactor.
@@ -208,6 +218,14 @@ namespace Isis {
         SetReductionFactor((int)algo["ReductionFactor"]);
       }
 
+      if(algo.hasKeyword("PyramidLevels")) {
+        SetPyramidLevels((int)algo["PyramidLevels"]);
+      }
+
+      if(algo.hasKeyword("PyramidCandidates")) {
+        SetPyramidCandidates((int)algo["PyramidCandidates"]);
+      }
+
       if (algo.hasKeyword("Gradient")) {
         SetGradientFilterType((QString)algo["Gradient"]);
       }
@@ -253,6 +271,10 @@ namespace Isis {
         if(smodel.hasKeyword("WindowSize")) {
           SetSurfaceModelWindowSize((int)smodel["WindowSize"]);
         }
+
+        if(smodel.hasKeyword("Method")) {
+          SetSurfaceModelMethod((QString)smodel["Method"]);
+        }
       }
 
     }
@@ -508,6 +530,50 @@ namespace Isis {
   }
 
 
+  /**
+   * Set the method used to refine the best whole pixel fit in the fit chip to sub-pixel
+   * accuracy. CenterOfMass takes the weighted center of mass of the pixels around the best
+   * fit. Paraboloid and Parabola fit the surface model window with SubpixelPeak.
+   *
+   * If this method is not called, the method defaults to CenterOfMass in the AutoReg object
+   * constructor.
+   *
+   * @param method CenterOfMass, Paraboloid or Parabola
+   * @throw iException::User - "Invalid value for SurfaceModel Method."
+   */
+  void AutoReg::SetSurfaceModelMethod(const QString &method) {
+    if (method == "CenterOfMass") {
+      p_surfaceModelMethod = CenterOfMass;
+    }
+    else if (method == "Paraboloid") {
+      p_surfaceModelMethod = Paraboloid;
+    }
+    else if (method == "Parabola") {
+      p_surfaceModelMethod = Parabola;
+    }
+    else {
+      throw IException(IException::User,
+                       "Invalid value for SurfaceModel Method [" + method +
+                       "].  Must be CenterOfMass, Paraboloid or Parabola",
+                       _FILEINFO_);
+    }
+  }
+
+
+  /**
+   * Returns the name of the method used to refine the best whole pixel fit.
+   *
+   * @return @b QString CenterOfMass, Paraboloid or Parabola
+   */
+  QString AutoReg::SurfaceModelMethodString() const {
+    switch (p_surfaceModelMethod) {
+      case Paraboloid: return "Paraboloid";
+      case Parabola: return "Parabola";
+      default: return "CenterOfMass";
+    }
+  }
+
+
   /**
    * Set the reduction factor used to speed up the pattern
    * matching algorithm.
@@ -527,6 +593,54 @@ namespace Isis {
     p_reduceFactor = factor;
   }
 
+
+  /**
+   * Set the number of levels in the image pyramid used to find the best
+   * registration.  Level 1 is full resolution, and each level after it has
+   * half of the resolution of the level before.  The whole search chip is
+   * only searched at the coarsest level. The best candidates from each level
+   * are then refined in a small window at the next finer level.
+   *
+   * If this method is not called, the number of levels defaults to 1 in the
+   * AutoReg object constructor, which searches the whole search chip at full
+   * resolution.
+   *
+   * @param levels Number of pyramid levels.  Must be greater than or equal
+   *               to 1.
+   * @throw iException::User - "Invalid value for Algorithm PyramidLevels."
+   */
+  void AutoReg::SetPyramidLevels(int levels) {
+    if(levels < 1) {
+      string msg = "Invalid value for Algorithm PyramidLevels ["
+        + IString(levels) + "].  Must greater than or equal to 1.";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+    p_pyramidLevels = levels;
+  }
+
+
+  /**
+   * Set the number of candidate positions that are kept at each level of the
+   * image pyramid and refined at the next finer level.  Keeping more than one
+   * candidate makes it less likely that the coarse levels will lose the
+   * correct position in repetitive or low contrast areas.
+   *
+   * If this method is not called, the number of candidates defaults to 3 in
+   * the AutoReg object constructor.
+   *
+   * @param candidates Number of candidates.  Must be greater than or equal
+   *                   to 1.
+   * @throw iException::User - "Invalid value for Algorithm PyramidCandidates."
+   */
+  void AutoReg::SetPyramidCandidates(int candidates) {
+    if(candidates < 1) {
+      string msg = "Invalid value for Algorithm PyramidCandidates ["
+        + IString(candidates) + "].  Must greater than or equal to 1.";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+    p_pyramidCandidates = candidates;
+  }
+
   /**
    * This method reduces the given chip by the given reduction
    * factor. Used to speed up the match algorithm.
@@ -574,6 +688,232 @@ namespace Isis {
   }
 
 
+  /**
+   * Reduce a chip to the next level of an image pyramid.  The chip is
+   * smoothed with a 5x5 binomial (approximately Gaussian) filter and every
+   * other sample and line is kept, so pixel s, l of the reduced chip is
+   * centered on pixel 2s-1, 2l-1 of the chip.  Pixels that are not valid are
+   * left out of the filter, and reduced pixels centered on them are Null.
+   *
+   * @param chip Chip to be reduced
+   *
+   * @return @b Chip Reduced chip object
+   */
+  Chip AutoReg::PyramidReduce(Chip &chip) {
+    static const double weights[5] = {1.0, 4.0, 6.0, 4.0, 1.0};
+
+    Chip rChip((chip.Samples() + 1) / 2, (chip.Lines() + 1) / 2);
+    for(int l = 1; l <= rChip.Lines(); l++) {
+      int line = 2 * l - 1;
+      for(int s = 1; s <= rChip.Samples(); s++) {
+        int samp = 2 * s - 1;
+        if(!chip.IsValid(samp, line)) {
+          rChip.SetValue(s, l, Isis::Null);
+          continue;
+        }
+
+        double sum = 0.0;
+        double weightSum = 0.0;
+        for(int j = -2; j <= 2; j++) {
+          if(line + j < 1 || line + j > chip.Lines()) continue;
+          for(int i = -2; i <= 2; i++) {
+            if(samp + i < 1 || samp + i > chip.Samples()) continue;
+            if(!chip.IsValid(samp + i, line + j)) continue;
+            double weight = weights[i + 2] * weights[j + 2];
+            sum += weight * chip.GetValue(samp + i, line + j);
+            weightSum += weight;
+          }
+        }
+        rChip.SetValue(s, l, sum / weightSum);
+      }
+    }
+    return rChip;
+  }
+
+
+  /**
+   * Search an image pyramid of the search and pattern chips for the area of
+   * the full resolution search chip that should be matched.
+   *
+   * The whole search chip is matched only at the coarsest level.  The best
+   * PyramidCandidates positions there are each matched in a small window at
+   * the next finer level, and the best candidates from all of those windows
+   * are passed on to the level after it.  At full resolution the candidate
+   * windows are matched again, and the window with the best fit is returned.
+   *
+   * @param sChip Search chip
+   * @param pChip Pattern chip
+   * @param startSamp In: first sample that can be matched.  Out: first sample of the window
+   * @param endSamp In: last sample that can be matched.  Out: last sample of the window
+   * @param startLine In: first line that can be matched.  Out: first line of the window
+   * @param endLine In: last line that can be matched.  Out: last line of the window
+   * @param bestSamp Best sample at full resolution
+   * @param bestLine Best line at full resolution
+   *
+   * @return @b bool False if no fit was found at some level
+   */
+  bool AutoReg::PyramidSearch(Chip &sChip, Chip &pChip, int &startSamp, int &endSamp,
+                              int &startLine, int &endLine, int &bestSamp, int &bestLine) {
+    // Build the pyramids.  Level 0 is full resolution.
+    vector<Chip> searchPyramid(1, sChip);
+    vector<Chip> patternPyramid(1, pChip);
+    for(int level = 1; level < p_pyramidLevels; level++) {
+      searchPyramid.push_back(PyramidReduce(searchPyramid[level - 1]));
+      patternPyramid.push_back(PyramidReduce(patternPyramid[level - 1]));
+    }
+
+    // Match the whole search chip at the coarsest level
+    int top = p_pyramidLevels - 1;
+    int levelStartSamp = (patternPyramid[top].Samples() - 1) / 2 + 1;
+    int levelStartLine = (patternPyramid[top].Lines() - 1) / 2 + 1;
+    int levelEndSamp = searchPyramid[top].Samples() - levelStartSamp + 1;
+    int levelEndLine = searchPyramid[top].Lines() - levelStartLine + 1;
+    if(levelStartSamp >= levelEndSamp && levelStartLine >= levelEndLine) return false;
+
+    Chip fitChip;
+    Match(searchPyramid[top], patternPyramid[top], fitChip,
+          levelStartSamp, levelEndSamp, levelStartLine, levelEndLine);
+
+    vector<double> fits;
+    vector<int> samples;
+    vector<int> lines;
+    AddCandidates(fitChip, levelStartSamp, levelEndSamp, levelStartLine, levelEndLine,
+                  fits, samples, lines);
+    p_bestSamp = 0;
+    p_bestLine = 0;
+    p_bestFit = Isis::Null;
+
+    // Refine the candidates at each finer level
+    for(int level = top - 1; level >= 0; level--) {
+      if(fits.empty()) return false;
+
+      levelStartSamp = (patternPyramid[level].Samples() - 1) / 2 + 1;
+      levelStartLine = (patternPyramid[level].Lines() - 1) / 2 + 1;
+      levelEndSamp = searchPyramid[level].Samples() - levelStartSamp + 1;
+      levelEndLine = searchPyramid[level].Lines() - levelStartLine + 1;
+      if(level == 0) {
+        levelStartSamp = startSamp;
+        levelStartLine = startLine;
+        levelEndSamp = endSamp;
+        levelEndLine = endLine;
+      }
+
+      // The window around each candidate must cover the rounding of the
+      // coarser level.  At full resolution it must also cover the surface
+      // model window.
+      int margin = (level == 0) ? p_windowSize + 3 : 2;
+
+      vector<double> levelFits;
+      vector<int> levelSamples;
+      vector<int> levelLines;
+      double bestWindowFit = Isis::Null;
+      for(unsigned int i = 0; i < fits.size(); i++) {
+        int samp = 2 * samples[i] - 1;
+        int line = 2 * lines[i] - 1;
+        int windowStartSamp = max(samp - margin, levelStartSamp);
+        int windowEndSamp = min(samp + margin, levelEndSamp);
+        int windowStartLine = max(line - margin, levelStartLine);
+        int windowEndLine = min(line + margin, levelEndLine);
+        if(windowStartSamp > windowEndSamp || windowStartLine > windowEndLine ||
+           (windowStartSamp == windowEndSamp && windowStartLine == windowEndLine)) {
+          continue;
+        }
+
+        Match(searchPyramid[level], patternPyramid[level], fitChip,
+              windowStartSamp, windowEndSamp, windowStartLine, windowEndLine);
+
+        if(level > 0) {
+          AddCandidates(fitChip, windowStartSamp, windowEndSamp, windowStartLine,
+                        windowEndLine, levelFits, levelSamples, levelLines);
+        }
+        else if(p_bestFit != Isis::Null &&
+                (bestWindowFit == Isis::Null || CompareFits(p_bestFit, bestWindowFit))) {
+          // Keep the full resolution window with the best fit
+          bestWindowFit = p_bestFit;
+          bestSamp = samp;
+          bestLine = line;
+          startSamp = windowStartSamp;
+          endSamp = windowEndSamp;
+          startLine = windowStartLine;
+          endLine = windowEndLine;
+        }
+
+        p_bestSamp = 0;
+        p_bestLine = 0;
+        p_bestFit = Isis::Null;
+      }
+
+      if(level == 0) return bestWindowFit != Isis::Null;
+
+      fits = levelFits;
+      samples = levelSamples;
+      lines = levelLines;
+    }
+
+    return !fits.empty();
+  }
+
+
+  /**
+   * Add the local best fits in a window of a fit chip to a list of
+   * candidates, which is kept sorted from the best fit and limited to
+   * PyramidCandidates entries.  Candidates that are already in the list are
+   * not added again.
+   *
+   * @param fChip Fit chip
+   * @param startSamp Start sample of the window
+   * @param endSamp End sample of the window
+   * @param startLine Start line of the window
+   * @param endLine End line of the window
+   * @param fits Fits of the candidates
+   * @param samples Samples of the candidates
+   * @param lines Lines of the candidates
+   */
+  void AutoReg::AddCandidates(Chip &fChip, int startSamp, int endSamp, int startLine,
+                              int endLine, vector<double> &fits, vector<int> &samples,
+                              vector<int> &lines) {
+    for(int line = startLine; line <= endLine; line++) {
+      for(int samp = startSamp; samp <= endSamp; samp++) {
+        double fit = fChip.GetValue(samp, line);
+        if(fit == Isis::Null) continue;
+
+        // Only keep positions that are at least as good as their neighbors
+        bool localBest = true;
+        for(int j = max(line - 1, startLine); localBest && j <= min(line + 1, endLine); j++) {
+          for(int i = max(samp - 1, startSamp); i <= min(samp + 1, endSamp); i++) {
+            double neighbor = fChip.GetValue(i, j);
+            if(neighbor != Isis::Null && !CompareFits(fit, neighbor)) {
+              localBest = false;
+              break;
+            }
+          }
+        }
+        if(!localBest) continue;
+
+        bool duplicate = false;
+        for(unsigned int c = 0; c < fits.size(); c++) {
+          if(samples[c] == samp && lines[c] == line) duplicate = true;
+        }
+        if(duplicate) continue;
+
+        // Insert in order from the best fit
+        unsigned int index = fits.size();
+        while(index > 0 && !CompareFits(fits[index - 1], fit)) index--;
+        if(index >= (unsigned int) p_pyramidCandidates) continue;
+
+        fits.insert(fits.begin() + index, fit);
+        samples.insert(samples.begin() + index, samp);
+        lines.insert(lines.begin() + index, line);
+        if(fits.size() > (unsigned int) p_pyramidCandidates) {
+          fits.pop_back();
+          samples.pop_back();
+          lines.pop_back();
+        }
+      }
+    }
+  }
+
+
   /**
    * Walk the pattern chip through the search chip to find the best registration
    *
@@ -665,6 +1005,23 @@ namespace Isis {
       }
     }
 
+    if (p_pyramidLevels != 1) {
+      if (p_reduceFactor != 1) {
+        string msg = "Algorithm ReductionFactor and PyramidLevels can not both be used";
+        throw IException(IException::User, msg, _FILEINFO_);
+      }
+
+      // Each level halves the chips, so the coarsest pattern chip must still
+      // be at least 3x3
+      int coarsest = 1 << (p_pyramidLevels - 1);
+      if(gradientPatternChip.Samples() < 2 * coarsest + 1 ||
+         gradientPatternChip.Lines() < 2 * coarsest + 1) {
+        string msg = "Pyramid levels [" + IString(p_pyramidLevels) + "] is too large "
+          "for the pattern chip";
+        throw IException(IException::User, msg, _FILEINFO_);
+      }
+    }
+
     // Establish the center search tack point as best pixel to start for the
     // adaptive algorithm prior to reduction.
     int bestSearchSamp = gradientSearchChip.TackSample();
@@ -745,6 +1102,17 @@ namespace Isis {
       p_bestLine = 0;
       p_bestFit = Isis::Null;
     }
+    else if(p_pyramidLevels != 1) {
+      // Search the image pyramid from the coarsest level to find the area of
+      // the full resolution search chip to match in
+      if(!PyramidSearch(gradientSearchChip, gradientPatternChip,
+                        startSamp, endSamp, startLine, endLine,
+                        bestSearchSamp, bestSearchLine)) {
+        p_fitChipNoDataCount++;
+        p_registrationStatus = FitChipNoData;
+        return FitChipNoData;
+      }
+    }
 
     p_registrationStatus = Registration(gradientSearchChip, gradientPatternChip,
         p_fitChip, startSamp, startLine, endSamp, endLine,
@@ -1046,23 +1414,70 @@ namespace Isis {
       }
     }
 
-    // Create a chip the same size as the pattern chip.
-    Chip subsearch(pChip.Samples(), pChip.Lines());
+    // Let the algorithm compute all of the fits at once if it can, otherwise
+    // match the subsearch chips one at a time
+    if(!ComputeFitChip(sChip, pChip, fChip, startSamp, endSamp, startLine, endLine)) {
+      // Create a chip the same size as the pattern chip.
+      Chip subsearch(pChip.Samples(), pChip.Lines());
+
+      // Count the valid pixels in the search chip with a summed-area table so
+      // the subsearch chips without enough valid data are skipped before they
+      // are extracted. validCounts[l][s] is the number of valid pixels above
+      // and to the left of sample s + 1 and line l + 1.
+      int samples = sChip.Samples();
+      int lines = sChip.Lines();
+      vector< vector<int> > validCounts(lines + 1, vector<int>(samples + 1, 0));
+      for(int line = 1; line <= lines; line++) {
+        int rowCount = 0;
+        for(int samp = 1; samp <= samples; samp++) {
+          if(sChip.IsValid(samp, line)) rowCount++;
+          validCounts[line][samp] = validCounts[line - 1][samp] + rowCount;
+        }
+      }
 
-    for(int line = startLine; line <= endLine; line++) {
-      for(int samp = startSamp; samp <= endSamp; samp++) {
-        // Extract the subsearch chip and make sure it has enough valid data
-        sChip.Extract(samp, line, subsearch);
+      int subsearchSamples = subsearch.Samples();
+      int subsearchLines = subsearch.Lines();
+      int subsearchPixels = subsearchSamples * subsearchLines;
+      int tackSample = (subsearchSamples - 1) / 2 + 1;
+      int tackLine = (subsearchLines - 1) / 2 + 1;
+      for(int line = startLine; line <= endLine; line++) {
+        // Lines of the subsearch chip that are inside of the search chip
+        int firstLine = max(line - tackLine + 1, 1);
+        int lastLine = min(line - tackLine + subsearchLines, lines);
+
+        for(int samp = startSamp; samp <= endSamp; samp++) {
+          int firstSamp = max(samp - tackSample + 1, 1);
+          int lastSamp = min(samp - tackSample + subsearchSamples, samples);
+
+          // Make sure the subsearch chip has enough valid data
+          int validCount = 0;
+          if(firstLine <= lastLine && firstSamp <= lastSamp) {
+            validCount = validCounts[lastLine][lastSamp] - validCounts[firstLine - 1][lastSamp] -
+                         validCounts[lastLine][firstSamp - 1] + validCounts[firstLine - 1][firstSamp - 1];
+          }
+          double validPercentage = 100.0 * (double) validCount / (double) subsearchPixels;
+//          if(!subsearch.IsValid(p_patternValidPercent)) continue;
+          if(validPercentage < p_subsearchValidPercent) continue;
 
-//        if(!subsearch.IsValid(p_patternValidPercent)) continue;
-        if(!subsearch.IsValid(p_subsearchValidPercent)) continue;
+          // Extract the subsearch chip
+          sChip.Extract(samp, line, subsearch);
 
-        // Try to match the two subchips
-        double fit = MatchAlgorithm(pChip, subsearch);
+          // Try to match the two subchips
+          double fit = MatchAlgorithm(pChip, subsearch);
 
-        // If we had a fit save off information about that fit
+          // If we had a fit save it in the fit chip
+          if(fit != Isis::Null) {
+            fChip.SetValue(samp, line, fit);
+          }
+        }
+      }
+    }
+
+    // Save off information about the best fit
+    for(int line = startLine; line <= endLine; line++) {
+      for(int samp = startSamp; samp <= endSamp; samp++) {
+        double fit = fChip.GetValue(samp, line);
         if(fit != Isis::Null) {
-          fChip.SetValue(samp, line, fit);
           if((p_bestFit == Isis::Null) || CompareFits(fit, p_bestFit)) {
             p_bestFit = fit;
             p_bestSamp = samp;
@@ -1081,10 +1496,37 @@ namespace Isis {
    * centers of gravity in the centroiding algorithm are modeled by goodness of
    * fit values within a discrete search window.
    *
+   * When the surface model method is Paraboloid or Parabola the extremum of the window is
+   * found with SubpixelPeak instead.
+   *
    * @param window The search window extracted from the fit chip
    * @return @b bool Returns true if the subpixel solution is valid
    */
   bool AutoReg::SetSubpixelPosition(Chip &window) {
+    if (p_surfaceModelMethod != CenterOfMass) {
+      double sampleOffset, lineOffset;
+      bool solved;
+      if (p_surfaceModelMethod == Paraboloid) {
+        solved = SubpixelPeak::Paraboloid(window.Row(1), window.Samples(), window.Lines(),
+                                          window.ChipSample() - 1, window.ChipLine() - 1,
+                                          p_windowSize, sampleOffset, lineOffset);
+      }
+      else {
+        solved = SubpixelPeak::Parabola(window.Row(1), window.Samples(), window.Lines(),
+                                        window.ChipSample() - 1, window.ChipLine() - 1,
+                                        sampleOffset, lineOffset);
+      }
+
+      if (!solved) {
+        p_surfaceModelSolutionInvalidCount++;
+        return false;
+      }
+
+      p_chipSample = p_bestSamp + sampleOffset;
+      p_chipLine = p_bestLine + lineOffset;
+      return true;
+    }
+
     // The best correlation will be at the center of the window
     //   if it's smaller than the edge DN's invert the chip DNs
     double samples = window.Samples();
@@ -1206,6 +1648,31 @@ namespace Isis {
     return (AlgorithmStatistics(pvl));
   }
 
+  /**
+   * Add the cumulative registration statistics of another AutoReg object to
+   * this object's statistics. This allows registrations to be split across
+   * several AutoReg objects created from the same template, such as one for
+   * each thread, and still be reported together.
+   *
+   * @param other The AutoReg object to add statistics from. It should use the
+   *              same algorithm as this object.
+   */
+  void AutoReg::AddStatistics(const AutoReg &other) {
+    p_totalRegistrations += other.p_totalRegistrations;
+    p_pixelSuccesses += other.p_pixelSuccesses;
+    p_subpixelSuccesses += other.p_subpixelSuccesses;
+    p_patternChipNotEnoughValidDataCount += other.p_patternChipNotEnoughValidDataCount;
+    p_patternZScoreNotMetCount += other.p_patternZScoreNotMetCount;
+    p_fitChipNoDataCount += other.p_fitChipNoDataCount;
+    p_fitChipToleranceNotMetCount += other.p_fitChipToleranceNotMetCount;
+    p_surfaceModelNotEnoughValidDataCount += other.p_surfaceModelNotEnoughValidDataCount;
+    p_surfaceModelSolutionInvalidCount += other.p_surfaceModelSolutionInvalidCount;
+    p_surfaceModelDistanceInvalidCount += other.p_surfaceModelDistanceInvalidCount;
+
+    AddAlgorithmStatistics(other);
+  }
+
+
   /**
    * This function returns the keywords that this object was
    * created from.
@@ -1225,6 +1692,12 @@ namespace Isis {
     if(algo.hasKeyword("ReductionFactor")) {
       reg += PvlKeyword("ReductionFactor", algo["ReductionFactor"][0]);
     }
+    if(algo.hasKeyword("PyramidLevels")) {
+      reg += PvlKeyword("PyramidLevels", algo["PyramidLevels"][0]);
+    }
+    if(algo.hasKeyword("PyramidCandidates")) {
+      reg += PvlKeyword("PyramidCandidates", algo["PyramidCandidates"][0]);
+    }
     if(algo.hasKeyword("Gradient")) {
       reg += PvlKeyword("Gradient", algo["Gradient"][0]);
     }
@@ -1269,6 +1742,10 @@ namespace Isis {
       if(smodel.hasKeyword("WindowSize")) {
         reg += PvlKeyword("WindowSize", smodel["WindowSize"][0]);
       }
+
+      if(smodel.hasKeyword("Method")) {
+        reg += PvlKeyword("SurfaceModelMethod", smodel["Method"][0]);
+      }
     }
 
     return reg;
@@ -1294,6 +1771,8 @@ namespace Isis {
     reg += PvlKeyword("SubpixelAccuracy",
         SubPixelAccuracy() ? "True" : "False");
     reg += PvlKeyword("ReductionFactor", toString(ReductionFactor()));
+    reg += PvlKeyword("PyramidLevels", toString(PyramidLevels()));
+    reg += PvlKeyword("PyramidCandidates", toString(PyramidCandidates()));
     reg += PvlKeyword("Gradient", GradientFilterString());
 
     Chip *pattern = PatternChip();
@@ -1312,6 +1791,9 @@ namespace Isis {
     if (SubPixelAccuracy()) {
       reg += PvlKeyword("DistanceTolerance", toString(DistanceTolerance()));
       reg += PvlKeyword("WindowSize", toString(WindowSize()));
+      if (p_surfaceModelMethod != CenterOfMass) {
+        reg += PvlKeyword("SurfaceModelMethod", SurfaceModelMethodString());
+      }
     }
 
     return reg;
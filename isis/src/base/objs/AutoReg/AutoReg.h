@@ -198,6 +198,16 @@ namespace Isis {
         Sobel   //!< Sobel gradient filter
       };
 
+      /**
+       * Enumeration of the methods that can be used to refine the best whole pixel fit to
+       * sub-pixel accuracy.
+       */
+      enum SurfaceModelMethod {
+        CenterOfMass, //!< default, weighted center of mass of the fit chip peak
+        Paraboloid,   //!< Least squares 2-D quadratic fit over the window
+        Parabola      //!< Three point parabola fit along each axis
+      };
+
       //! Return pointer to pattern chip
       inline Chip *PatternChip() {
         return &p_patternChip;
@@ -255,11 +265,15 @@ namespace Isis {
       void SetChipInterpolator(const QString &interpolator);
       void SetSurfaceModelWindowSize(int size);
       void SetSurfaceModelDistanceTolerance(double distance);
+      void SetSurfaceModelMethod(const QString &method);
       void SetReductionFactor(int reductionFactor);
+      void SetPyramidLevels(int levels);
+      void SetPyramidCandidates(int candidates);
       void SetPatternZScoreMinimum(double minimum);
       void SetGradientFilterType(const QString &gradientFilterType);
 
       QString GradientFilterString() const;
+      QString SurfaceModelMethodString() const;
 
       /**
        * Return whether this object will attempt to register to whole or
@@ -276,6 +290,16 @@ namespace Isis {
         return p_reduceFactor;
       }
 
+      //! Return the number of pyramid levels, including full resolution.
+      int PyramidLevels() const {
+        return p_pyramidLevels;
+      }
+
+      //! Return the number of candidates kept at each pyramid level.
+      int PyramidCandidates() const {
+        return p_pyramidCandidates;
+      }
+
       //! Return pattern chip valid percent.  The default value is
       double PatternValidPercent() const {
         return p_patternValidPercent;
@@ -363,6 +387,7 @@ namespace Isis {
       }
 
       Pvl RegistrationStatistics();
+      void AddStatistics(const AutoReg &other);
 
       /**
        * Minimum tolerance specific to algorithm
@@ -422,6 +447,7 @@ namespace Isis {
       virtual bool CompareFits(double fit1, double fit2);
       bool SetSubpixelPosition(Chip &window);
       Chip Reduce(Chip &chip, int reductionFactor);
+      Chip PyramidReduce(Chip &chip);
 
       /**
        * Returns the ideal (perfect) fit that could be returned by the
@@ -446,6 +472,34 @@ namespace Isis {
        */
       virtual double MatchAlgorithm(Chip &pattern, Chip &subsearch) = 0;
 
+      /**
+       * @brief Provide algorithms a chance to compute the whole fit chip at once
+       *
+       * Algorithms that can compute the MatchAlgorithm value at every position
+       * faster than by extracting each subsearch chip may override this method.
+       * The fit chip must be filled with the same values that MatchAlgorithm
+       * would give for the subsearch chips that meet the subsearch valid
+       * percent, and with Nulls elsewhere, at least where they could affect
+       * the best fit or the surface model window around it.
+       *
+       * @param sChip Search chip
+       * @param pChip Pattern chip
+       * @param fChip Fit chip, the same size as the search chip and filled with
+       *              Nulls
+       * @param startSamp Start sample
+       * @param endSamp End sample
+       * @param startLine Start line
+       * @param endLine End line
+       *
+       * @return bool If the fit chip was computed. If not, the subsearch chips
+       *              are matched one at a time.
+       */
+      virtual bool ComputeFitChip(Chip &sChip, Chip &pChip, Chip &fChip,
+                                  int startSamp, int endSamp,
+                                  int startLine, int endLine) {
+        return false;
+      }
+
       PvlObject p_template; //!< AutoRegistration object that created this projection
 
       /**
@@ -462,6 +516,18 @@ namespace Isis {
         return (pvl);
       }
 
+      /**
+       * @brief Add the algorithm specific statistics of another object
+       *
+       * Provide Adaptive objects the opportunity to combine the behavior they
+       * report when registrations are split across several objects of the
+       * same algorithm.
+       *
+       * @param other The object to add statistics from
+       */
+      virtual void AddAlgorithmStatistics(const AutoReg &other) {
+      }
+
     private:
       /**
        * Empty copy constructor.
@@ -476,6 +542,11 @@ namespace Isis {
                  int startLine,
                  int endLine);
       bool ComputeChipZScore(Chip &chip);
+      bool PyramidSearch(Chip &sChip, Chip &pChip, int &startSamp, int &endSamp,
+                         int &startLine, int &endLine, int &bestSamp, int &bestLine);
+      void AddCandidates(Chip &fChip, int startSamp, int endSamp, int startLine,
+                         int endLine, std::vector<double> &fits,
+                         std::vector<int> &samples, std::vector<int> &lines);
       void Init();
       void ApplyGradientFilter(Chip &chip);
       void SobelGradient(Buffer &in, double &v);
@@ -519,6 +590,7 @@ namespace Isis {
 
       int p_windowSize;                                    //!< Surface model window size
       double p_distanceTolerance;                          //!< Maximum distance the surface model solution may be from the best whole pixel fit in the fit chip
+      AutoReg::SurfaceModelMethod p_surfaceModelMethod;    //!< Method used to refine the best whole pixel fit
 
       double p_bestFit;                                    //!< Goodness of fit for adaptive algorithms.
       int p_bestSamp;                                      //!< Sample value of best fit.
@@ -526,6 +598,8 @@ namespace Isis {
       double p_sampMovement;                               //!< The number of samples the point moved.
       double p_lineMovement;                               //!< The number of lines the point moved.
       int p_reduceFactor;                                  //!< Reduction factor.
+      int p_pyramidLevels;                                 //!< Number of pyramid levels, including full resolution.
+      int p_pyramidCandidates;                             //!< Number of candidates kept at each pyramid level.
       Isis::AutoReg::RegisterStatus p_registrationStatus;  //!< Registration status to be returned by Register().
       AutoReg::GradientFilterType p_gradientFilterType;    //!< Type of gradient filter to use before matching.
   };
@@ -7,6 +7,7 @@ find files of those names at the top level of this repository. **/
 
 #include "Chip.h"
 #include "Camera.h"
+#include "ChipTransformCache.h"
 #include "Cube.h"
 #include "IException.h"
 #include "Interpolator.h"
@@ -70,6 +71,7 @@ namespace Isis {
     m_affine = other.m_affine;
     m_readInterpolator = other.m_readInterpolator;
     m_filename = other.m_filename;
+    m_transformCache = other.m_transformCache;
   }
 
 
@@ -98,9 +100,7 @@ namespace Isis {
    * @param d Value to set the chip to
    */
   void Chip::SetAllValues(const double &d) {
-    for (unsigned int i = 0; i < m_buf.size(); i++) {
-      fill(m_buf[i].begin(), m_buf[i].end(), d);
-    }
+    fill(m_buf.begin(), m_buf.end(), d);
   }
 
 
@@ -118,6 +118,7 @@ namespace Isis {
     SetSize(samples, lines);
     SetValidRange();
     m_clipPolygon = NULL;
+    m_transformCache = NULL;
   }
 
 
@@ -141,11 +142,7 @@ namespace Isis {
     }
     m_chipSamples = samples;
     m_chipLines = lines;
-    m_buf.clear();
-    m_buf.resize(lines);
-    for (int i = 0; i < lines; i++) {
-      m_buf[i].resize(samples);
-    }
+    m_buf.assign(samples * lines, 0.0);
     m_affine.Identity();
     m_tackSample = ((samples - 1) / 2) + 1;
     m_tackLine = ((lines - 1) / 2) + 1;
@@ -296,6 +293,8 @@ namespace Isis {
    *                           added to ensure that we do not choose colinear points.
    *   @history 2010-06-10 Jeannie Walldren - Modified error message and added tolerance to
    *                           linearity check. Fixed error messages.
+   *   @history 2022-10-18 If a transform cache has been set, a transform that was fit for a
+   *                           match chip in the same cell of the match cube is reused.
    */
   void Chip::Load(Cube &cube, Chip &match, Cube &matchChipCube, const double scale, const int band)
   {
@@ -345,6 +344,37 @@ namespace Isis {
       }
     }
 
+    // A transform fit for a nearby chip on the same images and with the same match chip
+    // geometry can be used instead of fitting a new one
+    QString pairKey;
+    double matchTackSample = 0.0;
+    double matchTackLine = 0.0;
+    if (m_transformCache != NULL) {
+      Affine::AMatrix matchMatrix = match.GetTransform().Forward();
+      pairKey = cube.fileName() + "|" + matchChipCube.fileName() + "|" +
+                QString::number(Samples()) + "x" + QString::number(Lines()) + "|" +
+                QString::number(match.Samples()) + "x" + QString::number(match.Lines());
+      for (int row = 0; row < 2; row++) {
+        for (int col = 0; col < 2; col++) {
+          pairKey += "|" + QString::number(matchMatrix[row][col], 'g', 17);
+        }
+      }
+
+      match.SetChipPosition(match.TackSample(), match.TackLine());
+      matchTackSample = match.CubeSample();
+      matchTackLine = match.CubeLine();
+
+      Affine::AMatrix cached;
+      // The cached transform is only used if the chip is on the surface of both cubes, as
+      // a fit transform would be
+      if (m_transformCache->find(pairKey, matchTackSample, matchTackLine, cached) &&
+          TackOnSurface(matchCam, matchProj, cam, proj, matchTackSample, matchTackLine)) {
+        m_affine = Affine(cached);
+        ApplyLoadTransform(cube, scale, band);
+        return;
+      }
+    }
+
     // Ok we can attempt to create an affine transformation that maps our chip to the match chip.
     // We will need a set of at least 3 control points so we can fit the affine transform.
     // We will try to find 4 points, one from each corner of the chip.
@@ -502,7 +532,67 @@ namespace Isis {
 
     // Now take our control points and create the affine map
     m_affine.Solve(&x[0], &y[0], &xp[0], &yp[0], (int)x.size());
+    if (m_transformCache != NULL) {
+      m_transformCache->insert(pairKey, matchTackSample, matchTackLine, m_affine.Forward());
+    }
 
+    ApplyLoadTransform(cube, scale, band);
+  }
+
+
+  /**
+   * Called by Load() before a cached transform is used, to check that the match chip tack
+   * point is on the surface in both cubes. Without this a cached transform could load a chip
+   * that no longer intersects the cube, which fitting a new transform would reject.
+   *
+   * @param matchCam  The camera of the match chip cube or NULL
+   * @param matchProj The projection of the match chip cube if it has no camera
+   * @param cam       The camera of the cube being loaded or NULL
+   * @param proj      The projection of the cube being loaded if it has no camera
+   * @param matchSample The match chip tack sample in the match chip cube
+   * @param matchLine   The match chip tack line in the match chip cube
+   *
+   * @return @b bool True if the tack point maps from the match chip cube to the cube
+   */
+  bool Chip::TackOnSurface(Camera *matchCam, TProjection *matchProj, Camera *cam,
+                           Projection *proj, double matchSample, double matchLine) {
+    double lat, lon;
+    if (matchCam != NULL) {
+      matchCam->SetImage(matchSample, matchLine);
+      if (!matchCam->HasSurfaceIntersection()) {
+        return false;
+      }
+      lat = matchCam->UniversalLatitude();
+      lon = matchCam->UniversalLongitude();
+    }
+    else {
+      matchProj->SetWorld(matchSample, matchLine);
+      if (!matchProj->IsGood()) {
+        return false;
+      }
+      lat = matchProj->UniversalLatitude();
+      lon = matchProj->UniversalLongitude();
+    }
+
+    if (cam != NULL) {
+      cam->SetUniversalGround(lat, lon);
+      return cam->HasSurfaceIntersection();
+    }
+    proj->SetUniversalGround(lat, lon);
+    return proj->IsGood();
+  }
+
+
+  /**
+   * Called by Load() once the affine from the chip to the cube has been fit. Scales the
+   * affine, translates it so that the chip tack point maps to the tack cube position,
+   * and reads the data.
+   *
+   * @param cube  The cube used to put data into the chip
+   * @param scale Scale factor
+   * @param band  Band number to use when loading
+   */
+  void Chip::ApplyLoadTransform(Cube &cube, const double scale, const int band) {
     //  TLS  8/3/06  Apply scale
     m_affine.Scale(scale);
 
@@ -700,9 +790,10 @@ namespace Isis {
    */
   bool Chip::IsValid(double percentage) {
     int validCount = 0;
-    for (int samp = 1; samp <= Samples(); samp++) {
-      for (int line = 1; line <= Lines(); line++) {
-        if (IsValid(samp, line)) validCount++;
+    for (int line = 1; line <= Lines(); line++) {
+      const double *row = Row(line);
+      for (int samp = 0; samp < Samples(); samp++) {
+        validCount += (row[samp] >= m_validMinimum && row[samp] <= m_validMaximum);
       }
     }
     double validPercentage = 100.0 * (double) validCount /
@@ -776,20 +867,25 @@ namespace Isis {
     chipped.m_tackSample = ((samples - 1) / 2) + 1;
     chipped.m_tackLine = ((lines - 1) / 2) + 1;
 
+    // Copy the part of each line that is inside of this chip, and fill the
+    // rest with nulls
+    int firstSamp = samp - chipped.TackSample() + 1;
+    int startOsamp = max(1, 2 - firstSamp);
+    int endOsamp = min(samples, Samples() - firstSamp + 1);
+
     for (int oline = 1; oline <= lines; oline++) {
-      for (int osamp = 1; osamp <= samples; osamp++) {
-        int thisSamp = samp + (osamp - chipped.TackSample());
-        int thisLine = line + (oline - chipped.TackLine());
-        if ((thisSamp < 1) ||
-            (thisLine < 1) ||
-            (thisSamp > Samples()) ||
-            (thisLine > Lines()) ) {
-          chipped.SetValue(osamp, oline, Isis::Null);
-        }
-        else {
-          chipped.SetValue(osamp, oline, GetValue(thisSamp, thisLine));
-        }
+      int thisLine = line + (oline - chipped.TackLine());
+      double *outRow = chipped.Row(oline);
+      if ((thisLine < 1) || (thisLine > Lines()) || (startOsamp > endOsamp)) {
+        fill(outRow, outRow + samples, Isis::Null);
+        continue;
       }
+
+      const double *inRow = Row(thisLine);
+      fill(outRow, outRow + (startOsamp - 1), Isis::Null);
+      copy(inRow + (firstSamp + startOsamp - 2), inRow + (firstSamp + endOsamp - 1),
+           outRow + (startOsamp - 1));
+      fill(outRow + endOsamp, outRow + samples, Isis::Null);
     }
 
     chipped.m_affine = m_affine;
@@ -911,9 +1007,7 @@ namespace Isis {
 
     stats->SetValidRange(m_validMinimum, m_validMaximum);
 
-    for (int i = 0; i < m_chipSamples; i++) {
-      stats->AddData(&m_buf[i][0], m_chipLines);
-    }
+    stats->AddData(&m_buf[0], m_chipSamples * m_chipLines);
 
     return stats;
   }
@@ -935,12 +1029,60 @@ namespace Isis {
    * @see GetReadInterpolator()
    * @internal
    *   @history 2010-06-15 Jeannie Walldren - Modified to allow any interpolator type except "None"
+   *   @history 2022-10-18 The area of the cube under the chip is read with a single portal
+   *                           when it is not much larger than the chip, and each pixel is
+   *                           interpolated from it, instead of reading a portal per pixel.
    */
   void Chip::Read(Cube &cube, const int band) {
     // Create an interpolator and portal for geoming
     Interpolator interp(m_readInterpolator);
-    Portal port(interp.Samples(), interp.Lines(), cube.pixelType(),
-                interp.HotSample(), interp.HotLine());
+    int interpSamples = interp.Samples();
+    int interpLines = interp.Lines();
+    double hotSample = interp.HotSample();
+    double hotLine = interp.HotLine();
+    Portal port(interpSamples, interpLines, cube.pixelType(), hotSample, hotLine);
+
+    // The transform is affine, so the interpolator windows of the corners of the chip bound the
+    // area of the cube under the chip
+    int regionStartSamp = 0;
+    int regionStartLine = 0;
+    int regionEndSamp = -1;
+    int regionEndLine = -1;
+    for (int corner = 0; corner < 4; corner++) {
+      SetChipPosition((corner % 2 == 0) ? 1.0 : (double) Samples(),
+                      (corner < 2) ? 1.0 : (double) Lines());
+      int windowSamp = (int) floor(CubeSample() - hotSample);
+      int windowLine = (int) floor(CubeLine() - hotLine);
+      if (corner == 0 || windowSamp < regionStartSamp) regionStartSamp = windowSamp;
+      if (corner == 0 || windowLine < regionStartLine) regionStartLine = windowLine;
+      if (corner == 0 || windowSamp + interpSamples - 1 > regionEndSamp) {
+        regionEndSamp = windowSamp + interpSamples - 1;
+      }
+      if (corner == 0 || windowLine + interpLines - 1 > regionEndLine) {
+        regionEndLine = windowLine + interpLines - 1;
+      }
+    }
+
+    // Pixels that are off of the cube are not read, so do not read far past its edges
+    regionStartSamp = max(regionStartSamp, 1 - interpSamples);
+    regionStartLine = max(regionStartLine, 1 - interpLines);
+    regionEndSamp = min(regionEndSamp, cube.sampleCount() + interpSamples);
+    regionEndLine = min(regionEndLine, cube.lineCount() + interpLines);
+    int regionSamples = regionEndSamp - regionStartSamp + 1;
+    int regionLines = regionEndLine - regionStartLine + 1;
+
+    // Only read the area at once if it is not much larger than the chip, which it can be if the
+    // chip is scaled down
+    Portal *region = NULL;
+    if (regionSamples > 0 && regionLines > 0 &&
+        (double) regionSamples * regionLines <=
+        4.0 * (Samples() + interpSamples) * (Lines() + interpLines)) {
+      region = new Portal(regionSamples, regionLines, cube.pixelType(), 0.0, 0.0);
+      region->SetPosition(regionStartSamp, regionStartLine, band);
+      cube.read(*region);
+    }
+    vector<double> window(interpSamples * interpLines);
+
     // Loop through the pixels in the chip and geom them
     for (int line = 1; line <= Lines(); line++) {
       for (int samp = 1; samp <= Samples(); samp++) {
@@ -950,30 +1092,49 @@ namespace Isis {
             (CubeSample() > cube.sampleCount() + 0.5) ||
             (CubeLine() > cube.lineCount() + 0.5)) {
 
-          m_buf[line-1][samp-1] = Isis::NULL8;
+          m_buf[(line-1) * m_chipSamples + (samp-1)] = Isis::NULL8;
+          continue;
         }
-        else if (m_clipPolygon == NULL) {
-          port.SetPosition(CubeSample(), CubeLine(), band);
-          cube.read(port);
-          m_buf[line-1][samp-1] =
-            interp.Interpolate(CubeSample(), CubeLine(), port.DoubleBuffer());
-        }
-        else {
+
+        if (m_clipPolygon != NULL) {
           geos::geom::Point *pnt = globalFactory->createPoint(
                                      geos::geom::Coordinate(CubeSample(), CubeLine()));
-          if (pnt->within(m_clipPolygon)) {
-            port.SetPosition(CubeSample(), CubeLine(), band);
-            cube.read(port);
-            m_buf[line-1][samp-1] =
-              interp.Interpolate(CubeSample(), CubeLine(), port.DoubleBuffer());
+          bool inside = pnt->within(m_clipPolygon);
+          delete pnt;
+          if (!inside) {
+            m_buf[(line-1) * m_chipSamples + (samp-1)] = Isis::NULL8;
+            continue;
           }
-          else {
-            m_buf[line-1][samp-1] = Isis::NULL8;
+        }
+
+        int windowSamp = (int) floor(CubeSample() - hotSample);
+        int windowLine = (int) floor(CubeLine() - hotLine);
+        if (region != NULL &&
+            windowSamp >= regionStartSamp &&
+            windowLine >= regionStartLine &&
+            windowSamp + interpSamples - 1 <= regionEndSamp &&
+            windowLine + interpLines - 1 <= regionEndLine) {
+          // Copy the interpolator window out of the area that was read
+          const double *regionBuffer = region->DoubleBuffer();
+          for (int j = 0; j < interpLines; j++) {
+            const double *regionRow = regionBuffer +
+                (windowLine - regionStartLine + j) * regionSamples +
+                (windowSamp - regionStartSamp);
+            copy(regionRow, regionRow + interpSamples, window.begin() + j * interpSamples);
           }
-          delete pnt;
+          m_buf[(line-1) * m_chipSamples + (samp-1)] =
+            interp.Interpolate(CubeSample(), CubeLine(), &window[0]);
+        }
+        else {
+          port.SetPosition(CubeSample(), CubeLine(), band);
+          cube.read(port);
+          m_buf[(line-1) * m_chipSamples + (samp-1)] =
+            interp.Interpolate(CubeSample(), CubeLine(), port.DoubleBuffer());
         }
       }
     }
+
+    delete region;
   }
 
 
@@ -1050,6 +1211,7 @@ namespace Isis {
     m_affine = other.m_affine;
     m_readInterpolator = other.m_readInterpolator;
     m_filename = other.m_filename;
+    m_transformCache = other.m_transformCache;
 
     return *this;
   }
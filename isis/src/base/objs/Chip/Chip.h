@@ -19,8 +19,12 @@ find files of those names at the top level of this repository. **/
 #include <geos/geom/MultiPolygon.h>
 
 namespace Isis {
+  class Camera;
+  class ChipTransformCache;
   class Cube;
+  class Projection;
   class Statistics;
+  class TProjection;
 
   /**
    * @brief A small chip of data used for pattern matching.
@@ -82,6 +86,10 @@ namespace Isis {
    *   @history 2015-07-06 David Miller - Modified code to better reflect current Coding Standards.
    *                           Updated truth data. Fixes #2273
    *   @history 2017-08-30 Summer Stapleton - Updated documentation. References #4807.
+   *   @history 2022-10-18 Added SetTransformCache so that chips loaded to match chips on the
+   *                           same pair of images near each other can reuse the affine
+   *                           transform. Read now reads the area of the cube under the chip
+   *                           at once instead of one interpolator window per pixel.
    */
   class Chip {
     public:
@@ -124,7 +132,7 @@ namespace Isis {
        * @param value   Value to set
        */
       void SetValue(int sample, int line, const double &value) {
-        m_buf[line-1][sample-1] = value;
+        m_buf[(line-1) * m_chipSamples + (sample-1)] = value;
       }
 
       /**
@@ -143,7 +151,7 @@ namespace Isis {
        * @returns (double) The value of the chip at the specified line/sample
        */
       inline double GetValue(int sample, int line) {
-        return m_buf[line-1][sample-1];
+        return m_buf[(line-1) * m_chipSamples + (sample-1)];
       }
 
       /**
@@ -161,7 +169,32 @@ namespace Isis {
        * @returns (double) The value of the chip at the specified line/sample
        */
       inline double GetValue(int sample, int line) const {
-        return m_buf[line-1][sample-1];
+        return m_buf[(line-1) * m_chipSamples + (sample-1)];
+      }
+
+      /**
+       * @brief Returns the values of one line of the chip.
+       *
+       * The samples of each line are stored contiguously, so algorithms can
+       * loop over a line without calling GetValue for each pixel.
+       *
+       * @param line    Line to get (1-based)
+       *
+       * @returns (double*) The value of the first sample in the line
+       */
+      inline double *Row(int line) {
+        return &m_buf[(line-1) * m_chipSamples];
+      }
+
+      /**
+       * @brief Returns the values of one line of the chip.
+       *
+       * @param line    Line to get (1-based)
+       *
+       * @returns (const double*) The value of the first sample in the line
+       */
+      inline const double *Row(int line) const {
+        return &m_buf[(line-1) * m_chipSamples];
       }
 
       void TackCube(const double cubeSample, const double cubeLine);
@@ -333,9 +366,32 @@ namespace Isis {
         throw IException(IException::Programmer, msg, _FILEINFO_);
       }
 
+      /**
+       * @brief Sets the cache of transforms used when loading the chip to match another chip.
+       *
+       * The cache is not owned by the chip and must exist for as long as the chip uses it.
+       *
+       * @param cache Transform cache, or NULL to always fit a new transform
+       * @see Load(Cube &, Chip &, Cube &, const double, const int)
+       */
+      void SetTransformCache(ChipTransformCache *cache) {
+        m_transformCache = cache;
+      }
+
+      /**
+       * @return @b ChipTransformCache* Cache of transforms used when loading the chip to match
+       *             another chip, or NULL if there is none
+       */
+      ChipTransformCache *GetTransformCache() const {
+        return m_transformCache;
+      }
+
     private:
       void Init(const int samples, const int lines);
       void Read(Cube &cube, const int band);
+      void ApplyLoadTransform(Cube &cube, const double scale, const int band);
+      bool TackOnSurface(Camera *matchCam, TProjection *matchProj, Camera *cam,
+                         Projection *proj, double matchSample, double matchLine);
       std::vector<int> MovePoints(int startSamp, int startLine,
                              int endSamp, int endLine);
       bool PointsColinear(double x0, double y0,
@@ -345,7 +401,7 @@ namespace Isis {
 
       int m_chipSamples;                           //!< Number of samples in the chip
       int m_chipLines;                             //!< Number of lines in the chip
-      std::vector< std::vector<double> > m_buf;    //!< Chip buffer
+      std::vector<double> m_buf;                   //!< Chip buffer, stored by line
       int m_tackSample;                            //!< Middle sample of the chip
       int m_tackLine;                              //!< Middle line of the chip
 
@@ -371,6 +427,9 @@ namespace Isis {
                                                    // cubes into chip.
 
       QString m_filename;                          //!< FileName of loaded cube
+
+      ChipTransformCache *m_transformCache;        //!< Transforms used to load the chip to
+                                                   // match other chips. Not owned.
   };
 };
 
@@ -0,0 +1,142 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include "ChipTransformCache.h"
+
+#include <cmath>
+
+#include <QMutexLocker>
+
+#include "IException.h"
+#include "IString.h"
+
+namespace Isis {
+
+  /**
+   * Constructs an empty cache.
+   *
+   * @param cellSize Size of the square cells of the match cube, in pixels
+   * @param maxEntries Number of transforms to store before the cache is cleared
+   *
+   * @throws IException::Programmer "The cell size must be positive"
+   */
+  ChipTransformCache::ChipTransformCache(double cellSize, int maxEntries) {
+    if (cellSize <= 0.0) {
+      QString msg = "The cell size [" + toString(cellSize) + "] must be positive";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_cellSize = cellSize;
+    m_maxEntries = maxEntries;
+    m_hits = 0;
+    m_misses = 0;
+  }
+
+
+  //! Destroys the cache
+  ChipTransformCache::~ChipTransformCache() {
+  }
+
+
+  /**
+   * @return @b double Size of the cells of the match cube, in pixels
+   */
+  double ChipTransformCache::cellSize() const {
+    return m_cellSize;
+  }
+
+
+  /**
+   * Looks up the transform for a pair of images in the cell that contains a match cube
+   * position.
+   *
+   * @param pairKey Identifies the pair of images and the chip geometry
+   * @param matchSample Match cube sample of the match chip tack point
+   * @param matchLine Match cube line of the match chip tack point
+   * @param transform Set to the cached transform if one was found
+   *
+   * @return @b bool True if a transform was found
+   */
+  bool ChipTransformCache::find(const QString &pairKey, double matchSample, double matchLine,
+                                Affine::AMatrix &transform) {
+    QString key = cellKey(pairKey, matchSample, matchLine);
+
+    QMutexLocker locker(&m_mutex);
+    QHash<QString, Affine::AMatrix>::const_iterator found = m_transforms.constFind(key);
+    if (found == m_transforms.constEnd()) {
+      m_misses++;
+      return false;
+    }
+
+    m_hits++;
+    transform = found.value().copy();
+    return true;
+  }
+
+
+  /**
+   * Stores the transform for a pair of images in the cell that contains a match cube
+   * position.
+   *
+   * @param pairKey Identifies the pair of images and the chip geometry
+   * @param matchSample Match cube sample of the match chip tack point
+   * @param matchLine Match cube line of the match chip tack point
+   * @param transform Transform to store
+   */
+  void ChipTransformCache::insert(const QString &pairKey, double matchSample, double matchLine,
+                                  const Affine::AMatrix &transform) {
+    QString key = cellKey(pairKey, matchSample, matchLine);
+
+    QMutexLocker locker(&m_mutex);
+    if (m_transforms.size() >= m_maxEntries) {
+      m_transforms.clear();
+    }
+    m_transforms.insert(key, transform.copy());
+  }
+
+
+  //! Removes all of the transforms from the cache
+  void ChipTransformCache::clear() {
+    QMutexLocker locker(&m_mutex);
+    m_transforms.clear();
+  }
+
+
+  /**
+   * @return @b int Number of transforms that were found in the cache
+   */
+  int ChipTransformCache::hits() const {
+    QMutexLocker locker(&m_mutex);
+    return m_hits;
+  }
+
+
+  /**
+   * @return @b int Number of transforms that were not found in the cache
+   */
+  int ChipTransformCache::misses() const {
+    QMutexLocker locker(&m_mutex);
+    return m_misses;
+  }
+
+
+  /**
+   * Creates the key for the cell of the match cube that contains a position.
+   *
+   * @param pairKey Identifies the pair of images and the chip geometry
+   * @param matchSample Match cube sample
+   * @param matchLine Match cube line
+   *
+   * @return @b QString Key of the transform
+   */
+  QString ChipTransformCache::cellKey(const QString &pairKey, double matchSample,
+                                      double matchLine) const {
+    int cellSample = (int) std::floor(matchSample / m_cellSize);
+    int cellLine = (int) std::floor(matchLine / m_cellSize);
+    return pairKey + "|" + QString::number(cellSample) + "," + QString::number(cellLine);
+  }
+}
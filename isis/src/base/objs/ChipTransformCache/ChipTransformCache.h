@@ -0,0 +1,67 @@
+#ifndef ChipTransformCache_h
+#define ChipTransformCache_h
+
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include "Affine.h"
+
+namespace Isis {
+  /**
+   * @brief Cache of the transforms used to load chips to match other chips
+   *
+   * Chip::Load(Cube &, Chip &, Cube &) fits an affine transform from the match chip to the
+   * cube by projecting points near the corners of the chip through both cameras or
+   * projections. In a dense control network, many measures on the same pair of images are
+   * close together, and the transforms fit for them are nearly the same.
+   *
+   * This cache stores the fit transforms for a pair of images by the region of the match
+   * cube that the match chip is centered in. The match cube is divided into square cells,
+   * and a chip that is loaded to match a chip in a cell that already has a transform uses
+   * it instead of fitting a new one. Only the linear part of the transform is used, the
+   * translation is always recomputed from the chip's tack point. The cell size sets how
+   * far apart two chips can be and still share a transform.
+   *
+   * The cache can be shared by several chips and is safe to use from several threads.
+   *
+   * @see Chip::SetTransformCache
+   *
+   * @ingroup PatternMatching
+   */
+  class ChipTransformCache {
+    public:
+      ChipTransformCache(double cellSize = 64.0, int maxEntries = 100000);
+      ~ChipTransformCache();
+
+      double cellSize() const;
+
+      bool find(const QString &pairKey, double matchSample, double matchLine,
+                Affine::AMatrix &transform);
+      void insert(const QString &pairKey, double matchSample, double matchLine,
+                  const Affine::AMatrix &transform);
+      void clear();
+
+      int hits() const;
+      int misses() const;
+
+    private:
+      QString cellKey(const QString &pairKey, double matchSample, double matchLine) const;
+
+      double m_cellSize;  //!< Size of the cells of the match cube, in pixels
+      int m_maxEntries;   //!< Number of transforms stored before the cache is cleared
+      QHash<QString, Affine::AMatrix> m_transforms; //!< Transforms by image pair and cell
+      int m_hits;         //!< Number of transforms found in the cache
+      int m_misses;       //!< Number of transforms not found in the cache
+      mutable QMutex m_mutex; //!< Guards the transforms and counts
+  };
+};
+
+#endif
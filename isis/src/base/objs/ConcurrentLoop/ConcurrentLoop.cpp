@@ -0,0 +1,84 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include "ConcurrentLoop.h"
+
+#include <algorithm>
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+
+#include "IException.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Runs work for each index from 0 to count - 1 on up to threads threads.
+   *
+   * @param count The number of indexes to process
+   * @param threads The maximum number of threads. Values less than 1 use a single thread.
+   * @param work Processes one index
+   * @param done Called after each index is processed, if it is set
+   */
+  void ConcurrentLoop::run(int count, int threads, const std::function<void (int)> &work,
+                           const std::function<void ()> &done) {
+    threads = min(threads, count);
+    if (threads <= 1) {
+      for (int i = 0; i < count; i++) {
+        work(i);
+        if (done) done();
+      }
+      return;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    QAtomicInt next(0);
+    QMutex mutex;
+    bool failed = false;
+    IException failure;
+    QList< QFuture<void> > futures;
+    for (int t = 0; t < threads; t++) {
+      futures.append(QtConcurrent::run(&pool, [&]() {
+        for (int i = next.fetchAndAddOrdered(1); i < count; i = next.fetchAndAddOrdered(1)) {
+          try {
+            work(i);
+          }
+          catch (IException &e) {
+            QMutexLocker lock(&mutex);
+            if (!failed) {
+              failure = e;
+              failed = true;
+            }
+            next.fetchAndStoreOrdered(count);
+            return;
+          }
+          if (done) {
+            QMutexLocker lock(&mutex);
+            done();
+          }
+        }
+      }));
+    }
+
+    for (int f = 0; f < futures.size(); f++) {
+      futures[f].waitForFinished();
+    }
+
+    if (failed) {
+      throw failure;
+    }
+  }
+}
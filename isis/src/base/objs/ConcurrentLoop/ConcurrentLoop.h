@@ -0,0 +1,38 @@
+#ifndef ConcurrentLoop_h
+#define ConcurrentLoop_h
+
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include <functional>
+
+namespace Isis {
+  /**
+   * @brief Runs the iterations of a loop on a limited number of threads
+   *
+   * The work is called once for each index from 0 to count - 1. With one thread the indexes
+   * are processed in order on the calling thread. Otherwise the indexes are handed out to a
+   * private thread pool as its threads become free, so the work must be safe to run for
+   * different indexes at the same time. The global thread pool is not used, so the number
+   * of threads of one loop does not depend on the other work running in the program.
+   *
+   * A callback can be given that is called after each index is done, such as checking a
+   * Progress. Calls to it are serialized, so it does not have to be thread safe.
+   *
+   * If the work throws an IException, no more indexes are started and the first exception
+   * is rethrown once the running ones are done.
+   *
+   * @ingroup Utility
+   */
+  class ConcurrentLoop {
+    public:
+      static void run(int count, int threads, const std::function<void (int)> &work,
+                      const std::function<void ()> &done = std::function<void ()>());
+  };
+};
+
+#endif
@@ -6,12 +6,21 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Equalization.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <vector>
 
+#include <QAtomicInt>
+#include <QFuture>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QSharedPointer>
 #include <QString>
 #include <QStringList>
+#include <QThreadPool>
 #include <QVector>
+#include <QtConcurrentMap>
 
 #include "Buffer.h"
 #include "Cube.h"
@@ -23,7 +32,9 @@ find files of those names at the top level of this repository. **/
 #include "OverlapStatistics.h"
 #include "Process.h"
 #include "ProcessByLine.h"
+#include "Progress.h"
 #include "Projection.h"
+#include "ProjectionFactory.h"
 #include "Pvl.h"
 #include "PvlGroup.h"
 #include "PvlObject.h"
@@ -248,6 +259,13 @@ namespace Isis {
    *
    * This method calculates any overlap statistics that have not been previously
    * calculated for the input images.
+   *
+   * Each image is opened once first to find its projected extent, so pairs of images that
+   * cannot overlap are skipped without reading them. The remaining pairs are gathered at the
+   * same time, using the number of threads in the GlobalThreads preference. Each thread keeps
+   * the cubes it has opened most recently, so an image is not opened again for every pair.
+   * The statistics are added to the normalizations in pair order afterwards, so the results
+   * do not depend on the number of threads.
    */
   void Equalization::calculateOverlapStatistics() {
     // Add adjustments for all input images
@@ -255,53 +273,193 @@ namespace Isis {
       addAdjustment(new ImageAdjustment(m_sType));
     }
 
-    // Find overlapping areas and add them to the set of known overlaps for
-    // each band shared amongst cubes
+    // The projected extent of each image, to skip pairs that cannot overlap
+    struct Extent {
+      int bands;
+      Projection *projection;
+      double xMin;
+      double xMax;
+      double yMin;
+      double yMax;
+    };
+
+    //! A pair of images, and the overlap statistics or error calculated for them
+    struct Pair {
+      int i;
+      int j;
+      OverlapStatistics *stats;
+      QSharedPointer<IException> error;
+    };
+
+    QVector<Extent> extents(m_imageList.size());
     for (int i = 0; i < m_imageList.size(); i++) {
-      Cube cube1;
-      cube1.open(m_imageList[i].toString());
+      extents[i].projection = NULL;
+    }
 
-      for (int j = (i + 1); j < m_imageList.size(); j++) {
-        // Skip if overlap already calculated
-        if (m_alreadyCalculated[i] == true && m_alreadyCalculated[j] == true) {
-          //cout << " *** Cube " << i << " vs Cube " << j << " already calculated." << endl;
-          //cout << endl << "    " << i << " = " << m_imageList[i].toString() << " ; " << j
-          //     << " = " << m_imageList[j].toString() << endl << endl;
-          continue;
+    QVector<Pair> pairs;
+    try {
+      for (int i = 0; i < m_imageList.size(); i++) {
+        Cube cube;
+        cube.open(m_imageList[i].toString());
+        Projection *proj = ProjectionFactory::CreateFromCube(cube);
+        extents[i].bands = cube.bandCount();
+        extents[i].projection = proj;
+        extents[i].xMin = proj->ToProjectionX(0.5);
+        extents[i].xMax = proj->ToProjectionX(cube.sampleCount() + 0.5);
+        extents[i].yMin = proj->ToProjectionY(cube.lineCount() + 0.5);
+        extents[i].yMax = proj->ToProjectionY(0.5);
+      }
+
+      for (int i = 0; i < m_imageList.size(); i++) {
+        for (int j = (i + 1); j < m_imageList.size(); j++) {
+          // Skip if overlap already calculated
+          if (m_alreadyCalculated[i] == true && m_alreadyCalculated[j] == true) {
+            continue;
+          }
+
+          // Pairs with matching bands and mappings but disjoint extents have no overlap.
+          // Mismatched pairs are still gathered, to report the mismatch.
+          const Extent &x = extents[i];
+          const Extent &y = extents[j];
+          if (x.bands == y.bands && *x.projection == *y.projection &&
+              !((x.xMin < y.xMax) && (x.xMax > y.xMin) &&
+                (x.yMin < y.yMax) && (x.yMax > y.yMin))) {
+            continue;
+          }
+
+          Pair pair;
+          pair.i = i;
+          pair.j = j;
+          pair.stats = NULL;
+          pairs.append(pair);
         }
+      }
+    }
+    catch (IException &) {
+      for (int i = 0; i < extents.size(); i++) {
+        delete extents[i].projection;
+      }
+      throw;
+    }
 
-        Cube cube2;
-        cube2.open(m_imageList[j].toString());
-        QString cubeStr1 = toString((int)(i + 1));
-        QString cubeStr2 = toString((int)(j + 1));
-        QString statMsg = "Gathering Overlap Statisitcs for Cube " +
-                         cubeStr1 + " vs " + cubeStr2 + " of " +
-                         toString(m_maxCube);
-
-        // Get overlap statistics for new cubes
-        OverlapStatistics *oStats = new OverlapStatistics(cube1, cube2, statMsg, m_samplingPercent);
-        // Only push the stats onto the overlap statistics vector if there is an overlap in at
-        // least one of the bands
-        if (oStats->HasOverlap()) {
-          m_overlapStats.push_back(oStats);
-          oStats->SetMincount(m_mincnt);
-          for (int band = 1; band <= m_maxBand; band++) {
-            // Fill wt vector with 1's if the overlaps are not to be weighted, or
-            // fill the vector with the number of valid pixels in each overlap
-            int weight = 1;
-            if (m_wtopt) weight = oStats->GetMStats(band).ValidPixels();
-
-            // Make sure overlap has at least MINCOUNT valid pixels and add
-            if (oStats->GetMStats(band).ValidPixels() >= m_mincnt) {
-              m_overlapNorms[band - 1]->AddOverlap(
-                  oStats->GetMStats(band).X(), i,
-                  oStats->GetMStats(band).Y(), j, weight);
-              m_doesOverlapList[i] = true;
-              m_doesOverlapList[j] = true;
-            }
+    for (int i = 0; i < extents.size(); i++) {
+      delete extents[i].projection;
+    }
+
+    Progress progress;
+    progress.SetText("Gathering Overlap Statistics");
+    progress.SetMaximumSteps(pairs.size());
+    progress.CheckStatus();
+
+    QAtomicInt nextPair(0);
+    QAtomicInt finishedPairs(0);
+    QVector<int> workers;
+    int threads = std::max(1, std::min(QThreadPool::globalInstance()->maxThreadCount(),
+                                       pairs.size()));
+    for (int w = 0; w < threads; w++) {
+      workers.append(w);
+    }
+
+    Pair *pairData = pairs.data();
+    QFuture<void> future = QtConcurrent::map(workers, [&](int) {
+      // The cubes this worker opened, most recently used last
+      const int maxOpenCubes = 16;
+      QList< QPair<int, Cube *> > openCubes;
+      auto openCube = [&](int img) {
+        for (int c = 0; c < openCubes.size(); c++) {
+          if (openCubes[c].first == img) {
+            openCubes.move(c, openCubes.size() - 1);
+            return openCubes.last().second;
+          }
+        }
+        Cube *cube = new Cube;
+        try {
+          cube->open(m_imageList[img].toString());
+        }
+        catch (IException &) {
+          delete cube;
+          throw;
+        }
+        if (openCubes.size() == maxOpenCubes) {
+          delete openCubes.takeFirst().second;
+        }
+        openCubes.append(qMakePair(img, cube));
+        return cube;
+      };
+
+      for (int p = nextPair.fetchAndAddOrdered(1); p < pairs.size();
+           p = nextPair.fetchAndAddOrdered(1)) {
+        Pair &pair = pairData[p];
+        try {
+          Cube *cube1 = openCube(pair.i);
+          Cube *cube2 = openCube(pair.j);
+          pair.stats = new OverlapStatistics(*cube1, *cube2, "", m_samplingPercent, false);
+        }
+        catch (IException &e) {
+          pair.error = QSharedPointer<IException>(new IException(e));
+        }
+        finishedPairs.fetchAndAddOrdered(1);
+      }
+
+      for (int c = 0; c < openCubes.size(); c++) {
+        delete openCubes[c].second;
+      }
+    });
+
+    int reported = 0;
+    QMutex sleeper;
+    sleeper.lock();
+    while (!future.isFinished()) {
+      sleeper.tryLock(100);
+      for (; reported < finishedPairs.loadAcquire(); reported++) {
+        progress.CheckStatus();
+      }
+    }
+    sleeper.unlock();
+    for (; reported < pairs.size(); reported++) {
+      progress.CheckStatus();
+    }
+
+    for (int p = 0; p < pairs.size(); p++) {
+      if (pairs[p].error) {
+        IException error = *pairs[p].error;
+        for (int q = 0; q < pairs.size(); q++) {
+          delete pairs[q].stats;
+        }
+        throw error;
+      }
+    }
+
+    // Add the overlaps in pair order
+    for (int p = 0; p < pairs.size(); p++) {
+      int i = pairs[p].i;
+      int j = pairs[p].j;
+      OverlapStatistics *oStats = pairs[p].stats;
+
+      // Only push the stats onto the overlap statistics vector if there is an overlap in at
+      // least one of the bands
+      if (oStats->HasOverlap()) {
+        m_overlapStats.push_back(oStats);
+        oStats->SetMincount(m_mincnt);
+        for (int band = 1; band <= m_maxBand; band++) {
+          // Fill wt vector with 1's if the overlaps are not to be weighted, or
+          // fill the vector with the number of valid pixels in each overlap
+          int weight = 1;
+          if (m_wtopt) weight = oStats->GetMStats(band).ValidPixels();
+
+          // Make sure overlap has at least MINCOUNT valid pixels and add
+          if (oStats->GetMStats(band).ValidPixels() >= m_mincnt) {
+            m_overlapNorms[band - 1]->AddOverlap(
+                oStats->GetMStats(band).X(), i,
+                oStats->GetMStats(band).Y(), j, weight);
+            m_doesOverlapList[i] = true;
+            m_doesOverlapList[j] = true;
           }
         }
       }
+      else {
+        delete oStats;
+      }
     }
 
     // Compute the number valid and invalid overlaps
@@ -0,0 +1,440 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "FFTMaximumCorrelation.h"
+
+#include <cmath>
+
+#include "Chip.h"
+#include "FourierTransform.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+  /**
+   * Fits computed from the transforms that are within this distance of the
+   * best one are recomputed directly.  This is many orders of magnitude larger
+   * than the rounding error of the transforms.
+   */
+  static const double s_candidateTolerance = 1.0e-6;
+
+  /**
+   * If the variance of the pattern or sub-search chip is smaller than this
+   * fraction of its sum of squares, the fit is recomputed directly.
+   */
+  static const double s_varianceTolerance = 1.0e-9;
+
+
+  /**
+   * Compute the correlation at every position from startSamp, startLine to
+   * endSamp, endLine and store it in the fit chip.
+   *
+   * The pattern chip is walked over a region of the search chip that is
+   * padded with Nulls where the sub-search chips extend past the search chip.
+   * For each position we need the number of valid pixel pairs n, and the sums
+   * Sx, Sxx, Sy, Syy and Sxy over those pairs, where x is the pattern and y
+   * is the search.  With Mp and Ms the valid masks of the pattern and the
+   * search region, these are the correlations of
+   * <pre>
+   *   n   = Ms    with Mp        Sx  = Ms with P*Mp    Sxy = S*Ms with P*Mp
+   *   Sy  = S*Ms  with Mp        Sxx = Ms with P*P*Mp
+   *   Syy = S*S*Ms with Mp
+   * </pre>
+   * When every pattern pixel is valid the correlations with Mp are sums over
+   * each sub-search chip, which are taken from summed-area tables. When every
+   * pixel in the search region is valid, Sx and Sxx are the same at every
+   * position. The remaining correlations are computed with Fourier transforms.
+   * The data is shifted by its mean first, which does not change the
+   * correlation coefficient but keeps the sums small.
+   *
+   * @param sChip Search chip
+   * @param pChip Pattern chip
+   * @param fChip Fit chip
+   * @param startSamp Start sample
+   * @param endSamp End sample
+   * @param startLine Start line
+   * @param endLine End line
+   *
+   * @return bool Always true
+   */
+  bool FFTMaximumCorrelation::ComputeFitChip(Chip &sChip, Chip &pChip, Chip &fChip,
+                                             int startSamp, int endSamp,
+                                             int startLine, int endLine) {
+    int patternSamples = pChip.Samples();
+    int patternLines = pChip.Lines();
+    int patternSize = patternSamples * patternLines;
+    int tackSample = (patternSamples - 1) / 2 + 1;
+    int tackLine = (patternLines - 1) / 2 + 1;
+
+    // The search region covered by all of the sub-search chips
+    int fitSamples = endSamp - startSamp + 1;
+    int fitLines = endLine - startLine + 1;
+    int regionSamples = fitSamples + patternSamples - 1;
+    int regionLines = fitLines + patternLines - 1;
+    int firstSamp = startSamp - tackSample + 1;
+    int firstLine = startLine - tackLine + 1;
+
+    // Load the pattern, and find its mean for shifting
+    vector<double> pattern(patternSize);
+    vector<bool> patternValid(patternSize);
+    bool patternFull = true;
+    double patternSum = 0.0;
+    int patternCount = 0;
+    for (int line = 1; line <= patternLines; line++) {
+      for (int samp = 1; samp <= patternSamples; samp++) {
+        int i = (line - 1) * patternSamples + (samp - 1);
+        pattern[i] = pChip.GetValue(samp, line);
+        patternValid[i] = IsValidPixel(pattern[i]);
+        if (patternValid[i]) {
+          patternSum += pattern[i];
+          patternCount++;
+        }
+        else {
+          patternFull = false;
+        }
+      }
+    }
+    double patternMean = (patternCount > 0) ? patternSum / patternCount : 0.0;
+
+    // Load the search region. The sub-search chips must meet the chip's
+    // valid range, while the correlation only skips special pixels.
+    int regionSize = regionSamples * regionLines;
+    vector<double> search(regionSize, 0.0);
+    vector<bool> searchValid(regionSize, false);
+    vector<bool> searchInRange(regionSize, false);
+    bool searchFull = true;
+    double searchSum = 0.0;
+    int searchCount = 0;
+    for (int line = 0; line < regionLines; line++) {
+      int chipLine = firstLine + line;
+      for (int samp = 0; samp < regionSamples; samp++) {
+        int chipSamp = firstSamp + samp;
+        int i = line * regionSamples + samp;
+        if (chipSamp < 1 || chipLine < 1 ||
+            chipSamp > sChip.Samples() || chipLine > sChip.Lines()) {
+          searchFull = false;
+          continue;
+        }
+
+        search[i] = sChip.GetValue(chipSamp, chipLine);
+        searchInRange[i] = sChip.IsValid(chipSamp, chipLine);
+        searchValid[i] = IsValidPixel(search[i]);
+        if (searchValid[i]) {
+          searchSum += search[i];
+          searchCount++;
+        }
+        else {
+          searchFull = false;
+        }
+      }
+    }
+    double searchMean = (searchCount > 0) ? searchSum / searchCount : 0.0;
+
+    // Summed-area tables over the search region
+    int tableSamples = regionSamples + 1;
+    vector<double> inRangeTable(tableSamples * (regionLines + 1), 0.0);
+    vector<double> countTable;
+    vector<double> sumTable;
+    vector<double> sumSquareTable;
+    if (patternFull) {
+      countTable.resize(inRangeTable.size(), 0.0);
+      sumTable.resize(inRangeTable.size(), 0.0);
+      sumSquareTable.resize(inRangeTable.size(), 0.0);
+    }
+    for (int line = 0; line < regionLines; line++) {
+      double inRangeRow = 0.0;
+      double countRow = 0.0;
+      double sumRow = 0.0;
+      double sumSquareRow = 0.0;
+      for (int samp = 0; samp < regionSamples; samp++) {
+        int i = line * regionSamples + samp;
+        int t = (line + 1) * tableSamples + (samp + 1);
+        if (searchInRange[i]) inRangeRow += 1.0;
+        inRangeTable[t] = inRangeTable[t - tableSamples] + inRangeRow;
+
+        if (patternFull) {
+          if (searchValid[i]) {
+            double y = search[i] - searchMean;
+            countRow += 1.0;
+            sumRow += y;
+            sumSquareRow += y * y;
+          }
+          countTable[t] = countTable[t - tableSamples] + countRow;
+          sumTable[t] = sumTable[t - tableSamples] + sumRow;
+          sumSquareTable[t] = sumSquareTable[t - tableSamples] + sumSquareRow;
+        }
+      }
+    }
+
+    // Transform the search region. The mask and the masked data are packed
+    // into the real and imaginary parts so one transform gives both.
+    FourierTransform fft;
+    int transformSamples = fft.NextPowerOfTwo(regionSamples);
+    int transformLines = fft.NextPowerOfTwo(regionLines);
+    int transformSize = transformSamples * transformLines;
+
+    vector< complex<double> > searchTransform(transformSize);
+    vector< complex<double> > searchSquareTransform;
+    if (!patternFull) {
+      searchSquareTransform.resize(transformSize);
+    }
+    for (int line = 0; line < regionLines; line++) {
+      for (int samp = 0; samp < regionSamples; samp++) {
+        int i = line * regionSamples + samp;
+        if (searchValid[i]) {
+          double y = search[i] - searchMean;
+          searchTransform[line * transformSamples + samp] = complex<double>(1.0, y);
+          if (!patternFull) {
+            searchSquareTransform[line * transformSamples + samp] = y * y;
+          }
+        }
+      }
+    }
+    Transform(searchTransform, transformSamples, transformLines, false);
+    if (!patternFull) {
+      Transform(searchSquareTransform, transformSamples, transformLines, false);
+    }
+
+    // Transform the pattern and its square, and its mask if it has
+    // invalid pixels
+    vector< complex<double> > patternTransform(transformSize);
+    vector< complex<double> > patternSquareTransform;
+    vector< complex<double> > patternMaskTransform;
+    double patternShiftedSum = 0.0;
+    double patternShiftedSumSquare = 0.0;
+    if (!searchFull) {
+      patternSquareTransform.resize(transformSize);
+    }
+    if (!patternFull) {
+      patternMaskTransform.resize(transformSize);
+    }
+    for (int line = 0; line < patternLines; line++) {
+      for (int samp = 0; samp < patternSamples; samp++) {
+        int i = line * patternSamples + samp;
+        if (patternValid[i]) {
+          double x = pattern[i] - patternMean;
+          int t = line * transformSamples + samp;
+          patternTransform[t] = x;
+          if (!searchFull) patternSquareTransform[t] = x * x;
+          if (!patternFull) patternMaskTransform[t] = 1.0;
+          patternShiftedSum += x;
+          patternShiftedSumSquare += x * x;
+        }
+      }
+    }
+    Transform(patternTransform, transformSamples, transformLines, false);
+    if (!searchFull) {
+      Transform(patternSquareTransform, transformSamples, transformLines, false);
+    }
+    if (!patternFull) {
+      Transform(patternMaskTransform, transformSamples, transformLines, false);
+    }
+
+    // Correlate. Each result holds two correlations, one in the real part and
+    // one in the imaginary part.
+    vector< complex<double> > sumsWithPattern;        // Sx, Sxy
+    vector< complex<double> > sumsWithPatternSquare;  // Sxx
+    vector< complex<double> > sumsWithMask;           // n, Sy
+    vector< complex<double> > squareSumsWithMask;     // Syy
+    Correlate(searchTransform, patternTransform, sumsWithPattern,
+              transformSamples, transformLines);
+    if (!searchFull) {
+      Correlate(searchTransform, patternSquareTransform, sumsWithPatternSquare,
+                transformSamples, transformLines);
+    }
+    if (!patternFull) {
+      Correlate(searchTransform, patternMaskTransform, sumsWithMask,
+                transformSamples, transformLines);
+      Correlate(searchSquareTransform, patternMaskTransform, squareSumsWithMask,
+                transformSamples, transformLines);
+    }
+
+    // Compute the fits
+    vector<double> fits(fitSamples * fitLines, Isis::Null);
+    vector<bool> direct(fitSamples * fitLines, false);
+    double bestFit = Isis::Null;
+    for (int line = 0; line < fitLines; line++) {
+      for (int samp = 0; samp < fitSamples; samp++) {
+        int f = line * fitSamples + samp;
+
+        // Skip sub-search chips without enough data in the valid range
+        int t0 = line * tableSamples + samp;
+        int t1 = (line + patternLines) * tableSamples + samp;
+        double inRange = inRangeTable[t1 + patternSamples] - inRangeTable[t1] -
+                         inRangeTable[t0 + patternSamples] + inRangeTable[t0];
+        if (100.0 * inRange / patternSize < SubsearchValidPercent()) continue;
+
+        int c = line * transformSamples + samp;
+        double n, sy, syy;
+        if (patternFull) {
+          n = countTable[t1 + patternSamples] - countTable[t1] -
+              countTable[t0 + patternSamples] + countTable[t0];
+          sy = sumTable[t1 + patternSamples] - sumTable[t1] -
+               sumTable[t0 + patternSamples] + sumTable[t0];
+          syy = sumSquareTable[t1 + patternSamples] - sumSquareTable[t1] -
+                sumSquareTable[t0 + patternSamples] + sumSquareTable[t0];
+        }
+        else {
+          n = floor(sumsWithMask[c].real() + 0.5);
+          sy = sumsWithMask[c].imag();
+          syy = squareSumsWithMask[c].real();
+        }
+        double sx = searchFull ? patternShiftedSum : sumsWithPattern[c].real();
+        double sxx = searchFull ? patternShiftedSumSquare : sumsWithPatternSquare[c].real();
+        double sxy = sumsWithPattern[c].imag();
+
+        // The same checks as MaximumCorrelation::MatchAlgorithm
+        if (n / patternSize * 100.0 < PatternValidPercent()) continue;
+        if (n <= 1.0) continue;
+
+        double varX = sxx - sx * sx / n;
+        double varY = syy - sy * sy / n;
+        if (varX <= s_varianceTolerance * sxx || varY <= s_varianceTolerance * syy) {
+          direct[f] = true;
+          continue;
+        }
+
+        double r = fabs((sxy - sx * sy / n) / sqrt(varX * varY));
+        if (!(r <= 1.0 + s_candidateTolerance)) {
+          direct[f] = true;
+          continue;
+        }
+
+        fits[f] = r;
+        if (bestFit == Isis::Null || r > bestFit) bestFit = r;
+      }
+    }
+
+    // Recompute every fit that could be the best fit directly
+    Chip subsearch(patternSamples, patternLines);
+    for (int line = 0; line < fitLines; line++) {
+      for (int samp = 0; samp < fitSamples; samp++) {
+        int f = line * fitSamples + samp;
+        if (fits[f] != Isis::Null && fits[f] >= bestFit - s_candidateTolerance) {
+          direct[f] = true;
+        }
+        if (direct[f]) {
+          fits[f] = DirectFit(sChip, pChip, subsearch, startSamp + samp, startLine + line);
+        }
+      }
+    }
+
+    // Recompute the surface model window around the best fit directly
+    int bestSamp = -1;
+    int bestLine = -1;
+    bestFit = Isis::Null;
+    for (int line = 0; line < fitLines; line++) {
+      for (int samp = 0; samp < fitSamples; samp++) {
+        double fit = fits[line * fitSamples + samp];
+        if (fit != Isis::Null && (bestFit == Isis::Null || CompareFits(fit, bestFit))) {
+          bestFit = fit;
+          bestSamp = samp;
+          bestLine = line;
+        }
+      }
+    }
+    if (bestFit != Isis::Null) {
+      int halfWindow = (int) WindowSize() / 2;
+      for (int line = max(0, bestLine - halfWindow);
+           line <= min(fitLines - 1, bestLine + halfWindow); line++) {
+        for (int samp = max(0, bestSamp - halfWindow);
+             samp <= min(fitSamples - 1, bestSamp + halfWindow); samp++) {
+          int f = line * fitSamples + samp;
+          if (!direct[f]) {
+            fits[f] = DirectFit(sChip, pChip, subsearch, startSamp + samp, startLine + line);
+          }
+        }
+      }
+    }
+
+    for (int line = 0; line < fitLines; line++) {
+      for (int samp = 0; samp < fitSamples; samp++) {
+        fChip.SetValue(startSamp + samp, startLine + line, fits[line * fitSamples + samp]);
+      }
+    }
+
+    return true;
+  }
+
+
+  /**
+   * Apply a two dimensional Fourier transform in place.
+   *
+   * @param data The data, with the samples of each line stored contiguously
+   * @param samples The number of samples, a power of two
+   * @param lines The number of lines, a power of two
+   * @param inverse Apply the inverse transform instead
+   */
+  void FFTMaximumCorrelation::Transform(vector< complex<double> > &data,
+                                        int samples, int lines, bool inverse) {
+    FourierTransform fft;
+    vector< complex<double> > buffer(samples);
+    for (int line = 0; line < lines; line++) {
+      buffer.assign(data.begin() + line * samples, data.begin() + (line + 1) * samples);
+      buffer = inverse ? fft.Inverse(buffer) : fft.Transform(buffer);
+      copy(buffer.begin(), buffer.end(), data.begin() + line * samples);
+    }
+
+    buffer.resize(lines);
+    for (int samp = 0; samp < samples; samp++) {
+      for (int line = 0; line < lines; line++) {
+        buffer[line] = data[line * samples + samp];
+      }
+      buffer = inverse ? fft.Inverse(buffer) : fft.Transform(buffer);
+      for (int line = 0; line < lines; line++) {
+        data[line * samples + samp] = buffer[line];
+      }
+    }
+  }
+
+
+  /**
+   * Correlate search data with real pattern data given their transforms.
+   * The result at each sample and line is the sum over the pattern of the
+   * pattern times the search data offset by that sample and line.
+   *
+   * @param search The transform of the search data
+   * @param pattern The transform of the pattern data, which must be real
+   * @param result The correlation
+   * @param samples The number of samples in the transforms
+   * @param lines The number of lines in the transforms
+   */
+  void FFTMaximumCorrelation::Correlate(const vector< complex<double> > &search,
+                                        const vector< complex<double> > &pattern,
+                                        vector< complex<double> > &result,
+                                        int samples, int lines) {
+    result.resize(search.size());
+    for (unsigned int i = 0; i < search.size(); i++) {
+      result[i] = search[i] * conj(pattern[i]);
+    }
+    Transform(result, samples, lines, true);
+  }
+
+
+  /**
+   * Compute the fit at one position the same way AutoReg does when it matches
+   * one sub-search chip at a time.
+   *
+   * @param sChip Search chip
+   * @param pChip Pattern chip
+   * @param subsearch A chip the size of the pattern chip to extract into
+   * @param samp Search chip sample
+   * @param line Search chip line
+   *
+   * @return double The fit, or Null if there is no fit
+   */
+  double FFTMaximumCorrelation::DirectFit(Chip &sChip, Chip &pChip, Chip &subsearch,
+                                          int samp, int line) {
+    sChip.Extract(samp, line, subsearch);
+    if (!subsearch.IsValid(SubsearchValidPercent())) return Isis::Null;
+    return MatchAlgorithm(pChip, subsearch);
+  }
+}
+
+extern "C" Isis::AutoReg *FFTMaximumCorrelationPlugin(Isis::Pvl &pvl) {
+  return new Isis::FFTMaximumCorrelation(pvl);
+}
@@ -0,0 +1,66 @@
+#ifndef FFTMaximumCorrelation_h
+#define FFTMaximumCorrelation_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include <complex>
+#include <vector>
+
+#include "MaximumCorrelation.h"
+
+namespace Isis {
+  class Pvl;
+  class Chip;
+
+  /**
+   * @brief Maximum correlation pattern matching using Fourier transforms
+   *
+   * This algorithm finds the same best fit as MaximumCorrelation, but
+   * computes the correlation at every position of the pattern chip in the
+   * search chip at once instead of extracting each sub-search chip.  The sums
+   * of products between the pattern chip and the search chip are computed
+   * with Fourier transforms, and the sums over each sub-search chip are
+   * computed with summed-area tables.  Valid pixel masks are correlated in the
+   * same way, so the pattern and sub-search valid percentages are applied
+   * exactly as in MaximumCorrelation.
+   *
+   * The correlations computed from the transforms differ from the direct
+   * correlations by rounding, so every position that could be the best fit,
+   * and the surface model window around the best fit, are recomputed with
+   * MaximumCorrelation::MatchAlgorithm.  Positions where the sub-search chip
+   * is nearly constant are also recomputed, because their correlation is not
+   * well defined.
+   *
+   * @ingroup PatternMatching
+   *
+   * @see MaximumCorrelation AutoReg FourierTransform
+   */
+  class FFTMaximumCorrelation : public MaximumCorrelation {
+    public:
+      FFTMaximumCorrelation(Pvl &pvl) : MaximumCorrelation(pvl) { };
+      virtual ~FFTMaximumCorrelation() {};
+
+    protected:
+      virtual bool ComputeFitChip(Chip &sChip, Chip &pChip, Chip &fChip,
+                                  int startSamp, int endSamp,
+                                  int startLine, int endLine);
+      virtual QString AlgorithmName() const {
+        return "FFTMaximumCorrelation";
+      };
+
+    private:
+      void Transform(std::vector< std::complex<double> > &data,
+                     int samples, int lines, bool inverse);
+      void Correlate(const std::vector< std::complex<double> > &search,
+                     const std::vector< std::complex<double> > &pattern,
+                     std::vector< std::complex<double> > &result,
+                     int samples, int lines);
+      double DirectFit(Chip &sChip, Chip &pChip, Chip &subsearch, int samp, int line);
+  };
+};
+
+#endif
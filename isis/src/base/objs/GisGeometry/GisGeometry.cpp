@@ -8,6 +8,7 @@ find files of those names at the top level of this repository. **/
 
 // Qt library
 #include <QDebug>
+#include <QMutexLocker>
 #include <QScopedPointer>
 #include <QString>
 
@@ -27,6 +28,17 @@ using namespace std;
 
 namespace Isis {
 
+  /**
+   * GEOS calls go through the handle of the calling thread, so different
+   * geometries can be used on different threads at the same time.
+   *
+   * @return GEOSContextHandle_t The GEOS handle of the calling thread
+   */
+  static GEOSContextHandle_t geosContext() {
+    return (GisTopology::instance()->context());
+  }
+
+
   /**
    * Fundamental constructor of an empty object
    */
@@ -215,7 +227,7 @@ namespace Isis {
       return (false);
     }
 
-    return (1 == GEOSisValid(this->m_geom));
+    return (1 == GEOSisValid_r(geosContext(), this->m_geom));
   }
 
 
@@ -228,7 +240,7 @@ namespace Isis {
     QString result = "Not defined!";
     if ( isDefined() ) {
       GisTopology *gis(GisTopology::instance());
-      char *reason = GEOSisValidReason(this->m_geom);
+      char *reason = GEOSisValidReason_r(geosContext(), this->m_geom);
       result = reason;
       gis->destroy(reason);
     }
@@ -339,7 +351,7 @@ namespace Isis {
     if ( !isValid() ) {
       return (true);
     }
-    return (1 == GEOSisEmpty(this->m_geom));
+    return (1 == GEOSisEmpty_r(geosContext(), this->m_geom));
   }
 
 
@@ -363,7 +375,7 @@ namespace Isis {
 
     int result = 0;
     double gisArea = 0.0;
-    result = GEOSArea(this->m_geom, &gisArea);
+    result = GEOSArea_r(geosContext(), this->m_geom, &gisArea);
     if (1 != result) {
       gisArea = 0.0;
     }
@@ -386,7 +398,7 @@ namespace Isis {
 
     int result = 0;
     double gisLength = 0.0;
-    result = GEOSLength(this->m_geom, &gisLength);
+    result = GEOSLength_r(geosContext(), this->m_geom, &gisLength);
     if (1 != result) {
       gisLength = 0.0;
     }
@@ -413,7 +425,7 @@ namespace Isis {
 
     int result = 0;
     double dist = Null;
-    result = GEOSDistance(this->m_geom, target.geometry(), &dist);
+    result = GEOSDistance_r(geosContext(), this->m_geom, target.geometry(), &dist);
     if ( 1 != result ) {
       dist = Null;
     }
@@ -429,10 +441,11 @@ namespace Isis {
   int GisGeometry::points() const {
     if (!isValid() ) { return (0); }
 
-    int ngeoms =  GEOSGetNumGeometries(m_geom);
+    GEOSContextHandle_t context = geosContext();
+    int ngeoms =  GEOSGetNumGeometries_r(context, m_geom);
     int npoints = 0;
     for (int i = 0 ; i < ngeoms ; i++) {
-      npoints += GEOSGetNumCoordinates(GEOSGetGeometryN(m_geom, i));
+      npoints += GEOSGetNumCoordinates_r(context, GEOSGetGeometryN_r(context, m_geom, i));
     }
 
     return ( npoints );
@@ -458,10 +471,11 @@ namespace Isis {
 
     int result = 0;
     if ( 0 != this->m_preparedGeom) {
-      result = GEOSPreparedIntersects(this->m_preparedGeom, target.geometry());
+      QMutexLocker lock(&m_preparedMutex);
+      result = GEOSPreparedIntersects_r(geosContext(), this->m_preparedGeom, target.geometry());
     }
     else {
-      result = GEOSIntersects(this->m_geom, target.geometry());
+      result = GEOSIntersects_r(geosContext(), this->m_geom, target.geometry());
     }
 
     return (1 == result);
@@ -485,10 +499,11 @@ namespace Isis {
 
     int result = 0;
     if ( 0 != this->m_preparedGeom) {
-      result = GEOSPreparedContains(this->m_preparedGeom, target.geometry());
+      QMutexLocker lock(&m_preparedMutex);
+      result = GEOSPreparedContains_r(geosContext(), this->m_preparedGeom, target.geometry());
     }
     else {
-      result = GEOSContains(this->m_geom, target.geometry());
+      result = GEOSContains_r(geosContext(), this->m_geom, target.geometry());
     }
 
     return (1 == result);
@@ -511,10 +526,11 @@ namespace Isis {
 
     int result = 0;
     if ( 0 != m_preparedGeom) {
-      result = GEOSPreparedDisjoint(m_preparedGeom, target.geometry());
+      QMutexLocker lock(&m_preparedMutex);
+      result = GEOSPreparedDisjoint_r(geosContext(), m_preparedGeom, target.geometry());
     }
     else {
-      result = GEOSDisjoint(m_geom, target.geometry());
+      result = GEOSDisjoint_r(geosContext(), m_geom, target.geometry());
     }
 
     return (1 == result);
@@ -538,10 +554,11 @@ namespace Isis {
 
     int result = 0;
     if ( 0 != m_preparedGeom) {
-      result = GEOSPreparedOverlaps(m_preparedGeom, target.geometry());
+      QMutexLocker lock(&m_preparedMutex);
+      result = GEOSPreparedOverlaps_r(geosContext(), m_preparedGeom, target.geometry());
     }
     else {
-      result = GEOSOverlaps(m_geom, target.geometry());
+      result = GEOSOverlaps_r(geosContext(), m_geom, target.geometry());
     }
 
     return (1 == result);
@@ -563,7 +580,7 @@ namespace Isis {
       return (false);
     }
 
-    int result = GEOSEquals(this->m_geom, target.geometry());
+    int result = GEOSEquals_r(geosContext(), this->m_geom, target.geometry());
     return ( 1 == result );
   }
 
@@ -621,7 +638,7 @@ namespace Isis {
       return (new GisGeometry());
     }
 
-    GEOSGeometry *geom = GEOSEnvelope(m_geom);
+    GEOSGeometry *geom = GEOSEnvelope_r(geosContext(), m_geom);
     return (new GisGeometry(geom));
   }
 
@@ -638,7 +655,7 @@ namespace Isis {
       return (new GisGeometry());
     }
 
-    GEOSGeometry *geom = GEOSConvexHull(m_geom);
+    GEOSGeometry *geom = GEOSConvexHull_r(geosContext(), m_geom);
     return (new GisGeometry(geom));
   }
 
@@ -660,7 +677,7 @@ namespace Isis {
     if ( !isValid() ) {
       return (0);
     }
-    GEOSGeometry *geom = GEOSTopologyPreserveSimplify(m_geom, tolerance);
+    GEOSGeometry *geom = GEOSTopologyPreserveSimplify_r(geosContext(), m_geom, tolerance);
     if ( 0 == geom ) {
       return (0);
     }
@@ -687,7 +704,7 @@ namespace Isis {
       return (new GisGeometry());
     }
 
-    GEOSGeometry *geom = GEOSIntersection(m_geom, target.geometry());
+    GEOSGeometry *geom = GEOSIntersection_r(geosContext(), m_geom, target.geometry());
     return (new GisGeometry(geom));
   }
 
@@ -706,7 +723,7 @@ namespace Isis {
       return (new GisGeometry());
     }
 
-    GEOSGeometry *geom = GEOSUnion(m_geom, target.geometry());
+    GEOSGeometry *geom = GEOSUnion_r(geosContext(), m_geom, target.geometry());
     return (new GisGeometry(geom));
   }
 
@@ -726,10 +743,10 @@ namespace Isis {
       return (false);
     }
 
-    GEOSGeometry *center = GEOSGetCentroid(m_geom);
+    GEOSGeometry *center = GEOSGetCentroid_r(geosContext(), m_geom);
     if ( 0 != center ) {
-      GEOSGeomGetX(center, &xlongitude);
-      GEOSGeomGetY(center, &ylatitude);
+      GEOSGeomGetX_r(geosContext(), center, &xlongitude);
+      GEOSGeomGetY_r(geosContext(), center, &ylatitude);
       GisTopology::instance()->destroy(center);
       return (true);
     }
@@ -748,7 +765,7 @@ namespace Isis {
       return (new GisGeometry());
     }
 
-    GEOSGeometry *center = GEOSGetCentroid(m_geom);
+    GEOSGeometry *center = GEOSGetCentroid_r(geosContext(), m_geom);
     return (new GisGeometry(center));
   }
 
@@ -778,11 +795,11 @@ namespace Isis {
    */
   GEOSGeometry *GisGeometry::makePoint(const double x, const double y) const {
 
-    GEOSCoordSequence *point = GEOSCoordSeq_create(1, 2);
-    GEOSCoordSeq_setX(point, 0, x);
-    GEOSCoordSeq_setY(point, 0, y);
+    GEOSCoordSequence *point = GEOSCoordSeq_create_r(geosContext(), 1, 2);
+    GEOSCoordSeq_setX_r(geosContext(), point, 0, x);
+    GEOSCoordSeq_setY_r(geosContext(), point, 0, y);
 
-    return (GEOSGeom_createPoint(point));
+    return (GEOSGeom_createPoint_r(geosContext(), point));
   }
 
 
@@ -12,6 +12,7 @@ find files of those names at the top level of this repository. **/
 
 // Qt library
 #include <QMetaType>
+#include <QMutex>
 #include <QSharedPointer>
 
 class QString;
@@ -37,6 +38,11 @@ namespace Isis {
    * the GEOS-C package can be found at 
    * http://geos.osgeo.org/doxygen/c_iface.html. 
    *  
+   * The GEOS operations use the context handle of the calling thread (see 
+   * GisTopology::context()), so the const methods can be called on different 
+   * threads at once. Calls to intersects(), contains(), disjoint() and 
+   * overlaps() on the same object take turns using its prepared geometry. 
+   *  
    * @author 2012-07-15 Kris Becker 
    * @internal 
    *   @history 2012-07-15 Kris Becker - Original version.
@@ -118,6 +124,8 @@ namespace Isis {
       Type                 m_type;  //!< Geometry type of GIS source
       GEOSGeometry         *m_geom; //!< Pointer to GEOS-C opaque structure
       GEOSPreparedGeometry const *m_preparedGeom; //!< A prepared geometry from the GEOS library.
+      mutable QMutex       m_preparedMutex; /**< GEOS builds the indexes of a prepared geometry
+                                                 on first use, so one thread uses it at a time. */
   
   };
 
@@ -29,6 +29,19 @@ namespace Isis {
    * when the instance() method is called.
    */
   GisTopology *GisTopology::m_gisfactory = 0;
+
+
+  /**
+   * A GEOS context handle owned by one thread. QThreadStorage deletes it, and 
+   * so shuts the handle down, when the thread finishes.
+   */
+  class GisTopology::ThreadContext {
+    public:
+      ThreadContext() : m_handle(initGEOS_r(GisTopology::notice, GisTopology::error)) { }
+      ~ThreadContext() { finishGEOS_r(m_handle); }
+
+      GEOSContextHandle_t m_handle; //!< The GEOS handle of the thread
+  };
   
 
   /** 
@@ -88,6 +101,21 @@ namespace Isis {
   }
   
 
+  /** 
+   * Gets the GEOS context handle of the calling thread. The handle is created 
+   * the first time a thread asks for it and uses the same notice and error 
+   * handlers as the GEOS C API. 
+   *  
+   * @return GEOSContextHandle_t The GEOS handle of the calling thread
+   */  
+  GEOSContextHandle_t GisTopology::context() const {
+    if (!m_contexts.hasLocalData()) {
+      m_contexts.setLocalData(new ThreadContext());
+    }
+    return (m_contexts.localData()->m_handle);
+  }
+  
+
   /** 
    * Reads in the geometry from the given well-known binary formatted string. 
    *  
@@ -147,7 +175,7 @@ namespace Isis {
    */  
   GEOSGeometry *GisTopology::clone(const GEOSGeometry *geom) const {
     if (!geom) return (0);
-    return (GEOSGeom_clone(geom));
+    return (GEOSGeom_clone_r(context(), geom));
   }
   
   
@@ -161,7 +189,7 @@ namespace Isis {
    *                                a GEOSPreparedGeometry."
    */  
   const GEOSPreparedGeometry *GisTopology::preparedGeometry(const GEOSGeometry *geom) const {
-    const GEOSPreparedGeometry *ppgeom = GEOSPrepare(geom);
+    const GEOSPreparedGeometry *ppgeom = GEOSPrepare_r(context(), geom);
     if (!ppgeom) {
       throw IException(IException::Programmer, 
                        "Unable convert the given GEOSGeometry to a GEOSPreparedGeometry",
@@ -231,7 +259,7 @@ namespace Isis {
    */  
   void GisTopology::destroy(GEOSGeometry *geom) const {
     if (geom) { 
-      GEOSGeom_destroy(geom); 
+      GEOSGeom_destroy_r(context(), geom); 
     }
     return;
   }
@@ -257,7 +285,7 @@ namespace Isis {
    */  
   void GisTopology::destroy(const GEOSPreparedGeometry *geom) const {
     if (geom) { 
-      GEOSPreparedGeom_destroy(geom); 
+      GEOSPreparedGeom_destroy_r(context(), geom); 
     }
     return;
   }
@@ -270,7 +298,7 @@ namespace Isis {
    */  
   void GisTopology::destroy(GEOSCoordSequence *sequence) const {
     if (sequence) { 
-      GEOSCoordSeq_destroy(sequence); 
+      GEOSCoordSeq_destroy_r(context(), sequence); 
     }
     return;
   }
@@ -283,7 +311,7 @@ namespace Isis {
    */  
   void GisTopology::destroy(const char *geos_text) const {
     if (geos_text) {
-      GEOSFree(const_cast<char *> (geos_text));
+      GEOSFree_r(context(), const_cast<char *> (geos_text));
     }
     return;
   }
@@ -296,7 +324,7 @@ namespace Isis {
    */  
   void GisTopology::destroy(const unsigned char *geos_text) const {
     if (geos_text) {
-      GEOSFree(const_cast<unsigned char *> (geos_text));
+      GEOSFree_r(context(), const_cast<unsigned char *> (geos_text));
     }
     return;
   }
@@ -11,6 +11,9 @@ find files of those names at the top level of this repository. **/
 // GEOSWKTReader, GEOSWKTWriter, GEOSWKBReader, GEOSWKBWriter 
 #include <geos_c.h>
 
+// Qt library
+#include <QThreadStorage>
+
 class QString;
 
 namespace Isis {
@@ -21,6 +24,11 @@ namespace Isis {
    * strings. It also allows us to create WKB or WKT strings from a GEOS 
    * geometry. 
    *  
+   * Each thread that operates on geometries gets its own GEOS context handle 
+   * from context(), so geometries can be processed on several threads at once 
+   * as long as each geometry is only changed by one of them. The readers and 
+   * writers are shared and must only be used by one thread at a time. 
+   *  
    * @author 2012-07-15 Kris Becker
    * @internal 
    *   @history 2012-07-15 Kris Becker - Original version.
@@ -44,6 +52,8 @@ namespace Isis {
   
       static GisTopology *instance();
   
+      GEOSContextHandle_t context() const;
+
       GEOSGeometry *geomFromWKB(const QString &wkb);
       GEOSGeometry *geomFromWKT(const QString &wkt);
       GEOSGeometry *clone(const GEOSGeometry *geom) const;
@@ -63,6 +73,8 @@ namespace Isis {
       void destroy(const char *geos_text) const;
   
     private:
+      class ThreadContext;
+
       GisTopology();
       ~GisTopology();
   
@@ -89,6 +101,7 @@ namespace Isis {
       GEOSWKTWriter *m_WKTwriter;       //!< A GEOS library writer for well-known text format.
       GEOSWKBReader *m_WKBreader;       //!< A GEOS library parser for well-known binary format.
       GEOSWKBWriter *m_WKBwriter;       //!< A GEOS library writer for well-known binary format. 
+      mutable QThreadStorage<ThreadContext *> m_contexts; //!< The GEOS handle of each thread.
   
   };
 
@@ -168,46 +168,72 @@ namespace Isis {
     double rgain  = radio.Gain();
 
     int maxPnts((pattern.Samples()-2) * (pattern.Lines()-2));
-    GMatrix a(maxPnts, 8);
-    GVector lvec(maxPnts);
+
+    // Flag the valid subsearch pixels once, as each one is tested by up to
+    // five of its neighbors.  The flags are kept between calls to avoid
+    // reallocating them at every iteration.
+    int subSamps = subsearch.Samples();
+    m_validPixels.resize(subSamps * subsearch.Lines());
+    for(int line = 1 ; line <= subsearch.Lines() ; line++) {
+      char *valid = &m_validPixels[(line-1) * subSamps];
+      for(int samp = 1 ; samp <= subSamps ; samp++) {
+        valid[samp-1] = subsearch.IsValid(samp, line);
+      }
+    }
+
+    //  Accumulate the normal equations (ATA and ATL) directly from each
+    //  pixel rather than building the full design matrix.  The upper triangle
+    //  of ATA is summed in pixel order, which gives the same sums as the
+    //  design matrix products.
+    double ata[NCONSTR][NCONSTR];
+    double atl[NCONSTR];
+    for(int i = 0 ; i < NCONSTR ; i++) {
+      atl[i] = 0.0;
+      for(int j = 0 ; j < NCONSTR ; j++) {
+        ata[i][j] = 0.0;
+      }
+    }
 
     //  pattern chip is rh image , subsearch chip is lh image
     resid = 0.0;
     int npts = 0;
     for(int line = 2 ; line < pattern.Lines() ; line++) {
-      for(int samp = 2; samp < pattern.Samples() ; samp++) {
+      const double *pRow = pattern.Row(line);
+      const double *sPrev = subsearch.Row(line - 1);
+      const double *sRow = subsearch.Row(line);
+      const double *sNext = subsearch.Row(line + 1);
+      const char *vPrev = &m_validPixels[(line-2) * subSamps];
+      const char *vRow = &m_validPixels[(line-1) * subSamps];
+      const char *vNext = &m_validPixels[line * subSamps];
+
+      //  Line number
+      double y0 = (double)(line - tackLine);
 
+      for(int samp = 2; samp < pattern.Samples() ; samp++) {
+        int s = samp - 1;
         if(!pattern.IsValid(samp, line)) continue;
-        if(!subsearch.IsValid(samp, line)) continue;
-        if(!subsearch.IsValid(samp + 1, line)) continue;
-        if(!subsearch.IsValid(samp - 1, line)) continue;
-        if(!subsearch.IsValid(samp, line - 1)) continue;
-        if(!subsearch.IsValid(samp, line + 1)) continue;
+        if(!(vRow[s] && vRow[s+1] && vRow[s-1] && vPrev[s] && vNext[s])) continue;
 
-        //  Sample/Line numbers
+        //  Sample number
         double x0 = (double)(samp - tackSamp);
-        double y0 = (double)(line - tackLine);
 
         // Discrete derivatives (delta sample #)
-        double gxtemp = subsearch.GetValue(samp + 1, line) -
-                        subsearch.GetValue(samp - 1, line);
-        double gytemp = subsearch.GetValue(samp, line + 1) -
-                        subsearch.GetValue(samp, line - 1);
-
-        a[npts][0] = gxtemp;
-        a[npts][1] = gxtemp * x0;
-        a[npts][2] = gxtemp * y0;
-        a[npts][3] = gytemp;
-        a[npts][4] = gytemp * x0;
-        a[npts][5] = gytemp * y0;
-        a[npts][6] = 1.0;
-        a[npts][7] = subsearch.GetValue(samp, line);
-
-        double ell = pattern.GetValue(samp, line) -
-                     (((1.0 + rgain) * subsearch.GetValue(samp, line)) +
-                      rshift);
-
-        lvec[npts] = ell;
+        double gxtemp = sRow[s+1] - sRow[s-1];
+        double gytemp = sNext[s] - sPrev[s];
+
+        double a[NCONSTR] = { gxtemp, gxtemp * x0, gxtemp * y0,
+                              gytemp, gytemp * x0, gytemp * y0,
+                              1.0, sRow[s] };
+
+        double ell = pRow[s] - (((1.0 + rgain) * sRow[s]) + rshift);
+
+        for(int i = 0 ; i < NCONSTR ; i++) {
+          for(int j = i ; j < NCONSTR ; j++) {
+            ata[i][j] += (a[i] * a[j]);
+          }
+          atl[i] += a[i] * ell;
+        }
+
         resid += (ell * ell);
         npts++;
       }
@@ -222,25 +248,21 @@ namespace Isis {
       return (logError(NotEnoughPoints, mess.str().c_str()));
     }
 
-    // Create the ATA array
-    GMatrix ata(8,8);
-    for(int i = 0 ; i < 8 ; i++) {
-      for(int j = 0 ; j < 8 ; j++) {
-        double temp(0.0);
-        for (int k = 0 ; k < npts ; k++) {
-          temp += (a[k][i] * a[k][j]);
-        }
-        ata[i][j] = temp;
+    // Fill in the lower triangle of the symmetric ATA array
+    for(int i = 1 ; i < NCONSTR ; i++) {
+      for(int j = 0 ; j < i ; j++) {
+        ata[i][j] = ata[j][i];
       }
     }
 
     // Solve the ATAI with Cholesky
+    if ((atai.dim1() != NCONSTR) || (atai.dim2() != NCONSTR)) {
+      atai = GMatrix(NCONSTR, NCONSTR);
+    }
     try {
-      GVector p(8);
-      atai = Choldc(ata, p);
-      GMatrix b = Identity(8);
-      GMatrix x = b;
-      atai = Cholsl(atai, p, b, x);
+      double p[NCONSTR];
+      Choldc(ata, p);
+      Cholsl(ata, p, atai);
     }
     catch(IException &ie) {
       QString mess = "Cholesky Failed:: " + ie.toString();
@@ -248,18 +270,9 @@ namespace Isis {
     }
 
     // Compute the affine update if result are requested by caller.
-    GVector atl(8);
-    for (int i = 0 ; i < 8 ; i++) {
-      double temp(0.0);
-      for (int k = 0 ; k < npts ; k++) {
-        temp += a[k][i] * lvec[k];
-      }
-      atl[i] = temp;
-    }
-
-    GVector alpha(8, 0.0);
-    for (int i = 0 ; i < 8 ; i++) {
-      for (int k = 0 ; k < 8 ; k++) {
+    GVector alpha(NCONSTR, 0.0);
+    for (int i = 0 ; i < NCONSTR ; i++) {
+      for (int k = 0 ; k < NCONSTR ; k++) {
         alpha[i] += atai[i][k] * atl[k];
       }
     }
@@ -329,27 +342,22 @@ namespace Isis {
   }
 
   /**
-   * @brief Compute Cholesky solution
+   * @brief Compute the Cholesky decomposition of the normal matrix
    *
-   * @author kbecker (5/15/2011)
+   * The lower triangle of the decomposition, less the diagonal, replaces the
+   * lower triangle of the matrix.  The upper triangle is not changed.
    *
-   * @param a
-   * @param p
+   * @author kbecker (5/15/2011)
    *
-   * @return Gruen::GMatrix
+   * @param a Symmetric normal matrix, decomposed in place
+   * @param p Returns the diagonal of the decomposition
    */
-  GMatrix Gruen::Choldc(const GMatrix &a, GVector &p) const {
-    int nrows(a.dim1());
-    int ncols(a.dim2());
-
-    GMatrix aa = a.copy();
-    p = GVector(ncols);
-
-    for(int i = 0 ; i < nrows ; i++) {
-      for(int j = i ; j < ncols ; j++) {
-        double sum = aa[i][j];
+  void Gruen::Choldc(double a[NCONSTR][NCONSTR], double p[NCONSTR]) const {
+    for(int i = 0 ; i < NCONSTR ; i++) {
+      for(int j = i ; j < NCONSTR ; j++) {
+        double sum = a[i][j];
         for(int k = i-1 ; k >= 0 ; k--) {
-          sum -= (aa[i][k] * aa[j][k]);
+          sum -= (a[i][k] * a[j][k]);
         }
         // Handle diagonal special
         if (i == j) {
@@ -361,55 +369,48 @@ namespace Isis {
           p[i] = sqrt(sum);
         }
         else {
-          aa[j][i] = sum / p[i];
+          a[j][i] = sum / p[i];
         }
       }
     }
-    return (aa);
+    return;
   }
 
   /**
-   * @brief Compute Cholesky solution matrix from correlation
+   * @brief Compute the inverse of the normal matrix from its decomposition
    *
    * @author kbecker (5/15/2011)
    *
-   * @param a
-   * @param p
-   * @param b
-   * @param x
-   *
-   * @return Gruen::GMatrix
+   * @param a       Cholesky decomposition from Choldc
+   * @param p       Diagonal of the decomposition from Choldc
+   * @param inverse Returns the inverse of the normal matrix.  It must be
+   *                NCONSTR x NCONSTR.
    */
-  GMatrix Gruen::Cholsl(const GMatrix &a,const GVector &p, const GMatrix &b,
-                        const GMatrix &x) const {
-    assert(b.dim1() == x.dim1());
-    assert(b.dim2() == x.dim2());
-    assert(p.dim1() == b.dim2());
-
-    int nrows(a.dim1());
-    int ncols(a.dim2());
+  void Gruen::Cholsl(const double a[NCONSTR][NCONSTR], const double p[NCONSTR],
+                     GMatrix &inverse) const {
+    assert(inverse.dim1() == NCONSTR);
+    assert(inverse.dim2() == NCONSTR);
 
-    GMatrix xout = x.copy();
-    for(int j = 0 ; j < nrows ; j++) {
+    for(int j = 0 ; j < NCONSTR ; j++) {
 
-      for(int i = 0 ; i < ncols ; i++) {
-        double sum = b[j][i];
+      for(int i = 0 ; i < NCONSTR ; i++) {
+        double sum = (i == j) ? 1.0 : 0.0;
         for(int k = i-1 ; k >= 0 ; k--) {
-          sum -= (a[i][k] * xout[j][k]);
+          sum -= (a[i][k] * inverse[j][k]);
         }
-        xout[j][i] = sum / p[i];
+        inverse[j][i] = sum / p[i];
       }
 
-      for (int i = ncols-1 ; i >= 0 ; i--) {
-        double sum = xout[j][i];
-        for(int k = i+1 ; k < ncols ; k++) {
-          sum -= (a[k][i] * xout[j][k]);
+      for (int i = NCONSTR-1 ; i >= 0 ; i--) {
+        double sum = inverse[j][i];
+        for(int k = i+1 ; k < NCONSTR ; k++) {
+          sum -= (a[k][i] * inverse[j][k]);
         }
-        xout[j][i] = sum / p[i];
+        inverse[j][i] = sum / p[i];
       }
 
     }
-    return (xout);
+    return;
   }
 
   /**
@@ -720,6 +721,7 @@ namespace Isis {
     //  Algorithm parameters
     bool done = false;
     m_nIters = 0;
+    GMatrix atai(NCONSTR, NCONSTR);
     do {
 
       // Extract the sub search chip.  The algorithm method handles the
@@ -739,7 +741,6 @@ namespace Isis {
       // Try to match the two subchips
       AffineRadio alpha;
       BigInt npts(0);
-      GMatrix atai;
       double resid;
       int status = algorithm(pChip, fChip, affine.m_radio, npts, resid,
                              atai, alpha);
@@ -840,6 +841,42 @@ namespace Isis {
     return (pvl);
   }
 
+  /**
+   * @brief Add the Gruen specific statistics of another Gruen object
+   *
+   * The error counts, iteration count and statistics gathered by the other
+   * object are added to this object's, so that they are reported together by
+   * AlgorithmStatistics.
+   *
+   * @param other Gruen object to add statistics from
+   */
+  void Gruen::AddAlgorithmStatistics(const AutoReg &other) {
+    const Gruen *otherGruen = dynamic_cast<const Gruen *>(&other);
+    if (!otherGruen) {
+      QString msg = "Cannot add the statistics of a [" + other.AlgorithmName()
+                    + "] registration to a [" + AlgorithmName() + "] registration";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    for (int e = 0 ; e < otherGruen->m_errors.size() ; e++) {
+      const ErrorCounter &error = otherGruen->m_errors.getNth(e);
+      if (m_errors.exists(error.Errno())) {
+        m_errors.get(error.Errno()).m_count += error.Count();
+      }
+      else {
+        m_unclassified += error.Count();
+      }
+    }
+    m_unclassified += otherGruen->m_unclassified;
+    m_totalIterations += otherGruen->m_totalIterations;
+
+    m_eigenStat.AddStatistics(otherGruen->m_eigenStat);
+    m_iterStat.AddStatistics(otherGruen->m_iterStat);
+    m_shiftStat.AddStatistics(otherGruen->m_shiftStat);
+    m_gainStat.AddStatistics(otherGruen->m_gainStat);
+  }
+
+
   /**
    * @brief Create a PvlGroup with the Gruen specific statistics
    *
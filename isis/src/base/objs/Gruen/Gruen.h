@@ -7,6 +7,7 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 
+#include <vector>
 
 #include "AutoReg.h"
 #include "tnt/tnt_array2d.h"
@@ -151,6 +152,7 @@ namespace Isis {
           int bestLine);
 
       virtual Pvl AlgorithmStatistics(Pvl &pvl);
+      virtual void AddAlgorithmStatistics(const AutoReg &other);
 
     private:
       /** Error enumeration values */
@@ -212,6 +214,9 @@ namespace Isis {
       AffineRadio  m_affine;            // Incoming affine setting
       MatchPoint   m_point;             // Last resuting registration result
 
+      // Valid pixel flags of the subsearch chip, reused by each iteration
+      std::vector<char> m_validPixels;
+
       //  Statistics gathered during processing
       Statistics   m_eigenStat;
       Statistics   m_iterStat;
@@ -351,9 +356,9 @@ namespace Isis {
       void resetStats();
 
       GMatrix Identity(const int &ndiag = 3) const;
-      GMatrix Choldc(const GMatrix &a, GVector &p) const;
-      GMatrix Cholsl(const GMatrix &a, const GVector &p,
-                     const GMatrix &b, const GMatrix &x) const;
+      void Choldc(double a[NCONSTR][NCONSTR], double p[NCONSTR]) const;
+      void Cholsl(const double a[NCONSTR][NCONSTR], const double p[NCONSTR],
+                  GMatrix &inverse) const;
       int Jacobi(const GMatrix &a, GVector &evals, GMatrix &evecs,
                   const int &MaxIters = 50) const;
       void EigenSort(GVector &evals, GMatrix &evecs) const;
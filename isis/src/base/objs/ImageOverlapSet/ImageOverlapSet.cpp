@@ -4,6 +4,7 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -11,15 +12,27 @@ find files of those names at the top level of this repository. **/
 #include <string>
 #include <vector>
 
+#include <QFuture>
+#include <QHash>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+#include <QtConcurrentRun>
+
 #include "Cube.h"
 #include "FileName.h"
 #include "geos/operation/distance/DistanceOp.h"
 #include "geos/util/IllegalArgumentException.h"
 #include "geos/geom/Point.h"
+#include "geos/index/strtree/STRtree.h"
+#include "geos/operation/intersection/Rectangle.h"
+#include "geos/operation/intersection/RectangleIntersection.h"
+#include "geos/operation/union/CascadedPolygonUnion.h"
 #include "geos/opOverlay.h"
 #include "IException.h"
 #include "ImageOverlapSet.h"
 #include "ImagePolygon.h"
+#include "IString.h"
 #include "PolygonTools.h"
 #include "Progress.h"
 #include "SerialNumberList.h"
@@ -45,10 +58,34 @@ namespace Isis {
     p_writtenSoFar = 0;
     p_calculatedSoFar = -1;
     p_threadedCalculate = useThread;
+    p_tiles = 1;
+    p_isTile = false;
+    p_factory = Isis::globalFactory.get();
     p_snlist = NULL;
   }
 
 
+  /**
+   * Set the number of tiles to split the (Lon,Lat) domain into along each axis. When there
+   * is more than one tile, the overlaps of the tiles are found concurrently, using the number
+   * of threads set by the GlobalThreads preference, and joined.
+   *
+   * The joined overlaps cover the same areas with the same serial numbers, but they are in a
+   * different order, and the areas with the same serial numbers are always one overlap.
+   *
+   * @param tiles The number of tiles along each axis, 1 to not tile the overlaps
+   *
+   * @see FindTiledOverlaps()
+   */
+  void ImageOverlapSet::SetTiles(int tiles) {
+    if (tiles < 1) {
+      QString msg = "The number of overlap tiles [" + toString(tiles) + "] must be at least 1";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+    p_tiles = tiles;
+  }
+
+
   /**
    * Delete this object.
    *
@@ -387,7 +424,7 @@ namespace Isis {
     if (!multiPolygon->isValid() ||
         (multiPolygon->getArea() < 1.0e-10 && !multiPolygon->isEmpty())) {
       delete multiPolygon;
-      multiPolygon = Isis::globalFactory->createMultiPolygon();
+      multiPolygon = p_factory->createMultiPolygon();
     }
 
     if (position > p_lonLatOverlaps.size()) {
@@ -408,6 +445,7 @@ namespace Isis {
         (multiPolygon->isEmpty() || multiPolygon->getArea() > 1.0e-14)) {
       if (!insert) {
         p_lonLatOverlaps.at(position)->SetPolygon(multiPolygon);
+        IndexOverlap(position);
 
         if (sncopy) {
           AddSerialNumbers(p_lonLatOverlaps.at(position), sncopy);
@@ -423,11 +461,7 @@ namespace Isis {
           AddSerialNumbers(imageOverlap, sncopy);
         }
 
-        // Insert could cause a reallocation of the overlap list, so lock it with
-        // the writing code so that we don't conflict
-        p_lonLatOverlapsMutex.lock();
-        p_lonLatOverlaps.insert(p_lonLatOverlaps.begin() + position, imageOverlap);
-        p_lonLatOverlapsMutex.unlock();
+        InsertOverlap(position, imageOverlap);
       }
 
       success = true;
@@ -532,6 +566,11 @@ namespace Isis {
   /**
    * Find the overlaps between all the existing ImageOverlap Objects
    *
+   * Each overlap is compared with the overlaps after it, in order. Only the overlaps whose
+   * owning footprints intersect its envelope can change, so the others are skipped without
+   * computing any intersections, and the work is proportional to the number of overlapping
+   * footprints instead of the square of the number of overlaps.
+   *
    * @param snlist The serialnumber list relating to the overlaps described by the
    *               current known ImageOverlap objects or NULL
    */
@@ -540,12 +579,23 @@ namespace Isis {
     bool foundOverlap = false;
     if (p_lonLatOverlaps.size() <= 1) return;
 
+    if (p_tiles > 1) {
+      FindTiledOverlaps(snlist);
+      return;
+    }
+
+    // Tiles are found concurrently, so only the tiled set reports progress
     Progress p;
+    if (p_isTile) p.DisableAutomaticDisplay();
     p.SetText("Calculating Image Overlaps");
     p.SetMaximumSteps(p_lonLatOverlaps.size() - 1);
     p.CheckStatus();
 
-    geos::geom::MultiPolygon *emptyPolygon = Isis::globalFactory->createMultiPolygon();
+    geos::geom::MultiPolygon *emptyPolygon = p_factory->createMultiPolygon();
+
+    geos::index::strtree::STRtree footprintIndex;
+    IndexOverlaps(footprintIndex);
+    std::vector<int> candidates;
 
     // Compare each polygon with all of the others
     for (int outside = 0; outside < p_lonLatOverlaps.size() - 1; ++outside) {
@@ -559,259 +609,673 @@ namespace Isis {
         }
       }
 
-      // Intersect the current polygon (from the outside loop) with all others
-      // below it
-      for (int inside = outside + 1; inside < p_lonLatOverlaps.size(); ++inside) {
-        try {
-          if (p_lonLatOverlaps.at(outside)->HasAnySameSerialNumber(*p_lonLatOverlaps.at(inside)))
-            continue;
-
-          // We know these are valid because they were filtered early on
-          const geos::geom::MultiPolygon *poly1 = p_lonLatOverlaps.at(outside)->Polygon();
-          const geos::geom::MultiPolygon *poly2 = p_lonLatOverlaps.at(inside)->Polygon();
-
-          // Check to see if the two poygons are equivalent.
-          // If they are, then we can get rid of one of them
-          if (PolygonTools::Equal(poly1, poly2)) {
-            p_lonLatOverlapsMutex.lock();
-            AddSerialNumbers(p_lonLatOverlaps[outside], p_lonLatOverlaps[inside]);
-            p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
-            p_lonLatOverlapsMutex.unlock();
-            inside --;
-            continue;
-          }
+      // Intersect the current polygon (from the outside loop) with the ones below it that
+      // it could intersect. If the current polygon is removed, start over with the next one.
+      bool restart;
+      do {
+        restart = false;
+        OverlapCandidates(footprintIndex, outside, candidates);
 
-          // We can get empty polygons in our list sometimes; try to avoid extra processing
-          if (poly2->isEmpty() || poly2->getArea() < 1.0e-14) {
-            p_lonLatOverlapsMutex.lock();
-            p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
-            p_lonLatOverlapsMutex.unlock();
-            inside --;
-            continue;
-          }
+        for (unsigned int candidate = 0; candidate < candidates.size(); ++candidate) {
+          int inside = OverlapPosition(candidates[candidate], outside + 1);
+          if (inside < 0) continue;
 
-          geos::geom::Geometry *intersected = NULL;
           try {
-            intersected = PolygonTools::Intersect(poly1, poly2);
-          }
-          catch (IException &e) {
-            intersected = NULL;
-            QString error = "Intersection of overlaps failed.";
-
-            // We never want to double seed, so we must delete one or both
-            //   of these polygons because they more than likely have an intersection
-            //   that we simply can't calculate.
-            double outsideArea = poly1->getArea();
-            double insideArea = poly2->getArea();
-            double areaRatio = std::min(outsideArea, insideArea) /
-                               std::max(outsideArea, insideArea);
-
-            // If one of the polygons is < 1% the area of the other,
-            //   then only throw out the small one to
-            //   try to minimize the impact of this failure.
-            if (areaRatio < 0.1) {
-              if (poly1->getArea() > poly2->getArea()) {
-                error += " The first polygon will be removed.";
-                HandleError(e, snlist, error, inside, outside);
-                p_lonLatOverlapsMutex.lock();
-                p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
-                p_lonLatOverlapsMutex.unlock();
-                inside --;
+            if (p_lonLatOverlaps.at(outside)->HasAnySameSerialNumber(*p_lonLatOverlaps.at(inside)))
+              continue;
+
+            // We know these are valid because they were filtered early on
+            const geos::geom::MultiPolygon *poly1 = p_lonLatOverlaps.at(outside)->Polygon();
+            const geos::geom::MultiPolygon *poly2 = p_lonLatOverlaps.at(inside)->Polygon();
+
+            // Check to see if the two poygons are equivalent.
+            // If they are, then we can get rid of one of them
+            if (PolygonTools::Equal(poly1, poly2)) {
+              AddSerialNumbers(p_lonLatOverlaps[outside], p_lonLatOverlaps[inside]);
+              EraseOverlap(inside);
+              continue;
+            }
+
+            // We can get empty polygons in our list sometimes; try to avoid extra processing
+            if (poly2->isEmpty() || poly2->getArea() < 1.0e-14) {
+              EraseOverlap(inside);
+              continue;
+            }
+
+            geos::geom::Geometry *intersected = NULL;
+            try {
+              intersected = PolygonTools::Intersect(poly1, poly2);
+            }
+            catch (IException &e) {
+              intersected = NULL;
+              QString error = "Intersection of overlaps failed.";
+
+              // We never want to double seed, so we must delete one or both
+              //   of these polygons because they more than likely have an intersection
+              //   that we simply can't calculate.
+              double outsideArea = poly1->getArea();
+              double insideArea = poly2->getArea();
+              double areaRatio = std::min(outsideArea, insideArea) /
+                                 std::max(outsideArea, insideArea);
+
+              // If one of the polygons is < 1% the area of the other,
+              //   then only throw out the small one to
+              //   try to minimize the impact of this failure.
+              if (areaRatio < 0.1) {
+                if (poly1->getArea() > poly2->getArea()) {
+                  error += " The first polygon will be removed.";
+                  HandleError(e, snlist, error, inside, outside);
+                  EraseOverlap(inside);
+                  continue;
+                }
+                else {
+                  error += " The second polygon will be removed.";
+                  HandleError(e, snlist, error, inside, outside);
+                  EraseOverlap(outside);
+                }
               }
               else {
-                error += " The second polygon will be removed.";
+                error += " Both polygons will be removed to prevent the "
+                         "possibility of double counted areas.";
                 HandleError(e, snlist, error, inside, outside);
-                p_lonLatOverlapsMutex.lock();
-                p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + outside);
-                p_lonLatOverlapsMutex.unlock();
-                inside = outside;
+                EraseOverlap(inside);
+                EraseOverlap(outside);
               }
+
+              restart = true;
+              break;
             }
-            else {
-              error += " Both polygons will be removed to prevent the "
-                       "possibility of double counted areas.";
-              HandleError(e, snlist, error, inside, outside);
-              p_lonLatOverlapsMutex.lock();
-              p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
-              p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + outside);
-              p_lonLatOverlapsMutex.unlock();
-              inside = outside;
+
+            if (intersected->isEmpty() || intersected->getArea() < 1.0e-14) {
+              delete intersected;
+              intersected = NULL;
+              continue;
             }
 
-            continue;
-          }
+            // We are only interested in overlaps that result in polygon(s)
+            // and not any that are lines or points, so create a new multipolygon
+            // with only the polygons of overlap
+            geos::geom::MultiPolygon *overlap = NULL;
+            try {
+              overlap = PolygonTools::Despike(intersected);
 
-          if (intersected->isEmpty() || intersected->getArea() < 1.0e-14) {
-            delete intersected;
-            intersected = NULL;
-            continue;
-          }
+              delete intersected;
+              intersected = NULL;
+            }
+            catch (IException &e) {
+              if (!intersected->isValid()) {
+                delete intersected;
+                intersected = NULL;
 
-          // We are only interested in overlaps that result in polygon(s)
-          // and not any that are lines or points, so create a new multipolygon
-          // with only the polygons of overlap
-          geos::geom::MultiPolygon *overlap = NULL;
-          try {
-            overlap = PolygonTools::Despike(intersected);
+                HandleError(e, snlist, "", inside, outside);
+                continue;
+              }
+              else {
+                overlap = PolygonTools::MakeMultiPolygon(intersected);
 
-            delete intersected;
-            intersected = NULL;
-          }
-          catch (IException &e) {
-            if (!intersected->isValid()) {
+                delete intersected;
+                intersected = NULL;
+              }
+            }
+            catch (geos::util::GEOSException *exc) {
               delete intersected;
               intersected = NULL;
+              HandleError(exc, snlist, "", inside, outside);
+              continue;
+            }
 
-              HandleError(e, snlist, "", inside, outside);
+            if (!overlap->isValid()) {
+              delete overlap;
+              overlap = NULL;
+              HandleError(snlist, "Intersection produced invalid overlap area", inside, outside);
               continue;
             }
-            else {
-              overlap = PolygonTools::MakeMultiPolygon(intersected);
 
-              delete intersected;
-              intersected = NULL;
+            // is there really overlap?
+            if (overlap->isEmpty() || overlap->getArea() < 1.0e-14) {
+              delete overlap;
+              overlap = NULL;
+              continue;
+            }
+
+            // poly1 is completely inside poly2
+            if (PolygonTools::Equal(poly1, overlap)) {
+              geos::geom::Geometry *tmpGeom = NULL;
+              try {
+                tmpGeom = PolygonTools::Difference(poly2, poly1);
+              }
+              catch (IException &e) {
+                HandleError(e, snlist, "Differencing overlap polygons failed."
+                                       "The first polygon will be removed.", inside, outside);
+
+                // Delete outside polygon directly and reset outside loop
+                //   - current outside is thrown out!
+                EraseOverlap(outside);
+                restart = true;
+                break;
+              }
+              if (SetPolygon(tmpGeom, inside) &&
+                  SetPolygon(overlap, outside, p_lonLatOverlaps[inside]))
+                foundOverlap = true;
             }
+            // poly2 is completely inside poly1
+            else if (PolygonTools::Equal(poly2, overlap)) {
+              geos::geom::Geometry *tmpGeom = NULL;
+              try {
+                tmpGeom = PolygonTools::Difference(poly1, poly2);
+              }
+              catch (IException &e) {
+                HandleError(e, snlist, "Differencing overlap polygons failed."
+                                       "The second polygon will be removed.", inside, outside);
+
+                // Delete inside polygon directly and process next inside
+                EraseOverlap(inside);
+                continue;
+              }
+              if (SetPolygon(tmpGeom, outside) &&
+                  SetPolygon(overlap, inside, p_lonLatOverlaps[outside]))
+                foundOverlap = true;
+            }
+            // There is partial overlap
+            else {
+              // Subtract overlap from poly1 and set poly1 to the result
+              geos::geom::Geometry *tmpGeom = NULL;
+              try {
+                tmpGeom = PolygonTools::Difference(poly1, overlap);
+              }
+              catch (IException &e) {
+                tmpGeom = NULL;
+              }
+
+              // If we failed to subtract overlap, try to subtract poly2 from poly1
+              // and set poly1 to the result
+              try {
+                if (tmpGeom == NULL) {
+                  tmpGeom = PolygonTools::Difference(poly1, poly2);
+                }
+              }
+              catch (IException &e) {
+                tmpGeom = NULL;
+                HandleError(e, snlist, "Differencing overlap polygons failed", inside, outside);
+                continue;
+              }
+
+              if (!SetPolygon(tmpGeom, outside)) {
+                if (SetPolygon(p_factory->createMultiPolygon(), outside))
+                  foundOverlap = true;
+              }
+
+              // The new overlap is inserted after the inside polygon, so it is not a candidate
+              int oldSize = p_lonLatOverlaps.size();
+              if (SetPolygon(overlap, inside + 1, p_lonLatOverlaps[outside], true)) {
+                int newSize = p_lonLatOverlaps.size();
+                int newSteps = newSize - oldSize;
+                p.AddSteps(newSteps);
+                foundOverlap = true;
+              }
+            } // End of partial overlap else
+          }
+          // Collections are illegal as intersection argument
+          catch (IException &e) {
+            HandleError(e, snlist, "Unable to find overlap.", inside, outside);
+          }
+          // Collections are illegal as intersection argument
+          catch (geos::util::IllegalArgumentException *ill) {
+            HandleError(NULL, snlist, "Unable to find overlap", inside, outside);
           }
           catch (geos::util::GEOSException *exc) {
-            delete intersected;
-            intersected = NULL;
-            HandleError(exc, snlist, "", inside, outside);
-            continue;
+            HandleError(exc, snlist, "Unable to find overlap", inside, outside);
           }
-
-          if (!overlap->isValid()) {
-            delete overlap;
-            overlap = NULL;
-            HandleError(snlist, "Intersection produced invalid overlap area", inside, outside);
-            continue;
+          catch (...) {
+            HandleError(snlist, "Unknown Error: Unable to find overlap", inside, outside);
           }
+        }
+      } while (restart);
 
-          // is there really overlap?
-          if (overlap->isEmpty() || overlap->getArea() < 1.0e-14) {
-            delete overlap;
-            overlap = NULL;
-            continue;
-          }
+      // The current polygon is done, so it is no longer a candidate
+      if (outside < p_lonLatOverlaps.size()) {
+        p_overlapActive[p_overlapIds[outside]] = false;
+      }
 
-          // poly1 is completely inside poly2
-          if (PolygonTools::Equal(poly1, overlap)) {
-            geos::geom::Geometry *tmpGeom = NULL;
-            try {
-              tmpGeom = PolygonTools::Difference(poly2, poly1);
-            }
-            catch (IException &e) {
-              HandleError(e, snlist, "Differencing overlap polygons failed."
-                                     "The first polygon will be removed.", inside, outside);
-
-              // Delete outside polygon directly and reset outside loop
-              //   - current outside is thrown out!
-              p_lonLatOverlapsMutex.lock();
-              p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + outside);
-              p_lonLatOverlapsMutex.unlock();
-              inside = outside;
-              continue;
-            }
-            if (SetPolygon(tmpGeom, inside) &&
-                SetPolygon(overlap, outside, p_lonLatOverlaps[inside]))
-              foundOverlap = true;
-          }
-          // poly2 is completely inside poly1
-          else if (PolygonTools::Equal(poly2, overlap)) {
-            geos::geom::Geometry *tmpGeom = NULL;
-            try {
-              tmpGeom = PolygonTools::Difference(poly1, poly2);
-            }
-            catch (IException &e) {
-              HandleError(e, snlist, "Differencing overlap polygons failed."
-                                     "The second polygon will be removed.", inside, outside);
-
-              // Delete inside polygon directly and process next inside
-              p_lonLatOverlapsMutex.lock();
-              p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + inside);
-              p_lonLatOverlapsMutex.unlock();
-              inside --;
+      p.CheckStatus();
+    }
+
+    p_calculatedSoFar = p_lonLatOverlaps.size();
+    delete emptyPolygon;
+
+    p_overlapIds.clear();
+    p_overlapOrder.clear();
+    p_overlapOwner.clear();
+    p_overlapActive.clear();
+    p_footprintEnvelopes.clear();
+    p_footprintOverlaps.clear();
+    p_unindexedOverlaps.clear();
+
+    // Do not write empty overlap files. The overlaps of a tile are always kept, since the
+    // overlaps of the other tiles are joined with them.
+    if (foundOverlap == false && !p_isTile) {
+      p_lonLatOverlapsMutex.lock();
+      p_lonLatOverlaps.clear();
+      p_lonLatOverlapsMutex.unlock();
+    }
+
+    // unblock the writing process
+    // Check first if the the thread is still locked
+    // to avoid undefined behavior
+    p_calculatePolygonMutex.tryLock();
+    p_calculatePolygonMutex.unlock();
+  }
+
+
+  /**
+   * Find the overlaps by splitting the footprints into a grid of (Lon,Lat) tiles, finding the
+   * overlaps of each tile concurrently, and joining the overlaps with the same serial numbers
+   * across the tiles.
+   *
+   * The footprints are already split at the 0/360 seam and around the poles when they are
+   * made, so the tiles are a regular grid over the envelope of all of the footprints. The
+   * footprints are clipped to the tiles exactly, so the overlaps on either side of a tile edge
+   * share their vertices on it and join without gaps. Each tile has its own overlap set with
+   * its own copies of the clipped footprints, created with its own geometry factory, so no
+   * geometry or factory is shared between threads. The joined overlaps are created with the
+   * factory of this set.
+   *
+   * Each overlap is the area covered by exactly its images, so the joined overlaps cover the
+   * same areas as the overlaps found without tiles. They are ordered by the first tile they
+   * are found in.
+   *
+   * @param snlist The serialnumber list relating to the overlaps described by the
+   *               current known ImageOverlap objects or NULL
+   */
+  void ImageOverlapSet::FindTiledOverlaps(SerialNumberList *snlist) {
+
+    //! The overlap set of one tile and the error it failed with
+    struct Tile {
+      ImageOverlapSet *overlaps;
+      QSharedPointer<IException> error;
+    };
+
+    geos::geom::Envelope domain;
+    for (int i = 0; i < p_lonLatOverlaps.size(); i++) {
+      const geos::geom::MultiPolygon *poly = p_lonLatOverlaps[i]->Polygon();
+      if (!poly->isEmpty()) {
+        domain.expandToInclude(poly->getEnvelopeInternal());
+      }
+    }
+
+    // Clip the footprints to the tiles. The tiles share their edges exactly.
+    QVector<Tile> tiles;
+    if (!domain.isNull() && domain.getWidth() > 0.0 && domain.getHeight() > 0.0) {
+      std::vector<double> lons(p_tiles + 1);
+      std::vector<double> lats(p_tiles + 1);
+      for (int t = 0; t < p_tiles; t++) {
+        lons[t] = domain.getMinX() + t * domain.getWidth() / p_tiles;
+        lats[t] = domain.getMinY() + t * domain.getHeight() / p_tiles;
+      }
+      lons[p_tiles] = domain.getMaxX();
+      lats[p_tiles] = domain.getMaxY();
+
+      for (int row = 0; row < p_tiles; row++) {
+        for (int col = 0; col < p_tiles; col++) {
+          geos::geom::Envelope tileEnvelope(lons[col], lons[col + 1], lats[row], lats[row + 1]);
+          geos::operation::intersection::Rectangle rectangle(lons[col], lats[row],
+                                                             lons[col + 1], lats[row + 1]);
+          Tile tile;
+          tile.overlaps = new ImageOverlapSet(p_continueAfterError, false);
+          tile.overlaps->p_isTile = true;
+          tile.overlaps->p_tileFactory = geos::geom::GeometryFactory::create();
+          tile.overlaps->p_factory = tile.overlaps->p_tileFactory.get();
+
+          for (int i = 0; i < p_lonLatOverlaps.size(); i++) {
+            const geos::geom::MultiPolygon *poly = p_lonLatOverlaps[i]->Polygon();
+            if (poly->isEmpty() || !tileEnvelope.intersects(poly->getEnvelopeInternal())) {
               continue;
             }
-            if (SetPolygon(tmpGeom, outside) &&
-                SetPolygon(overlap, inside, p_lonLatOverlaps[outside]))
-              foundOverlap = true;
-          }
-          // There is partial overlap
-          else {
-            // Subtract overlap from poly1 and set poly1 to the result
-            geos::geom::Geometry *tmpGeom = NULL;
-            try {
-              tmpGeom = PolygonTools::Difference(poly1, overlap);
-            }
-            catch (IException &e) {
-              tmpGeom = NULL;
-            }
 
-            // If we failed to subtract overlap, try to subtract poly2 from poly1
-            // and set poly1 to the result
+            geos::geom::MultiPolygon *clipped = NULL;
             try {
-              if (tmpGeom == NULL) {
-                tmpGeom = PolygonTools::Difference(poly1, poly2);
-              }
+              std::unique_ptr<geos::geom::Geometry> clip =
+                  geos::operation::intersection::RectangleIntersection::clip(*poly, rectangle);
+              std::unique_ptr<geos::geom::Geometry> tileClip(
+                  tile.overlaps->p_factory->createGeometry(clip.get()));
+              clipped = PolygonTools::MakeMultiPolygon(tileClip.get());
             }
             catch (IException &e) {
-              tmpGeom = NULL;
-              HandleError(e, snlist, "Differencing overlap polygons failed", inside, outside);
+              HandleError(e, snlist, "Unable to clip the footprint to an overlap tile.", i);
               continue;
             }
 
-            if (!SetPolygon(tmpGeom, outside)) {
-              if (SetPolygon(Isis::globalFactory->createMultiPolygon(), outside))
-                foundOverlap = true;
+            if (!clipped->isEmpty() && clipped->getArea() >= 1.0e-14) {
+              ImageOverlap *imageOverlap = new ImageOverlap();
+              imageOverlap->SetPolygon(clipped);
+              AddSerialNumbers(imageOverlap, p_lonLatOverlaps[i]);
+              tile.overlaps->p_lonLatOverlaps.push_back(imageOverlap);
             }
+            delete clipped;
+          }
 
-            int oldSize = p_lonLatOverlaps.size();
-            if (SetPolygon(overlap, inside + 1, p_lonLatOverlaps[outside], true)) {
-              int newSize = p_lonLatOverlaps.size();
-              int newSteps = newSize - oldSize;
-              p.AddSteps(newSteps);
-              foundOverlap = true;
-              if (newSize != oldSize) inside++;
-            }
-          } // End of partial overlap else
+          tiles.append(tile);
+        }
+      }
+    }
+
+    Progress progress;
+    progress.SetText("Calculating Image Overlaps");
+    progress.SetMaximumSteps(tiles.size());
+    progress.CheckStatus();
+
+    QList< QFuture<void> > futures;
+    for (int t = 0; t < tiles.size(); t++) {
+      Tile *tile = &tiles[t];
+      futures.append(QtConcurrent::run([snlist, tile]() {
+        try {
+          tile->overlaps->FindAllOverlaps(snlist);
         }
-        // Collections are illegal as intersection argument
         catch (IException &e) {
-          HandleError(e, snlist, "Unable to find overlap.", inside, outside);
+          tile->error = QSharedPointer<IException>(new IException(e));
         }
-        // Collections are illegal as intersection argument
-        catch (geos::util::IllegalArgumentException *ill) {
-          HandleError(NULL, snlist, "Unable to find overlap", inside, outside);
+      }));
+    }
+
+    // Report the tiles in order as they finish
+    for (int t = 0; t < futures.size(); t++) {
+      futures[t].waitForFinished();
+      progress.CheckStatus();
+    }
+
+    for (int t = 0; t < tiles.size(); t++) {
+      p_errorLog.insert(p_errorLog.end(), tiles[t].overlaps->p_errorLog.begin(),
+                        tiles[t].overlaps->p_errorLog.end());
+    }
+    for (int t = 0; t < tiles.size(); t++) {
+      if (tiles[t].error) {
+        IException error = *tiles[t].error;
+        for (int i = 0; i < tiles.size(); i++) {
+          delete tiles[i].overlaps;
         }
-        catch (geos::util::GEOSException *exc) {
-          HandleError(exc, snlist, "Unable to find overlap", inside, outside);
+        throw error;
+      }
+    }
+
+    // Gather the pieces of the overlaps with the same serial numbers
+    QList<ImageOverlap *> joined;
+    std::vector< std::vector<geos::geom::Polygon *> > pieces;
+    QHash<QString, int> joinedIndex;
+    for (int t = 0; t < tiles.size(); t++) {
+      const QList<ImageOverlap *> &tileOverlaps = tiles[t].overlaps->p_lonLatOverlaps;
+      for (int i = 0; i < tileOverlaps.size(); i++) {
+        const geos::geom::MultiPolygon *poly = tileOverlaps[i]->Polygon();
+        if (poly->isEmpty()) continue;
+
+        QStringList serialNumbers;
+        for (int sn = 0; sn < tileOverlaps[i]->Size(); sn++) {
+          serialNumbers.append((*tileOverlaps[i])[sn]);
         }
-        catch (...) {
-          HandleError(snlist, "Unknown Error: Unable to find overlap", inside, outside);
+        serialNumbers.sort();
+        QString key = serialNumbers.join("\n");
+
+        if (!joinedIndex.contains(key)) {
+          joinedIndex.insert(key, joined.size());
+          ImageOverlap *imageOverlap = new ImageOverlap();
+          AddSerialNumbers(imageOverlap, tileOverlaps[i]);
+          joined.append(imageOverlap);
+          pieces.push_back(std::vector<geos::geom::Polygon *>());
+        }
+
+        std::vector<geos::geom::Polygon *> &overlapPieces = pieces[joinedIndex[key]];
+        for (unsigned int g = 0; g < poly->getNumGeometries(); g++) {
+          overlapPieces.push_back(dynamic_cast<geos::geom::Polygon *>(
+                                  const_cast<geos::geom::Geometry *>(poly->getGeometryN(g))));
         }
       }
+    }
 
-      p.CheckStatus();
+    // Join the pieces across the tile edges
+    bool foundOverlap = false;
+    for (int j = 0; j < joined.size(); j++) {
+      geos::geom::MultiPolygon *polygon = NULL;
+      try {
+        std::unique_ptr<geos::geom::Geometry> unioned(
+            geos::operation::geounion::CascadedPolygonUnion::Union(&pieces[j]));
+        std::unique_ptr<geos::geom::Geometry> copy(p_factory->createGeometry(unioned.get()));
+        polygon = PolygonTools::MakeMultiPolygon(copy.get());
+      }
+      catch (geos::util::GEOSException &exc) {
+        HandleError(snlist, "Joining overlap tiles failed: " + QString(exc.what()) +
+                            ". The overlap is not joined.");
+      }
+      catch (IException &e) {
+        HandleError(e, snlist, "Joining overlap tiles failed. The overlap is not joined.");
+      }
+
+      if (polygon == NULL) {
+        std::vector<geos::geom::Geometry *> *copies = new std::vector<geos::geom::Geometry *>;
+        for (unsigned int p = 0; p < pieces[j].size(); p++) {
+          copies->push_back(p_factory->createGeometry(pieces[j][p]));
+        }
+        polygon = p_factory->createMultiPolygon(copies);
+      }
+      else {
+        try {
+          geos::geom::MultiPolygon *despiked = PolygonTools::Despike(polygon);
+          delete polygon;
+          polygon = despiked;
+        }
+        catch (IException &) {
+        }
+      }
+
+      joined[j]->SetPolygon(polygon);
+      delete polygon;
+      if (joined[j]->Size() > 1) foundOverlap = true;
     }
 
-    p_calculatedSoFar = p_lonLatOverlaps.size();
-    delete emptyPolygon;
+    for (int t = 0; t < tiles.size(); t++) {
+      delete tiles[t].overlaps;
+    }
 
     // Do not write empty overlap files
     if (foundOverlap == false) {
-      p_lonLatOverlapsMutex.lock();
-      p_lonLatOverlaps.clear();
-      p_lonLatOverlapsMutex.unlock();
+      for (int j = 0; j < joined.size(); j++) {
+        delete joined[j];
+      }
+      joined.clear();
+    }
+
+    p_lonLatOverlapsMutex.lock();
+    for (int i = 0; i < p_lonLatOverlaps.size(); i++) {
+      delete p_lonLatOverlaps[i];
     }
+    p_lonLatOverlaps = joined;
+    p_lonLatOverlapsMutex.unlock();
+
+    p_calculatedSoFar = p_lonLatOverlaps.size();
 
     // unblock the writing process
-    // Check first if the the thread is still locked
-    // to avoid undefined behavior
     p_calculatePolygonMutex.tryLock();
     p_calculatePolygonMutex.unlock();
   }
 
 
+  /**
+   * Index the overlaps before they are compared. Each overlap is owned by its own footprint,
+   * and the footprint envelopes are added to the footprint index.
+   *
+   * @param footprintIndex The index of the footprint envelopes
+   */
+  void ImageOverlapSet::IndexOverlaps(geos::index::strtree::STRtree &footprintIndex) {
+    int size = p_lonLatOverlaps.size();
+    p_overlapIds.resize(size);
+    p_overlapOrder.resize(size);
+    p_overlapOwner.resize(size);
+    p_overlapActive.assign(size, true);
+    p_footprintEnvelopes.resize(size);
+    p_footprintOverlaps.assign(size, std::vector<int>());
+    p_unindexedOverlaps.clear();
+
+    for (int i = 0; i < size; i++) {
+      p_overlapIds[i] = i;
+      p_overlapOrder[i] = (qint64) i << 32;
+      p_overlapOwner[i] = i;
+      p_footprintOverlaps[i].push_back(i);
+
+      // Empty polygons are removed when they are compared, so they are always candidates
+      const geos::geom::MultiPolygon *poly = p_lonLatOverlaps[i]->Polygon();
+      if (!poly->isEmpty() && poly->getArea() >= 1.0e-14) {
+        p_footprintEnvelopes[i] = *poly->getEnvelopeInternal();
+      }
+    }
+
+    // The envelopes are not moved once they are in the index
+    for (int i = 0; i < size; i++) {
+      if (p_footprintEnvelopes[i].isNull()) {
+        p_overlapOwner[i] = -1;
+        p_unindexedOverlaps.push_back(i);
+      }
+      else {
+        footprintIndex.insert(&p_footprintEnvelopes[i], &p_footprintOverlaps[i]);
+      }
+    }
+  }
+
+
+  /**
+   * Stop indexing the overlap at a position if its polygon is empty or no longer inside the
+   * envelope of its owner. This is called whenever the polygon of an overlap changes.
+   *
+   * @param position The position of the overlap in p_lonLatOverlaps
+   */
+  void ImageOverlapSet::IndexOverlap(int position) {
+    int id = p_overlapIds[position];
+    int owner = p_overlapOwner[id];
+    if (owner < 0) return;
+
+    const geos::geom::MultiPolygon *poly = p_lonLatOverlaps[position]->Polygon();
+    if (poly->isEmpty() || poly->getArea() < 1.0e-14 ||
+        !p_footprintEnvelopes[owner].covers(*poly->getEnvelopeInternal())) {
+      p_overlapOwner[id] = -1;
+      p_unindexedOverlaps.push_back(id);
+    }
+  }
+
+
+  /**
+   * Insert a new overlap and index it. The overlap is owned by the owner of the overlap
+   * before it, which it was split from.
+   *
+   * @param position The position to insert the overlap at, after the first overlap
+   * @param overlap The overlap to insert
+   */
+  void ImageOverlapSet::InsertOverlap(int position, ImageOverlap *overlap) {
+    const qint64 spacing = (qint64) 1 << 32;
+
+    // Relabel the overlaps when there is no label left between the neighbors
+    qint64 before = p_overlapOrder[p_overlapIds[position - 1]];
+    qint64 after = (position < (int) p_overlapIds.size()) ?
+                   p_overlapOrder[p_overlapIds[position]] : before + 2 * spacing;
+    if (after - before < 2) {
+      for (unsigned int i = 0; i < p_overlapIds.size(); i++) {
+        p_overlapOrder[p_overlapIds[i]] = i * spacing;
+      }
+      before = p_overlapOrder[p_overlapIds[position - 1]];
+      after = before + spacing;
+    }
+
+    int id = p_overlapOrder.size();
+    p_overlapOrder.push_back(before + (after - before) / 2);
+    p_overlapOwner.push_back(p_overlapOwner[p_overlapIds[position - 1]]);
+    p_overlapActive.push_back(true);
+    if (p_overlapOwner[id] >= 0) {
+      p_footprintOverlaps[p_overlapOwner[id]].push_back(id);
+    }
+
+    // Insert could cause a reallocation of the overlap list, so lock it with
+    // the writing code so that we don't conflict
+    p_lonLatOverlapsMutex.lock();
+    p_lonLatOverlaps.insert(p_lonLatOverlaps.begin() + position, overlap);
+    p_lonLatOverlapsMutex.unlock();
+    p_overlapIds.insert(p_overlapIds.begin() + position, id);
+
+    IndexOverlap(position);
+  }
+
+
+  /**
+   * Erase an overlap from the list of overlaps and the index.
+   *
+   * @param position The position of the overlap in p_lonLatOverlaps
+   */
+  void ImageOverlapSet::EraseOverlap(int position) {
+    p_overlapActive[p_overlapIds[position]] = false;
+    p_overlapIds.erase(p_overlapIds.begin() + position);
+
+    p_lonLatOverlapsMutex.lock();
+    p_lonLatOverlaps.erase(p_lonLatOverlaps.begin() + position);
+    p_lonLatOverlapsMutex.unlock();
+  }
+
+
+  /**
+   * Find the position of an overlap from its order label.
+   *
+   * @param id The id of the overlap
+   * @param first The first position to search
+   *
+   * @return int The position of the overlap in p_lonLatOverlaps, or -1 if it is not at or
+   *             after first
+   */
+  int ImageOverlapSet::OverlapPosition(int id, int first) {
+    if (!p_overlapActive[id]) return -1;
+
+    qint64 order = p_overlapOrder[id];
+    std::vector<int>::const_iterator position =
+        std::lower_bound(p_overlapIds.begin() + std::min(first, (int) p_overlapIds.size()),
+                         p_overlapIds.end(), order,
+                         [this](int i, qint64 o) { return p_overlapOrder[i] < o; });
+    if (position == p_overlapIds.end() || *position != id) return -1;
+    return position - p_overlapIds.begin();
+  }
+
+
+  /**
+   * Find the overlaps after an overlap that could be changed by it, in order. These are the
+   * overlaps owned by footprints that intersect its envelope and the overlaps that are not
+   * indexed. Inactive ids are dropped from the footprint lists as they are found.
+   *
+   * @param footprintIndex The index of the footprint envelopes
+   * @param outside The position of the overlap
+   * @param candidates Returns the ids of the candidates
+   */
+  void ImageOverlapSet::OverlapCandidates(geos::index::strtree::STRtree &footprintIndex,
+                                          int outside, std::vector<int> &candidates) {
+    candidates.clear();
+    if (outside >= p_lonLatOverlaps.size() - 1) return;
+
+    std::vector<void *> footprints;
+    const geos::geom::MultiPolygon *poly = p_lonLatOverlaps.at(outside)->Polygon();
+    if (!poly->isEmpty()) {
+      footprintIndex.query(poly->getEnvelopeInternal(), footprints);
+    }
+    footprints.push_back(&p_unindexedOverlaps);
+
+    qint64 order = p_overlapOrder[p_overlapIds[outside]];
+    for (unsigned int f = 0; f < footprints.size(); f++) {
+      std::vector<int> &ids = *static_cast<std::vector<int> *>(footprints[f]);
+      unsigned int kept = 0;
+      for (unsigned int i = 0; i < ids.size(); i++) {
+        if (!p_overlapActive[ids[i]]) continue;
+        ids[kept++] = ids[i];
+        if (p_overlapOrder[ids[i]] > order) candidates.push_back(ids[i]);
+      }
+      ids.resize(kept);
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [this](int a, int b) { return p_overlapOrder[a] < p_overlapOrder[b]; });
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+  }
+
+
   /**
    * Add the serial numbers from the second overlap to the first
    *
@@ -14,6 +14,8 @@ find files of those names at the top level of this repository. **/
 #include <QThread>
 #include <QMutex>
 
+#include "geos/geom/Envelope.h"
+#include "geos/geom/GeometryFactory.h"
 #include "geos/geom/MultiPolygon.h"
 #include "geos/geom/LinearRing.h"
 #include "geos/util/GEOSException.h"
@@ -22,6 +24,14 @@ find files of those names at the top level of this repository. **/
 #include "IException.h"
 #include "PvlGroup.h"
 
+namespace geos {
+  namespace index {
+    namespace strtree {
+      class STRtree;
+    }
+  }
+}
+
 namespace Isis {
 
   // Forward declarations
@@ -92,6 +102,7 @@ namespace Isis {
       void FindImageOverlaps(std::vector<QString> sns,
                              std::vector<geos::geom::MultiPolygon *> polygons);
       void FindImageOverlaps(SerialNumberList &boundaries, QString outputFile);
+      void SetTiles(int tiles);
       void ReadImageOverlaps(const QString &filename);
       void WriteImageOverlaps(const QString &filename);
 
@@ -136,6 +147,7 @@ namespace Isis {
       }
 
       void DespikeLonLatOverlaps();
+      void FindTiledOverlaps(SerialNumberList *snlist);
 
       QList<ImageOverlap *> p_lonLatOverlaps; //!< The list of lat/lon overlaps
 
@@ -143,15 +155,44 @@ namespace Isis {
                                      geos::geom::MultiPolygon *lonLatPolygon);
 
       bool SetPolygon(geos::geom::Geometry *poly, int position, ImageOverlap *sncopy = NULL, bool insert = false);
+      void IndexOverlaps(geos::index::strtree::STRtree &footprintIndex);
+      void IndexOverlap(int position);
+      void InsertOverlap(int position, ImageOverlap *overlap);
+      void EraseOverlap(int position);
+      int OverlapPosition(int id, int first);
+      void OverlapCandidates(geos::index::strtree::STRtree &footprintIndex, int outside,
+                             std::vector<int> &candidates);
       void HandleError(IException &e, SerialNumberList *snlist, QString msg = "", int overlap1 = -1, int overlap2 = -1);
       void HandleError(geos::util::GEOSException *exc, SerialNumberList *snlist, QString msg = "", int overlap1 = -1, int overlap2 = -1);
       void HandleError(SerialNumberList *snlist, QString msg, int overlap1 = -1, int overlap2 = -1);
 
       bool p_continueAfterError; //!< If false iExceptions will be thrown from FindImageOverlaps(...)
       bool p_threadedCalculate; //!< True if we want to do calculations in a threaded way
+      int p_tiles; //!< The number of tiles along each axis, 1 if the overlaps are not tiled
+      bool p_isTile; //!< True if this set finds the overlaps of one tile
+      //! The factory of the geometries of a tile, which is only used by the tile's thread
+      geos::geom::GeometryFactory::Ptr p_tileFactory;
+      //! The factory the geometries of this set are created with
+      const geos::geom::GeometryFactory *p_factory;
       int p_writtenSoFar; //!< The index of the last overlap that is done writing (number written-1)
       int p_calculatedSoFar; //!< The index of the last overlap that is done calculating (number calculated-1)
 
+      /**
+       * These index the overlaps while FindAllOverlaps() runs. Every overlap is inside the
+       * footprint of the image it was split from, its owner, so only the overlaps owned by
+       * images whose footprint envelopes intersect an overlap can intersect it. Each overlap
+       * has an id and an order label that increases along p_lonLatOverlaps, so the position
+       * of an overlap is found by a binary search. Overlaps that are empty or not inside the
+       * envelope of their owner are not indexed and are always candidates.
+       */
+      std::vector<int> p_overlapIds; //!< The id of each overlap in p_lonLatOverlaps
+      std::vector<qint64> p_overlapOrder; //!< The order label of each id
+      std::vector<int> p_overlapOwner; //!< The owning footprint of each id, or -1 if not indexed
+      std::vector<bool> p_overlapActive; //!< False once an id is erased or done
+      std::vector<geos::geom::Envelope> p_footprintEnvelopes; //!< The envelope of each footprint
+      std::vector< std::vector<int> > p_footprintOverlaps; //!< The ids owned by each footprint
+      std::vector<int> p_unindexedOverlaps; //!< The ids that are always candidates
+
       //! This is used for multi-threaded calls to FindAllOverlaps only; this class never gets ownership of this pointer
       SerialNumberList *p_snlist;
 
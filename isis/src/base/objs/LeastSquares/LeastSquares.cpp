@@ -7,6 +7,8 @@ find files of those names at the top level of this repository. **/
 #include "jama/jama_svd.h"
 #include "jama/jama_qr.h"
 
+#include <algorithm>
+
 #include <armadillo>
 
 #include "LeastSquares.h"
@@ -201,11 +203,22 @@ namespace Isis {
    *                          all zeros.
    * @history  2010-12-12 Debbie A. Cook  Fixed "no data" test for SPARSE
    *                          case
+   *
+   * @throws Isis::IException::Programmer - SPARSE or CG on an object that
+   *                                        was not constructed as sparse
    */
   int LeastSquares::Solve(Isis::LeastSquares::SolveMethod method) {
 
-    if((method == SPARSE  &&  p_sparseRows == 0)  ||
-       (method != SPARSE  &&  Rows() == 0 )) {
+    bool sparse = (method == SPARSE || method == CG);
+    if (sparse && !p_sparse) {
+      p_solved = false;
+      QString msg = "The SPARSE and CG solve methods require a LeastSquares "
+                    "constructed with sparse set to true";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if((sparse  &&  p_sparseRows == 0)  ||
+       (!sparse  &&  Rows() == 0 )) {
       p_solved = false;
       QString msg = "No solution available because no input data was provided";
       throw IException(IException::Unknown, msg, _FILEINFO_);
@@ -217,8 +230,8 @@ namespace Isis {
     else if(method == QRD) {
       SolveQRD();
     }
-    else if(method == SPARSE) {
-      int column = SolveSparse();
+    else if(sparse) {
+      int column = SolveSparse(method);
       return column;
     }
     return 0;
@@ -407,7 +420,8 @@ namespace Isis {
    * l is the "computed - observed" column vector;
    *
    * The solution is achieved using a sparse matrix formulation of
-   * the LU decomposition of the normal equations.
+   * the LU decomposition of the normal equations, or a conjugate gradient
+   * if the method is CG.
    *
    * You can then use the Evaluate and Residual methods freely.
    *
@@ -424,8 +438,9 @@ namespace Isis {
    * @history 2010-11-20  Debbie A. Cook Merged Ken Edmundson verion with system version
    * @history 2011-03-17  Ken Edmundson Corrected computation of residuals
    *
+   * @param method SPARSE or CG
    */
-  int LeastSquares::SolveSparse() {
+  int LeastSquares::SolveSparse(Isis::LeastSquares::SolveMethod method) {
 
     // form "normal equations" matrix by multiplying ATA
     p_normals = p_sparseA.t()*p_sparseA;
@@ -453,7 +468,17 @@ namespace Isis {
       }
     }
 
-    bool status = spsolve(p_xSparse, p_normals, p_ATb, "superlu");
+    bool status;
+    if (method == CG) {
+      arma::vec x;
+      status = ConjugateGradient(p_normals, p_ATb.col(0), x);
+      if (status) {
+        p_xSparse = x;
+      }
+    }
+    else {
+      status = spsolve(p_xSparse, p_normals, p_ATb, "superlu");
+    }
 
     if (status == false) {
       QString msg = "Could not solve sparse least squares problem.";
@@ -520,6 +545,53 @@ namespace Isis {
   }
 
 
+  /**
+   * Solves symmetric positive definite normal equations with a conjugate
+   * gradient preconditioned by their diagonal. It stops when the
+   * preconditioned residual is 1e-12 of the right hand side. This is used by
+   * the CG solve method and by OverlapNormalization.
+   *
+   * @param normals  The normal equations matrix
+   * @param rhs      The right hand side of the normal equations
+   * @param solution Output solution of the normal equations
+   *
+   * @return bool False if a diagonal entry is not positive or it did not
+   *              converge
+   */
+  bool LeastSquares::ConjugateGradient(const arma::SpMat<double> &normals,
+                                       const arma::vec &rhs, arma::vec &solution) {
+    arma::vec diagonal(normals.diag());
+    if (arma::any(diagonal <= 0.0)) {
+      return false;
+    }
+
+    arma::vec x(rhs.n_elem, arma::fill::zeros);
+    arma::vec r = rhs;
+    arma::vec z = r / diagonal;
+    arma::vec p = z;
+    double rz = arma::dot(r, z);
+    double tolerance = 1e-24 * rz;
+    int maxIterations = std::max(1000, 10 * (int)rhs.n_elem);
+
+    for (int iteration = 0; rz > tolerance; iteration++) {
+      if (iteration == maxIterations) {
+        return false;
+      }
+      arma::vec q = normals * p;
+      double alpha = rz / arma::dot(p, q);
+      x += alpha * p;
+      r -= alpha * q;
+      z = r / diagonal;
+      double rzNext = arma::dot(r, z);
+      p = z + (rzNext / rz) * p;
+      rz = rzNext;
+    }
+
+    solution = x;
+    return true;
+  }
+
+
   void LeastSquares::Reset ()
   {
     if ( p_sparse ) {
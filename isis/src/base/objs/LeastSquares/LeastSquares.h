@@ -111,10 +111,13 @@ namespace Isis {
 
       enum SolveMethod { SVD,     //!<  Singular Value Decomposition
                          QRD,     //!<  QR Decomposition
-                         SPARSE   //!<  Sparse
+                         SPARSE,  //!<  Sparse
+                         CG       //!<  Conjugate gradient on the sparse normal equations
                        };
 
       int Solve(Isis::LeastSquares::SolveMethod method = SVD);
+      static bool ConjugateGradient(const arma::SpMat<double> &normals,
+                                    const arma::vec &rhs, arma::vec &solution);
       double Evaluate(const std::vector<double> &input);
       std::vector<double> Residuals() const;
       double Residual(int i) const;
@@ -144,7 +147,7 @@ namespace Isis {
       void SolveQRD();
       void SolveCholesky () {}
 
-      int SolveSparse();
+      int SolveSparse(Isis::LeastSquares::SolveMethod method = SPARSE);
       void FillSparseA(const std::vector<double> &data);
       bool ApplyParameterWeights();
 
@@ -6,7 +6,11 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 
 #include "MinimumDifference.h"
+
+#include <cmath>
+
 #include "Chip.h"
+#include "SpecialPixel.h"
 
 namespace Isis {
 
@@ -29,25 +33,25 @@ namespace Isis {
    *         met.
    */
   double MinimumDifference::MatchAlgorithm(Chip &pattern, Chip &subsearch) {
-    // calculate the sampling information
-
+    // The pixels are summed in the same order as the sample by sample loop
+    // so the fits, and the ties between them, do not change. Adding zero for
+    // special pixels instead of branching keeps the sum exact.
     double diff = 0.0;
-    double count = 0;
-    for(double l = 1.0; l <= pattern.Lines(); l++) {
-      for(double s = 1.0; s <= pattern.Samples(); s++) {
-        int line = (int)l;
-        int samp = (int)s;
+    int count = 0;
+    int samples = pattern.Samples();
+
+    for(int line = 1; line <= pattern.Lines(); line++) {
+      const double *pdn = pattern.Row(line);
+      const double *sdn = subsearch.Row(line);
 
-        double pdn = pattern.GetValue(samp, line);
-        double sdn = subsearch.GetValue(samp, line);
-        if(IsSpecial(pdn)) continue;
-        if(IsSpecial(sdn)) continue;
-        diff += fabs(pdn - sdn);
-        count++;
+      for(int samp = 0; samp < samples; samp++) {
+        bool valid = !IsSpecial(pdn[samp]) && !IsSpecial(sdn[samp]);
+        diff += valid ? fabs(pdn[samp] - sdn[samp]) : 0.0;
+        count += valid;
       }
     }
 
-    return diff / count;
+    return diff / (double)count;
   }
 
   /**
@@ -5,6 +5,10 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "MoravecOperator.h"
+
+#include <algorithm>
+#include <vector>
+
 #include "Chip.h"
 
 namespace Isis {
@@ -52,6 +56,91 @@ namespace Isis {
     return smallestInterest;
   }
 
+
+  /**
+   * This method calculates the interest of every window position in an area. For each offset
+   * the squared differences between every pixel and its offset pixel are computed once, and a
+   * box filter sums them over the windows.
+   *
+   * @param pArea         The area to calculate the interest of
+   * @param pInterest     Chip to put the interest of each window position into
+   * @param piSampleShift The sample shift of the Null part of each window
+   * @param piLineShift   The line shift of the Null part of each window
+   *
+   * @see InterestOperator::InterestImage
+   */
+  void MoravecOperator::InterestImage(Chip &pArea, Chip &pInterest, int piSampleShift,
+                                      int piLineShift) {
+    int areaSamples = pArea.Samples();
+    int areaLines = pArea.Lines();
+    int windowSamples = areaSamples - pInterest.Samples() + 1;
+    int windowLines = areaLines - pInterest.Lines() + 1;
+
+    // The part of each window that is not Null
+    int firstSamp = std::max(1, 1 - piSampleShift);
+    int lastSamp = std::min(windowSamples, windowSamples - piSampleShift);
+    int firstLine = std::max(1, 1 - piLineShift);
+    int lastLine = std::min(windowLines, windowLines - piLineShift);
+
+    std::vector<char> valid(areaSamples * areaLines);
+    for (int line = 1; line <= areaLines; line++) {
+      const double *row = pArea.Row(line);
+      for (int samp = 0; samp < areaSamples; samp++) {
+        valid[(line - 1) * areaSamples + samp] = ValidDnValue(row[samp]);
+      }
+    }
+
+    std::vector<double> differences(areaSamples * areaLines);
+    std::vector<double> sums;
+    bool first = true;
+    for (int offX = -1; offX <= 1; offX++) {
+      for (int offY = -1; offY <= 1; offY++) {
+        if (offX == 0 && offY == 0) continue;
+
+        // Interest only compares the inner pixels of a window with offset pixels that are
+        // in the window too
+        int firstX = std::max(2, firstSamp + std::max(0, -offX));
+        int lastX = std::min(windowSamples - 1, lastSamp - std::max(0, offX));
+        int firstY = std::max(2, firstLine + std::max(0, -offY));
+        int lastY = std::min(windowLines - 1, lastLine - std::max(0, offY));
+
+        std::fill(differences.begin(), differences.end(), 0.0);
+        for (int line = std::max(1, 1 - offY); line <= std::min(areaLines, areaLines - offY);
+             line++) {
+          const double *row = pArea.Row(line);
+          const double *offRow = pArea.Row(line + offY);
+          const char *validRow = &valid[(line - 1) * areaSamples];
+          const char *validOffRow = &valid[(line + offY - 1) * areaSamples];
+          double *difference = &differences[(line - 1) * areaSamples];
+          for (int samp = std::max(0, -offX); samp < std::min(areaSamples, areaSamples - offX);
+               samp++) {
+            if (validRow[samp] && validOffRow[samp + offX]) {
+              double delta = row[samp] - offRow[samp + offX];
+              difference[samp] = delta * delta;
+            }
+          }
+        }
+
+        int boxSamples = lastX - firstX + 1;
+        int boxLines = lastY - firstY + 1;
+        BoxSum(differences, areaSamples, areaLines, boxSamples, boxLines, sums);
+
+        // Keep the smallest interest of the offsets
+        int sumSamples = areaSamples - boxSamples + 1;
+        for (int line = 1; line <= pInterest.Lines(); line++) {
+          double *interest = pInterest.Row(line);
+          const double *sum = &sums[(line + firstY - 2) * sumSamples + firstX - 1];
+          for (int samp = 0; samp < pInterest.Samples(); samp++) {
+            if (first || sum[samp] < interest[samp]) {
+              interest[samp] = sum[samp];
+            }
+          }
+        }
+        first = false;
+      }
+    }
+  }
+
   /**
   * Sets an offset to pass in larger chips if operator requires it
   * This is used to offset the subchip size passed into Interest
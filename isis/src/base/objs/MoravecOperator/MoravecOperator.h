@@ -55,6 +55,8 @@ namespace Isis {
 
     protected:
       virtual double Interest(Chip &chip);
+      virtual void InterestImage(Chip &pArea, Chip &pInterest, int piSampleShift,
+                                 int piLineShift);
       virtual int Padding();
   };
 };
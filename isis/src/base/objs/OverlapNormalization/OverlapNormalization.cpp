@@ -6,10 +6,14 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "OverlapNormalization.h"
 
+#include <algorithm>
 #include <iomanip>
 
+#include <cholmod.h>
+
 #include "BasisFunction.h"
 #include "IException.h"
+#include "IString.h"
 #include "LeastSquares.h"
 #include "Statistics.h"
 
@@ -133,6 +137,17 @@ namespace Isis {
   /**
    * Attempts to solve the least squares equation for all data sets.
    *
+   * Each overlap only relates two data sets, so the SPARSE and CG methods form the normal
+   * equations directly from the overlaps instead of building a row of the design matrix for
+   * every overlap. SPARSE factors them with a sparse Cholesky decomposition and CG solves them
+   * with a Jacobi preconditioned conjugate gradient, which only keeps the overlaps in memory
+   * and is meant for very large sets. Both weight every parameter by 1/1000, as the
+   * LeastSquares SPARSE method did for this class, so they find a solution without holds.
+   *
+   * The dense QRD and SVD methods need memory and time that grow with the square of the number
+   * of data sets, so above MaxDenseSize data sets they solve the same, unweighted normal
+   * equations with the sparse Cholesky decomposition instead.
+   *
    * @param type The enumeration clarifying whether the offset, gain, or both
    *             should be solved here
    * @param method The enumeration clarifying the LeastSquares::SolveMethod to
@@ -160,72 +175,60 @@ namespace Isis {
                    "holds must be greater than the number of input images";
       throw IException(IException::User, msg, _FILEINFO_);
     }
-    
-    if ( method == LeastSquares::SPARSE ) {
-      m_offsetLsq = NULL;
-      m_gainLsq = NULL;
-      delete m_offsetLsq;
-      delete m_gainLsq;
-      int sparseMatrixRows = m_overlapList.size() + m_idHoldList.size();
-      int sparseMatrixCols = m_offsetFunction->Coefficients();
-      m_offsetLsq = new LeastSquares(*m_offsetFunction, true, sparseMatrixRows, sparseMatrixCols, true);
-      sparseMatrixCols = m_gainFunction->Coefficients();
-      m_gainLsq = new LeastSquares(*m_gainFunction, true, sparseMatrixRows, sparseMatrixCols, true);
-      const std::vector<double> alphaWeight(sparseMatrixCols, 1/1000.0);
-      m_offsetLsq->SetParameterWeights( alphaWeight );
-      m_gainLsq->SetParameterWeights( alphaWeight );
-    }
+
+    bool dense = (method == LeastSquares::QRD || method == LeastSquares::SVD);
+    bool normalEquations = !dense || m_statsList.size() > MaxDenseSize;
+    double parameterWeight = dense ? 0.0 : 1.0 / 1000.0;
 
     // Calculate offsets
     if (type != Gains && type != GainsWithoutNormalization) {
-      // Add knowns to least squares for each overlap
-      for (int overlap = 0; overlap < (int)m_overlapList.size(); overlap++) {
-        Overlap curOverlap = m_overlapList[overlap];
-        int id1 = curOverlap.index1;
-        int id2 = curOverlap.index2;
-
-        vector<double> input;
-        input.resize(m_statsList.size());
-        for (int i = 0; i < (int)input.size(); i++) input[i] = 0.0;
-        input[id1] = 1.0;
-        input[id2] = -1.0;
-
-        m_offsetLsq->AddKnown(input, m_deltas[overlap], m_weights[overlap]);
+      if (normalEquations) {
+        m_offsets = SolveNormalEquations(m_deltas, m_weights, 1e30, parameterWeight, method);
       }
+      else {
+        // Add knowns to least squares for each overlap
+        for (int overlap = 0; overlap < (int)m_overlapList.size(); overlap++) {
+          Overlap curOverlap = m_overlapList[overlap];
+          int id1 = curOverlap.index1;
+          int id2 = curOverlap.index2;
+
+          vector<double> input;
+          input.resize(m_statsList.size());
+          for (int i = 0; i < (int)input.size(); i++) input[i] = 0.0;
+          input[id1] = 1.0;
+          input[id2] = -1.0;
+
+          m_offsetLsq->AddKnown(input, m_deltas[overlap], m_weights[overlap]);
+        }
 
-      // Add a known to the least squares for each hold image
-      for (int h = 0; h < (int)m_idHoldList.size(); h++) {
-        int hold = m_idHoldList[h];
+        // Add a known to the least squares for each hold image
+        for (int h = 0; h < (int)m_idHoldList.size(); h++) {
+          int hold = m_idHoldList[h];
 
-        vector<double> input;
-        input.resize(m_statsList.size());
-        for (int i = 0; i < (int)input.size(); i++) input[i] = 0.0;
-        input[hold] = 1.0;
-        m_offsetLsq->AddKnown(input, 0.0, 1e30);
-      }
+          vector<double> input;
+          input.resize(m_statsList.size());
+          for (int i = 0; i < (int)input.size(); i++) input[i] = 0.0;
+          input[hold] = 1.0;
+          m_offsetLsq->AddKnown(input, 0.0, 1e30);
+        }
 
-      // Solve the least squares and get the offset coefficients to apply to the
-      // images
-      m_offsets.resize(m_statsList.size());
-      m_offsetLsq->Solve(method);
-      for (int i = 0; i < m_offsetFunction->Coefficients(); i++) {
-        m_offsets[i] = m_offsetFunction->Coefficient(i);
+        // Solve the least squares and get the offset coefficients to apply to the
+        // images
+        m_offsets.resize(m_statsList.size());
+        m_offsetLsq->Solve(method);
+        for (int i = 0; i < m_offsetFunction->Coefficients(); i++) {
+          m_offsets[i] = m_offsetFunction->Coefficient(i);
+        }
       }
     }
 
     // Calculate Gains
     if (type != Offsets) {
-      // Add knowns to least squares for each overlap
+      // Find the log of the gain ratio of each overlap
+      vector<double> logRatios(m_overlapList.size());
+      vector<double> weights(m_overlapList.size());
       for (int overlap = 0; overlap < (int)m_overlapList.size(); overlap++) {
         Overlap curOverlap = m_overlapList[overlap];
-        int id1 = curOverlap.index1;
-        int id2 = curOverlap.index2;
-
-        vector<double> input;
-        input.resize(m_statsList.size());
-        for (int i = 0; i < (int)input.size(); i++) input[i] = 0.0;
-        input[id1] = 1.0;
-        input[id2] = -1.0;
 
         double tanp;
 
@@ -248,36 +251,253 @@ namespace Isis {
         }
 
         if (tanp > 0.0) {
-          m_gainLsq->AddKnown(input, log(tanp), m_weights[overlap]);
+          logRatios[overlap] = log(tanp);
+          weights[overlap] = m_weights[overlap];
         }
         else {
-          m_gainLsq->AddKnown(input, 0.0, 1e10); // Set gain to 1.0
+          logRatios[overlap] = 0.0; // Set gain to 1.0
+          weights[overlap] = 1e10;
         }
       }
 
-      // Add a known to the least squares for each hold image
-      for (int h = 0; h < (int)m_idHoldList.size(); h++) {
-        int hold = m_idHoldList[h];
+      vector<double> logGains;
+      if (normalEquations) {
+        logGains = SolveNormalEquations(logRatios, weights, 1e10, parameterWeight, method);
+      }
+      else {
+        // Add knowns to least squares for each overlap
+        for (int overlap = 0; overlap < (int)m_overlapList.size(); overlap++) {
+          Overlap curOverlap = m_overlapList[overlap];
+          int id1 = curOverlap.index1;
+          int id2 = curOverlap.index2;
+
+          vector<double> input;
+          input.resize(m_statsList.size());
+          for (int i = 0; i < (int)input.size(); i++) input[i] = 0.0;
+          input[id1] = 1.0;
+          input[id2] = -1.0;
+
+          m_gainLsq->AddKnown(input, logRatios[overlap], weights[overlap]);
+        }
+
+        // Add a known to the least squares for each hold image
+        for (int h = 0; h < (int)m_idHoldList.size(); h++) {
+          int hold = m_idHoldList[h];
+
+          vector<double> input;
+          input.resize(m_statsList.size());
+          for (int i = 0; i < (int)input.size(); i++) input[i] = 0.0;
+          input[hold] = 1.0;
+          m_gainLsq->AddKnown(input, 0.0, 1e10);
+        }
 
-        vector<double> input;
-        input.resize(m_statsList.size());
-        for (int i = 0; i < (int)input.size(); i++) input[i] = 0.0;
-        input[hold] = 1.0;
-        m_gainLsq->AddKnown(input, 0.0, 1e10);
+        // Solve the least squares and get the gain coefficients to apply to the
+        // images
+        m_gainLsq->Solve(method);
+        for (int i = 0; i < m_gainFunction->Coefficients(); i++) {
+          logGains.push_back(m_gainFunction->Coefficient(i));
+        }
       }
 
-      // Solve the least squares and get the gain coefficients to apply to the
-      // images
       m_gains.resize(m_statsList.size());
-      m_gainLsq->Solve(method);
-      for (int i = 0; i < m_gainFunction->Coefficients(); i++) {
-        m_gains[i] = exp(m_gainFunction->Coefficient(i));
+      for (int i = 0; i < (int)logGains.size(); i++) {
+        m_gains[i] = exp(logGains[i]);
       }
     }
 
     m_solved = true;
   }
 
+
+  /**
+   * Solves the normal equations of the overlaps for one correction, either the offsets or the
+   * logs of the gains.
+   *
+   * The row of the design matrix for an overlap is 1 for its first data set and -1 for its
+   * second, so the overlap adds its weight to the two diagonal entries of the normal equations
+   * and subtracts it from the entry that relates them. A hold adds its weight to the diagonal
+   * entry of the held data set and pulls its correction towards 0.
+   *
+   * @param expected The expected difference of the corrections of each overlap
+   * @param weights The weight of each overlap
+   * @param holdWeight The weight of each hold
+   * @param parameterWeight The weight added to the diagonal entry of every data set
+   * @param method CG solves with a Jacobi preconditioned conjugate gradient, anything else
+   *               with a sparse Cholesky decomposition
+   *
+   * @return vector<double> The correction of each data set
+   *
+   * @throws Isis::IException::Unknown - The normal equations are not positive definite
+   * @throws Isis::IException::Unknown - The conjugate gradient did not converge
+   */
+  vector<double> OverlapNormalization::SolveNormalEquations(const vector<double> &expected,
+                                                            const vector<double> &weights,
+                                                            double holdWeight,
+                                                            double parameterWeight,
+                                                            LeastSquares::SolveMethod method) const {
+    int size = m_statsList.size();
+    vector<double> diagonal(size, parameterWeight);
+    vector<double> rhs(size, 0.0);
+    for (int overlap = 0; overlap < (int)m_overlapList.size(); overlap++) {
+      int id1 = m_overlapList[overlap].index1;
+      int id2 = m_overlapList[overlap].index2;
+      if (id1 == id2) continue;
+      diagonal[id1] += weights[overlap];
+      diagonal[id2] += weights[overlap];
+      rhs[id1] += weights[overlap] * expected[overlap];
+      rhs[id2] -= weights[overlap] * expected[overlap];
+    }
+    for (int h = 0; h < (int)m_idHoldList.size(); h++) {
+      diagonal[m_idHoldList[h]] += holdWeight;
+    }
+
+    if (method == LeastSquares::CG) {
+      return ConjugateGradient(weights, diagonal, rhs);
+    }
+
+    cholmod_common common;
+    cholmod_start(&common);
+    common.print = 0;
+    common.nmethods = 1;
+    common.method[0].ordering = CHOLMOD_AMD;
+
+    // Only the lower triangle is stored, and duplicate entries are summed
+    cholmod_triplet *triplet = cholmod_allocate_triplet(size, size,
+                                                        size + m_overlapList.size(),
+                                                        -1, CHOLMOD_REAL, &common);
+    if (!triplet) {
+      cholmod_finish(&common);
+      string msg = "Unable to allocate the normal equations of the overlaps.";
+      throw IException(IException::Unknown, msg, _FILEINFO_);
+    }
+    int *rows = (int *) triplet->i;
+    int *columns = (int *) triplet->j;
+    double *values = (double *) triplet->x;
+    for (int i = 0; i < size; i++) {
+      rows[i] = i;
+      columns[i] = i;
+      values[i] = diagonal[i];
+    }
+    int entry = size;
+    for (int overlap = 0; overlap < (int)m_overlapList.size(); overlap++) {
+      int id1 = m_overlapList[overlap].index1;
+      int id2 = m_overlapList[overlap].index2;
+      if (id1 == id2) continue;
+      rows[entry] = max(id1, id2);
+      columns[entry] = min(id1, id2);
+      values[entry] = -weights[overlap];
+      entry++;
+    }
+    triplet->nnz = entry;
+
+    cholmod_sparse *normals = cholmod_triplet_to_sparse(triplet, triplet->nnz, &common);
+    cholmod_free_triplet(&triplet, &common);
+
+    cholmod_factor *factor = NULL;
+    if (normals) {
+      factor = cholmod_analyze(normals, &common);
+    }
+    if (factor) {
+      cholmod_factorize(normals, factor, &common);
+    }
+    if (!factor || common.status < CHOLMOD_OK || common.status == CHOLMOD_NOT_POSDEF) {
+      bool notPositiveDefinite = (common.status == CHOLMOD_NOT_POSDEF);
+      cholmod_free_factor(&factor, &common);
+      cholmod_free_sparse(&normals, &common);
+      cholmod_finish(&common);
+
+      string msg = "Unable to factor the normal equations of the overlaps.";
+      if (notPositiveDefinite) {
+        msg += " They are not positive definite, so some images are not tied to a held image.";
+      }
+      throw IException(IException::Unknown, msg, _FILEINFO_);
+    }
+
+    cholmod_dense *b = cholmod_zeros(size, 1, CHOLMOD_REAL, &common);
+    cholmod_dense *x = NULL;
+    if (b) {
+      copy(rhs.begin(), rhs.end(), (double *) b->x);
+      x = cholmod_solve(CHOLMOD_A, factor, b, &common);
+    }
+
+    vector<double> solution;
+    if (x) {
+      solution.assign((double *) x->x, (double *) x->x + size);
+    }
+
+    cholmod_free_dense(&x, &common);
+    cholmod_free_dense(&b, &common);
+    cholmod_free_factor(&factor, &common);
+    cholmod_free_sparse(&normals, &common);
+    cholmod_finish(&common);
+
+    if (solution.empty()) {
+      string msg = "Unable to solve the normal equations of the overlaps.";
+      throw IException(IException::Unknown, msg, _FILEINFO_);
+    }
+    return solution;
+  }
+
+
+  /**
+   * Solves the normal equations of the overlaps with LeastSquares::ConjugateGradient. The
+   * normal equations are only stored as a sparse matrix with an entry for each data set and
+   * two for each overlap.
+   *
+   * @param weights The weight of each overlap
+   * @param diagonal The diagonal of the normal equations, including the holds
+   * @param rhs The right hand side of the normal equations
+   *
+   * @return vector<double> The correction of each data set
+   *
+   * @throws Isis::IException::Unknown - A data set has no overlaps or holds
+   * @throws Isis::IException::Unknown - The conjugate gradient did not converge
+   */
+  vector<double> OverlapNormalization::ConjugateGradient(const vector<double> &weights,
+                                                         const vector<double> &diagonal,
+                                                         const vector<double> &rhs) const {
+    int size = rhs.size();
+    for (int i = 0; i < size; i++) {
+      if (diagonal[i] <= 0.0) {
+        string msg = "Unable to solve the normal equations of the overlaps with a conjugate "
+                     "gradient. Image [" + toString(i) + "] has no overlaps or holds.";
+        throw IException(IException::Unknown, msg, _FILEINFO_);
+      }
+    }
+
+    // Duplicate entries are summed
+    arma::umat locations(2, size + 2 * m_overlapList.size());
+    arma::vec values(locations.n_cols);
+    for (int i = 0; i < size; i++) {
+      locations(0, i) = i;
+      locations(1, i) = i;
+      values(i) = diagonal[i];
+    }
+    int entry = size;
+    for (int overlap = 0; overlap < (int)m_overlapList.size(); overlap++) {
+      int id1 = m_overlapList[overlap].index1;
+      int id2 = m_overlapList[overlap].index2;
+      if (id1 == id2) continue;
+      locations(0, entry) = id1;
+      locations(1, entry) = id2;
+      values(entry++) = -weights[overlap];
+      locations(0, entry) = id2;
+      locations(1, entry) = id1;
+      values(entry++) = -weights[overlap];
+    }
+    arma::SpMat<double> normals(true, locations.cols(0, entry - 1), values.subvec(0, entry - 1),
+                                size, size);
+
+    arma::vec x;
+    if (!LeastSquares::ConjugateGradient(normals, arma::vec(rhs), x)) {
+      string msg = "The conjugate gradient did not converge after [" +
+                   toString(max(1000, 10 * size)) + "] iterations. You may want to try "
+                   "another LeastSquares::SolveMethod.";
+      throw IException(IException::Unknown, msg, _FILEINFO_);
+    }
+    return arma::conv_to< vector<double> >::from(x);
+  }
+
   /**
    * Returns the calculated average DN value for the given
    * data set
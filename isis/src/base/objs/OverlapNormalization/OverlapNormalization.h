@@ -35,6 +35,11 @@ namespace Isis {
    * where i is the index of a known data set from the statistics
    * list.
    *
+   * Every overlap only relates two data sets, so the SPARSE and CG
+   * solve methods form the sparse normal equations directly from the
+   * overlaps. The dense QRD and SVD methods are only used for up to
+   * MaxDenseSize data sets.
+   *
    * @author 2009-05-07 Travis Addair
    *
    * @internal
@@ -61,6 +66,13 @@ namespace Isis {
   class OverlapNormalization {
     public:
 
+      /**
+       * The largest number of data sets that the dense QRD and SVD
+       * methods solve. Larger sets are solved with the sparse normal
+       * equations.
+       */
+      static const unsigned int MaxDenseSize = 1000;
+
       OverlapNormalization(std::vector<Statistics *> statsList);
 
       virtual ~OverlapNormalization();
@@ -145,6 +157,13 @@ namespace Isis {
       double Evaluate(double dn, unsigned index) const;
 
     private:
+      std::vector<double> SolveNormalEquations(const std::vector<double> &expected,
+                                               const std::vector<double> &weights,
+                                               double holdWeight, double parameterWeight,
+                                               LeastSquares::SolveMethod method) const;
+      std::vector<double> ConjugateGradient(const std::vector<double> &weights,
+                                            const std::vector<double> &diagonal,
+                                            const std::vector<double> &rhs) const;
 
       /**
        * Vector of Statistics objects for each data set
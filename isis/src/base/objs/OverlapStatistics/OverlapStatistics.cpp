@@ -44,12 +44,15 @@ namespace Isis {
    *         for indicating progress during statistic gathering
    * @param sampPercent (Default value of 100.0) Sampling percent, or the percentage
    *       of lines to consider during the statistic gathering procedure
+   * @param displayProgress (Default value of true) Whether to display the progress. Statistics
+   *       gathered on other threads should not display it.
    *
    * @throws Isis::IException::User - All images must have the same number of
    *                                  bands
    */
   OverlapStatistics::OverlapStatistics(Isis::Cube &x, Isis::Cube &y,
-                                       QString progressMsg, double sampPercent) {
+                                       QString progressMsg, double sampPercent,
+                                       bool displayProgress) {
 
     init();
 
@@ -123,6 +126,7 @@ namespace Isis {
       // Print percent processed
       Progress progress;
       progress.SetText(progressMsg);
+      if (!displayProgress) progress.DisableAutomaticDisplay();
 
       int linc = (int)(100.0 / sampPercent + 0.5); // Calculate our line increment
 
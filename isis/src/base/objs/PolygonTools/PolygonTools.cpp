@@ -357,7 +357,7 @@ namespace Isis {
     for(unsigned int i = 0; i < mpolygon->getNumGeometries(); ++i) {
       polys->push_back((mpolygon->getGeometryN(i))->clone());
     }
-    return globalFactory->createMultiPolygon(polys);
+    return mpolygon->getFactory()->createMultiPolygon(polys);
   }
 
 
@@ -379,7 +379,7 @@ namespace Isis {
     for(unsigned int i = 0; i < mpolygon.getNumGeometries(); ++i) {
       polys->push_back((mpolygon.getGeometryN(i))->clone());
     }
-    return globalFactory->createMultiPolygon(polys);
+    return mpolygon.getFactory()->createMultiPolygon(polys);
   }
 
 
@@ -722,7 +722,7 @@ namespace Isis {
 
       // Create a new polygon with the holes and save it
       if(!lr->isEmpty()) {
-        geos::geom::Polygon *tp = Isis::globalFactory->createPolygon(lr, holes);
+        geos::geom::Polygon *tp = multiPoly->getFactory()->createPolygon(lr, holes);
 
         if(tp->isEmpty() || !tp->isValid()) {
           delete tp;
@@ -735,7 +735,7 @@ namespace Isis {
     } // End polygons loop
 
     // Create a new multipoly from the polygon(s)
-    geos::geom::MultiPolygon *mp = Isis::globalFactory->createMultiPolygon(newPolys);
+    geos::geom::MultiPolygon *mp = multiPoly->getFactory()->createMultiPolygon(newPolys);
 
     if(!mp->isValid() || mp->isEmpty()) {
       delete mp;
@@ -775,7 +775,7 @@ namespace Isis {
     // We need a full polygon to despike = 3 points (+1 for end==first) = at least 4 points
     if(vertices->getSize() < 4) {
       delete vertices;
-      return Isis::globalFactory->createLinearRing(geos::geom::CoordinateArraySequence());
+      return lineString->getFactory()->createLinearRing(geos::geom::CoordinateArraySequence());
     }
 
     // delete one of the duplicate first/end coordinates,
@@ -814,7 +814,8 @@ namespace Isis {
       // Test the middle point for a spike
       if(IsSpiked(vertices->getAt(testCoords[0]),
                   vertices->getAt(testCoords[1]),
-                  vertices->getAt(testCoords[2]))) {
+                  vertices->getAt(testCoords[2]),
+                  lineString->getFactory())) {
         // It's spiked, delete it
         vertices->deleteAt(testCoords[1]);
 
@@ -827,12 +828,12 @@ namespace Isis {
       delete vertices;
       vertices = NULL;
 
-      return Isis::globalFactory->createLinearRing(geos::geom::CoordinateArraySequence());
+      return lineString->getFactory()->createLinearRing(geos::geom::CoordinateArraySequence());
     }
     else {
       // Duplicate the first vertex as the last to close the polygon
       vertices->add(vertices->getAt(0));
-      return Isis::globalFactory->createLinearRing(vertices);
+      return lineString->getFactory()->createLinearRing(vertices);
     }
   }
 
@@ -842,13 +843,15 @@ namespace Isis {
    * @param first
    * @param middle
    * @param last
+   * @param factory The factory of the geometry being despiked
    *
    * @return bool Returns true if middle point is spiked
    */
   bool PolygonTools::IsSpiked(geos::geom::Coordinate first, 
                               geos::geom::Coordinate middle, 
-                              geos::geom::Coordinate last) {
-    return TestSpiked(first, middle, last) || TestSpiked(last, middle, first);
+                              geos::geom::Coordinate last,
+                              const geos::geom::GeometryFactory *factory) {
+    return TestSpiked(first, middle, last, factory) || TestSpiked(last, middle, first, factory);
   }
 
   /**
@@ -876,19 +879,21 @@ namespace Isis {
    * @param first
    * @param middle
    * @param last
+   * @param factory The factory to create the test geometries with
    *
    * @return bool Returns true if middle point spiked given this first/last pt
    */
   bool PolygonTools::TestSpiked(geos::geom::Coordinate first, geos::geom::Coordinate middle, 
-                                geos::geom::Coordinate last) {
-    geos::geom::Point *firstPt = Isis::globalFactory->createPoint(first);
-    geos::geom::Point *middlePt = Isis::globalFactory->createPoint(middle);
-    geos::geom::Point *lastPt = Isis::globalFactory->createPoint(last);
+                                geos::geom::Coordinate last,
+                                const geos::geom::GeometryFactory *factory) {
+    geos::geom::Point *firstPt = factory->createPoint(first);
+    geos::geom::Point *middlePt = factory->createPoint(middle);
+    geos::geom::Point *lastPt = factory->createPoint(last);
 
     geos::geom::CoordinateSequence *coords = new geos::geom::CoordinateArraySequence();
     coords->add(first);
     coords->add(middle);
-    geos::geom::LineString *line = Isis::globalFactory->createLineString(coords); // line takes ownership
+    geos::geom::LineString *line = factory->createLineString(coords); // line takes ownership
 
     // The lower the tolerance, the less this algorithm removes and thus
     //   the better chance of success in findimageoverlaps. However, if you
@@ -922,11 +927,11 @@ namespace Isis {
       coords->add(first);
 
       // shell takes ownership of coords
-      geos::geom::LinearRing *shell = Isis::globalFactory->createLinearRing(coords);
+      geos::geom::LinearRing *shell = factory->createLinearRing(coords);
       std::vector<geos::geom::Geometry *> *empty = new std::vector<geos::geom::Geometry *>;
 
       // poly takes ownership of shell and empty
-      geos::geom::Polygon *poly = Isis::globalFactory->createPolygon(shell, empty);
+      geos::geom::Polygon *poly = factory->createPolygon(shell, empty);
 
 
       // if these 3 points define a straight line then the middle is worthless (defines nothing) 
@@ -1136,7 +1141,7 @@ namespace Isis {
       fixedpoly = NULL;
     }
 
-    geos::geom::MultiPolygon *mp = Isis::globalFactory->createMultiPolygon(newPolys);
+    geos::geom::MultiPolygon *mp = poly->getFactory()->createMultiPolygon(newPolys);
     return mp;
   }
 
@@ -1179,7 +1184,7 @@ namespace Isis {
         throw IException(IException::Programmer, msg, _FILEINFO_);
       }
 
-      return globalFactory->createPolygon(newExterior, holes);
+      return poly->getFactory()->createPolygon(newExterior, holes);
     }
     catch (IException &e) {
       IString msg = "Failed when attempting to fix exterior ring of polygon";
@@ -1209,7 +1214,7 @@ namespace Isis {
 
     // Check this, just in case
     if(coords->getSize() < 4) {
-      return globalFactory->createLinearRing(new geos::geom::DefaultCoordinateSequence());
+      return ring->getFactory()->createLinearRing(new geos::geom::DefaultCoordinateSequence());
     }
 
     geos::geom::CoordinateSequence *newCoords = new geos::geom::DefaultCoordinateSequence();
@@ -1261,7 +1266,7 @@ namespace Isis {
     // Now that we've weeded out any bad coordinates, let's rebuild the geometry
     try {
       if(newCoords->getSize() > 3) {
-        newRing = globalFactory->createLinearRing(newCoords);
+        newRing = ring->getFactory()->createLinearRing(newCoords);
       }
       else {
         delete newCoords;
@@ -1364,16 +1369,20 @@ namespace Isis {
    * multipolygon. The original geometry is deleted. The resulting multipolygon is
    * not necessarily valid.
    *
+   * The multipolygon is created with the factory of the geometry, like the results of the other
+   * methods that copy, despike, fix or reduce the precision of geometries. Geometries can then
+   * be processed on several threads at once as long as each thread uses its own factory.
+   *
    * @param geom The geometry to be converted into a multipolygon
    */
   geos::geom::MultiPolygon *PolygonTools::MakeMultiPolygon(const geos::geom::Geometry *geom) {
     // The area of the geometry is too small, so just ignore it.
     if(geom->isEmpty()) {
-      return Isis::globalFactory->createMultiPolygon();
+      return geom->getFactory()->createMultiPolygon();
     }
 
     else if(geom->getArea() - DBL_EPSILON <= DBL_EPSILON) {
-      return Isis::globalFactory->createMultiPolygon();
+      return geom->getFactory()->createMultiPolygon();
     }
 
     else if(geom->getGeometryTypeId() == geos::geom::GEOS_MULTIPOLYGON) {
@@ -1383,7 +1392,7 @@ namespace Isis {
     else if(geom->getGeometryTypeId() == geos::geom::GEOS_POLYGON) {
       vector<geos::geom::Geometry *> *polys = new vector<geos::geom::Geometry *>;
       polys->push_back(geom->clone());
-      geos::geom::MultiPolygon *mp = Isis::globalFactory->createMultiPolygon(polys);
+      geos::geom::MultiPolygon *mp = geom->getFactory()->createMultiPolygon(polys);
       return mp;
     }
 
@@ -1407,10 +1416,10 @@ namespace Isis {
       }
 
       geos::geom::MultiPolygon *mp =
-          Isis::globalFactory->createMultiPolygon(polys);
+          geom->getFactory()->createMultiPolygon(polys);
       if(mp->getArea() - DBL_EPSILON <= DBL_EPSILON) {
         delete mp;
-        mp = Isis::globalFactory->createMultiPolygon();
+        mp = geom->getFactory()->createMultiPolygon();
       }
 
       return mp;
@@ -1418,7 +1427,7 @@ namespace Isis {
 
     // All other geometry types are invalid so ignore them
     else {
-      return Isis::globalFactory->createMultiPolygon();
+      return geom->getFactory()->createMultiPolygon();
     }
   }
 
@@ -1615,7 +1624,7 @@ namespace Isis {
       }
     }
 
-    geos::geom::MultiPolygon *mp = Isis::globalFactory->createMultiPolygon(newPolys);
+    geos::geom::MultiPolygon *mp = poly->getFactory()->createMultiPolygon(newPolys);
     return mp;
   }
 
@@ -1675,7 +1684,7 @@ namespace Isis {
         throw IException(IException::Programmer, msg, _FILEINFO_);
       }
 
-      return globalFactory->createPolygon(newExterior, holes);
+      return poly->getFactory()->createPolygon(newExterior, holes);
     }
     catch(IException &e) {
       IString msg = "Failed when attempting to fix exterior ring of polygon";
@@ -1721,7 +1730,7 @@ namespace Isis {
 
     // Now that we've weeded out any bad coordinates, let's rebuild the geometry
     try {
-      newRing = globalFactory->createLinearRing(newCoords);
+      newRing = ring->getFactory()->createLinearRing(newCoords);
     }
     catch(geos::util::GEOSException *exc) {
       delete exc;
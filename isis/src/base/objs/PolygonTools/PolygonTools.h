@@ -195,10 +195,12 @@ namespace Isis {
     private:
       //! Returns true if the middle point is spiked
       static bool IsSpiked(geos::geom::Coordinate first,
-                           geos::geom::Coordinate middle, geos::geom::Coordinate last);
+                           geos::geom::Coordinate middle, geos::geom::Coordinate last,
+                           const geos::geom::GeometryFactory *factory);
       //! Used by IsSpiked to directionally test (first/last matter) the spike
       static bool TestSpiked(geos::geom::Coordinate first, geos::geom::Coordinate middle,
-                             geos::geom::Coordinate last);
+                             geos::geom::Coordinate last,
+                             const geos::geom::GeometryFactory *factory);
 
       static geos::geom::Geometry     *FixGeometry(const geos::geom::Geometry *geom);
       static geos::geom::MultiPolygon *FixGeometry(const geos::geom::MultiPolygon *poly);
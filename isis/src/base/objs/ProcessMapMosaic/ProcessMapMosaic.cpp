@@ -66,19 +66,78 @@ namespace Isis {
     inCube->addCachingAlgorithm(new UniqueIOCachingAlgorithm(2));
 
     Cube *mosaicCube = OutputCubes[0];
-    Projection *iproj = inCube->projection();
+    QList<QPoint> locations = MosaicLocations(*inCube);
+
+    if (locations.isEmpty()) {
+      // Add a PvlKeyword naming which files are not included in output mosaic
+      ClearInputCubes();
+      return false;
+    }
+    else {
+      // Place the input in the mosaic
+      Progress()->SetText("Mosaicking " + FileName(inputFile).name());
+
+      try {
+        for (int i = 0; i < locations.size(); i++) {
+          int outBand = 1;
+
+          ProcessMosaic::StartProcess(locations[i].x(), locations[i].y(), outBand);
+          // Reset the creation flag to ensure that the data within the tracking cube written from
+          // this call of StartProcess isn't over-written in the next. This needs to occur since the 
+          // tracking cube is created in ProcessMosaic if the m_createOutputMosaic flag is set to 
+          // true and the cube would then be completely re-created (setting all pixels to Null).
+          ProcessMosaic::SetCreateFlag(false);
+        }
+      }
+      catch (IException &e) {
+        QString msg = "Unable to mosaic cube [" + FileName(inputFile).name() + "]";
+        throw IException(e, IException::User, msg, _FILEINFO_);
+      }
+    }
+
+    WriteHistory(*mosaicCube);
+
+    // Don't propagate any more histories now that we've done one
+    p_propagateHistory = false;
+
+    ClearInputCubes();
+
+    return true;
+  }
+
+
+  /**
+   * Finds where an input cube is placed in the mosaic. The location of the first pixel of the
+   * input is returned for each time it is placed, which is more than once for equatorial
+   * cylindrical projections when the input wraps around the mosaic. The locations are not
+   * clipped to the mosaic, so they can be less than 1.
+   *
+   * @param inputCube The input cube, with the same mapping group as the mosaic
+   *
+   * @return QList<QPoint> The mosaic sample (x) and line (y) of the first pixel of the input
+   *                       for each placement. It is empty if the input is outside of the mosaic.
+   *
+   * @throws IException::User "Mapping groups do not match between cube and mosaic"
+   */
+  QList<QPoint> ProcessMapMosaic::MosaicLocations(Cube &inputCube) {
+    if (OutputCubes.size() == 0) {
+      QString msg = "An output cube must be set before calling MosaicLocations";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    Cube *mosaicCube = OutputCubes[0];
+    Projection *iproj = inputCube.projection();
     Projection *oproj = mosaicCube->projection();
     int nsMosaic = mosaicCube->sampleCount();
     int nlMosaic = mosaicCube->lineCount();
 
     if (*iproj != *oproj) {
-      QString msg = "Mapping groups do not match between cube [" + inputFile + "] and mosaic";
+      QString msg = "Mapping groups do not match between cube [" + inputCube.fileName() +
+                    "] and mosaic";
       throw IException(IException::User, msg, _FILEINFO_);
     }
 
     int outSample, outSampleEnd, outLine, outLineEnd;
-    
-    
     if (oproj->ToWorldX(iproj->ToProjectionX(1.0)) < 0) {
       outSample = (int)(oproj->ToWorldX(iproj->ToProjectionX(1.0)) - 0.5);
     }
@@ -92,8 +151,8 @@ namespace Isis {
       outLine   = (int)(oproj->ToWorldY(iproj->ToProjectionY(1.0)) + 0.5);
     }
     
-    int ins = InputCubes[0]->sampleCount();
-    int inl =  InputCubes[0]->lineCount();
+    int ins = inputCube.sampleCount();
+    int inl = inputCube.lineCount();
     outSampleEnd = outSample + ins;
     outLineEnd   = outLine + inl;
 
@@ -144,46 +203,21 @@ namespace Isis {
       inl = nlMosaic - outLine + 1;
     }
 
+    QList<QPoint> locations;
     if (outSampleEnd < 1 || outLineEnd < 1 || outSample > nsMosaic || outLine > nlMosaic || ins < 1 || inl < 1) {
-      // Add a PvlKeyword naming which files are not included in output mosaic
-      ClearInputCubes();
-      return false;
+      return locations;
     }
-    else {
-      // Place the input in the mosaic
-      Progress()->SetText("Mosaicking " + FileName(inputFile).name());
 
-      try {
-        do {
-          int outBand = 1;
-          
-          ProcessMosaic::StartProcess(outSample, outLine, outBand);
-          // Reset the creation flag to ensure that the data within the tracking cube written from
-          // this call of StartProcess isn't over-written in the next. This needs to occur since the 
-          // tracking cube is created in ProcessMosaic if the m_createOutputMosaic flag is set to 
-          // true and the cube would then be completely re-created (setting all pixels to Null).
-          ProcessMosaic::SetCreateFlag(false);
+    do {
+      locations.append(QPoint(outSample, outLine));
 
-          // Increment for projections where occurrances may happen multiple times
-          outSample += worldSize;
-          outSampleEnd += worldSize;
-        }
-        while (wrapPossible && outSample < nsMosaic);
-      }
-      catch (IException &e) {
-        QString msg = "Unable to mosaic cube [" + FileName(inputFile).name() + "]";
-        throw IException(e, IException::User, msg, _FILEINFO_);
-      }
+      // Increment for projections where occurrances may happen multiple times
+      outSample += worldSize;
+      outSampleEnd += worldSize;
     }
+    while (wrapPossible && outSample < nsMosaic);
 
-    WriteHistory(*mosaicCube);
-
-    // Don't propagate any more histories now that we've done one
-    p_propagateHistory = false;
-
-    ClearInputCubes();
-
-    return true;
+    return locations;
   }
 
 
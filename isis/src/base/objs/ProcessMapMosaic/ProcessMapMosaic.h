@@ -6,6 +6,9 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <QList>
+#include <QPoint>
+
 #include "ProcessMosaic.h"
 #include "Buffer.h"
 #include "FileList.h"
@@ -147,6 +150,8 @@ namespace Isis {
       using Isis::ProcessMosaic::StartProcess;
       virtual bool StartProcess(QString inputFile);
 
+      QList<QPoint> MosaicLocations(Cube &inputCube);
+
     private:
       static void FillNull(Buffer &data);
 
@@ -6,6 +6,12 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Preference.h"
 
+#include <QFuture>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QVector>
+#include <QtConcurrentMap>
+
 #include "Application.h"
 #include "IException.h"
 #include "IString.h"
@@ -16,6 +22,7 @@ find files of those names at the top level of this repository. **/
 #include "SpecialPixel.h"
 #include "Table.h"
 #include "TrackingTable.h"
+#include "UniqueIOCachingAlgorithm.h"
 
 using namespace std;
 
@@ -64,6 +71,8 @@ namespace Isis {
     m_osl = -1;
     m_osb = -1;
     m_onb = -1;
+
+    m_tileLines = 0;
   }
 
 
@@ -182,9 +191,11 @@ namespace Isis {
       m_osb = 1;
     }
 
-    p_progress->SetMaximumSteps(
-        (int)InputCubes[0]->lineCount() * (int)InputCubes[0]->bandCount());
-    p_progress->CheckStatus();
+    if (m_tileLines == 0) {
+      p_progress->SetMaximumSteps(
+          (int)InputCubes[0]->lineCount() * (int)InputCubes[0]->bandCount());
+      p_progress->CheckStatus();
+    }
 
     // Tracking is done for:
     // (1) Band priority,
@@ -357,15 +368,7 @@ namespace Isis {
 
     m_onb = OutputCubes[0]->bandCount();
 
-    if (m_trackingEnabled) {
-
-      // For mosaic creation, the input is copied onto mosaic by default
-      if (m_imageOverlay == UseBandPlacementCriteria && !m_createOutputMosaic) {
-        BandComparison(iss, isl, ins, inl,
-                       bandPriorityInputBandNumber, bandPriorityOutputBandNumber, iIndex);
-      }
-    }
-    else if (m_imageOverlay == AverageImageWithMosaic) {
+    if (!m_trackingEnabled && m_imageOverlay == AverageImageWithMosaic) {
       m_onb /= 2;
       if (m_onb < 1) {
         QString msg = "The mosaic cube needs a count band.";
@@ -373,34 +376,104 @@ namespace Isis {
       }
     }
 
+    Placement placement;
+    placement.inputFile = InputCubes[0]->fileName();
+    for (int band = 1; band <= InputCubes[0]->bandCount(); band++) {
+      placement.inputBands.push_back(toString(InputCubes[0]->physicalBand(band)));
+    }
+    placement.iss = iss;
+    placement.isl = isl;
+    placement.isb = isb;
+    placement.ins = ins;
+    placement.inl = inl;
+    placement.inb = inb;
+    placement.oss = m_oss;
+    placement.osl = m_osl;
+    placement.osb = m_osb;
+    placement.onb = m_onb;
+    placement.index = iIndex;
+    placement.bandPriorityInputBandNumber = bandPriorityInputBandNumber;
+    placement.bandPriorityOutputBandNumber = bandPriorityOutputBandNumber;
+    placement.bandPriorityUseMaxValue = m_bandPriorityUseMaxValue;
+    placement.createOutputMosaic = m_createOutputMosaic;
+    placement.trackingEnabled = m_trackingEnabled;
+    placement.imageOverlay = m_imageOverlay;
+    placement.placeHighSatPixels = m_placeHighSatPixels;
+    placement.placeLowSatPixels = m_placeLowSatPixels;
+    placement.placeNullPixels = m_placeNullPixels;
+
+    // The pixels of tiled mosaics are placed by EndProcess
+    if (m_tileLines > 0) {
+      m_placements.append(placement);
+    }
+    else {
+      MosaicLines(placement, InputCubes[0], m_trackingCube, m_osl, m_osl + inl - 1, p_progress);
+    }
+
+    if (m_trackingCube) {
+      m_trackingCube->close();
+      delete m_trackingCube;
+      m_trackingCube = NULL;
+    }
+  } // End StartProcess
+
+
+  /**
+   * Places the pixels of an input cube in a range of lines of the mosaic. Each line of the
+   * mosaic only depends on the same line of the input, so the lines can be placed in any
+   * order, as long as the inputs are placed on each line in the order they were given.
+   *
+   * @param placement The placement of the input cube in the mosaic
+   * @param inputCube The input cube
+   * @param trackingCube The tracking cube, or NULL if tracking is not enabled
+   * @param firstLine The first line of the mosaic to place
+   * @param lastLine The last line of the mosaic to place
+   * @param progress The progress to report each line to, or NULL
+   */
+  void ProcessMosaic::MosaicLines(const Placement &placement, Cube *inputCube,
+                                  Cube *trackingCube, int firstLine, int lastLine,
+                                  Progress *progress) {
+    Cube *outputCube = OutputCubes[0];
+    int iss = placement.iss;
+    int isl = placement.isl + firstLine - placement.osl;
+    int isb = placement.isb;
+    int ins = placement.ins;
+    int inb = placement.inb;
+
+    // For mosaic creation, the input is copied onto mosaic by default
+    if (placement.trackingEnabled && placement.imageOverlay == UseBandPlacementCriteria &&
+        !placement.createOutputMosaic) {
+      BandComparison(placement, inputCube, trackingCube, firstLine, lastLine);
+    }
+
     // Process Band Priority with no tracking
-    if (m_imageOverlay == UseBandPlacementCriteria && !m_trackingEnabled ) {
-      BandPriorityWithNoTracking(iss, isl, isb, ins, inl, inb, bandPriorityInputBandNumber,
-                                 bandPriorityOutputBandNumber);
+    if (placement.imageOverlay == UseBandPlacementCriteria && !placement.trackingEnabled) {
+      BandPriorityWithNoTracking(placement, inputCube, firstLine, lastLine);
     }
     else {
       // Create portal buffers for the input and output files
-      Portal iPortal(ins, 1, InputCubes[0]->pixelType());
-      Portal oPortal(ins, 1, OutputCubes[0]->pixelType());
-      Portal countPortal(ins, 1, OutputCubes[0]->pixelType());
+      Portal iPortal(ins, 1, inputCube->pixelType());
+      Portal oPortal(ins, 1, outputCube->pixelType());
+      Portal countPortal(ins, 1, outputCube->pixelType());
       Portal trackingPortal(ins, 1, PixelType::UnsignedInteger);
 
-      for (int ib = isb, ob = m_osb; ib < (isb + inb) && ob <= m_onb; ib++, ob++) {
-        for (int il = isl, ol = m_osl; il < isl + inl; il++, ol++) {
+      for (int ib = isb, ob = placement.osb; ib < (isb + inb) && ob <= placement.onb;
+           ib++, ob++) {
+        for (int il = isl, ol = firstLine; ol <= lastLine; il++, ol++) {
           // Set the position of the portals in the input and output cubes
           iPortal.SetPosition(iss, il, ib);
-          InputCubes[0]->read(iPortal);
+          inputCube->read(iPortal);
 
-          oPortal.SetPosition(m_oss, ol, ob);
-          OutputCubes[0]->read(oPortal);
+          oPortal.SetPosition(placement.oss, ol, ob);
+          outputCube->read(oPortal);
 
-          if (m_trackingEnabled) {
-            trackingPortal.SetPosition(m_oss, ol, 1);
-            m_trackingCube->read(trackingPortal);
+          if (placement.trackingEnabled) {
+            trackingPortal.SetPosition(placement.oss, ol, 1);
+            trackingCube->read(trackingPortal);
           }
-          else if (m_imageOverlay == AverageImageWithMosaic) {
-            countPortal.SetPosition(m_oss, ol, (ob+m_onb));
-            OutputCubes[0]->read(countPortal);
+          else if (placement.imageOverlay == AverageImageWithMosaic) {
+            countPortal.SetPosition(placement.oss, ol, (ob+placement.onb));
+            outputCube->read(countPortal);
           }
 
           bool bChanged = false;
@@ -408,13 +481,13 @@ namespace Isis {
           for (int pixel = 0; pixel < oPortal.size(); pixel++) {
             // Creating Mosaic, copy the input onto mosaic
             // regardless of the priority
-            if (m_createOutputMosaic) {
+            if (placement.createOutputMosaic) {
               oPortal[pixel] = iPortal[pixel];
-              if (m_trackingEnabled) {
-                trackingPortal[pixel] = iIndex;
+              if (placement.trackingEnabled) {
+                trackingPortal[pixel] = placement.index;
                 bChanged = true;
               }
-              else if (m_imageOverlay == AverageImageWithMosaic) {
+              else if (placement.imageOverlay == AverageImageWithMosaic) {
                 if (IsValidPixel(iPortal[pixel])) {
                   countPortal[pixel]=1;
                   bChanged = true;
@@ -422,37 +495,38 @@ namespace Isis {
               }
             }
             // Band Priority
-            else if (m_trackingEnabled && m_imageOverlay == UseBandPlacementCriteria) {
+            else if (placement.trackingEnabled &&
+                     placement.imageOverlay == UseBandPlacementCriteria) {
               int iPixelOrigin = qRound(trackingPortal[pixel]);
 
-              Portal iComparePortal( ins, 1, InputCubes[0]->pixelType() );
-              Portal oComparePortal( ins, 1, OutputCubes[0]->pixelType() );
-              iComparePortal.SetPosition(iss, il, bandPriorityInputBandNumber);
-              InputCubes[0]->read(iComparePortal);
-              oComparePortal.SetPosition(m_oss, ol, bandPriorityOutputBandNumber);
-              OutputCubes[0]->read(oComparePortal);
+              Portal iComparePortal( ins, 1, inputCube->pixelType() );
+              Portal oComparePortal( ins, 1, outputCube->pixelType() );
+              iComparePortal.SetPosition(iss, il, placement.bandPriorityInputBandNumber);
+              inputCube->read(iComparePortal);
+              oComparePortal.SetPosition(placement.oss, ol, placement.bandPriorityOutputBandNumber);
+              outputCube->read(oComparePortal);
 
-              if (iPixelOrigin == iIndex) {
+              if (iPixelOrigin == placement.index) {
                 if ( ( IsValidPixel(iComparePortal[pixel]) &&
                        IsValidPixel(oComparePortal[pixel]) ) &&
-                     ( (!m_bandPriorityUseMaxValue &&
+                     ( (!placement.bandPriorityUseMaxValue &&
                         iComparePortal[pixel] < oComparePortal[pixel]) ||
-                       (m_bandPriorityUseMaxValue &&
+                       (placement.bandPriorityUseMaxValue &&
                         iComparePortal[pixel] > oComparePortal[pixel]) ) ) {
 
                   if ( IsValidPixel(iPortal[pixel]) ||
-                       ( m_placeHighSatPixels && IsHighPixel(iPortal[pixel]) ) ||
-                       ( m_placeLowSatPixels  && IsLowPixel (iPortal[pixel]) ) ||
-                       ( m_placeNullPixels    && IsNullPixel(iPortal[pixel]) ) ){
+                       ( placement.placeHighSatPixels && IsHighPixel(iPortal[pixel]) ) ||
+                       ( placement.placeLowSatPixels  && IsLowPixel (iPortal[pixel]) ) ||
+                       ( placement.placeNullPixels    && IsNullPixel(iPortal[pixel]) ) ){
                     oPortal[pixel] = iPortal[pixel];
                     bChanged = true;
                   }
                 }
                 else { //bad comparison
                   if ( ( IsValidPixel(iPortal[pixel]) && !IsValidPixel(oPortal[pixel]) ) ||
-                       ( m_placeHighSatPixels && IsHighPixel(iPortal[pixel]) ) ||
-                       ( m_placeLowSatPixels  && IsLowPixel (iPortal[pixel]) ) ||
-                       ( m_placeNullPixels    && IsNullPixel(iPortal[pixel]) ) ) {
+                       ( placement.placeHighSatPixels && IsHighPixel(iPortal[pixel]) ) ||
+                       ( placement.placeLowSatPixels  && IsLowPixel (iPortal[pixel]) ) ||
+                       ( placement.placeNullPixels    && IsNullPixel(iPortal[pixel]) ) ) {
                     oPortal[pixel] = iPortal[pixel];
                     bChanged = true;
                   }
@@ -460,61 +534,149 @@ namespace Isis {
               }
             }
             // OnTop/Input Priority
-            else if (m_imageOverlay == PlaceImagesOnTop) {
+            else if (placement.imageOverlay == PlaceImagesOnTop) {
               if (IsNullPixel(oPortal[pixel])  ||
                  IsValidPixel(iPortal[pixel]) ||
-                 (m_placeHighSatPixels && IsHighPixel(iPortal[pixel])) ||
-                 (m_placeLowSatPixels  && IsLowPixel(iPortal[pixel]))  ||
-                 (m_placeNullPixels    && IsNullPixel(iPortal[pixel]))) {
+                 (placement.placeHighSatPixels && IsHighPixel(iPortal[pixel])) ||
+                 (placement.placeLowSatPixels  && IsLowPixel(iPortal[pixel]))  ||
+                 (placement.placeNullPixels    && IsNullPixel(iPortal[pixel]))) {
                 oPortal[pixel] = iPortal[pixel];
-                if (m_trackingEnabled) {
-                  trackingPortal[pixel] = iIndex;
+                if (placement.trackingEnabled) {
+                  trackingPortal[pixel] = placement.index;
                   bChanged = true;
                 }
               }
             }
             // AverageImageWithMosaic priority
-            else if (m_imageOverlay == AverageImageWithMosaic) {
-              bChanged |= ProcessAveragePriority(pixel, iPortal, oPortal, countPortal);
+            else if (placement.imageOverlay == AverageImageWithMosaic) {
+              bChanged |= ProcessAveragePriority(placement, pixel, iPortal, oPortal, countPortal);
             }
             // Beneath/Mosaic Priority
-            else if (m_imageOverlay == PlaceImagesBeneath) {
+            else if (placement.imageOverlay == PlaceImagesBeneath) {
               if (IsNullPixel(oPortal[pixel])) {
                 oPortal[pixel] = iPortal[pixel];
                 // Set the origin if number of input bands equal to 1
                 // and if the track flag was set
-                if (m_trackingEnabled) {
-                  trackingPortal[pixel] = iIndex;
+                if (placement.trackingEnabled) {
+                  trackingPortal[pixel] = placement.index;
                   bChanged = true;
                 }
               }
             }
           } // End sample loop
           if (bChanged) {
-            if (m_trackingEnabled) {
-              m_trackingCube->write(trackingPortal);
+            if (placement.trackingEnabled) {
+              trackingCube->write(trackingPortal);
             }
-            if (m_imageOverlay == AverageImageWithMosaic) {
-              OutputCubes[0]->write(countPortal);
+            if (placement.imageOverlay == AverageImageWithMosaic) {
+              outputCube->write(countPortal);
             }
           }
-          OutputCubes[0]->write(oPortal);
-          p_progress->CheckStatus();
+          outputCube->write(oPortal);
+          if (progress) progress->CheckStatus();
         } // End line loop
       }   // End band loop
     }
-    if (m_trackingCube) {
-      m_trackingCube->close();
-      delete m_trackingCube;
-      m_trackingCube = NULL;
+  }
+
+
+  /**
+   * Places the pixels of the inputs deferred by SetTileLines. The mosaic is split into tiles of
+   * lines, and the tiles are mosaicked at the same time. Each tile opens its own copy of each
+   * input that overlaps it, and places them in the order StartProcess was called, so every
+   * line of the mosaic gets the same pixels it would get by placing the inputs one at a time.
+   */
+  void ProcessMosaic::MosaicTiles() {
+    //! The lines of one tile of the mosaic and the error it failed with
+    struct Tile {
+      int firstLine;
+      int lastLine;
+      QSharedPointer<IException> error;
+    };
+
+    Cube *trackingCube = NULL;
+    for (int i = 0; i < m_placements.size() && !trackingCube; i++) {
+      if (m_placements[i].trackingEnabled) {
+        QString trackingPath = FileName(OutputCubes[0]->fileName()).path();
+        QString trackingFile = OutputCubes[0]->group("Tracking").findKeyword("FileName")[0];
+        trackingCube = new Cube;
+        trackingCube->open(trackingPath + "/" + trackingFile, "rw");
+      }
     }
-  } // End StartProcess
+
+    QVector<Tile> tiles;
+    for (int line = 1; line <= OutputCubes[0]->lineCount(); line += m_tileLines) {
+      Tile tile;
+      tile.firstLine = line;
+      tile.lastLine = min(line + m_tileLines - 1, OutputCubes[0]->lineCount());
+      tiles.append(tile);
+    }
+
+    p_progress->SetText("Mosaicking tiles");
+    p_progress->SetMaximumSteps(tiles.size());
+    p_progress->CheckStatus();
+
+    QFuture<void> future = QtConcurrent::map(tiles, [this, trackingCube](Tile &tile) {
+      for (int i = 0; i < m_placements.size(); i++) {
+        const Placement &placement = m_placements[i];
+        int firstLine = max(tile.firstLine, placement.osl);
+        int lastLine = min(tile.lastLine, placement.osl + placement.inl - 1);
+        if (firstLine > lastLine) continue;
+
+        try {
+          Cube inputCube;
+          inputCube.setVirtualBands(placement.inputBands);
+          inputCube.open(placement.inputFile);
+          inputCube.addCachingAlgorithm(new UniqueIOCachingAlgorithm(2));
+          MosaicLines(placement, &inputCube, trackingCube, firstLine, lastLine, NULL);
+        }
+        catch (IException &e) {
+          QString msg = "Unable to mosaic cube [" + FileName(placement.inputFile).name() + "]";
+          tile.error = QSharedPointer<IException>(
+                           new IException(e, IException::User, msg, _FILEINFO_));
+          return;
+        }
+      }
+    });
+
+    int reported = 0;
+    QMutex sleeper;
+    sleeper.lock();
+    while (!future.isFinished()) {
+      sleeper.tryLock(100);
+      for (; reported < future.progressValue(); reported++) {
+        p_progress->CheckStatus();
+      }
+    }
+    sleeper.unlock();
+    for (; reported < tiles.size(); reported++) {
+      p_progress->CheckStatus();
+    }
+
+    if (trackingCube) {
+      trackingCube->close();
+      delete trackingCube;
+    }
+    m_placements.clear();
+
+    for (int t = 0; t < tiles.size(); t++) {
+      if (tiles[t].error) {
+        throw *tiles[t].error;
+      }
+    }
+  }
+
 
 
   /**
-   * Cleans up by closing input, output and tracking cubes
+   * Places the pixels of any inputs deferred by SetTileLines, then cleans up by closing input,
+   * output and tracking cubes
    */
   void ProcessMosaic::EndProcess() {
+    if (!m_placements.isEmpty()) {
+      MosaicTiles();
+    }
+
     if (m_trackingCube) {
       m_trackingCube->close();
       delete m_trackingCube;
@@ -819,6 +981,24 @@ namespace Isis {
   }
 
 
+  /**
+   * Sets the number of mosaic lines in each tile of a tiled mosaic. When this is 0, the
+   * default, StartProcess places the pixels of each input as it is called. Otherwise
+   * StartProcess only checks each input and updates the labels, and EndProcess places the
+   * pixels of all of the inputs in tiles of this many lines at the same time, using the
+   * number of threads in the GlobalThreads preference. The mosaic is the same either way.
+   *
+   * @param tileLines The number of lines in each tile, or 0 to not use tiles
+   */
+  void ProcessMosaic::SetTileLines(int tileLines) {
+    if (tileLines < 0) {
+      QString msg = "The number of tile lines [" + toString(tileLines) + "] must not be negative";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+    m_tileLines = tileLines;
+  }
+
+
   /**
    * @see SetHighSaturationFlag()
    */
@@ -1025,6 +1205,7 @@ namespace Isis {
    *
    * @author Sharmila Prasad (1/13/2011)
    *
+   * @param placement   - The placement of the input cube
    * @param piPixel     - Pixel index
    * @param piPortal    - Input Portal
    * @param poPortal    - Output Portal
@@ -1032,7 +1213,8 @@ namespace Isis {
    *
    * @return bool
    */
-  bool ProcessMosaic::ProcessAveragePriority(int piPixel, Portal& piPortal, Portal& poPortal,
+  bool ProcessMosaic::ProcessAveragePriority(const Placement &placement, int piPixel,
+                                             Portal& piPortal, Portal& poPortal,
                                              Portal& countPortal)
   {
     bool bChanged=false;
@@ -1051,9 +1233,9 @@ namespace Isis {
     }
     // Input-Special, Flags-True
     else if (IsSpecial(piPortal[piPixel])) {
-      if ((m_placeHighSatPixels && IsHighPixel(piPortal[piPixel])) ||
-         (m_placeLowSatPixels  && IsLowPixel (piPortal[piPixel]))  ||
-         (m_placeNullPixels    && IsNullPixel(piPortal[piPixel]))) {
+      if ((placement.placeHighSatPixels && IsHighPixel(piPortal[piPixel])) ||
+         (placement.placeLowSatPixels  && IsLowPixel (piPortal[piPixel]))  ||
+         (placement.placeNullPixels    && IsNullPixel(piPortal[piPixel]))) {
         poPortal[piPixel]    = piPortal[piPixel];
         countPortal[piPixel] = 0;
         bChanged = true;
@@ -1323,53 +1505,56 @@ namespace Isis {
    * input pixel is assigned to the output if the origin pixel equals the current
    * input file index
    *
-   * @param iss - Comparison start sample
-   * @param isl - Comparison start line
-   * @param ins - The number of samples to compare
-   * @param inl - The number of lines to compare
-   * @param bandPriorityInputBandNumber - The band in the input cube to use for comparison
-   * @param bandPriorityOutputBandNumber - The band in the output cube to use for comparison
-   * @param index - Tracking index for the input cube
+   * @param placement - The placement of the input cube
+   * @param inputCube - The input cube
+   * @param trackingCube - The tracking cube
+   * @param firstLine - The first line of the mosaic to compare
+   * @param lastLine - The last line of the mosaic to compare
    *
    * @author Sharmila Prasad (9/04/2009)
    */
-  void ProcessMosaic::BandComparison(int iss, int isl, int ins, int inl,
-      int bandPriorityInputBandNumber, int bandPriorityOutputBandNumber, int index) {
+  void ProcessMosaic::BandComparison(const Placement &placement, Cube *inputCube,
+                                     Cube *trackingCube, int firstLine, int lastLine) {
+    int ins = placement.ins;
+    int isl = placement.isl + firstLine - placement.osl;
+
     //
     // Create portal buffers for the input and output files
-    Portal cIportal(ins, 1, InputCubes[0]->pixelType());
+    Portal cIportal(ins, 1, inputCube->pixelType());
     Portal cOportal(ins, 1, OutputCubes[0]->pixelType());
     Portal trackingPortal(ins, 1, PixelType::UnsignedInteger);
 
-    for (int iIL = isl, iOL = m_osl; iIL < isl + inl; iIL++, iOL++) {
+    for (int iIL = isl, iOL = firstLine; iOL <= lastLine; iIL++, iOL++) {
       // Set the position of the portals in the input and output cubes
-      cIportal.SetPosition(iss, iIL, bandPriorityInputBandNumber);
-      InputCubes[0]->read(cIportal);
+      cIportal.SetPosition(placement.iss, iIL, placement.bandPriorityInputBandNumber);
+      inputCube->read(cIportal);
 
-      cOportal.SetPosition(m_oss, iOL, bandPriorityOutputBandNumber);
+      cOportal.SetPosition(placement.oss, iOL, placement.bandPriorityOutputBandNumber);
       OutputCubes[0]->read(cOportal);
 
-      trackingPortal.SetPosition(m_oss, iOL, 1);
-      m_trackingCube->read(trackingPortal);
+      trackingPortal.SetPosition(placement.oss, iOL, 1);
+      trackingCube->read(trackingPortal);
 
       // Move the input data to the output
       for (int iPixel = 0; iPixel < cOportal.size(); iPixel++) {
-        if ((m_placeHighSatPixels && IsHighPixel(cIportal[iPixel])) ||
-            (m_placeLowSatPixels  && IsLowPixel(cIportal[iPixel])) ||
-            (m_placeNullPixels    && IsNullPixel(cIportal[iPixel]))) {
-          trackingPortal[iPixel] = index;
+        if ((placement.placeHighSatPixels && IsHighPixel(cIportal[iPixel])) ||
+            (placement.placeLowSatPixels  && IsLowPixel(cIportal[iPixel])) ||
+            (placement.placeNullPixels    && IsNullPixel(cIportal[iPixel]))) {
+          trackingPortal[iPixel] = placement.index;
         }
         else {
           if (IsValidPixel(cIportal[iPixel])) {
             if (IsSpecial(cOportal[iPixel]) ||
-                (m_bandPriorityUseMaxValue == false  && cIportal[iPixel] < cOportal[iPixel]) ||
-                (m_bandPriorityUseMaxValue == true && cIportal[iPixel] > cOportal[iPixel])) {
-              trackingPortal[iPixel] = index;
+                (placement.bandPriorityUseMaxValue == false &&
+                 cIportal[iPixel] < cOportal[iPixel]) ||
+                (placement.bandPriorityUseMaxValue == true &&
+                 cIportal[iPixel] > cOportal[iPixel])) {
+              trackingPortal[iPixel] = placement.index;
             }
           }
         }
       }
-      m_trackingCube->write(trackingPortal);
+      trackingCube->write(trackingPortal);
     }
   }
 
@@ -1377,46 +1562,56 @@ namespace Isis {
   /**
    * Mosaicking for Band Priority with no Tracking
    *
+   * @param placement - The placement of the input cube
+   * @param inputCube - The input cube
+   * @param firstLine - The first line of the mosaic to place
+   * @param lastLine - The last line of the mosaic to place
+   *
    * @author Sharmila Prasad (1/4/2012)
    */
-void ProcessMosaic::BandPriorityWithNoTracking(int iss, int isl, int isb, int ins, int inl,
-                                                 int inb, int bandPriorityInputBandNumber,
-                                                 int bandPriorityOutputBandNumber) {
+void ProcessMosaic::BandPriorityWithNoTracking(const Placement &placement, Cube *inputCube,
+                                                 int firstLine, int lastLine) {
+    int iss = placement.iss;
+    int isl = placement.isl + firstLine - placement.osl;
+    int isb = placement.isb;
+    int ins = placement.ins;
+    int inb = placement.inb;
+
     /*
      * specified band for comparison
      * Create portal buffers for the input and output files pointing to the
      */
-    Portal iComparePortal( ins, 1, InputCubes[0]->pixelType() );
+    Portal iComparePortal( ins, 1, inputCube->pixelType() );
     Portal oComparePortal( ins, 1, OutputCubes[0]->pixelType() );
     Portal resultsPortal ( ins, 1, OutputCubes[0]->pixelType() );
 
     // Create portal buffers for the input and output files
-    Portal iPortal( ins, 1, InputCubes[0]->pixelType() );
+    Portal iPortal( ins, 1, inputCube->pixelType() );
     Portal oPortal( ins, 1, OutputCubes[0]->pixelType() );
 
-    for (int inLine = isl, outLine = m_osl; inLine < isl + inl; inLine++, outLine++) {
+    for (int inLine = isl, outLine = firstLine; outLine <= lastLine; inLine++, outLine++) {
 //       Set the position of the portals in the input and output cubes
-      iComparePortal.SetPosition(iss, inLine, bandPriorityInputBandNumber);
-      InputCubes[0]->read(iComparePortal);
+      iComparePortal.SetPosition(iss, inLine, placement.bandPriorityInputBandNumber);
+      inputCube->read(iComparePortal);
 
-      oComparePortal.SetPosition(m_oss, outLine, bandPriorityOutputBandNumber);
+      oComparePortal.SetPosition(placement.oss, outLine, placement.bandPriorityOutputBandNumber);
       OutputCubes[0]->read(oComparePortal);
 
-      Portal iPortal( ins, 1, InputCubes[0]->pixelType() );
+      Portal iPortal( ins, 1, inputCube->pixelType() );
       Portal oPortal( ins, 1, OutputCubes[0]->pixelType() );
 
       bool inCopy = false;
 //       Move the input data to the output
       for (int iPixel = 0; iPixel < ins; iPixel++) {
         resultsPortal[iPixel] = false;
-        if (m_createOutputMosaic) {
+        if (placement.createOutputMosaic) {
           resultsPortal[iPixel] = true;
           inCopy = true;
         }
         else if ( IsValidPixel(iComparePortal[iPixel]) && IsValidPixel(oComparePortal[iPixel]) ) {
-          if ( (m_bandPriorityUseMaxValue == false  &&
+          if ( (placement.bandPriorityUseMaxValue == false  &&
                 iComparePortal[iPixel] < oComparePortal[iPixel]) ||
-                (m_bandPriorityUseMaxValue == true &&
+                (placement.bandPriorityUseMaxValue == true &&
                 iComparePortal[iPixel] > oComparePortal[iPixel]) ) {
             resultsPortal[iPixel] = true;
             inCopy = true;
@@ -1428,23 +1623,23 @@ void ProcessMosaic::BandPriorityWithNoTracking(int iss, int isl, int isb, int in
         }
       }
       if (inCopy) {
-        for (int ib = isb, ob = m_osb; ib < (isb + inb) && ob <= m_onb; ib++, ob++) {
+        for (int ib = isb, ob = placement.osb; ib < (isb + inb) && ob <= placement.onb; ib++, ob++) {
 //           Set the position of the portals in the input and output cubes
           iPortal.SetPosition(iss, inLine, ib);
-          InputCubes[0]->read(iPortal);
+          inputCube->read(iPortal);
 
-          oPortal.SetPosition(m_oss, outLine, ob);
+          oPortal.SetPosition(placement.oss, outLine, ob);
           OutputCubes[0]->read(oPortal);
 
           for (int iPixel = 0; iPixel < ins; iPixel++) {
             if (resultsPortal[iPixel]) {
-              if (m_createOutputMosaic) {
+              if (placement.createOutputMosaic) {
                 oPortal[iPixel] = iPortal[iPixel];
               }
               else if ( IsValidPixel(iPortal[iPixel]) ||
-                        (m_placeHighSatPixels && IsHighPixel(iPortal[iPixel]) ) ||
-                        (m_placeLowSatPixels  && IsLowPixel (iPortal[iPixel]) ) ||
-                        (m_placeNullPixels    && IsNullPixel(iPortal[iPixel]) ) ) {
+                        (placement.placeHighSatPixels && IsHighPixel(iPortal[iPixel]) ) ||
+                        (placement.placeLowSatPixels  && IsLowPixel (iPortal[iPixel]) ) ||
+                        (placement.placeNullPixels    && IsNullPixel(iPortal[iPixel]) ) ) {
                 oPortal[iPixel] = iPortal[iPixel];
               }
             }
@@ -6,6 +6,10 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <vector>
+
+#include <QList>
+
 #include "Process.h"
 
 namespace Isis {
@@ -267,6 +271,7 @@ namespace Isis {
       void SetMatchDEM(bool matchDEM);
       void SetNullFlag(bool placeNullPixels);
       void SetTrackFlag(bool trackingEnabled);
+      void SetTileLines(int tileLines);
 
       bool GetHighSaturationFlag() const;
       ImageOverlay GetImageOverlay() const;
@@ -283,17 +288,49 @@ namespace Isis {
 
     private:
 
+      /**
+       * The placement of an input cube in the mosaic, and the settings it is placed with
+       */
+      struct Placement {
+        QString inputFile;               //!< The file name of the input cube
+        std::vector<QString> inputBands; //!< The physical bands of the input cube
+        int iss; //!< The starting sample within the input cube
+        int isl; //!< The starting line within the input cube
+        int isb; //!< The starting band within the input cube
+        int ins; //!< The number of samples from the input cube
+        int inl; //!< The number of lines from the input cube
+        int inb; //!< The number of bands from the input cube
+        int oss; //!< The starting sample within the output cube
+        int osl; //!< The starting line within the output cube
+        int osb; //!< The starting band within the output cube
+        int onb; //!< The number of bands in the output cube
+        int index; //!< The tracking index of the input cube
+        int bandPriorityInputBandNumber;  //!< The input band compared by band priority
+        int bandPriorityOutputBandNumber; //!< The output band compared by band priority
+        bool bandPriorityUseMaxValue;     //!< Band priority takes the greater value
+        bool createOutputMosaic;          //!< The input is the first one in a new mosaic
+        bool trackingEnabled;             //!< The tracking cube is updated
+        ImageOverlay imageOverlay;        //!< The priority of the input
+        bool placeHighSatPixels;          //!< High saturation input pixels are placed
+        bool placeLowSatPixels;           //!< Low saturation input pixels are placed
+        bool placeNullPixels;             //!< Null input pixels are placed
+      };
+
+      // Place the pixels of an input in a range of mosaic lines
+      void MosaicLines(const Placement &placement, Cube *inputCube, Cube *trackingCube,
+                       int firstLine, int lastLine, Progress *progress);
+
+      // Place the pixels of the deferred inputs in tiles of lines at the same time
+      void MosaicTiles();
+
       //Compare the input and mosaic for the specified band based on the criteria and update the
       //  mosaic origin band.
-      void BandComparison(int iss, int isl, int ins, int inl,
-                          int bandPriorityInputBandNumber, int bandPriorityOutputBandNumber,
-                          int index);
+      void BandComparison(const Placement &placement, Cube *inputCube, Cube *trackingCube,
+                          int firstLine, int lastLine);
 
       // Mosaicking for Band Priority with no Tracking
-      void BandPriorityWithNoTracking(int iss, int isl, int isb,
-                                      int ins, int inl, int inb,
-                                      int bandPriorityInputBandNumber,
-                                      int bandPriorityOutputBandNumber);
+      void BandPriorityWithNoTracking(const Placement &placement, Cube *inputCube,
+                                      int firstLine, int lastLine);
 
       // Get the default origin value based on pixel type for the origin band
       int GetOriginDefaultByPixelType();
@@ -313,8 +350,8 @@ namespace Isis {
       // Mosaic exists, match the band with the input image
       void MatchBandBinGroup(int origIsb, int &inb);
 
-      bool ProcessAveragePriority(int piPixel, Portal& pInPortal, Portal& pOutPortal,
-                                  Portal& pOrigPortal);
+      bool ProcessAveragePriority(const Placement &placement, int piPixel, Portal& pInPortal,
+                                  Portal& pOutPortal, Portal& pOrigPortal);
 
       void ResetCountBands();
 
@@ -360,6 +397,9 @@ namespace Isis {
       bool m_placeHighSatPixels; //!<
       bool m_placeLowSatPixels;  //!<
       bool m_placeNullPixels;    //!<
+
+      int m_tileLines; //!< The number of lines in each tile, or 0 to place each input as it comes
+      QList<Placement> m_placements; //!< The inputs waiting to be placed in tiles
   };
 };
 
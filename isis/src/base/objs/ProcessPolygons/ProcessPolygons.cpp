@@ -5,9 +5,19 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "ProcessPolygons.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <QList>
+#include <QSharedPointer>
+#include <QtConcurrentMap>
+
 #include "PolygonTools.h"
 #include "Application.h"
 #include "BoxcarCachingAlgorithm.h"
+#include "IException.h"
 #include "SpecialPixel.h"
 
 #include "geos/geom/CoordinateSequence.h"
@@ -16,19 +26,158 @@ find files of those names at the top level of this repository. **/
 #include "geos/geom/Envelope.h"
 #include "geos/geom/LineString.h"
 #include "geos/geom/Geometry.h"
-#include "geos/geom/Point.h"
-#include "geos/geom/prep/PreparedGeometryFactory.h"
-#include "geos/geom/prep/PreparedPolygon.h"
 #include "geos/util/IllegalArgumentException.h"
-#include "geos/operation/overlay/snap/GeometrySnapper.h"
 
 using namespace std;
 namespace Isis {
 
+  //! The polygons of one output tile and the error rasterizing them failed with
+  struct ProcessPolygons::Tile {
+    int firstSample;
+    int lastSample;
+    int firstLine;
+    int lastLine;
+    QList<int> polygons;
+    QSharedPointer<IException> error;
+  };
+
+
+  /**
+   * Appends the edges of the rings of a polygon to an edge list.
+   *
+   * @param poly The polygon
+   * @param edges The x1, y1, x2, y2 of each edge
+   */
+  static void appendPolygonEdges(const geos::geom::Polygon *poly, std::vector<double> &edges) {
+    for (int r = -1; r < (int) poly->getNumInteriorRing(); r++) {
+      const geos::geom::LineString *ring = (r < 0) ? poly->getExteriorRing() :
+                                                     poly->getInteriorRingN(r);
+      const geos::geom::CoordinateSequence *coords = ring->getCoordinatesRO();
+      for (unsigned int i = 1; i < coords->getSize(); i++) {
+        edges.push_back(coords->getAt(i - 1).x);
+        edges.push_back(coords->getAt(i - 1).y);
+        edges.push_back(coords->getAt(i).x);
+        edges.push_back(coords->getAt(i).y);
+      }
+    }
+  }
+
+
+  /**
+   * Tests if a point is inside of the rings of a polygon with the even-odd rule. The point
+   * must not be on an edge.
+   *
+   * @param edges The x1, y1, x2, y2 of each edge
+   * @param x The x of the point
+   * @param y The y of the point
+   *
+   * @return bool True if the point is inside
+   */
+  static bool insideEdges(const std::vector<double> &edges, double x, double y) {
+    bool inside = false;
+    for (unsigned int e = 0; e < edges.size(); e += 4) {
+      double x1 = edges[e], y1 = edges[e + 1], x2 = edges[e + 2], y2 = edges[e + 3];
+      if ((y1 > y) != (y2 > y) && x < x1 + (y - y1) * (x2 - x1) / (y2 - y1)) {
+        inside = !inside;
+      }
+    }
+    return inside;
+  }
+
+
+  /**
+   * Tests if an edge touches a closed box, with the Liang-Barsky clipping of the edge.
+   *
+   * @return bool True if any part of the edge is in the box
+   */
+  static bool edgeTouchesBox(double x1, double y1, double x2, double y2,
+                             double minX, double maxX, double minY, double maxY) {
+    double p[4] = {x1 - x2, x2 - x1, y1 - y2, y2 - y1};
+    double q[4] = {x1 - minX, maxX - x1, y1 - minY, maxY - y1};
+    double enter = 0.0, leave = 1.0;
+    for (int i = 0; i < 4; i++) {
+      if (p[i] == 0.0) {
+        if (q[i] < 0.0) return false;
+      }
+      else {
+        double t = q[i] / p[i];
+        if (p[i] < 0.0) {
+          if (t > leave) return false;
+          enter = max(enter, t);
+        }
+        else {
+          if (t < enter) return false;
+          leave = min(leave, t);
+        }
+      }
+    }
+    return true;
+  }
+
+
+  /**
+   * Tests if any part of a closed box is inside of or on the rings of a polygon.
+   *
+   * @param edges The x1, y1, x2, y2 of each edge
+   *
+   * @return bool True if the box intersects the polygon
+   */
+  static bool touchesBox(const std::vector<double> &edges,
+                         double minX, double maxX, double minY, double maxY) {
+    for (unsigned int e = 0; e < edges.size(); e += 4) {
+      if (edgeTouchesBox(edges[e], edges[e + 1], edges[e + 2], edges[e + 3],
+                         minX, maxX, minY, maxY)) {
+        return true;
+      }
+    }
+
+    // No edge reaches the box, so it is either all inside or all outside
+    return insideEdges(edges, minX, minY);
+  }
+
+
+  /**
+   * Adds the values of a polygon to the average and count of an output pixel.
+   *
+   * @param dns The values
+   * @param band The band of a single value or -1 for a value per band
+   * @param average The averages of the output tile
+   * @param count The counts of the output tile
+   * @param pixel The index of the pixel in the first band of the tile
+   */
+  static void addValues(const std::vector<double> &dns, int band, Brick &average,
+                        Brick &count, int pixel) {
+    int bandSize = average.SampleDimension() * average.LineDimension();
+    for (unsigned int i = 0; i < dns.size(); i++) {
+      int index = pixel + bandSize * ((band < 0) ? (int) i : band);
+      double inputDn = dns[i];
+
+      // The input dn is good
+      if (IsValidPixel(inputDn)) {
+        if (IsValidPixel(average[index])) {
+          double currentCount = count[index];
+          double newCount = ++count[index];
+          double currentAverage = average[index];
+          average[index] = ((currentAverage * currentCount) + inputDn) / newCount;
+        }
+        else {
+          average[index] = inputDn;
+          count[index] = 1;
+        }
+      }
+
+      // The input dn is special
+      else {
+        if ((average[index] == Isis::Null) || (inputDn != Null)) {
+          average[index] = inputDn;
+        }
+      }
+    }
+  }
+
+
   ProcessPolygons::ProcessPolygons() {
     m_useCenter = true;
-    m_average = NULL;
-    m_count = NULL;
     m_imagePoly = NULL;
   }
 
@@ -77,17 +226,28 @@ namespace Isis {
 
 
   /**
-   * This method does the actuall reading and writing to the cube
-   * file.  The Flag parameter is there to help out where the two
-   * Rasterize method need to behave differently during this
-   * operation.  Most notibly, when we set the position of the
-   * bricks and when we are calculating the average using the
-   * given value or values.
+   * This method clips the polygon to the output image and queues it to be rasterized. The
+   * Flag parameter is there to help out where the two Rasterize method need to behave
+   * differently, which is the band the given value or values are averaged into.
    *
    * @param Flag
    */
   void ProcessPolygons::FillPolygon(int Flag) {
 
+    if (!m_imagePoly) {
+      geos::geom::CoordinateArraySequence imagePts;
+
+      imagePts.add(geos::geom::Coordinate(0.0, 0.0));
+      imagePts.add(geos::geom::Coordinate(0.0, this->OutputCubes[0]->lineCount()));
+      imagePts.add(geos::geom::Coordinate(this->OutputCubes[0]->sampleCount(),
+                                          this->OutputCubes[0]->lineCount()));
+      imagePts.add(geos::geom::Coordinate(this->OutputCubes[0]->sampleCount(), 0.0));
+      imagePts.add(geos::geom::Coordinate(0.0, 0.0));
+
+      m_imagePoly = Isis::globalFactory->createPolygon(
+                      globalFactory->createLinearRing(imagePts), NULL);
+    }
+
     // Create a sample/line polygon for the input pixel vertices
     geos::geom::CoordinateSequence *pts = new geos::geom::CoordinateArraySequence();
     for (unsigned int i = 0; i < m_sampleVertices.size(); i++) {
@@ -101,6 +261,7 @@ namespace Isis {
       //  Do not rasterize pixel if despiking fails or there are multiple polygons.
       geos::geom::Polygon *spikedPixelPoly = Isis::globalFactory->createPolygon(
           globalFactory->createLinearRing(pts), NULL);
+      geos::geom::MultiPolygon *despikedPixelPoly = NULL;
 
       const geos::geom::Polygon *projectedInputPixelPoly;
 
@@ -108,7 +269,6 @@ namespace Isis {
         projectedInputPixelPoly = spikedPixelPoly;
       }
       else {
-        geos::geom::MultiPolygon *despikedPixelPoly;
         try {
           despikedPixelPoly = PolygonTools::Despike(spikedPixelPoly);
         }
@@ -117,114 +277,62 @@ namespace Isis {
           return;
         }
 
-        try {
-          despikedPixelPoly = PolygonTools::Despike(spikedPixelPoly);
-        }
-        catch (IException &e) {
+        if (despikedPixelPoly->getNumGeometries() != 1) {
+          delete despikedPixelPoly;
           delete spikedPixelPoly;
           return;
         }
-
-        if (despikedPixelPoly->getNumGeometries() > 1) return;
         projectedInputPixelPoly =
             dynamic_cast<const geos::geom::Polygon *>(despikedPixelPoly->getGeometryN(0));
       }
 
-      /* If there is not an intersecting polygon, there is no reason to go on.*/
-      if (!projectedInputPixelPoly->intersects(m_imagePoly)) return;
-
-      geos::geom::MultiPolygon *intersectPoly = PolygonTools::MakeMultiPolygon(
-          m_imagePoly->intersection(projectedInputPixelPoly));
-      geos::geom::prep::PreparedPolygon *preparedPoly =
-        new geos::geom::prep::PreparedPolygon(intersectPoly);
-      const geos::geom::Envelope *envelope = intersectPoly->getEnvelopeInternal();
-
-      // Go thru each coord. in the envelope and ask if it is within the polygon
-      for (double x = floor(envelope->getMinX()); x <= ceil(envelope->getMaxX()); x++) {
-        if (x == 0) continue;
-
-        for (double y = floor(envelope->getMinY()); y <= ceil(envelope->getMaxY()); y++) {
-          if (y == 0) continue;
-
-          bool contains;
-
-          if (m_useCenter) {
-            geos::geom::Coordinate c(x, y);
-            geos::geom::Point *p = Isis::globalFactory->createPoint(c);
-            contains = preparedPoly->contains(p);
-            delete p;
-          }
-          else {
-            geos::geom::CoordinateSequence *tpts = new geos::geom::CoordinateArraySequence();
-            tpts->add(geos::geom::Coordinate(x - 0.5, y - 0.5));
-            tpts->add(geos::geom::Coordinate(x + 0.5, y - 0.5));
-            tpts->add(geos::geom::Coordinate(x + 0.5, y + 0.5));
-            tpts->add(geos::geom::Coordinate(x - 0.5, y + 0.5));
-            tpts->add(geos::geom::Coordinate(x - 0.5, y - 0.5));
-
-            geos::geom::Polygon *outPixelFootPrint = Isis::globalFactory->createPolygon(
-                                      globalFactory->createLinearRing(tpts), NULL);
-            contains = preparedPoly->intersects(outPixelFootPrint);
-            delete outPixelFootPrint;
-          }
-
-          if (contains) {
+      PendingPolygon pending;
+      const geos::geom::Envelope *envelope = NULL;
+      const geos::geom::Geometry *clippedPoly = NULL;
+      geos::geom::MultiPolygon *intersectPoly = NULL;
 
-            // Read spectral noodle from samp, line position
-            m_average->SetBasePosition((int)(x + 0.5), (int)(y + 0.5), 1);
-            this->OutputCubes[0]->read(*m_average);
-            m_count->SetBasePosition((int)(x + 0.5), (int)(y + 0.5), 1);
-            this->OutputCubes[1]->read(*m_count);
-
-            //  Process each band in the buffer
-            for (unsigned int i = 0; i < m_dns.size(); i++) {
-
-              int band;
-              if (Flag == 0) {
-                band = i;
-              }
-              else {
-                band = m_band - 1;
-              }
-
-              double inputDn = m_dns[i];
-
-              // The input dn is good
-              if (IsValidPixel(inputDn)) {
-                if (IsValidPixel((*m_average)[band])) {
-                  double currentCount = (*m_count)[band];
-                  double newCount = ++((*m_count)[band]);
-                  double currentAverage = (*m_average)[band];
-                  (*m_average)[band] = ((currentAverage * currentCount) + inputDn) / newCount;
-                }
-                else {
-                  (*m_average)[band] = inputDn;
-                  (*m_count)[band] = 1;
-                }
-              }
-
-              // The input dn is special
-              else {
-                if (((*m_average)[band] == Isis::Null) || (inputDn != Null)) {
-                  (*m_average)[band] = inputDn;
-                }
-              }
-
-            } /*End for each band*/
-
-            // Write spectral noodles back out to average and count cubes
-            this->OutputCubes[0]->write(*m_average);
-            this->OutputCubes[1]->write(*m_count);
-
-          } /*End if (contains)*/
+      // Polygons inside of the image do not need to be intersected with it
+      if (m_imagePoly->getEnvelopeInternal()->contains(
+              projectedInputPixelPoly->getEnvelopeInternal())) {
+        clippedPoly = projectedInputPixelPoly;
+      }
+      else if (projectedInputPixelPoly->intersects(m_imagePoly)) {
+        geos::geom::Geometry *intersection = m_imagePoly->intersection(projectedInputPixelPoly);
+        intersectPoly = PolygonTools::MakeMultiPolygon(intersection);
+        delete intersection;
+        clippedPoly = intersectPoly;
+      }
 
-        } /*End for y*/
+      // Polygons without area, such as one only touching the edge of the image, are skipped
+      if (clippedPoly && clippedPoly->getArea() - DBL_EPSILON > DBL_EPSILON) {
+        for (unsigned int i = 0; i < clippedPoly->getNumGeometries(); i++) {
+          appendPolygonEdges(
+              dynamic_cast<const geos::geom::Polygon *>(clippedPoly->getGeometryN(i)),
+              pending.edges);
+        }
+        envelope = clippedPoly->getEnvelopeInternal();
+      }
 
-      } /*End for x*/
+      // The output pixels in the envelope, the pixels at 0 are outside of the image
+      if (envelope) {
+        pending.firstSample = max(1, (int) floor(envelope->getMinX()));
+        pending.lastSample = min(this->OutputCubes[0]->sampleCount(),
+                                 (int) ceil(envelope->getMaxX()));
+        pending.firstLine = max(1, (int) floor(envelope->getMinY()));
+        pending.lastLine = min(this->OutputCubes[0]->lineCount(),
+                               (int) ceil(envelope->getMaxY()));
+        pending.dns = m_dns;
+        pending.band = (Flag == 0) ? -1 : m_band - 1;
+
+        if (pending.firstSample <= pending.lastSample &&
+            pending.firstLine <= pending.lastLine) {
+          m_polygons.push_back(pending);
+        }
+      }
 
-      delete projectedInputPixelPoly;
       delete intersectPoly;
-      delete preparedPoly;
+      delete despikedPixelPoly;
+      delete spikedPixelPoly;
 
     } /*end try*/
 
@@ -235,6 +343,143 @@ namespace Isis {
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }/*end catch*/
 
+    if (m_polygons.size() >= (unsigned int) MaxPendingPolygons) {
+      FlushPolygons();
+    }
+  }
+
+
+  /**
+   * Rasterizes the queued polygons into the average and count cubes. The polygons are binned
+   * into the output tiles they cover and the tiles are rasterized in parallel. Each tile adds
+   * its polygons in the order they were queued, so the averages are the same as adding the
+   * polygons one at a time.
+   */
+  void ProcessPolygons::FlushPolygons() {
+    if (m_polygons.empty()) return;
+
+    int tileSamples = (this->OutputCubes[0]->sampleCount() + TileSize - 1) / TileSize;
+    int tileLines = (this->OutputCubes[0]->lineCount() + TileSize - 1) / TileSize;
+
+    QList<Tile> tiles;
+    std::vector<int> tileIndex(tileSamples * tileLines, -1);
+    for (unsigned int p = 0; p < m_polygons.size(); p++) {
+      const PendingPolygon &poly = m_polygons[p];
+      for (int tl = (poly.firstLine - 1) / TileSize; tl <= (poly.lastLine - 1) / TileSize; tl++) {
+        for (int ts = (poly.firstSample - 1) / TileSize;
+             ts <= (poly.lastSample - 1) / TileSize; ts++) {
+          int &index = tileIndex[tl * tileSamples + ts];
+          if (index < 0) {
+            Tile tile;
+            tile.firstSample = ts * TileSize + 1;
+            tile.lastSample = min(this->OutputCubes[0]->sampleCount(), (ts + 1) * TileSize);
+            tile.firstLine = tl * TileSize + 1;
+            tile.lastLine = min(this->OutputCubes[0]->lineCount(), (tl + 1) * TileSize);
+            tiles.append(tile);
+            index = tiles.size() - 1;
+          }
+          tiles[index].polygons.append(p);
+        }
+      }
+    }
+
+    QtConcurrent::blockingMap(tiles, [this](Tile &tile) {
+      try {
+        RasterizeTile(tile);
+      }
+      catch (IException &e) {
+        tile.error = QSharedPointer<IException>(new IException(e));
+      }
+    });
+
+    m_polygons.clear();
+
+    for (int t = 0; t < tiles.size(); t++) {
+      if (tiles[t].error) {
+        throw *tiles[t].error;
+      }
+    }
+  }
+
+
+  /**
+   * Rasterizes the polygons of one output tile. The tile is read from the average and count
+   * cubes, the polygons are added to it and it is written back.
+   *
+   * When the centers of the output pixels are used, each line of the tile is filled between
+   * the pairs of points where the polygon edges cross it. A pixel center on an edge is not
+   * inside of the polygon. Otherwise a pixel is covered if any part of it touches the polygon.
+   *
+   * @param tile The tile and its polygons
+   */
+  void ProcessPolygons::RasterizeTile(Tile &tile) {
+    int samples = tile.lastSample - tile.firstSample + 1;
+    int lines = tile.lastLine - tile.firstLine + 1;
+    int bands = this->OutputCubes[0]->bandCount();
+
+    Brick average(*this->OutputCubes[0], samples, lines, bands);
+    Brick count(*this->OutputCubes[1], samples, lines, bands);
+    average.SetBasePosition(tile.firstSample, tile.firstLine, 1);
+    count.SetBasePosition(tile.firstSample, tile.firstLine, 1);
+    this->OutputCubes[0]->read(average);
+    this->OutputCubes[1]->read(count);
+
+    std::vector<double> crossings;
+    std::vector<double> horizontals;
+    for (int p = 0; p < tile.polygons.size(); p++) {
+      const PendingPolygon &poly = m_polygons[tile.polygons[p]];
+      const std::vector<double> &edges = poly.edges;
+      int firstSample = max(poly.firstSample, tile.firstSample);
+      int lastSample = min(poly.lastSample, tile.lastSample);
+      int firstLine = max(poly.firstLine, tile.firstLine);
+      int lastLine = min(poly.lastLine, tile.lastLine);
+
+      for (int y = firstLine; y <= lastLine; y++) {
+        int row = (y - tile.firstLine) * samples - tile.firstSample;
+
+        if (m_useCenter) {
+          // Find where the edges cross the line, and the edges along it
+          crossings.clear();
+          horizontals.clear();
+          for (unsigned int e = 0; e < edges.size(); e += 4) {
+            double x1 = edges[e], y1 = edges[e + 1], x2 = edges[e + 2], y2 = edges[e + 3];
+            if ((y1 > y) != (y2 > y)) {
+              crossings.push_back(x1 + (y - y1) * (x2 - x1) / (y2 - y1));
+            }
+            else if (y1 == y && y2 == y) {
+              horizontals.push_back(min(x1, x2));
+              horizontals.push_back(max(x1, x2));
+            }
+          }
+          sort(crossings.begin(), crossings.end());
+
+          for (unsigned int c = 0; c + 1 < crossings.size(); c += 2) {
+            int first = max(firstSample, (int) floor(crossings[c]) + 1);
+            int last = min(lastSample, (int) ceil(crossings[c + 1]) - 1);
+            for (int x = first; x <= last; x++) {
+              bool onEdge = false;
+              for (unsigned int h = 0; h < horizontals.size(); h += 2) {
+                onEdge = onEdge || (x >= horizontals[h] && x <= horizontals[h + 1]);
+              }
+              if (!onEdge) {
+                addValues(poly.dns, poly.band, average, count, row + x);
+              }
+            }
+          }
+        }
+        else {
+          for (int x = firstSample; x <= lastSample; x++) {
+            if (touchesBox(edges, x - 0.5, x + 0.5, y - 0.5, y + 0.5)) {
+              addValues(poly.dns, poly.band, average, count, row + x);
+            }
+          }
+        }
+      }
+    }
+
+    // Write the tile back out to the average and count cubes
+    this->OutputCubes[0]->write(average);
+    this->OutputCubes[1]->write(count);
   }
 
 
@@ -244,9 +489,9 @@ namespace Isis {
    */
   void ProcessPolygons::EndProcess() {
 
+    FlushPolygons();
     delete m_imagePoly;
-    delete m_average;
-    delete m_count;
+    m_imagePoly = NULL;
     Process::EndProcess();
   }
 
@@ -257,9 +502,9 @@ namespace Isis {
    */
   void ProcessPolygons::Finalize() {
 
+    FlushPolygons();
     delete m_imagePoly;
-    delete m_average;
-    delete m_count;
+    m_imagePoly = NULL;
     Process::Finalize();
   }
 
@@ -325,21 +570,6 @@ namespace Isis {
 
     OutputCubes[0]->addCachingAlgorithm(new BoxcarCachingAlgorithm());
     OutputCubes[1]->addCachingAlgorithm(new BoxcarCachingAlgorithm());
-
-    geos::geom::CoordinateArraySequence imagePts;
-
-    imagePts.add(geos::geom::Coordinate(0.0, 0.0));
-    imagePts.add(geos::geom::Coordinate(0.0, this->OutputCubes[0]->lineCount()));
-    imagePts.add(geos::geom::Coordinate(this->OutputCubes[0]->sampleCount(),
-                                        this->OutputCubes[0]->lineCount()));
-    imagePts.add(geos::geom::Coordinate(this->OutputCubes[0]->sampleCount(), 0.0));
-    imagePts.add(geos::geom::Coordinate(0.0, 0.0));
-
-    m_imagePoly = Isis::globalFactory->createPolygon(
-                    globalFactory->createLinearRing(imagePts), NULL);
-
-    m_average = new Brick(*this->OutputCubes[0], 1, 1, nbands);
-    m_count = new Brick(*this->OutputCubes[1], 1, 1, nbands);
   }
 
 
@@ -72,15 +72,37 @@ namespace Isis {
       void Finalize();
 
     private:
+      /**
+       * An output polygon waiting to be rasterized. Its rings are kept as a list of edges in
+       * output sample/line coordinates, already clipped to the output image.
+       */
+      struct PendingPolygon {
+        std::vector<double> edges;  //!< x1, y1, x2, y2 of each edge of every ring
+        std::vector<double> dns;    //!< The values written to the covered pixels
+        int band;                   //!< The output band of a single value or -1 for all bands
+        int firstSample;            //!< The first output sample the polygon may cover
+        int lastSample;             //!< The last output sample the polygon may cover
+        int firstLine;              //!< The first output line the polygon may cover
+        int lastLine;               //!< The last output line the polygon may cover
+      };
+
+      struct Tile;
+
       void FillPolygon(int Flag);
+      void FlushPolygons();
+      void RasterizeTile(Tile &tile);
       void GetPolygonCoords();
 
+      //! The samples and lines of the output tiles rasterized in parallel
+      static const int TileSize = 128;
+      //! The number of polygons buffered before they are rasterized
+      static const int MaxPendingPolygons = 100000;
+
       bool m_useCenter;
       std::vector<double> m_sampleVertices, m_lineVertices, m_dns;
       int m_band;
-      Brick *m_average;
-      Brick *m_count;
       geos::geom::Polygon *m_imagePoly;
+      std::vector<PendingPolygon> m_polygons; //!< The polygons not rasterized yet
 
   };
 
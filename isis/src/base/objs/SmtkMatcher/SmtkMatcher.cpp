@@ -11,7 +11,10 @@ find files of those names at the top level of this repository. **/
 #include <iostream>
 #include <iomanip>
 
+#include <QAtomicInt>
 #include <QSharedPointer>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 
 #include "Camera.h"
 #include "Projection.h"
@@ -76,8 +79,9 @@ namespace Isis {
    * @param regdef Gruen definitions Pvl file
    */
   void SmtkMatcher::setGruenDef(const QString &regdef) {
-    Pvl reg(regdef);
-    m_gruen = QSharedPointer<Gruen> (new Gruen(reg));  // Deallocation automatic
+    m_regdef = Pvl(regdef);
+    m_gruen = QSharedPointer<Gruen> (new Gruen(m_regdef));  // Deallocation automatic
+    m_workers.clear();
     return;
   }
 
@@ -337,69 +341,92 @@ namespace Isis {
     // Validate object state
     validate();
 
-    // Test if the left point is defined. This will throw an error if this
-    // situation occurs
-    if (!lpg.getPoint().isValid()) {
-      QString mess = "Left point is not defined which is required";
-      throw IException(IException::Programmer, mess, _FILEINFO_);
+    PointGeometry left, right;
+    SmtkPoint failed;
+    if (!loadChips(lpg, rpg, *m_gruen->PatternChip(), *m_gruen->SearchChip(),
+                   left, right, failed)) {
+      return (failed);
     }
 
-   // First we need a lat,lon from the left image to find the same place in
-    // the right image.
-    Coordinate lpnt = lpg.getPoint();
-    Coordinate lgeom = lpg.getGeometry();
-    if (!lgeom.isValid()) {
-      lgeom = getLatLon(lhCamera(), lpnt);
-    }
+    // Register the points with incoming affine/radiometric parameters
+    m_gruen->setAffineRadio(affrad);
+    AutoReg::RegisterStatus status = m_gruen->Register();
 
-    // Construct geometry and check validity
-    PointGeometry left = PointGeometry(lpnt, lgeom);
-    if (!left.isValid()) {
-      m_offImage++;
-      return ( SmtkPoint(PointPair(lpnt), PointPair(lgeom)) );
+    MatchPoint match;
+    Coordinate rcorr;
+    if (status == AutoReg::SuccessSubPixel) {
+      match = m_gruen->getLastMatch();
+      rcorr = Coordinate(m_gruen->CubeLine(), m_gruen->CubeSample());
     }
+    return (makeRegisteredPoint(left, right, status, match, rcorr));
+  }
 
-    // Validate the right point
-    Coordinate rpnt = rpg.getPoint();
-    Coordinate rgeom = rpg.getGeometry();
-    if ( !rpnt.isValid() ) {
-      if (rgeom.isValid()) {
-        rpnt = getLineSample(rhCamera(), rgeom);
-      }
-      else {
-        rpnt = getLineSample(rhCamera(), lgeom);
-        rgeom = lgeom;
-      }
-    }
-    else if (!rgeom.isValid() ){
-      rgeom = getLatLon(rhCamera(), rpnt);
-    }
 
-    //  Construct and for good right geometry
-    PointGeometry right = PointGeometry(rpnt, rgeom);
-    if (!right.isValid()) {
-      m_spiceErr++;
-      return (SmtkPoint(PointPair(lpnt, rpnt), PointPair(lgeom, rgeom)));
+  /**
+   * @brief Register a batch of left image points concurrently
+   *
+   * Each point is registered as by Register(const Coordinate &) with the
+   * default affine/radiometric parameters.  See registerBatch() for how the
+   * work is split between threads.
+   *
+   * @param lpnts Line/Sample coordinates in the left image
+   *
+   * @return QVector<SmtkPoint> The registered points, in the same order.  Test
+   *         each for validity to evaluate success.
+   */
+  QVector<SmtkPoint> SmtkMatcher::Register(const QVector<Coordinate> &lpnts) {
+    QVector<Registration> batch(lpnts.size());
+    for (int i = 0 ; i < lpnts.size() ; i++) {
+      batch[i].lpg = PointGeometry(lpnts[i]);
     }
 
-    try {
-      // These calls are computationally expensive... can we fix it?
-      m_gruen->PatternChip()->TackCube(lpnt.getSample(), lpnt.getLine());
-      m_gruen->PatternChip()->Load(*m_lhCube);
-      m_gruen->SearchChip()->TackCube(rpnt.getSample(), rpnt.getLine());
-      m_gruen->SearchChip()->Load(*m_rhCube, *m_gruen->PatternChip(),
-                                  *m_lhCube);
+    registerBatch(batch);
+
+    QVector<SmtkPoint> points(batch.size());
+    for (int i = 0 ; i < batch.size() ; i++) {
+      points[i] = batch[i].result;
     }
-    catch (IException &) {
-      m_offImage++;  // Failure to load is assumed an offimage error
-      return (SmtkPoint(PointPair(lpnt,rpnt), PointPair(lgeom,rgeom)));
+    return (points);
+  }
+
+
+  /**
+   * @brief Register a batch of SmtkPoints concurrently
+   *
+   * Each point is registered as by Register(const SmtkPoint &, const
+   * AffineRadio &) using the affine/radiometric parameters of the point.
+   * Points that are already registered are returned as they are.
+   *
+   * @param spnts SmtkPoints to register
+   *
+   * @return QVector<SmtkPoint> The registered points, in the same order.  Test
+   *         each for validity to evaluate success.
+   */
+  QVector<SmtkPoint> SmtkMatcher::Register(const QVector<SmtkPoint> &spnts) {
+    QVector<SmtkPoint> points = spnts;
+
+    QVector<int> indices;
+    QVector<Registration> batch;
+    for (int i = 0 ; i < spnts.size() ; i++) {
+      if (!spnts[i].isRegistered()) {
+        Registration reg;
+        reg.lpg = PointGeometry(spnts[i].getLeft());
+        reg.rpg = PointGeometry(spnts[i].getRight());
+        reg.affrad = spnts[i].getAffine();
+        batch.append(reg);
+        indices.append(i);
+      }
     }
 
-    // Register the points with incoming affine/radiometric parameters
-    m_gruen->setAffineRadio(affrad);
-    return (makeRegisteredPoint(left, right, m_gruen.data()));
+    registerBatch(batch);
+
+    for (int i = 0 ; i < batch.size() ; i++) {
+      points[indices[i]] = batch[i].result;
+    }
+    return (points);
   }
 
+
   /**
    * @brief Create a valid, unregistered SmtkPoint
    *
@@ -599,38 +626,222 @@ namespace Isis {
   }
 
   /**
-   * @brief Create an SmtkPoint from Gruen match result
+   * @brief Validate the geometry of two points and load their chips
+   *
+   * This method determines the valid geometry of the left point.  If the right
+   * point is not defined, it uses the left geometry to determine the right
+   * point to register the left point with.  If the right point is defined, it
+   * verifies the point has valid geometry mapping in the right image.  All
+   * points and geometry must fall within the boundaries of the image and be
+   * valid or the point is deemed invalid.
+   *
+   * The pattern chip is then loaded from the left image and the search chip is
+   * loaded from the right image according to the geometry of the pattern chip.
+   * This uses the cameras, so it must not be called concurrently.
+   *
+   * @param lpg     Left point to register
+   * @param rpg     Right point to register, may be undefined
+   * @param pattern Pattern chip to load
+   * @param search  Search chip to load
+   * @param left    Returns the left point with its geometry
+   * @param right   Returns the right point with its geometry
+   * @param failed  Returns the invalid point if the geometry is not valid or
+   *                the chips cannot be loaded
+   *
+   * @return bool True if the chips were loaded and can be registered
+   */
+  bool SmtkMatcher::loadChips(const PointGeometry &lpg, const PointGeometry &rpg,
+                              Chip &pattern, Chip &search, PointGeometry &left,
+                              PointGeometry &right, SmtkPoint &failed) {
+
+    // Test if the left point is defined. This will throw an error if this
+    // situation occurs
+    if (!lpg.getPoint().isValid()) {
+      QString mess = "Left point is not defined which is required";
+      throw IException(IException::Programmer, mess, _FILEINFO_);
+    }
+
+   // First we need a lat,lon from the left image to find the same place in
+    // the right image.
+    Coordinate lpnt = lpg.getPoint();
+    Coordinate lgeom = lpg.getGeometry();
+    if (!lgeom.isValid()) {
+      lgeom = getLatLon(lhCamera(), lpnt);
+    }
+
+    // Construct geometry and check validity
+    left = PointGeometry(lpnt, lgeom);
+    if (!left.isValid()) {
+      m_offImage++;
+      failed = SmtkPoint(PointPair(lpnt), PointPair(lgeom));
+      return (false);
+    }
+
+    // Validate the right point
+    Coordinate rpnt = rpg.getPoint();
+    Coordinate rgeom = rpg.getGeometry();
+    if ( !rpnt.isValid() ) {
+      if (rgeom.isValid()) {
+        rpnt = getLineSample(rhCamera(), rgeom);
+      }
+      else {
+        rpnt = getLineSample(rhCamera(), lgeom);
+        rgeom = lgeom;
+      }
+    }
+    else if (!rgeom.isValid() ){
+      rgeom = getLatLon(rhCamera(), rpnt);
+    }
+
+    //  Construct and for good right geometry
+    right = PointGeometry(rpnt, rgeom);
+    if (!right.isValid()) {
+      m_spiceErr++;
+      failed = SmtkPoint(PointPair(lpnt, rpnt), PointPair(lgeom, rgeom));
+      return (false);
+    }
+
+    try {
+      // These calls are computationally expensive... can we fix it?
+      pattern.TackCube(lpnt.getSample(), lpnt.getLine());
+      pattern.Load(*m_lhCube);
+      search.TackCube(rpnt.getSample(), rpnt.getLine());
+      search.Load(*m_rhCube, pattern, *m_lhCube);
+    }
+    catch (IException &) {
+      m_offImage++;  // Failure to load is assumed an offimage error
+      failed = SmtkPoint(PointPair(lpnt,rpnt), PointPair(lgeom,rgeom));
+      return (false);
+    }
+
+    return (true);
+  }
+
+
+  /**
+   * @brief Register a batch of points with the Gruen matcher of each thread
+   *
+   * The chips of every point are loaded on the calling thread first, because
+   * the cameras are not thread safe.  The loaded points are then registered
+   * concurrently, each thread in the global thread pool using its own copy of
+   * the Gruen algorithm, and the results are checked against the right image
+   * on the calling thread.  The results do not depend on the number of
+   * threads.
+   *
+   * @param batch Points to register.  The result of each is returned in it.
+   */
+  void SmtkMatcher::registerBatch(QVector<Registration> &batch) {
+    validate();
+    if (batch.isEmpty()) return;
+
+    for (int i = 0 ; i < batch.size() ; i++) {
+      Registration &reg = batch[i];
+      reg.pattern = *m_gruen->PatternChip();
+      reg.search = *m_gruen->SearchChip();
+      reg.loaded = loadChips(reg.lpg, reg.rpg, reg.pattern, reg.search,
+                             reg.left, reg.right, reg.result);
+    }
+
+    int numWorkers = qMax(1, qMin(QThreadPool::globalInstance()->maxThreadCount(),
+                                  batch.size()));
+    QVector<int> workerIndices;
+    for (int w = 0 ; w < numWorkers ; w++) {
+      if (w >= m_workers.size()) {
+        m_workers.append(QSharedPointer<Gruen> (new Gruen(m_regdef)));
+      }
+      workerIndices.append(w);
+    }
+
+    Registration *regs = batch.data();
+    int nregs = batch.size();
+    QAtomicInt next(0);
+    QtConcurrent::blockingMap(workerIndices, [&](int w) {
+      Gruen *gruen = m_workers[w].data();
+      int i;
+      while ((i = next.fetchAndAddOrdered(1)) < nregs) {
+        Registration &reg = regs[i];
+        if (!reg.loaded) continue;
+        try {
+          *gruen->PatternChip() = reg.pattern;
+          *gruen->SearchChip() = reg.search;
+          gruen->setAffineRadio(reg.affrad);
+          reg.status = gruen->Register();
+          if (reg.status == AutoReg::SuccessSubPixel) {
+            reg.match = gruen->getLastMatch();
+            reg.rcorr = Coordinate(gruen->CubeLine(), gruen->CubeSample());
+          }
+        }
+        catch (IException &ie) {
+          reg.error = QSharedPointer<IException>(new IException(ie));
+        }
+      }
+    });
+
+    for (int i = 0 ; i < batch.size() ; i++) {
+      Registration &reg = batch[i];
+      if (reg.error) throw *reg.error;
+      if (reg.loaded) {
+        reg.result = makeRegisteredPoint(reg.left, reg.right, reg.status,
+                                         reg.match, reg.rcorr);
+      }
+    }
+    return;
+  }
+
+
+  /**
+   * @brief Returns the registration statistics of all Gruen matchers
+   *
+   * The statistics of the matchers used to register batches of points are
+   * added to those of the matcher used to register single points.
    *
-   * This method applies the Gruen registration to the points as provided.  It
-   * assumes the points have been already set up in the gruen algorithm (@see
-   * Register()) and simply calls the Gruen::RegisterI() function.
+   * @return Pvl Gruen registration statistics
+   */
+  Pvl SmtkMatcher::RegistrationStatistics() {
+    validate();
+    if (m_workers.isEmpty()) {
+      return (m_gruen->RegistrationStatistics());
+    }
+
+    Gruen total(m_regdef);
+    total.AddStatistics(*m_gruen);
+    for (int w = 0 ; w < m_workers.size() ; w++) {
+      total.AddStatistics(*m_workers[w]);
+    }
+    return (total.RegistrationStatistics());
+  }
+
+
+  /**
+   * @brief Create an SmtkPoint from Gruen match result
    *
-   * The result is the transformed into a SmtkPoint base upon the result of the
-   * registration.  The status of the point is set to reflect the registration
-   * processing result.
+   * This method transforms the result of a Gruen registration of the points
+   * (@see Register()) into a SmtkPoint.  The status of the point is set to
+   * reflect the registration processing result.  The registered point is
+   * mapped into the right image, so this must not be called concurrently.
    *
    * @author Kris Becker - 5/26/2011
    *
-   * @param left  Left point with geometry
-   * @param right RIght point with geometry
-   * @param gruen Gruen algorithm to use to register points
+   * @param left   Left point with geometry
+   * @param right  RIght point with geometry
+   * @param status Status of the Gruen registration
+   * @param match  Gruen match point of a successful registration
+   * @param rcorr  Registered right point of a successful registration
    *
    * @return SmtkPoint
    */
   SmtkPoint SmtkMatcher::makeRegisteredPoint(const PointGeometry &left,
                                              const PointGeometry &right,
-                                             Gruen *gruen) {
+                                             const AutoReg::RegisterStatus status,
+                                             const MatchPoint &match,
+                                             const Coordinate &rcorr) {
 
-    if (gruen->Register() != AutoReg::SuccessSubPixel) {
+    if (status != AutoReg::SuccessSubPixel) {
       return (SmtkPoint(PointPair(left.getPoint(),right.getPoint()),
                          PointPair(left.getGeometry(), right.getGeometry())));
     }
 
-    // Registration point data
-    MatchPoint match = gruen->getLastMatch();
-
     // Compute new right coordinate data
-    Coordinate rcorr = Coordinate(gruen->CubeLine(), gruen->CubeSample());
     Coordinate rgeom = getLatLon(rhCamera(), rcorr);
     PointGeometry rpoint = PointGeometry(rcorr, rgeom);
 
@@ -648,7 +859,7 @@ namespace Isis {
     else {
      // Check for distance error
       double dist = (rcorr - right.getPoint()).getDistance();
-      if (dist > gruen->getSpiceConstraint()) {
+      if (dist > m_gruen->getSpiceConstraint()) {
         m_spiceErr++;
         spnt.m_isValid = false;
       }
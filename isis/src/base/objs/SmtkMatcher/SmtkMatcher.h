@@ -11,7 +11,9 @@ find files of those names at the top level of this repository. **/
 #include <memory>
 
 
+#include <QList>
 #include <QSharedPointer>
+#include <QVector>
 #include "SmtkStack.h"
 #include "Gruen.h"
 #include "SmtkPoint.h"
@@ -32,6 +34,11 @@ namespace Isis {
  * The Gruen algorithm is initialized here and maintained for use in the
  * stereo matching process.
  *
+ * Batches of points can be registered concurrently.  The chips of a batch are
+ * loaded from the cubes on the calling thread, because the cameras are not
+ * thread safe, and then registered by a separate copy of the Gruen algorithm
+ * for each thread in the global thread pool.
+ *
  * @author 2011-05-28 Kris Becker
  *
  * @internal
@@ -89,6 +96,9 @@ class SmtkMatcher {
     SmtkPoint Register(const PointGeometry &lpg, const PointGeometry &rpg,
                        const AffineRadio &affrad  = AffineRadio());
 
+    QVector<SmtkPoint> Register(const QVector<Coordinate> &lpnts);
+    QVector<SmtkPoint> Register(const QVector<SmtkPoint> &spnts);
+
     SmtkPoint Create(const Coordinate &left, const Coordinate &right);
     SmtkPoint Clone(const SmtkPoint &point, const Coordinate &left);
 
@@ -97,16 +107,36 @@ class SmtkMatcher {
 
     /** Return Gruen template parameters */
     PvlGroup RegTemplate() { return (m_gruen->RegTemplate());  }
-    /** Return Gruen registration statistics */
-    Pvl RegistrationStatistics() { return (m_gruen->RegistrationStatistics()); }
+    Pvl RegistrationStatistics();
 
   private:
     SmtkMatcher &operator=(const SmtkMatcher &matcher); // Assignment disabled
     SmtkMatcher(const SmtkMatcher &matcher);            // Copy const disabled
 
+    /** The state of one point of a batch of registrations */
+    struct Registration {
+      Registration() : loaded(false), status(AutoReg::Success) { }
+
+      PointGeometry lpg;               // Requested left point
+      PointGeometry rpg;               // Requested right point
+      AffineRadio   affrad;            // Initial affine/radiometric parameters
+      PointGeometry left;              // Left point with geometry
+      PointGeometry right;             // Right point with geometry
+      Chip          pattern;           // Loaded pattern chip
+      Chip          search;            // Loaded search chip
+      bool          loaded;            // Chips were loaded, ready to register
+      SmtkPoint     result;            // Registered (or failed) point
+      AutoReg::RegisterStatus status;  // Gruen registration status
+      MatchPoint    match;             // Gruen match of a successful registration
+      Coordinate    rcorr;             // Registered right point
+      QSharedPointer<IException> error;  // Error thrown by the registration
+    };
+
     Cube     *m_lhCube;                // Left image cube (not owned)
     Cube     *m_rhCube;                // Right image cube (not owned)
+    Pvl       m_regdef;                // Gruen definitions
     QSharedPointer<Gruen> m_gruen;     // Gruen matcher
+    QList<QSharedPointer<Gruen> > m_workers;  // Gruen matcher of each thread
     BigInt  m_offImage;                // Offimage counter
     BigInt  m_spiceErr;                // SPICE distance error
     bool    m_useAutoReg;              // Select AutoReg features
@@ -124,8 +154,16 @@ class SmtkMatcher {
 
     bool inCube(const Camera &camera, const Coordinate &point) const;
 
+    bool loadChips(const PointGeometry &lpg, const PointGeometry &rpg,
+                   Chip &pattern, Chip &search, PointGeometry &left,
+                   PointGeometry &right, SmtkPoint &failed);
+    void registerBatch(QVector<Registration> &batch);
+
     SmtkPoint makeRegisteredPoint(const PointGeometry &left,
-                                  const PointGeometry &right, Gruen *gruen);
+                                  const PointGeometry &right,
+                                  const AutoReg::RegisterStatus status,
+                                  const MatchPoint &match,
+                                  const Coordinate &rcorr);
 };
 } // namespace Isis
 
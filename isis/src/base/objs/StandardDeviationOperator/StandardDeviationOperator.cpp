@@ -5,6 +5,11 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "StandardDeviationOperator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "Chip.h"
 #include "Statistics.h"
 
@@ -33,6 +38,77 @@ namespace Isis {
 
     return stats.StandardDeviation();
   }
+
+
+  /**
+   * This method calculates the interest of every window position in an area. The count, sum,
+   * and sum of squares of the valid pixels of every window are found with box filters instead
+   * of adding up each window.
+   *
+   * @param pArea         The area to calculate the interest of
+   * @param pInterest     Chip to put the interest of each window position into
+   * @param piSampleShift The sample shift of the Null part of each window
+   * @param piLineShift   The line shift of the Null part of each window
+   *
+   * @see InterestOperator::InterestImage
+   */
+  void StandardDeviationOperator::InterestImage(Chip &pArea, Chip &pInterest,
+                                                int piSampleShift, int piLineShift) {
+    int areaSamples = pArea.Samples();
+    int areaLines = pArea.Lines();
+    int windowSamples = areaSamples - pInterest.Samples() + 1;
+    int windowLines = areaLines - pInterest.Lines() + 1;
+
+    // The part of each window that is not Null
+    int firstSamp = std::max(1, 1 - piSampleShift);
+    int lastSamp = std::min(windowSamples, windowSamples - piSampleShift);
+    int firstLine = std::max(1, 1 - piLineShift);
+    int lastLine = std::min(windowLines, windowLines - piLineShift);
+    int boxSamples = lastSamp - firstSamp + 1;
+    int boxLines = lastLine - firstLine + 1;
+
+    std::vector<double> valid(areaSamples * areaLines);
+    std::vector<double> pixels(areaSamples * areaLines);
+    std::vector<double> squares(areaSamples * areaLines);
+    for (int line = 1; line <= areaLines; line++) {
+      const double *row = pArea.Row(line);
+      int index = (line - 1) * areaSamples;
+      for (int samp = 0; samp < areaSamples; samp++, index++) {
+        if (ValidDnValue(row[samp])) {
+          valid[index] = 1.0;
+          pixels[index] = row[samp];
+          squares[index] = row[samp] * row[samp];
+        }
+        else {
+          valid[index] = 0.0;
+          pixels[index] = 0.0;
+          squares[index] = 0.0;
+        }
+      }
+    }
+
+    std::vector<double> counts, sums, sumsums;
+    BoxSum(valid, areaSamples, areaLines, boxSamples, boxLines, counts);
+    BoxSum(pixels, areaSamples, areaLines, boxSamples, boxLines, sums);
+    BoxSum(squares, areaSamples, areaLines, boxSamples, boxLines, sumsums);
+
+    // Same as Statistics::StandardDeviation
+    int sumSamples = areaSamples - boxSamples + 1;
+    for (int line = 1; line <= pInterest.Lines(); line++) {
+      double *interest = pInterest.Row(line);
+      int index = (line + firstLine - 2) * sumSamples + firstSamp - 1;
+      for (int samp = 0; samp < pInterest.Samples(); samp++, index++) {
+        double count = counts[index];
+        if (count <= 1.0) {
+          interest[samp] = Isis::Null;
+          continue;
+        }
+        double temp = count * sumsums[index] - sums[index] * sums[index];
+        if (temp < 0.0) temp = 0.0;
+        interest[samp] = sqrt(temp / ((count - 1.0) * count));
+      }
+    }
+  }
 }
 
 extern "C" Isis::InterestOperator *StandardDeviationOperatorPlugin(Isis::Pvl &pPvl) {
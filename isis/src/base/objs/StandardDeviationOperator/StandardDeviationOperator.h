@@ -43,6 +43,8 @@ namespace Isis {
 
     protected:
       virtual double Interest(Chip &chip);
+      virtual void InterestImage(Chip &pArea, Chip &pInterest, int piSampleShift,
+                                 int piLineShift);
   };
 };
 
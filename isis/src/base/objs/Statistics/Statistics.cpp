@@ -252,6 +252,34 @@ namespace Isis {
   }
 
 
+  /**
+   * Add the data from another Statistics object to the accumulators and counters. This
+   * gives the same results as adding all of the other object's data to this object, so
+   * statistics gathered on separate pieces of a data set can be combined. The valid range of
+   * this object is kept and the other object's data is not checked against it.
+   *
+   * @param other The statistics to add.
+   */
+  void Statistics::AddStatistics(const Statistics &other) {
+    m_sum += other.m_sum;
+    m_sumsum += other.m_sumsum;
+    if (other.m_validPixels > 0) {
+      if (other.m_minimum < m_minimum) m_minimum = other.m_minimum;
+      if (other.m_maximum > m_maximum) m_maximum = other.m_maximum;
+    }
+    m_totalPixels += other.m_totalPixels;
+    m_validPixels += other.m_validPixels;
+    m_nullPixels += other.m_nullPixels;
+    m_lrsPixels += other.m_lrsPixels;
+    m_lisPixels += other.m_lisPixels;
+    m_hrsPixels += other.m_hrsPixels;
+    m_hisPixels += other.m_hisPixels;
+    m_underRangePixels += other.m_underRangePixels;
+    m_overRangePixels += other.m_overRangePixels;
+    m_removedData = m_removedData || other.m_removedData;
+  }
+
+
   void Statistics::SetValidRange(const double minimum, const double maximum) {
     m_validMinimum = minimum;
     m_validMaximum = maximum;
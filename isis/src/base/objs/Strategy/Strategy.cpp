@@ -6,15 +6,21 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Strategy.h"
 
+// std library
+#include <vector>
+
 // Qt library
+#include <QAtomicInt>
 #include <QScopedPointer>
 #include <QString>
 #include <QStringList>
+#include <QThread>
 
 // boost library
 #include <boost/foreach.hpp>
 
 // other ISIS
+#include "ConcurrentLoop.h"
 #include "IException.h"
 #include "GisGeometry.h"
 #include "Progress.h"
@@ -378,6 +384,46 @@ namespace Isis {
     m_total = 0;
     return;
   }
+
+
+  /** 
+   * @brief Number of threads to use for concurrent operations 
+   *  
+   * This is the value of the MaxThreads keyword in the strategy definition. 
+   * If it is 0 or less, the ideal number of threads for the system is used. 
+   * Debugging always uses a single thread so the output stays in order. 
+   * Defaults to 1. 
+   *  
+   * @return int Number of threads, at least 1
+   */ 
+  int Strategy::maxThreads() const {
+    int threads = toInt(getDefinitionMap().get("MaxThreads", "1"));
+    if ( threads <= 0 ) { threads = QThread::idealThreadCount(); }
+    if ( isDebug() ) { threads = 1; }
+    return ( qMax(1, threads) );
+  }
+
+
+  /** 
+   * @brief Runs work for each index on up to maxThreads() threads 
+   *  
+   * The work is called once for each index from 0 to count - 1 and processed() 
+   * is called after each one. With one thread the indexes are processed in 
+   * order on the calling thread. Otherwise the threads take the next index 
+   * as they become free, so the work must be safe to run for different 
+   * indexes at the same time. 
+   *  
+   * If the work throws, no more indexes are started and the first exception 
+   * is rethrown once the running ones are done. See ConcurrentLoop. 
+   *  
+   * @param count Number of indexes to process
+   * @param work  Processes one index
+   */ 
+  void Strategy::runConcurrently(const int &count, 
+                                 const std::function<void (const int &)> &work) {
+    ConcurrentLoop::run(count, maxThreads(), work, [this]() { processed(); });
+    return;
+  }
   
   
   /** 
@@ -916,6 +962,11 @@ namespace Isis {
    * postives as the envelope used in the RTree method may not be as accurate 
    * as is required for a robust intersection of GIS geometries. 
    *  
+   * If MaxThreads is more than 1, the direct intersections and the calls to 
+   * Strategy::apply(SharedResource &) are run concurrently (see 
+   * runConcurrently()). Strategies that use this method must then make sure 
+   * their apply(SharedResource &) only changes the Resource it is given. 
+   *  
    * @author 2013-02-23  Kris Becker
    * 
    *  
@@ -951,15 +1002,24 @@ namespace Isis {
       }
 
       // Direct intersect computations of overlaps has about the same overhead 
-      // of constructing an RTree index and running queries.
+      // of constructing an RTree index and running queries. The prepared
+      // geometry of geom is used by one thread at a time, so concurrent
+      // threads test with the prepared geometry of each Resource instead.
+      bool concurrent = ( maxThreads() > 1 );
+      vector<char> hits(v_active.size(), 0);
       initProgress(v_active.size());
-      BOOST_FOREACH ( SharedResource resource, v_active ) {
+      runConcurrently(v_active.size(), [&](const int &i) {
+        const SharedResource &resource = v_active.at(i);
         if ( resource->hasValidGeometry() ) {
-          if ( geom.intersects( *resource->geometry()) ) {
-            overlaps.append(resource);
-          }
+          hits[i] = ( concurrent ) ? resource->geometry()->intersects(geom) :
+                                     geom.intersects( *resource->geometry());
+        }
+      });
+
+      for ( int i = 0 ; i < v_active.size() ; i++ ) {
+        if ( hits[i] ) {
+          overlaps.append(v_active[i]);
         }
-        processed();
       }
     }
     else {
@@ -1016,19 +1076,19 @@ namespace Isis {
     deactivateList(v_active);
 
     initProgress(overlaps.size());
-    int n = 0;  // Result count
-    BOOST_FOREACH ( SharedResource resource, overlaps ) {
+    QAtomicInt n(0);  // Result count
+    runConcurrently(overlaps.size(), [&](const int &i) {
+      SharedResource resource = overlaps.at(i);
       resource->activate();
-      n += apply(resource, globals);
-      processed();
-    }
+      n.fetchAndAddOrdered(apply(resource, globals));
+    });
 
 
     if ( isDebug() ) {
-      cout << "Total valid Intersections Found: " << n << "\n"; 
+      cout << "Total valid Intersections Found: " << n.load() << "\n"; 
     }
   
-    return (n);
+    return (n.load());
   }
   
   
@@ -1038,8 +1098,8 @@ namespace Isis {
    * This method accumulates the resources that are determined to potentially 
    * overlap the resource geometry provided in the GEOS query. 
    *  
-   * This implementation may not be portable or safe. It most certainly is not 
-   * threadable.  (I am open for suggestions on how to do this better...) 
+   * This implementation may not be portable or safe. Concurrent queries can use 
+   * it only if each one is given its own ResourceList. 
    * 
    * @author 2015-03-27 Kris Becker 
    * 
@@ -7,6 +7,9 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 
+// std library
+#include <functional>
+
 // Qt library
 #include <QList>
 #include <QPair>
@@ -127,6 +130,9 @@ namespace Isis {
      int applyToResources(ResourceList &resources, const ResourceList &globals);
      unsigned int processed();
      void resetProcessed();
+
+     int maxThreads() const;
+     void runConcurrently(const int &count, const std::function<void (const int &)> &work);
   
      int countActive(const ResourceList &resources) const;
      int countDiscarded(const ResourceList &resources) const;
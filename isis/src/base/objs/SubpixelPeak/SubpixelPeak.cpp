@@ -0,0 +1,208 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include "SubpixelPeak.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Refines a peak by fitting z = a0 + a1 x + a2 y + a3 x^2 + a4 xy + a5 y^2 to the valid
+   * pixels of a window centered on it, where x and y are offsets from the peak. The extremum
+   * of the fit is where both partial derivatives are zero.
+   *
+   * The normal equations are accumulated into a fixed 6x6 matrix while walking the lines of
+   * the window, then solved with a Cholesky decomposition, so no memory is allocated.
+   *
+   * @param surface      The surface, stored by line
+   * @param samples      The number of samples in the surface
+   * @param lines        The number of lines in the surface
+   * @param sample       The zero based sample of the whole pixel peak
+   * @param line         The zero based line of the whole pixel peak
+   * @param windowSize   The size of the window to fit. It is clipped to the surface.
+   * @param sampleOffset Output sample offset of the extremum from the peak
+   * @param lineOffset   Output line offset of the extremum from the peak
+   *
+   * @return @b bool False if there are too few valid pixels, the fit has a saddle point or
+   *         no unique extremum, or the extremum is outside of the window
+   */
+  bool SubpixelPeak::Paraboloid(const double *surface, int samples, int lines,
+                                int sample, int line, int windowSize,
+                                double &sampleOffset, double &lineOffset) {
+    const int N = 6;
+    int half = windowSize / 2;
+    int firstSamp = max(0, sample - half);
+    int lastSamp = min(samples - 1, sample + half);
+    int firstLine = max(0, line - half);
+    int lastLine = min(lines - 1, line + half);
+
+    double ata[N][N] = { { 0.0 } };
+    double atz[N] = { 0.0 };
+    int count = 0;
+    for (int l = firstLine; l <= lastLine; l++) {
+      const double *row = surface + l * samples;
+      double y = l - line;
+      for (int s = firstSamp; s <= lastSamp; s++) {
+        double z = row[s];
+        if (IsSpecial(z)) continue;
+
+        double x = s - sample;
+        double a[N] = { 1.0, x, y, x * x, x * y, y * y };
+        for (int i = 0; i < N; i++) {
+          for (int j = i; j < N; j++) {
+            ata[i][j] += a[i] * a[j];
+          }
+          atz[i] += a[i] * z;
+        }
+        count++;
+      }
+    }
+    if (count < N) return false;
+
+    // Cholesky decomposition of the upper triangle into the lower triangle and diagonal
+    double diag[N];
+    for (int i = 0; i < N; i++) {
+      for (int j = i; j < N; j++) {
+        double sum = ata[i][j];
+        for (int k = 0; k < i; k++) {
+          sum -= ata[i][k] * ata[j][k];
+        }
+        if (i == j) {
+          if (sum <= 1.0e-12 * ata[i][i]) return false;
+          diag[i] = sqrt(sum);
+        }
+        else {
+          ata[j][i] = sum / diag[i];
+        }
+      }
+    }
+
+    double coef[N];
+    for (int i = 0; i < N; i++) {
+      double sum = atz[i];
+      for (int k = 0; k < i; k++) {
+        sum -= ata[i][k] * coef[k];
+      }
+      coef[i] = sum / diag[i];
+    }
+    for (int i = N - 1; i >= 0; i--) {
+      double sum = coef[i];
+      for (int k = i + 1; k < N; k++) {
+        sum -= ata[k][i] * coef[k];
+      }
+      coef[i] = sum / diag[i];
+    }
+
+    // Solve [2a3 a4; a4 2a5] [x y]' = -[a1 a2]'
+    double det = 4.0 * coef[3] * coef[5] - coef[4] * coef[4];
+    if (det <= 0.0) return false;
+    double x = (coef[2] * coef[4] - 2.0 * coef[1] * coef[5]) / det;
+    double y = (coef[1] * coef[4] - 2.0 * coef[2] * coef[3]) / det;
+    if (fabs(x) > half || fabs(y) > half) return false;
+
+    sampleOffset = x;
+    lineOffset = y;
+    return true;
+  }
+
+
+  /**
+   * Refines a peak by fitting a parabola through the peak and its two neighbors along
+   * each axis, independently. The offset along an axis is (f(-1) - f(1)) / (2 (f(-1) - 2 f(0)
+   * + f(1))).
+   *
+   * @param surface      The surface, stored by line
+   * @param samples      The number of samples in the surface
+   * @param lines        The number of lines in the surface
+   * @param sample       The zero based sample of the whole pixel peak
+   * @param line         The zero based line of the whole pixel peak
+   * @param sampleOffset Output sample offset of the extremum from the peak
+   * @param lineOffset   Output line offset of the extremum from the peak
+   *
+   * @return @b bool False if the peak is on the edge of the surface, a neighbor is not
+   *         valid, a parabola is flat, or the extremum is more than a pixel away
+   */
+  bool SubpixelPeak::Parabola(const double *surface, int samples, int lines,
+                              int sample, int line,
+                              double &sampleOffset, double &lineOffset) {
+    if (sample < 1 || sample > samples - 2 || line < 1 || line > lines - 2) return false;
+
+    const double *center = surface + line * samples + sample;
+    double z = center[0];
+    double left = center[-1];
+    double right = center[1];
+    double up = center[-samples];
+    double down = center[samples];
+    if (IsSpecial(z) || IsSpecial(left) || IsSpecial(right) ||
+        IsSpecial(up) || IsSpecial(down)) {
+      return false;
+    }
+
+    double sampleCurve = left - 2.0 * z + right;
+    double lineCurve = up - 2.0 * z + down;
+    if (sampleCurve == 0.0 || lineCurve == 0.0) return false;
+
+    double x = (left - right) / (2.0 * sampleCurve);
+    double y = (up - down) / (2.0 * lineCurve);
+    if (fabs(x) > 1.0 || fabs(y) > 1.0) return false;
+
+    sampleOffset = x;
+    lineOffset = y;
+    return true;
+  }
+
+
+  /**
+   * Refines the peak of a phase correlation surface along each axis, independently, from the
+   * peak and its larger neighbor (Foroosh, Zerubia and Berthod, 2002). The peak of a phase
+   * correlation surface is a sinc, for which the offset toward the larger neighbor f(1) is
+   * exactly f(1) / (f(1) + f(0)). If neither neighbor is positive the peak is on the whole pixel.
+   *
+   * @param surface      The surface, stored by line
+   * @param samples      The number of samples in the surface
+   * @param lines        The number of lines in the surface
+   * @param sample       The zero based sample of the whole pixel peak
+   * @param line         The zero based line of the whole pixel peak
+   * @param sampleOffset Output sample offset of the peak
+   * @param lineOffset   Output line offset of the peak
+   *
+   * @return @b bool False if the peak is on the edge of the surface, a neighbor is not
+   *         valid, or the pixel is not a positive maximum along both axes
+   */
+  bool SubpixelPeak::PhaseCorrelation(const double *surface, int samples, int lines,
+                                      int sample, int line,
+                                      double &sampleOffset, double &lineOffset) {
+    if (sample < 1 || sample > samples - 2 || line < 1 || line > lines - 2) return false;
+
+    const double *center = surface + line * samples + sample;
+    double z = center[0];
+    double left = center[-1];
+    double right = center[1];
+    double up = center[-samples];
+    double down = center[samples];
+    if (IsSpecial(z) || IsSpecial(left) || IsSpecial(right) ||
+        IsSpecial(up) || IsSpecial(down)) {
+      return false;
+    }
+    if (z <= 0.0 || left > z || right > z || up > z || down > z) return false;
+
+    double sampleNext = max(left, right);
+    double lineNext = max(up, down);
+    double x = (sampleNext > 0.0) ? sampleNext / (sampleNext + z) : 0.0;
+    double y = (lineNext > 0.0) ? lineNext / (lineNext + z) : 0.0;
+
+    sampleOffset = (right >= left) ? x : -x;
+    lineOffset = (down >= up) ? y : -y;
+    return true;
+  }
+}
@@ -0,0 +1,55 @@
+#ifndef SubpixelPeak_h
+#define SubpixelPeak_h
+
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+namespace Isis {
+  /**
+   * @brief Subpixel refinement of the peak of a match surface
+   *
+   * Area based matchers produce a surface of goodness of fit values, such as an AutoReg fit
+   * chip or an OpenCV template matching result, whose best whole pixel is the match. These
+   * kernels refine the best whole pixel to the subpixel location of the extremum of the
+   * surface around it. They work for both maxima and minima.
+   *
+   * The surfaces are stored by line, with the samples of each line contiguous, as in a Chip
+   * or a single channel cv::Mat converted to doubles. Special pixels are not used. The
+   * locations are zero based indexes into the surface, and the refined location is returned
+   * as an offset from the whole pixel.
+   *
+   * <ul>
+   *   <li>Paraboloid fits a 2-D quadratic to a window around the peak by least squares and
+   *       solves for its extremum. It uses every valid pixel in the window, so it is the
+   *       most robust to noise.</li>
+   *   <li>Parabola fits a parabola through the peak and its two neighbors along each axis.
+   *       It is the usual three point peak interpolation of correlation surfaces, and it is
+   *       the fastest.</li>
+   *   <li>PhaseCorrelation uses the peak and its larger neighbor along each axis. The peak
+   *       of a phase correlation surface is a sinc rather than a parabola, and for a sinc the
+   *       ratio of the neighbor to the sum of the two is the offset. It only finds maxima.</li>
+   * </ul>
+   *
+   * AutoReg also refines its fit chip peak with a weighted center of mass, see Centroid.
+   *
+   * @ingroup PatternMatching
+   */
+  class SubpixelPeak {
+    public:
+      static bool Paraboloid(const double *surface, int samples, int lines,
+                             int sample, int line, int windowSize,
+                             double &sampleOffset, double &lineOffset);
+      static bool Parabola(const double *surface, int samples, int lines,
+                           int sample, int line,
+                           double &sampleOffset, double &lineOffset);
+      static bool PhaseCorrelation(const double *surface, int samples, int lines,
+                                   int sample, int line,
+                                   double &sampleOffset, double &lineOffset);
+  };
+};
+
+#endif
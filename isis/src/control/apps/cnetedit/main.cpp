@@ -18,6 +18,7 @@ find files of those names at the top level of this repository. **/
 
 #include "ControlMeasure.h"
 #include "ControlNet.h"
+#include "ControlNetPointFilter.h"
 #include "ControlNetValidMeasure.h"
 #include "ControlPoint.h"
 #include "ControlPointList.h"
@@ -145,9 +146,25 @@ void IsisMain() {
     throw IException(IException::User, msg, _FILEINFO_);
   }
 
+  // With DELETE, ignored points that are not edit locked are deleted by the first pass below,
+  // and unlocking before it cannot lock them. Unless the deleted points are logged, they are
+  // skipped while the network is read.
+  ControlNet cnet;
+  ControlNetPointFilter filter;
+  if (deleteIgnored && !keepLog) {
+    filter.setIgnored(false);
+    filter.setAcceptEditLocked(true);
+  }
+  try {
+    cnet.ReadControl(ui.GetFileName("CNET"), filter);
+  }
+  catch (IException &e) {
+    QString msg = "Invalid control network [" + ui.GetFileName("CNET") + "]";
+    throw IException(e, IException::Io, msg, _FILEINFO_);
+  }
+
   // If the user wants to keep a log, go ahead and populate it with all the
   // existing ignored points and measures
-  ControlNet cnet(ui.GetFileName("CNET"));
   if (keepLog && cnet.GetNumPoints() > 0)
     populateLog(cnet, ignore);
 
@@ -11,6 +11,35 @@ find files of those names at the top level of this repository. **/
 using namespace std;
 
 namespace Isis {
+  /**
+   * The filters that are tested while the control network is read, so the points they remove
+   * are never created. The filters are tested in the order cnetextract tests them. A filter
+   * is only tested while reading if each filter before it can also be tested from the point
+   * fields and does not change the points, so a skipped point is reported by the filter that
+   * would have removed it.
+   */
+  struct ReadFilters {
+    ReadFilters() : noIgnore(false), fixed(false), constrained(false), editLocked(false),
+                    cubePoints(false), noMeasureless(false), pointList(false) {}
+
+    bool noIgnore;      //!< Ignored points are skipped.
+    bool fixed;         //!< Points that are not fixed are skipped.
+    bool constrained;   //!< Points that are not constrained are skipped.
+    bool editLocked;    //!< Points that are not edit locked are skipped.
+    bool cubePoints;    //!< Points that are not measured on a cube in CUBELIST are skipped.
+    bool noMeasureless; //!< Points without measures are skipped.
+    bool pointList;     //!< Points that are not in POINTLIST are skipped.
+  };
+
+  ReadFilters ReadPointFilter(UserInterface &ui, ControlNetPointFilter &filter);
+  bool OnlyPointListRead(const ReadFilters &readFilters);
+  void ReadListedPoints(const QString &cnetFile, FileName pointListFile, ControlNet &outNet,
+                        QList<ControlNetPointFilter::PointFields> &rejectedPoints);
+  void ExtractNetwork(ControlNet &outNet,
+                      const QList<ControlNetPointFilter::PointFields> &rejectedPoints,
+                      const ReadFilters &readFilters, UserInterface &ui, Pvl *log);
+  QList<QString> ReadPointList(FileName pointListFile);
+  QList<QString> ReadCubeSerials(FileName cubeListFile);
   void ExtractPointList(ControlNet &outNet, QVector<QString> &nonListedPoints, FileName pointListFile);
   void ExtractLatLonRange(ControlNet &outNet, QVector<QString> &nonLatLonPoints,
                           QVector<QString> &cannotGenerateLatLonPoints,
@@ -29,14 +58,167 @@ namespace Isis {
   void omit(ControlPoint *point, int cm);
 
   void cnetextract(UserInterface &ui, Pvl *log) {
-    ControlNet outNet(ui.GetFileName("CNET"));
+    // The points that the first filters remove are skipped while the network is read
+    ControlNetPointFilter filter;
+    ReadFilters readFilters = ReadPointFilter(ui, filter);
 
-    cnetextract(outNet, ui, log);
+    QString cnetFile = ui.GetFileName("CNET");
+    ControlNet outNet;
+    QList<ControlNetPointFilter::PointFields> rejectedPoints;
+    try {
+      if (OnlyPointListRead(readFilters)) {
+        ReadListedPoints(cnetFile, ui.GetFileName("POINTLIST"), outNet, rejectedPoints);
+      }
+      else {
+        outNet.ReadControl(cnetFile, filter, &rejectedPoints);
+      }
+    }
+    catch (IException &e) {
+      QString msg = "Invalid control network [" + cnetFile + "]";
+      throw IException(e, IException::Io, msg, _FILEINFO_);
+    }
+
+    ExtractNetwork(outNet, rejectedPoints, readFilters, ui, log);
   }
 
 
-  // Main program
   void cnetextract(ControlNet outNet, UserInterface &ui, Pvl *log) {
+    ExtractNetwork(outNet, QList<ControlNetPointFilter::PointFields>(), ReadFilters(), ui, log);
+  }
+
+
+  /**
+   * Sets up the filter that is tested while the control network is read. This holds the
+   * filters that are tested first, up to the first filter that needs the whole point or
+   * changes the measures of the points.
+   *
+   * @param ui The user interface with the filter parameters
+   * @param filter[out] The filter to read the network with
+   *
+   * @return ReadFilters The filters that are in the filter
+   */
+  ReadFilters ReadPointFilter(UserInterface &ui, ControlNetPointFilter &filter) {
+    bool noIgnore        = ui.GetBoolean("NOIGNORE");
+    bool noMeasureless   = ui.GetBoolean("NOMEASURELESS");
+    bool noSingleMeasure = ui.GetBoolean("NOSINGLEMEASURES");
+    bool reference       = ui.GetBoolean("REFERENCE");
+    bool fixed           = ui.GetBoolean("FIXED");
+    bool constrained     = ui.GetBoolean("CONSTRAINED");
+    bool editLocked      = ui.GetBoolean("EDITLOCKED");
+    bool tolerance       = ui.GetBoolean("TOLERANCE");
+    bool cubePoints      = ui.GetBoolean("CUBES");
+    bool cubeMeasures    = ui.GetBoolean("CUBEMEASURES");
+
+    ReadFilters readFilters;
+    readFilters.noIgnore = noIgnore;
+    readFilters.fixed = fixed;
+    readFilters.constrained = constrained;
+
+    // The single measure test counts the valid measures of the point
+    if (!noSingleMeasure) {
+      readFilters.editLocked = editLocked;
+
+      // These filters remove measures or test their residuals
+      if (!(noIgnore || reference || cubeMeasures || tolerance)) {
+        readFilters.cubePoints = cubePoints;
+        readFilters.noMeasureless = noMeasureless;
+        readFilters.pointList = ui.WasEntered("POINTLIST");
+      }
+    }
+
+    if (readFilters.noIgnore) {
+      filter.setIgnored(false);
+    }
+    if (readFilters.fixed || readFilters.constrained) {
+      // No point passes both
+      QList<ControlPoint::PointType> types;
+      if (!readFilters.constrained) {
+        types.append(ControlPoint::Fixed);
+      }
+      else if (!readFilters.fixed) {
+        types.append(ControlPoint::Constrained);
+      }
+      filter.setPointTypes(types);
+    }
+    if (readFilters.editLocked) {
+      filter.setEditLocked(true);
+    }
+    if (readFilters.cubePoints) {
+      filter.setCubeSerialNumbers( ReadCubeSerials(ui.GetFileName("CUBELIST")) );
+    }
+    if (readFilters.noMeasureless) {
+      filter.setNumMeasuresRange(1, INT_MAX);
+    }
+    if (readFilters.pointList) {
+      // Point IDs are matched without regard to case
+      filter.setPointIds(ReadPointList(ui.GetFileName("POINTLIST")), Qt::CaseInsensitive);
+    }
+
+    return readFilters;
+  }
+
+
+  /**
+   * Returns if the point list is the only filter tested while the network is read. The
+   * points that are not listed are then reported without looking at them.
+   *
+   * @param readFilters The filters that are tested while the network is read
+   *
+   * @return bool True if only the point list is tested
+   */
+  bool OnlyPointListRead(const ReadFilters &readFilters) {
+    return readFilters.pointList && !(readFilters.noIgnore || readFilters.fixed ||
+                                      readFilters.constrained || readFilters.editLocked ||
+                                      readFilters.cubePoints || readFilters.noMeasureless);
+  }
+
+
+  /**
+   * Reads only the points in POINTLIST from a control network. Networks with a point index
+   * are read through a LazyControlNet, so the points that are not listed are never decoded.
+   * Their IDs and measure counts come from the index.
+   *
+   * @param cnetFile The control network file
+   * @param pointListFile The list of point IDs to read
+   * @param outNet[out] The network the listed points are added to, in file order
+   * @param rejectedPoints[out] The ID and measure count of each point that is not listed,
+   *                            in file order
+   */
+  void ReadListedPoints(const QString &cnetFile, FileName pointListFile, ControlNet &outNet,
+                        QList<ControlNetPointFilter::PointFields> &rejectedPoints) {
+    // Point IDs are matched without regard to case
+    QSet<QString> listedIds;
+    foreach (QString pointId, ReadPointList(pointListFile)) {
+      listedIds.insert(pointId.toLower());
+    }
+
+    LazyControlNet lazyNet(cnetFile);
+    outNet.SetTarget(lazyNet.GetTarget());
+    outNet.SetNetworkId(lazyNet.GetNetworkId());
+    outNet.SetUserName(lazyNet.GetUserName());
+    outNet.SetCreatedDate(lazyNet.CreatedDate());
+    outNet.SetModifiedDate(lazyNet.GetLastModified());
+    outNet.SetDescription(lazyNet.Description());
+
+    QList<QString> pointIds = lazyNet.GetPointIds();
+    for (int index = 0; index < pointIds.size(); index++) {
+      if (listedIds.contains(pointIds[index].toLower())) {
+        outNet.AddPoint(new ControlPoint(*lazyNet.GetPoint(index)));
+      }
+      else {
+        ControlNetPointFilter::PointFields point;
+        point.id = pointIds[index];
+        point.numMeasures = lazyNet.GetNumMeasures(index);
+        rejectedPoints.append(point);
+      }
+    }
+  }
+
+
+  // Main program
+  void ExtractNetwork(ControlNet &outNet,
+                      const QList<ControlNetPointFilter::PointFields> &rejectedPoints,
+                      const ReadFilters &readFilters, UserInterface &ui, Pvl *log) {
     if(!ui.WasEntered("FROMLIST") && ui.WasEntered("TOLIST")) {
       QString msg = "To create a [TOLIST] the [FROMLIST] parameter must be provided.";
       throw IException(IException::User, msg, _FILEINFO_);
@@ -74,10 +256,12 @@ namespace Isis {
       inList.read(ui.GetFileName("FROMLIST"));
     }
 
-    int inputPoints = outNet.GetNumPoints();
+    int inputPoints = outNet.GetNumPoints() + rejectedPoints.size();
     int inputMeasures = 0;
     for (int cp = 0; cp < outNet.GetNumPoints(); cp++)
       inputMeasures += outNet.GetPoint(cp)->GetNumMeasures();
+    for (int cp = 0; cp < rejectedPoints.size(); cp++)
+      inputMeasures += rejectedPoints[cp].numMeasures;
 
     // Set up the Serial Number to FileName mapping
     QMap<QString, QString> sn2filename;
@@ -115,11 +299,32 @@ namespace Isis {
     // Set up comparison data
     QVector<QString> serialNumbers;
     if(cubePoints) {
-      FileList cubeList(ui.GetFileName("CUBELIST"));
-      for(int cubeIndex = 0; cubeIndex < (int)cubeList.size(); cubeIndex ++) {
-        QString sn = SerialNumber::Compose(cubeList[cubeIndex].toString());
-        serialNumbers.push_back(sn);
+      serialNumbers = ReadCubeSerials(ui.GetFileName("CUBELIST")).toVector();
+    }
+
+    // Report the points that were skipped while the network was read by the first filter
+    // they fail, in the same backwards order as the points removed below
+    for(int cp = rejectedPoints.size() - 1; cp >= 0; cp--) {
+      const ControlNetPointFilter::PointFields &point = rejectedPoints[cp];
+      bool onCubeList = false;
+      for(int cm = 0; cm < point.serialNumbers.size() && !onCubeList; cm++) {
+        onCubeList = serialNumbers.contains(point.serialNumbers[cm]);
       }
+
+      if(readFilters.noIgnore && point.ignored)
+        ignoredPoints.append(point.id);
+      else if(readFilters.fixed && point.type != ControlPoint::Fixed)
+        nonFixedPoints.append(point.id);
+      else if(readFilters.constrained && point.type != ControlPoint::Constrained)
+        nonConstrainedPoints.append(point.id);
+      else if(readFilters.editLocked && !point.editLocked)
+        nonEditLockedPoints.append(point.id);
+      else if(readFilters.cubePoints && !onCubeList)
+        nonCubePoints.append(point.id);
+      else if(readFilters.noMeasureless && point.numMeasures == 0)
+        measurelessPoints.append(point.id);
+      else
+        nonListedPoints.append(point.id);
     }
 
     double tolerance = 0.0;
@@ -513,6 +718,44 @@ namespace Isis {
   }
 
 
+  /**
+   * Reads the point IDs in POINTLIST
+   *
+   * @param pointListFile The list of point IDs
+   *
+   * @return QList<QString> The point IDs
+   */
+  QList<QString> ReadPointList(FileName pointListFile) {
+    // Use the file list class for functionality
+    // (even though this is a list of point IDs)
+    FileList listedPoints(pointListFile);
+
+    QList<QString> pointIds;
+    for(int i = 0; i < (int)listedPoints.size(); i++) {
+      pointIds.append(listedPoints[i].toString());
+    }
+    return pointIds;
+  }
+
+
+  /**
+   * Reads the serial numbers of the cubes in CUBELIST
+   *
+   * @param cubeListFile The list of cubes
+   *
+   * @return QList<QString> The serial numbers of the cubes
+   */
+  QList<QString> ReadCubeSerials(FileName cubeListFile) {
+    FileList cubeList(cubeListFile);
+
+    QList<QString> serialNumbers;
+    for(int cubeIndex = 0; cubeIndex < (int)cubeList.size(); cubeIndex ++) {
+      serialNumbers.append(SerialNumber::Compose(cubeList[cubeIndex].toString()));
+    }
+    return serialNumbers;
+  }
+
+
   /**
    * Removes control points not listed in POINTLIST
    *
@@ -524,23 +767,15 @@ namespace Isis {
    *                           accessed in the main program.
    */
   void ExtractPointList(ControlNet &outNet, QVector<QString> &nonListedPoints, FileName pointListFile) {
-    // Use the file list class for functionality
-    // (even though this is a list of point IDs)
-    FileList listedPoints(pointListFile);
+    // Point IDs are matched without regard to case
+    ControlNetPointFilter pointFilter;
+    pointFilter.setPointIds(ReadPointList(pointListFile), Qt::CaseInsensitive);
+    QVector<bool> isInList = pointFilter.evaluate(outNet.GetPoints());
 
     // loop through control point indices, backwards
     for(int cp = outNet.GetNumPoints() - 1; cp >= 0; cp--) {
       ControlPoint *controlpt = outNet.GetPoint(cp);
-      // flag to determine if this controlpoint is in the pointlist
-      bool isInList = false;
-      // loop through line numbers of POINTLIST until we find a point ID in the
-      // list that matches this control point's ID
-      for(int i = 0; i < (int)listedPoints.size()  &&  !isInList; i++) {
-        QString pointId = listedPoints[i].toString();
-        // isInList is true if these strings are equal
-        isInList = pointId.toLower() == controlpt->GetId().toLower();
-      }
-      if(!isInList) {
+      if(!isInList[cp]) {
         nonListedPoints.append(controlpt->GetId());
         omit(outNet, cp);
       }
@@ -9,6 +9,7 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 
+#include <climits>
 #include <set>
 #include <sstream>
 
@@ -20,6 +21,7 @@ find files of those names at the top level of this repository. **/
 #include "Camera.h"
 #include "ControlMeasure.h"
 #include "ControlNet.h"
+#include "ControlNetPointFilter.h"
 #include "ControlPoint.h"
 #include "Cube.h"
 #include "CubeManager.h"
@@ -27,6 +29,7 @@ find files of those names at the top level of this repository. **/
 #include "FileList.h"
 #include "IException.h"
 #include "IString.h"
+#include "LazyControlNet.h"
 #include "Longitude.h"
 #include "Latitude.h"
 #include "TProjection.h"
@@ -475,6 +475,23 @@ SharedRobustMatcher FeatureAlgorithmFactory::make(const QString &definition) con
 }
 
 
+/**
+ * @brief Create a single Feature2D algorithm from its config string
+ *
+ * This creates a new instance of a detector or extractor from the config
+ * string of an existing one (e.g., "SIFT@nfeatures:100").  OpenCV Feature2D
+ * algorithms cannot be shared between threads, so this is used to give each
+ * thread its own copy.
+ *
+ * @param config Config string of a single Feature2D algorithm
+ *
+ * @return FeatureAlgorithmPtr New Feature2D algorithm
+ */
+FeatureAlgorithmPtr FeatureAlgorithmFactory::makeFeature(const QString &config) const {
+  return ( m_algorithmInventory.getFeature(config) );
+}
+
+
 /**
  * @brief Parses a full specification string for a set of algorithms.
  *
@@ -117,6 +117,7 @@ class FeatureAlgorithmFactory  {
     RobustMatcherList create(const QString &specifications,
                              const bool &errorIfEmpty = true) const;
     SharedRobustMatcher make(const QString &definition) const;
+    FeatureAlgorithmPtr makeFeature(const QString &config) const;
 
     unsigned int manufactured() const;
 
@@ -0,0 +1,235 @@
+/** This is free and unencumbered software released into the public domain.
+
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include <cstring>
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+#include <QTemporaryFile>
+
+#include "FeatureCache.h"
+#include "FileName.h"
+#include "IException.h"
+
+namespace Isis {
+
+/**
+ * @brief Construct a store in a directory, which is created if needed
+ *
+ * @param path Store directory
+ */
+FeatureCache::FeatureCache(const QString &path) {
+  m_path = FileName(path).expanded();
+  if ( !QDir().mkpath(m_path) ) {
+    QString mess = "Unable to create feature cache directory [" + m_path + "]";
+    throw IException(IException::User, mess, _FILEINFO_);
+  }
+}
+
+
+FeatureCache::~FeatureCache() { }
+
+
+/** Returns the expanded store directory */
+QString FeatureCache::path() const {
+  return ( m_path );
+}
+
+
+/**
+ * @brief Compute the key of an image, its transforms and an algorithm
+ *
+ * @param image     Image that features are detected in
+ * @param rendered  The image rendered through its transforms
+ * @param algorithm String that identifies the detector, extractor and any
+ *                  parameters that change the keypoints or descriptors
+ *
+ * @return QString Entry key
+ */
+QString FeatureCache::key(const MatchImage &image, const cv::Mat &rendered,
+                          const QString &algorithm) const {
+  FileName file(image.name());
+  QString id = image.id();
+  if ( id.isEmpty() || ( "none" == id ) ) {
+    id = file.expanded();
+  }
+
+  // The serial number does not change when the pixels do, so the size and
+  // modification time of the file and the bands read from it are part of
+  // the key too
+  QFileInfo info(file.expanded());
+  QString content = QString::number(info.size()) + "@" +
+                    QString::number(info.lastModified().toMSecsSinceEpoch());
+  if ( !file.attributes().isEmpty() ) {
+    content += "+" + file.attributes();
+  }
+
+  // Signature of the transforms is their names and where they put the
+  // corners and center of the source image
+  QStringList transforms;
+  Transformer::ImageTransformConstIterator tform = image.transforms().begin();
+  while ( tform != image.transforms().end() ) {
+    transforms.append( (*tform)->name() );
+    ++tform;
+  }
+
+  float samples = image.source().samples();
+  float lines = image.source().lines();
+  std::vector<cv::Point2f> probes;
+  probes.push_back(cv::Point2f(0.0, 0.0));
+  probes.push_back(cv::Point2f(samples, 0.0));
+  probes.push_back(cv::Point2f(0.0, lines));
+  probes.push_back(cv::Point2f(samples, lines));
+  probes.push_back(cv::Point2f(samples / 2.0, lines / 2.0));
+  for (unsigned int i = 0 ; i < probes.size() ; i++) {
+    cv::Point2f point = image.transforms().forward(probes[i]);
+    transforms.append( QString::number(point.x, 'f', 3) + "," +
+                       QString::number(point.y, 'f', 3) );
+  }
+  transforms.append( QString::number(rendered.cols) + "x" +
+                     QString::number(rendered.rows) );
+
+  return ( id + "|" + content + "|" + transforms.join(";") + "|" + algorithm );
+}
+
+
+/**
+ * @brief Load the keypoints and descriptors of an entry
+ *
+ * @param key         Entry key
+ * @param keypoints   Returns the keypoints
+ * @param descriptors Returns the descriptors
+ *
+ * @return bool True if the entry was found and read
+ */
+bool FeatureCache::load(const QString &key, Keypoints &keypoints,
+                        Descriptors &descriptors) const {
+  QFile file(fileName(key));
+  if ( !file.open(QIODevice::ReadOnly) ) return ( false );
+
+  qint64 fileBytes = file.size();
+  if ( fileBytes < (qint64) sizeof(Header) ) return ( false );
+
+  const uchar *data = file.map(0, fileBytes);
+  if ( !data ) return ( false );
+
+  Header header;
+  std::memcpy(&header, data, sizeof(Header));
+  QByteArray keyBytes = key.toUtf8();
+  if ( ( 0 != std::memcmp(header.magic, "FFKD", 4) ) || ( 1 != header.version ) ||
+       ( header.keyBytes != keyBytes.size() ) || ( header.keypoints != header.rows ) ||
+       ( header.keypoints < 0 ) || ( header.cols < 0 ) ) {
+    return ( false );
+  }
+
+  // Check the size before using any of the counts
+  int elemSize = CV_ELEM_SIZE(header.type);
+  qint64 descriptorBytes = (qint64) header.rows * header.cols * elemSize;
+  qint64 expected = sizeof(Header) + header.keyBytes +
+                    (qint64) header.keypoints * sizeof(KeypointRecord) +
+                    descriptorBytes;
+  if ( expected != fileBytes ) return ( false );
+
+  // Hashes can collide, so the full key is stored too
+  const uchar *next = data + sizeof(Header);
+  if ( 0 != std::memcmp(next, keyBytes.constData(), header.keyBytes) ) {
+    return ( false );
+  }
+  next += header.keyBytes;
+
+  keypoints.resize(header.keypoints);
+  for (int i = 0 ; i < header.keypoints ; i++) {
+    KeypointRecord record;
+    std::memcpy(&record, next, sizeof(KeypointRecord));
+    next += sizeof(KeypointRecord);
+    keypoints[i] = cv::KeyPoint(record.x, record.y, record.size, record.angle,
+                                record.response, record.octave, record.classId);
+  }
+
+  // Copy the descriptors out of the mapped file before it is closed
+  descriptors = cv::Mat(header.rows, header.cols, header.type,
+                        (void *) next).clone();
+  return ( true );
+}
+
+
+/**
+ * @brief Save the keypoints and descriptors of an entry
+ *
+ * Failures to write are ignored, the entry will just be computed again on
+ * the next run.
+ *
+ * @param key         Entry key
+ * @param keypoints   Keypoints to save
+ * @param descriptors Descriptors of the keypoints
+ */
+void FeatureCache::save(const QString &key, const Keypoints &keypoints,
+                        const Descriptors &descriptors) const {
+  if ( (int) keypoints.size() != descriptors.rows ) return;
+
+  QByteArray keyBytes = key.toUtf8();
+  Header header;
+  std::memcpy(header.magic, "FFKD", 4);
+  header.version = 1;
+  header.keyBytes = keyBytes.size();
+  header.keypoints = keypoints.size();
+  header.rows = descriptors.rows;
+  header.cols = descriptors.cols;
+  header.type = descriptors.type();
+
+  // The temporary file name is unique across threads and processes sharing
+  // the store, and the file is removed unless it is renamed into place
+  QString fname = fileName(key);
+  QTemporaryFile file(fname + ".XXXXXX.tmp");
+  if ( !file.open() ) return;
+
+  bool good = ( file.write((const char *) &header, sizeof(Header)) == sizeof(Header) );
+  good = good && ( file.write(keyBytes) == keyBytes.size() );
+  for (unsigned int i = 0 ; good && ( i < keypoints.size() ) ; i++) {
+    const cv::KeyPoint &keypoint = keypoints[i];
+    KeypointRecord record;
+    record.x = keypoint.pt.x;
+    record.y = keypoint.pt.y;
+    record.size = keypoint.size;
+    record.angle = keypoint.angle;
+    record.response = keypoint.response;
+    record.octave = keypoint.octave;
+    record.classId = keypoint.class_id;
+    good = ( file.write((const char *) &record, sizeof(KeypointRecord)) ==
+             sizeof(KeypointRecord) );
+  }
+
+  // Rows of submatrices are not contiguous
+  qint64 rowBytes = (qint64) descriptors.cols * descriptors.elemSize();
+  for (int row = 0 ; good && ( row < descriptors.rows ) ; row++) {
+    good = ( file.write((const char *) descriptors.ptr(row), rowBytes) == rowBytes );
+  }
+  file.close();
+
+  // Another thread or run may have saved the same entry first
+  if ( good ) {
+    QFile::remove(fname);
+    if ( file.rename(fname) ) {
+      file.setAutoRemove(false);
+    }
+  }
+  return;
+}
+
+
+/** Returns the file name of an entry, which is named by a hash of its key */
+QString FeatureCache::fileName(const QString &key) const {
+  QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1);
+  return ( m_path + "/" + QString(hash.toHex()) + ".ffkd" );
+}
+
+}  // namespace Isis
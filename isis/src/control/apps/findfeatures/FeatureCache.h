@@ -0,0 +1,89 @@
+#ifndef FeatureCache_h
+#define FeatureCache_h
+
+/** This is free and unencumbered software released into the public domain.
+
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include <QString>
+
+#include <opencv2/opencv.hpp>
+
+#include "FeatureMatcherTypes.h"
+#include "MatchImage.h"
+
+namespace Isis {
+
+/**
+ * @brief On disk store of image keypoints and descriptors
+ *
+ * Detecting keypoints and extracting their descriptors is usually the most
+ * expensive part of matching. The results only depend on the image, the
+ * transforms applied to render it and the detector and extractor
+ * specifications, so they can be reused by later runs that match the same
+ * image to other images, or that only change the matcher or outlier
+ * parameters.
+ *
+ * Each entry is keyed by the image serial number (or name for images that are
+ * not cubes), the size and modification time of the image file, a signature
+ * of the rendering transforms and the algorithm string. An image that is
+ * rewritten, for example by a new calibration, therefore gets a new entry. The transform signature is made from the transform names and the
+ * rendered positions of the corners and center of the source image, so the
+ * same image rendered by a different fast geom gets its own entry.
+ *
+ * Entries are stored in a compact binary file named from a hash of the key.
+ * The file starts with a fixed size header, followed by the full key, the
+ * keypoints as fixed size records and the descriptor matrix rows, so it is
+ * read by mapping it into memory. Entries are written to a temporary file and
+ * renamed so that several threads or processes can share the store.
+ *
+ * @author 2022-10-18 Original Version
+ */
+
+class FeatureCache {
+  public:
+    FeatureCache(const QString &path);
+    ~FeatureCache();
+
+    QString path() const;
+
+    QString key(const MatchImage &image, const cv::Mat &rendered,
+                const QString &algorithm) const;
+    bool load(const QString &key, Keypoints &keypoints,
+              Descriptors &descriptors) const;
+    void save(const QString &key, const Keypoints &keypoints,
+              const Descriptors &descriptors) const;
+
+  private:
+    /** Fixed size header at the start of each entry file */
+    struct Header {
+      char   magic[4];        //!< Always "FFKD"
+      qint32 version;         //!< Layout version
+      qint32 keyBytes;        //!< Size of the UTF-8 key that follows the header
+      qint32 keypoints;       //!< Number of keypoint records
+      qint32 rows;            //!< Descriptor rows
+      qint32 cols;            //!< Descriptor columns
+      qint32 type;            //!< OpenCV type of the descriptors
+    };
+
+    /** Fixed size record of a keypoint */
+    struct KeypointRecord {
+      float  x;               //!< Sample position
+      float  y;               //!< Line position
+      float  size;            //!< Diameter of the neighborhood
+      float  angle;           //!< Orientation
+      float  response;        //!< Detector response
+      qint32 octave;          //!< Pyramid octave
+      qint32 classId;         //!< Object class
+    };
+
+    QString m_path;  //!< Expanded store directory
+
+    QString fileName(const QString &key) const;
+};
+}  // namespace Isis
+#endif
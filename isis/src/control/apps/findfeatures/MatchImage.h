@@ -107,6 +107,10 @@ class MatchImage {
       m_data->m_transforms.clear();
     }
 
+    inline const Transformer &transforms() const {
+      return ( m_data->m_transforms );
+    }
+
     inline ImageSource &source() const {
       return ( m_data->m_source );
     }
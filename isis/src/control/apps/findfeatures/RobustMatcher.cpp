@@ -16,9 +16,16 @@ find files of those names at the top level of this repository. **/
 
 #include <QDebug>
 #include <QtDebug>
+#include <QFuture>
 #include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QScopedPointer>
 #include <QStringList>
+#include <QThread>
+#include <QThreadPool>
 #include <QTime>
+#include <QtConcurrentRun>
 
 #include <opencv2/opencv.hpp>
 
@@ -26,10 +33,13 @@ find files of those names at the top level of this repository. **/
 #include <boost/foreach.hpp>
 
 #include "Application.h"
+#include "FeatureAlgorithmFactory.h"
+#include "FeatureCache.h"
 #include "IException.h"
 #include "IString.h"
 #include "FileName.h"
 #include "RobustMatcher.h"
+#include "SubpixelPeak.h"
 
 
 namespace Isis {
@@ -161,24 +171,22 @@ MatchPair RobustMatcher::match(MatchImage &query, MatchImage &train) const {
    QTime stime;
    stime.start();
 
-   // 1a. Detection of the features
-   detector().algorithm()->detect(i_query, v_query.keypoints());
-   detector().algorithm()->detect(i_train, v_train.keypoints());
-
-   int v_query_points = v_query.size();
-   int v_train_points = v_train.size();
-   int allPoints = v_query_points + v_train_points;
-
    // Limit keypoints if requested by user
    int v_maxpoints = toInt(m_parameters.get("MaxPoints"));
    if ( v_maxpoints > 0 ) {
      logger() << "  Keypoints restricted by user to " << v_maxpoints << " points...\n";
      logger().flush();
-     cv::KeyPointsFilter::retainBest(v_query.keypoints(), v_maxpoints);
-     cv::KeyPointsFilter::retainBest(v_train.keypoints(), v_maxpoints);
    }
 
-   double v_time = elapsed(stime);  // Event timing
+   // 1a. Detection of the features and 1b. extraction of the descriptors,
+   // or reading them from the feature cache
+   QScopedPointer<FeatureCache> cache( featureCache() );
+   double v_time(0.0), d_time(0.0);
+   int v_query_points = detectAndExtract(i_query, v_query, cache.data(),
+                                         v_time, d_time);
+   int v_train_points = detectAndExtract(i_train, v_train, cache.data(),
+                                         v_time, d_time);
+   int allPoints = v_query_points + v_train_points;
 
    // Log results
    if ( isDebug() ) {
@@ -193,11 +201,6 @@ MatchPair RobustMatcher::match(MatchImage &query, MatchImage &train) const {
      logger().flush();
    }
 
-   // 1b. Extraction of the descriptors
-   cv::Mat queryDescriptors, trainerDescriptors;
-   extractor().algorithm()->compute(i_query, v_query.keypoints(), v_query.descriptors());
-   extractor().algorithm()->compute(i_train, v_train.keypoints(), v_train.descriptors());
-   double d_time = elapsed(stime) - v_time;
    v_pair.addTime( v_time + d_time );
 
    // Do root sift normalization if requested
@@ -235,6 +238,10 @@ MatchPair RobustMatcher::match(MatchImage &query, MatchImage &train) const {
      v_pair.setFundamental(fundamental);
      v_pair.setHomography(homography);
      v_pair.addTime(mtime);
+
+     if ( toBool(m_parameters.get("SubpixelRefine")) ) {
+       refineMatches(i_query, i_train, v_query, v_train, v_pair.matches());
+     }
    }
    catch ( cv::Exception &c ) {
      QString mess = "Outlier removal process failed on image pair: "
@@ -349,70 +356,28 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
    QTime stime;
    stime.start();
 
-   // 1a. Run detection of features
-   std::vector<std::vector<cv::KeyPoint> > trainerKeypoints;
-   detector().algorithm()->detect(i_query, v_query.keypoints());
-   detector().algorithm()->detect(i_trainers, trainerKeypoints);
-
-   int v_query_points = v_query.size();
-   int allPoints = v_query_points;
-   QList<int> v_train_points;
-   for (unsigned int i = 0; i < trainerKeypoints.size() ; i++) {
-     v_train_points.append(trainerKeypoints[i].size());
-     allPoints += trainerKeypoints[i].size();
-   }
-
    // Limit keypoints if requested by user
    int v_maxpoints = toInt(m_parameters.get("MaxPoints"));
    if ( v_maxpoints > 0 ) {
      logger() << "  Keypoints restricted by user to " << v_maxpoints << " points...\n";
      logger().flush();
-     cv::KeyPointsFilter::retainBest(v_query.keypoints(), v_maxpoints);
-     for (unsigned int i = 0 ; i < trainerKeypoints.size() ; i++) {
-       cv::KeyPointsFilter::retainBest(trainerKeypoints[i], v_maxpoints);
-     }
    }
 
-   double d_time = elapsed(stime);
-
-   // Prep for computing an accurate duration
-   double allKeypoints = v_query.size();
-   for (unsigned int k = 0 ; k < trainerKeypoints.size() ; k++) {
-     allKeypoints += trainerKeypoints[k].size();
-   }
+   // 1a. Run detection of features and 1b. extraction of the descriptors for
+   // the query image, or read them from the feature cache
+   QScopedPointer<FeatureCache> cache( featureCache() );
+   double d_time(0.0), e_time(0.0);
+   int v_query_points = detectAndExtract(i_query, v_query, cache.data(),
+                                         d_time, e_time);
+   v_query.addTime( d_time + e_time );
 
    if ( isDebug() ) {
      logger() << "  Total Query keypoints:    " << v_query.size()
               << " [" << v_query_points << "]\n";
-     logger() << "  Total Trainer keypoints:  " << trainerKeypoints.size()
-               << " @ (";
-     QString sep("");
-     for ( unsigned int t = 0 ; t < trainerKeypoints.size() ; t++ ) {
-       logger() << sep << trainerKeypoints[t].size()
-                 << " [" << v_train_points[t] << "]";
-       sep = ",";
-     }
-     logger() << ") = " << allKeypoints - v_query.size() << "\n";
-     logger() << "  Total keypoints:          " << allKeypoints << "\n";
-     logger() << "  Processing Time:          " << d_time << "\n";
-     logger() << "  Processing Keypoints/Sec: "
-               << allPoints / d_time  << "\n";
-     logger() << "--> Extracting descriptors...\n";
+     logger() << "  Processing Time:          " << d_time + e_time << "\n";
      logger().flush();
    }
 
-   // 1b. Extraction of the descriptors
-   std::vector<cv::Mat> trainerDescriptors;
-   extractor().algorithm()->compute(i_query, v_query.keypoints(), v_query.descriptors());
-   extractor().algorithm()->compute(i_trainers, trainerKeypoints, trainerDescriptors);
-
-    // Record time to detect features and extract descriptors for all images
-   double e_time = elapsed(stime) - d_time;
-
-   // Update times for query and train images by distributing the total time
-   // by the factor of image keypoints over sum of all keypoints
-   v_query.addTime( (d_time  + e_time) * ( v_query.size() / allPoints ) );
-
    // Do root sift normalization if requested
    bool v_doRootSift = toBool(m_parameters.get("RootSift"));
    if ( v_doRootSift ) {
@@ -420,81 +385,122 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
        logger() << "  Computing RootSift Descriptors...\n";
      }
      RootSift( v_query.descriptors() );
-     for (unsigned int i = 0; i < trainerDescriptors.size() ; i++) {
-       RootSift( trainerDescriptors[i] );
-     }
    }
 
-   MatchPairQList pairs;
-   for ( int i = 0 ; i < v_trainers.size() ; i++) {
+   // The trainer images are processed concurrently with a bounded number of
+   // threads. The debug log is written as the images are processed, so use a
+   // single thread to keep it readable when debugging.
+   int v_threads = toInt(m_parameters.get("MaxThreads"));
+   if ( v_threads <= 0 ) v_threads = QThread::idealThreadCount();
+   if ( isDebug() ) v_threads = 1;
+   QThreadPool v_pool;
+   v_pool.setMaxThreadCount( qMax(1, qMin(v_threads, v_trainers.size())) );
 
-     double kpRatio = (trainerKeypoints[i].size() / allPoints);
-     MatchImage &v_train = v_trainers[i];
+   if ( isDebug() ) {
+     logger() << "--> Matching trainer images with " << v_pool.maxThreadCount()
+              << " threads...\n";
+     logger().flush();
+   }
 
-     // Compute the distributed time to train images
-     double t_time = (d_time + e_time) * kpRatio;
-     v_train.keypoints() = trainerKeypoints[i];
-     v_train.setDescriptors(trainerDescriptors[i]);
-     v_train.addTime(t_time);
-     MatchPair v_pair(v_query, v_train);
-     if ( isDebug() ) {
-       logger() << "  Processing Time(s):         " << d_time * kpRatio << "\n";
-       logger() << "  Processing Descriptors/Sec: "
-                << (double) v_pair.keyPointTotal() / (d_time * kpRatio) << "\n";
-       logger() << "\n*Removing outliers from image pairs:"
-                << "\n *  Query: " << v_query.name()
-                << "\n *  Train: " << v_train.name()
-                << "\n";
-       logger().flush();
+   // Each thread only touches its own trainer, pair and failure message
+   std::vector<MatchImage> v_trains;
+   std::vector<MatchPair> v_pairs;
+   for ( int i = 0 ; i < v_trainers.size() ; i++) {
+     v_trains.push_back( v_trainers[i] );
+     v_pairs.push_back( MatchPair(v_query, v_trainers[i]) );
+   }
+   std::vector<QString> v_failures(v_trainers.size());
+
+   // OpenCV detectors and extractors keep state while they run, so each
+   // thread takes its own pair from this list while it extracts a trainer.
+   // The first pair is ours, the others are new algorithms made from our
+   // config strings.
+   QList<Feature2DAlgorithm *> v_detectors;
+   QList<Feature2DAlgorithm *> v_extractors;
+   QList<FeatureAlgorithmPtr> v_made;
+   v_detectors.append( &detector() );
+   v_extractors.append( &extractor() );
+   if ( !detector().config().isEmpty() && !extractor().config().isEmpty() ) {
+     FeatureAlgorithmFactory *v_factory = FeatureAlgorithmFactory::getInstance();
+     bool v_shared = ( &detector() == &extractor() );
+     while ( v_detectors.size() < v_pool.maxThreadCount() ) {
+       FeatureAlgorithmPtr v_detector = v_factory->makeFeature(detector().config());
+       FeatureAlgorithmPtr v_extractor = v_shared ? v_detector :
+                                 v_factory->makeFeature(extractor().config());
+       v_made << v_detector << v_extractor;
+       v_detectors.append( v_detector.get() );
+       v_extractors.append( v_extractor.get() );
      }
+   }
+   QThreadPool v_extractPool;
+   v_extractPool.setMaxThreadCount( v_detectors.size() );
+   QMutex v_algorithmsLock;
 
-     try {
-       // OUTLIER DETECTION!!!
-       // 2, 3, 4,  5, 6: Apply ratio (2) and symmetric (3) tests, then apply
-       // RANSAC homography (4) outlier followed by epipoloar (5) and final
-       // homography (6)
-       double mtime(0);
-       cv::Mat homography, fundamental;
-       removeOutliers(v_query.descriptors(), v_train.descriptors(),
-                      v_query.keypoints(), v_train.keypoints(),
-                      v_pair.homography_matches(), v_pair.epipolar_matches(),
-                      v_pair.matches(), homography, fundamental,
-                      t_time, onErrorThrow);
-
-       v_pair.setFundamental(fundamental);
-       v_pair.setHomography(homography);
-       v_pair.addTime(mtime);
-       pairs.push_back( v_pair );
-     }
-     catch ( cv::Exception &c ) {
-       QString mess = "Outlier removal process failed on Query/Train image pair "
-                      " Query=" + v_query.name() +
-                      ", Train[" + QString::number(i) + "]: " + v_train.name() +
-                      ".  cv::Error - " + c.what();
-       // throw IException(IException::Programmer, mess, _FILEINFO_);
-       v_pair.addError(mess);
-       pairs.push_back( v_pair ) ;
-       if ( isDebug() ) {
-         logger() << "  Outlier Error = "
-                   << v_pair.getError(v_pair.errorCount()-1) << "\n";
-         logger().flush();
+   // 1a, 1b. Detect and extract the trainer image features
+   QList<QFuture<void> > v_futures;
+   for ( int i = 0 ; i < v_trainers.size() ; i++) {
+     v_futures.append( QtConcurrent::run(&v_extractPool, [&, i]() {
+       Feature2DAlgorithm *v_detector, *v_extractor;
+       {
+         QMutexLocker locker(&v_algorithmsLock);
+         v_detector = v_detectors.takeLast();
+         v_extractor = v_extractors.takeLast();
        }
-     }
-     catch ( IException &ie) {
-       QString mess = "Outlier removal process failed on Query/Train image pair "
-                      " Query=" + v_query.name() +
-                      ", Train[" + QString::number(i) + "]: " + v_train.name();
-       // throw IException(ie, IException::Programmer, mess, _FILEINFO_);
-       v_pair.addError(mess);
-       pairs.push_back( v_pair );
-       if ( isDebug() ) {
-         logger() << "  Outlier Error = "
-                   << v_pair.getError(v_pair.errorCount()-1) << "\n";
-         logger().flush();
+       try {
+         extractTrainer(v_trains[i], i_trainers[i], *v_detector, *v_extractor,
+                        cache.data(), v_doRootSift);
+       }
+       catch ( cv::Exception &c ) {
+         v_failures[i] = "Feature detection failed on Train[" + QString::number(i) +
+                         "]: " + v_trains[i].name() + ".  cv::Error - " + c.what();
        }
+       catch ( IException &ie ) {
+         v_failures[i] = "Feature detection failed on Train[" + QString::number(i) +
+                         "]: " + v_trains[i].name() + ".  " + ie.toString();
+       }
+       QMutexLocker locker(&v_algorithmsLock);
+       v_detectors.append( v_detector );
+       v_extractors.append( v_extractor );
+     }) );
+   }
+
+   for ( int i = 0 ; i < v_futures.size() ; i++) {
+     v_futures[i].waitForFinished();
+   }
+   v_futures.clear();
+
+   for ( unsigned int i = 0 ; i < v_failures.size() ; i++) {
+     if ( !v_failures[i].isEmpty() ) {
+       throw IException(IException::Programmer, v_failures[i], _FILEINFO_);
      }
    }
 
+   // For large train sets, match the query image to all trainer images with
+   // a single query of an index of all of the trainer descriptors
+   std::vector<std::vector<std::vector<cv::DMatch> > > v_queryMatches;
+   int v_flannTrainers = toInt(m_parameters.get("FlannTrainers"));
+   if ( ( v_flannTrainers > 0 ) && ( v_trainers.size() >= v_flannTrainers ) ) {
+     indexMatches(v_query, v_trains, v_queryMatches);
+   }
+
+   // 2 - 6. Remove outliers from each pair
+   for ( int i = 0 ; i < v_trainers.size() ; i++) {
+     v_futures.append( QtConcurrent::run(&v_pool, [&, i]() {
+       matchTrainer(v_query, v_trains[i], i_query, i_trainers[i], v_pairs[i], i,
+                    v_queryMatches.empty() ? 0 : &v_queryMatches[i],
+                    onErrorThrow);
+     }) );
+   }
+
+   for ( int i = 0 ; i < v_futures.size() ; i++) {
+     v_futures[i].waitForFinished();
+   }
+
+   MatchPairQList pairs;
+   for ( unsigned int i = 0 ; i < v_pairs.size() ; i++) {
+     pairs.push_back( v_pairs[i] );
+   }
+
    // All done...
   if ( isDebug() ) {
     logger() << "%% match-multi complete in " << elapsed(stime) << " seconds!\n\n";
@@ -507,6 +513,393 @@ MatchPairQList RobustMatcher::match(MatchImage &query,
 }
 
 
+/**
+ * @brief Detect and extract the features of one trainer image
+ *
+ * This is run concurrently for each trainer image by the multi-image matcher,
+ * so it only changes the trainer image and uses the detector and extractor
+ * given to the thread running it.
+ *
+ * @param train        Trainer image, receives its keypoints and descriptors
+ * @param image        Rendered trainer image
+ * @param detector     Detector used only by this thread
+ * @param extractor    Extractor used only by this thread
+ * @param cache        Feature cache, or null if there is none
+ * @param doRootSift   Apply RootSift normalization to the descriptors
+ */
+void RobustMatcher::extractTrainer(MatchImage &train, const cv::Mat &image,
+                                   Feature2DAlgorithm &detector,
+                                   Feature2DAlgorithm &extractor,
+                                   const FeatureCache *cache,
+                                   const bool doRootSift) const {
+  double d_time(0.0), e_time(0.0);
+  int v_train_points = detectAndExtract(image, train, detector, extractor,
+                                        cache, d_time, e_time);
+  train.addTime(d_time + e_time);
+
+  if ( doRootSift ) {
+    RootSift( train.descriptors() );
+  }
+
+  if ( isDebug() ) {
+    logger() << "  Total Trainer keypoints:  " << train.size()
+             << " [" << v_train_points << "]\n";
+    logger() << "  Processing Time(s):         " << d_time + e_time << "\n";
+    logger() << "  Processing Descriptors/Sec: "
+             << (double) train.size() / e_time << "\n";
+    logger().flush();
+  }
+  return;
+}
+
+
+/**
+ * @brief Remove outliers for one trainer image
+ *
+ * This is run concurrently for each trainer image by the multi-image matcher,
+ * so it only changes the match pair. Outlier removal errors are recorded in
+ * the pair.
+ *
+ * @param query        Query image with its keypoints and descriptors
+ * @param train        Trainer image with its keypoints and descriptors
+ * @param queryImage   Rendered query image
+ * @param trainImage   Rendered trainer image
+ * @param pair         Match pair of the query and trainer images
+ * @param index        Index of the trainer image
+ * @param queryMatches Query to trainer matches from the trainer index, or
+ *                     null to match the pair directly
+ * @param onErrorThrow Throw outlier removal errors
+ */
+void RobustMatcher::matchTrainer(const MatchImage &query, const MatchImage &train,
+                                 const cv::Mat &queryImage, const cv::Mat &trainImage,
+                                 MatchPair &pair, const int index,
+                                 const std::vector<std::vector<cv::DMatch> > *queryMatches,
+                                 const bool onErrorThrow) const {
+  if ( isDebug() ) {
+    logger() << "\n*Removing outliers from image pairs:"
+             << "\n *  Query: " << query.name()
+             << "\n *  Train: " << train.name()
+             << "\n";
+    logger().flush();
+  }
+
+  try {
+    // OUTLIER DETECTION!!!
+    // 2, 3, 4,  5, 6: Apply ratio (2) and symmetric (3) tests, then apply
+    // RANSAC homography (4) outlier followed by epipoloar (5) and final
+    // homography (6)
+    double mtime(0);
+    cv::Mat homography, fundamental;
+    MatchImage v_query(query);
+    MatchImage v_train(train);
+    removeOutliers(v_query.descriptors(), v_train.descriptors(),
+                   v_query.keypoints(), v_train.keypoints(),
+                   pair.homography_matches(), pair.epipolar_matches(),
+                   pair.matches(), homography, fundamental,
+                   mtime, onErrorThrow, queryMatches);
+
+    pair.setFundamental(fundamental);
+    pair.setHomography(homography);
+    pair.addTime(mtime);
+
+    if ( toBool(m_parameters.get("SubpixelRefine")) ) {
+      refineMatches(queryImage, trainImage, v_query, v_train, pair.matches());
+    }
+  }
+  catch ( cv::Exception &c ) {
+    QString mess = "Outlier removal process failed on Query/Train image pair "
+                   " Query=" + query.name() +
+                   ", Train[" + QString::number(index) + "]: " + train.name() +
+                   ".  cv::Error - " + c.what();
+    pair.addError(mess);
+    if ( isDebug() ) {
+      logger() << "  Outlier Error = "
+                << pair.getError(pair.errorCount()-1) << "\n";
+      logger().flush();
+    }
+  }
+  catch ( IException &ie) {
+    QString mess = "Outlier removal process failed on Query/Train image pair "
+                   " Query=" + query.name() +
+                   ", Train[" + QString::number(index) + "]: " + train.name();
+    pair.addError(mess);
+    if ( isDebug() ) {
+      logger() << "  Outlier Error = "
+                << pair.getError(pair.errorCount()-1) << "\n";
+      logger().flush();
+    }
+  }
+  return;
+}
+
+
+/**
+ * @brief Refine the trainer keypoints of matches to subpixel accuracy
+ *
+ * A SubpixelPatch square of the rendered query image centered on the query
+ * keypoint is correlated with the rendered trainer image at every whole pixel
+ * within SubpixelSearch pixels of the trainer keypoint. The peak of the
+ * normalized correlation surface is refined with a paraboloid fit, and the
+ * trainer keypoint is moved to it.
+ *
+ * This assumes that the rendered images have about the same scale and
+ * orientation, as they do when the trainer is rendered in the query geometry
+ * with FastGeom. Matches whose patches are not entirely in the images, whose
+ * correlation peak is on the edge of the search area or below
+ * SubpixelTolerance, or whose peak cannot be fit are left as they are.
+ *
+ * @param queryImage Rendered query image
+ * @param trainImage Rendered trainer image
+ * @param query      Query image with its keypoints
+ * @param train      Trainer image, receives the refined keypoints
+ * @param matches    Matches of the query and trainer keypoints
+ *
+ * @return int Returns the number of refined matches
+ */
+int RobustMatcher::refineMatches(const cv::Mat &queryImage,
+                                 const cv::Mat &trainImage,
+                                 const MatchImage &query, MatchImage &train,
+                                 const std::vector<cv::DMatch> &matches) const {
+  int v_half = toInt(m_parameters.get("SubpixelPatch")) / 2;
+  int v_search = toInt(m_parameters.get("SubpixelSearch"));
+  double v_tolerance = toDouble(m_parameters.get("SubpixelTolerance"));
+  if ( ( v_half < 1 ) || ( v_search < 1 ) ) return ( 0 );
+
+  const Keypoints &v_queryPoints = query.keypoints();
+  Keypoints &v_trainPoints = train.keypoints();
+  int v_size = 2 * v_half + 1;
+  int v_surfaceSize = 2 * v_search + 1;
+  cv::Rect v_queryBounds(0, 0, queryImage.cols, queryImage.rows);
+  cv::Rect v_trainBounds(0, 0, trainImage.cols, trainImage.rows);
+
+  cv::Mat v_result, v_surface;
+  int v_refined(0);
+  for (unsigned int i = 0 ; i < matches.size() ; i++) {
+    const cv::Point2f &v_qpt = v_queryPoints[matches[i].queryIdx].pt;
+    cv::Point2f &v_tpt = v_trainPoints[matches[i].trainIdx].pt;
+    int qx = cvRound(v_qpt.x);
+    int qy = cvRound(v_qpt.y);
+    int tx = cvRound(v_tpt.x);
+    int ty = cvRound(v_tpt.y);
+
+    cv::Rect v_patch(qx - v_half, qy - v_half, v_size, v_size);
+    cv::Rect v_searchArea(tx - v_half - v_search, ty - v_half - v_search,
+                          v_size + 2 * v_search, v_size + 2 * v_search);
+    if ( ( (v_patch & v_queryBounds) != v_patch ) ||
+         ( (v_searchArea & v_trainBounds) != v_searchArea ) ) {
+      continue;
+    }
+
+    cv::matchTemplate(trainImage(v_searchArea), queryImage(v_patch), v_result,
+                      cv::TM_CCOEFF_NORMED);
+    double v_max;
+    cv::Point v_peak;
+    cv::minMaxLoc(v_result, 0, &v_max, 0, &v_peak);
+    if ( ( v_max < v_tolerance ) ||
+         ( v_peak.x < 1 ) || ( v_peak.x > v_surfaceSize - 2 ) ||
+         ( v_peak.y < 1 ) || ( v_peak.y > v_surfaceSize - 2 ) ) {
+      continue;
+    }
+
+    v_result.convertTo(v_surface, CV_64F);
+    double dx, dy;
+    if ( !SubpixelPeak::Paraboloid(v_surface.ptr<double>(), v_surface.cols,
+                                   v_surface.rows, v_peak.x, v_peak.y, 3,
+                                   dx, dy) ) {
+      continue;
+    }
+
+    // The peak locates the query pixel (qx,qy) in the trainer image
+    v_tpt.x = tx - v_search + v_peak.x + dx + (v_qpt.x - qx);
+    v_tpt.y = ty - v_search + v_peak.y + dy + (v_qpt.y - qy);
+    v_refined++;
+  }
+
+  if ( isDebug() ) {
+    logger() << "  Subpixel refined matches:  " << v_refined << " of "
+             << matches.size() << "\n";
+    logger().flush();
+  }
+  return ( v_refined );
+}
+
+
+/**
+ * @brief Match the query image to all trainer images with one index query
+ *
+ * All of the trainer descriptors are added to a FLANN index (a KD-tree forest
+ * for floating point descriptors, or LSH for binary descriptors), and each
+ * query descriptor is matched to its FlannNeighbors nearest neighbors over
+ * all trainers with a single query. The neighbors are then split by trainer
+ * into the two nearest neighbor lists used by the ratio test.
+ *
+ * When only one neighbor of a trainer is in the list, the distance to the
+ * last neighbor in the list is used as the second distance. It is never
+ * larger than the true second distance, so the ratio test is never passed
+ * that would fail with a direct match.
+ *
+ * @param query        Query image with its keypoints and descriptors
+ * @param trainers     Trainer images with their keypoints and descriptors
+ * @param queryMatches Returns the query to trainer matches of each trainer
+ */
+void RobustMatcher::indexMatches(const MatchImage &query,
+                                 const std::vector<MatchImage> &trainers,
+                                 std::vector<std::vector<std::vector<cv::DMatch> > >
+                                 &queryMatches) const {
+  QTime stime;
+  stime.start();
+
+  const Descriptors &v_query = query.descriptors();
+  cv::Ptr<cv::DescriptorMatcher> v_index;
+  if ( CV_32F == v_query.depth() ) {
+    v_index = cv::makePtr<cv::FlannBasedMatcher>();
+  }
+  else {
+    v_index = cv::makePtr<cv::FlannBasedMatcher>(
+                        cv::makePtr<cv::flann::LshIndexParams>(12, 20, 2));
+  }
+
+  std::vector<cv::Mat> v_descriptors;
+  for (unsigned int i = 0 ; i < trainers.size() ; i++) {
+    v_descriptors.push_back( trainers[i].descriptors() );
+  }
+  v_index->add(v_descriptors);
+  v_index->train();
+
+  int v_neighbors = qMax(2, toInt(m_parameters.get("FlannNeighbors")));
+  std::vector<std::vector<cv::DMatch> > v_matches;
+  v_index->knnMatch(v_query, v_matches, v_neighbors);
+
+  queryMatches.assign(trainers.size(),
+                      std::vector<std::vector<cv::DMatch> >(v_query.rows));
+  for (unsigned int q = 0 ; q < v_matches.size() ; q++) {
+    const std::vector<cv::DMatch> &neighbors = v_matches[q];
+    if ( neighbors.empty() ) continue;
+    float v_last = neighbors.back().distance;
+    for (unsigned int n = 0 ; n < neighbors.size() ; n++) {
+      std::vector<cv::DMatch> &v_nn = queryMatches[neighbors[n].imgIdx][q];
+      if ( v_nn.size() < 2 ) {
+        cv::DMatch match = neighbors[n];
+        match.imgIdx = 0;
+        v_nn.push_back(match);
+      }
+    }
+
+    for (unsigned int t = 0 ; t < trainers.size() ; t++) {
+      std::vector<cv::DMatch> &v_nn = queryMatches[t][q];
+      if ( v_nn.size() == 1 ) {
+        cv::DMatch bound = v_nn[0];
+        bound.distance = v_last;
+        v_nn.push_back(bound);
+      }
+    }
+  }
+
+  if ( isDebug() ) {
+    logger() << "--> Matched query to " << trainers.size() << " trainer images with "
+             << v_neighbors << " neighbors in " << elapsed(stime) << " seconds\n";
+    logger().flush();
+  }
+  return;
+}
+
+
+/**
+ * @brief Detect keypoints and extract their descriptors for an image
+ *
+ * The keypoints are restricted to the MaxPoints parameter. If a feature cache
+ * is provided, the keypoints and descriptors are read from the cache when
+ * they have already been computed for the same rendered image, detector,
+ * extractor and MaxPoints, and saved to it otherwise.
+ *
+ * @param image    Rendered image
+ * @param mimage   Match image that receives the keypoints and descriptors
+ * @param cache    Feature cache, or null if there is none
+ * @param d_time   Incremented by the detection time in seconds
+ * @param e_time   Incremented by the extraction time in seconds
+ *
+ * @return int Number of keypoints detected before they were restricted
+ */
+int RobustMatcher::detectAndExtract(const cv::Mat &image, MatchImage &mimage,
+                                    const FeatureCache *cache,
+                                    double &d_time, double &e_time) const {
+  return ( detectAndExtract(image, mimage, detector(), extractor(), cache,
+                            d_time, e_time) );
+}
+
+
+/**
+ * @brief Detect keypoints and extract their descriptors with given algorithms
+ *
+ * This is the same as the other detectAndExtract() but uses the detector and
+ * extractor provided instead of our own, so that threads do not share them.
+ *
+ * @param image     Rendered image
+ * @param mimage    Match image that receives the keypoints and descriptors
+ * @param detector  Detector algorithm to use
+ * @param extractor Extractor algorithm to use
+ * @param cache     Feature cache, or null if there is none
+ * @param d_time    Incremented by the detection time in seconds
+ * @param e_time    Incremented by the extraction time in seconds
+ *
+ * @return int Number of keypoints detected before they were restricted
+ */
+int RobustMatcher::detectAndExtract(const cv::Mat &image, MatchImage &mimage,
+                                    Feature2DAlgorithm &detector,
+                                    Feature2DAlgorithm &extractor,
+                                    const FeatureCache *cache,
+                                    double &d_time, double &e_time) const {
+  QTime stime;
+  stime.start();
+
+  QString v_key;
+  if ( cache ) {
+    QString v_detector = detector.config().isEmpty() ? detector.name() :
+                                                       detector.config();
+    QString v_extractor = extractor.config().isEmpty() ? extractor.name() :
+                                                         extractor.config();
+    v_key = cache->key(mimage, image, v_detector + "|" + v_extractor + "|MaxPoints=" +
+                              m_parameters.get("MaxPoints"));
+    if ( cache->load(v_key, mimage.keypoints(), mimage.descriptors()) ) {
+      d_time += elapsed(stime);
+      return ( mimage.size() );
+    }
+  }
+
+  detector.algorithm()->detect(image, mimage.keypoints());
+  int v_points = mimage.size();
+
+  // Limit keypoints if requested by user
+  int v_maxpoints = toInt(m_parameters.get("MaxPoints"));
+  if ( v_maxpoints > 0 ) {
+    cv::KeyPointsFilter::retainBest(mimage.keypoints(), v_maxpoints);
+  }
+  double v_time = elapsed(stime);
+  d_time += v_time;
+
+  extractor.algorithm()->compute(image, mimage.keypoints(), mimage.descriptors());
+  e_time += elapsed(stime) - v_time;
+
+  if ( cache ) {
+    cache->save(v_key, mimage.keypoints(), mimage.descriptors());
+  }
+  return ( v_points );
+}
+
+
+/**
+ * @brief Create the feature cache named by the FeatureCache parameter
+ *
+ * @return FeatureCache* New feature cache owned by the caller, or null if no
+ *                       cache directory was given
+ */
+FeatureCache *RobustMatcher::featureCache() const {
+  QString v_path = m_parameters.get("FeatureCache", "");
+  if ( v_path.isEmpty() ) return ( 0 );
+  return ( new FeatureCache(v_path) );
+}
+
+
 /**
  * @brief Apply ratio and symmetric outlier tests
  *
@@ -524,7 +917,8 @@ bool RobustMatcher::removeOutliers(const cv::Mat &queryDescriptors,
                                    std::vector<cv::DMatch> &epipolar_matches,
                                    std::vector<cv::DMatch> &matches,
                                    cv::Mat &homography, cv::Mat &fundamental,
-                                   double &mtime, const bool onErrorThrow)
+                                   double &mtime, const bool onErrorThrow,
+                                   const std::vector<std::vector<cv::DMatch> > *queryMatches)
                                    const {
 
   // Introduce ourselves
@@ -553,10 +947,16 @@ bool RobustMatcher::removeOutliers(const cv::Mat &queryDescriptors,
       logger() << "  Computing query->train Matches...\n";
       logger().flush();
     }
-    matcher().algorithm()->knnMatch(queryDescriptors, trainDescriptors,
-                                   matches1, // vector of matches (up to 2 per entry)
-                                   2); // return 2 nearest neighbours
-              }
+    if ( queryMatches ) {
+      // Already matched with the index of all trainer images
+      matches1 = *queryMatches;
+    }
+    else {
+      matcher().algorithm()->knnMatch(queryDescriptors, trainDescriptors,
+                                     matches1, // vector of matches (up to 2 per entry)
+                                     2); // return 2 nearest neighbours
+    }
+  }
   catch (cv::Exception &e) {
     QString mess = "RobustMatcher::MatcherFailed: "+ QString(e.what()) +
                    " - if its an assertion failure, you may be enabling "
@@ -1132,6 +1532,14 @@ void RobustMatcher::init(const PvlFlatMap &parameters) {
   m_parameters.add("MinimumFundamentalPoints", "8");
   m_parameters.add("RefineFundamentalMatrix",  "true");
   m_parameters.add("MinimumHomographyPoints",  "8");
+  m_parameters.add("MaxThreads",  "0");
+  m_parameters.add("FlannTrainers",  "0");
+  m_parameters.add("FlannNeighbors",  "8");
+  m_parameters.add("FeatureCache",  "");
+  m_parameters.add("SubpixelRefine",  "false");
+  m_parameters.add("SubpixelPatch",  "15");
+  m_parameters.add("SubpixelSearch",  "2");
+  m_parameters.add("SubpixelTolerance",  "0.7");
   m_parameters.merge(parameters);
   return;
 }
@@ -26,6 +26,7 @@ find files of those names at the top level of this repository. **/
 
 namespace Isis {
 
+class FeatureCache;
 class QDebug;
 
 /**
@@ -69,7 +70,8 @@ class QDebug;
                           std::vector<cv::DMatch> &epipolar_matches,
                           std::vector<cv::DMatch> &matches,
                           cv::Mat &homography, cv::Mat &fundamental,
-                          double &mtime, const bool onErrorThrow = true)
+                          double &mtime, const bool onErrorThrow = true,
+                          const std::vector<std::vector<cv::DMatch> > *queryMatches = 0)
                           const;
 
       int ratioTest( std::vector<std::vector<cv::DMatch> > &matches,
@@ -106,6 +108,31 @@ class QDebug;
       PvlFlatMap   m_parameters;  // Parameters for matcher
 
       void init(const PvlFlatMap &parameters = PvlFlatMap());
+      void extractTrainer(MatchImage &train, const cv::Mat &image,
+                          Feature2DAlgorithm &detector,
+                          Feature2DAlgorithm &extractor,
+                          const FeatureCache *cache, const bool doRootSift) const;
+      void matchTrainer(const MatchImage &query, const MatchImage &train,
+                        const cv::Mat &queryImage, const cv::Mat &trainImage,
+                        MatchPair &pair, const int index,
+                        const std::vector<std::vector<cv::DMatch> > *queryMatches,
+                        const bool onErrorThrow) const;
+      int refineMatches(const cv::Mat &queryImage, const cv::Mat &trainImage,
+                        const MatchImage &query, MatchImage &train,
+                        const std::vector<cv::DMatch> &matches) const;
+      void indexMatches(const MatchImage &query,
+                        const std::vector<MatchImage> &trainers,
+                        std::vector<std::vector<std::vector<cv::DMatch> > >
+                        &queryMatches) const;
+      int detectAndExtract(const cv::Mat &image, MatchImage &mimage,
+                           const FeatureCache *cache,
+                           double &d_time, double &e_time) const;
+      int detectAndExtract(const cv::Mat &image, MatchImage &mimage,
+                           Feature2DAlgorithm &detector,
+                           Feature2DAlgorithm &extractor,
+                           const FeatureCache *cache,
+                           double &d_time, double &e_time) const;
+      FeatureCache *featureCache() const;
       void RootSift(cv::Mat &descriptors, const float eps = 1.0E-7) const;
       double elapsed(const QTime &runtime) const;  // returns seconds
 
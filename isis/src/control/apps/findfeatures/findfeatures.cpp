@@ -156,11 +156,16 @@ namespace Isis{
     QStringList parmlist;
     parmlist << "Ratio" << "EpiTolerance" << "EpiConfidence" << "HmgTolerance"
              << "MaxPoints" << "FastGeom" << "FastGeomPoints" << "GeomType"
-             << "GeomSource" << "Filter";
+             << "GeomSource" << "Filter" << "MaxThreads" << "FlannTrainers";
     BOOST_FOREACH (QString p, parmlist ) {
       parameters.add(p, ui.GetAsString(p));
     }
 
+    // Keypoints and descriptors are cached on disk if requested
+    if ( ui.WasEntered("FEATURECACHE") ) {
+      parameters.add("FeatureCache", ui.GetAsString("FEATURECACHE"));
+    }
+
     // Got all parameters.  Add them now and they don't need to be considered
     // from here on.  Parameters specified in input algorithm specs take
     // precedence (in MatchMaker)
@@ -8,12 +8,21 @@ find files of those names at the top level of this repository. **/
 
 #include <sys/resource.h>
 
+#include <QAtomicInt>
+#include <QFuture>
+#include <QList>
+#include <QSet>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+#include <QVector>
+
 #include "pointreg.h"
 
 #include "AutoReg.h"
 #include "AutoRegFactory.h"
 #include "Camera.h"
 #include "Chip.h"
+#include "ChipTransformCache.h"
 #include "ControlMeasure.h"
 #include "ControlMeasureLogData.h"
 #include "ControlNet.h"
@@ -34,6 +43,7 @@ namespace Isis {
   AutoReg *ar;
   AutoReg *validator;
   CubeManager *cubeMgr;
+  ChipTransformCache *transformCache;
   SerialNumberList *files;
   QList<QString> *falsePositives;
 
@@ -184,8 +194,68 @@ namespace Isis {
   };
 
 
+  /**
+   * The registration of one measure to the reference measure of its point. The
+   * chips are loaded on the main thread, because loading them uses the cubes
+   * and their cameras, and then registered by one of the workers.
+   *
+   * @internal
+   */
+  struct MeasureRegistration {
+    ControlMeasure *measure;        //!< The measure being registered
+    Chip patternChip;               //!< The reference measure's chip
+    Chip searchChip;                //!< The measure's chip
+    bool loaded;                    //!< If the search chip was loaded
+    bool registered;                //!< If the registration ran without errors
+    AutoReg::RegisterStatus status; //!< The registration status
+    bool success;                   //!< If the registration succeeded
+    double cubeSample;              //!< The registered sample
+    double cubeLine;                //!< The registered line
+    double goodnessOfFit;           //!< The goodness of fit of the registration
+    double zScoreMin;               //!< The minimum z-score of the pattern chip
+    double zScoreMax;               //!< The maximum z-score of the pattern chip
+  };
+
+
+  /**
+   * A control point in a batch and the range of its measure registrations.
+   *
+   * @internal
+   */
+  struct PointRegistration {
+    ControlPoint *point;         //!< The point
+    bool wantToRegister;         //!< If the point is registered and validated
+    ControlMeasure *patternCM;   //!< The reference measure
+    int firstMeasure;            //!< Index of the point's first measure registration
+    int endMeasure;              //!< Index after the point's last measure registration
+  };
+
+
+  /**
+   * A batch of consecutive control points. The measures in one batch are
+   * registered while the chips for the next batch are loaded, so at most two
+   * batches are in memory at once.
+   *
+   * @internal
+   */
+  struct RegistrationBatch {
+    ~RegistrationBatch() {
+      qDeleteAll(measures);
+    }
+
+    QVector<PointRegistration> points;      //!< The points in the batch, in network order
+    QVector<MeasureRegistration *> measures; //!< The measure registrations in the batch
+    QAtomicInt nextMeasure;                 //!< The next measure for a worker to register
+  };
+
+
+  RegistrationBatch *loadBatch(const QList<ControlPoint *> &points, int &nextPoint,
+      int batchSize, QString registerPoints, QString registerMeasures,
+      QString validate);
+  void registerMeasure(AutoReg &worker, MeasureRegistration &registration);
   void registerPoint(ControlPoint *outPoint, ControlMeasure *patternCM,
-      QString registerMeasures, bool outputFailed);
+      const RegistrationBatch &batch, const PointRegistration &pointRegistration,
+      bool outputFailed);
   void validatePoint(ControlPoint *point, ControlMeasure *reference,
       double shiftTolerance);
   Validation backRegister(ControlMeasure *measure, ControlMeasure *reference,
@@ -209,6 +279,7 @@ namespace Isis {
     ar = NULL;
     validator = NULL;
     cubeMgr = NULL;
+    transformCache = NULL;
     falsePositives = NULL;
 
     ignored = 0;
@@ -251,6 +322,13 @@ namespace Isis {
     Pvl pvl(ui.GetFileName("DEFFILE"));
     ar = AutoRegFactory::Create(pvl);
 
+    // Measures on the same pair of images that are close together can share
+    // the transform used to load the search chip
+    if (ui.WasEntered("TRANSFORMCELL")) {
+      transformCache = new ChipTransformCache(ui.GetDouble("TRANSFORMCELL"));
+      ar->SearchChip()->SetTransformCache(transformCache);
+    }
+
     Progress progress;
     progress.SetText("Registering Points");
     progress.SetMaximumSteps(outNet.GetNumPoints());
@@ -293,72 +371,100 @@ namespace Isis {
       resTolerance = ui.GetDouble("RESTOLERANCE");
     }
 
+    // Each worker registers measures with its own copy of the AutoReg. The
+    // chips are loaded on the main thread, because the cameras are not thread
+    // safe, while the workers register the previous batch of points.
+    int numWorkers = QThreadPool::globalInstance()->maxThreadCount();
+    QList<AutoReg *> workers;
+    QVector<int> workerIndices;
+    for (int w = 0; w < numWorkers; w++) {
+      workers.append(AutoRegFactory::Create(pvl));
+      workerIndices.append(w);
+    }
+    int batchSize = numWorkers * 16;
+
     // Register the points and create a new
     // ControlNet containing the refined measurements
-    int i = 0;
-    while (i < outNet.GetNumPoints()) {
-
-      progress.CheckStatus();
-
-      ControlPoint * outPoint = outNet.GetPoint(i);
+    QList<ControlPoint *> points = outNet.GetPoints();
+    int nextPoint = 0;
+    RegistrationBatch *batch = loadBatch(points, nextPoint, batchSize,
+        registerPoints, registerMeasures, validate);
+
+    while (!batch->points.isEmpty()) {
+      QFuture<void> registering = QtConcurrent::map(workerIndices,
+          [batch, &workers](int w) {
+        int m;
+        while ((m = batch->nextMeasure.fetchAndAddOrdered(1)) < batch->measures.size()) {
+          registerMeasure(*workers[w], *batch->measures[m]);
+        }
+      });
 
-      // Establish whether or not we want to attempt to register this point.
-      bool wantToRegister = true;
-      if (outPoint->IsIgnored()) {
-        if (registerPoints == "NONIGNORED") wantToRegister = false;
+      RegistrationBatch *nextBatch = NULL;
+      try {
+        nextBatch = loadBatch(points, nextPoint, batchSize,
+            registerPoints, registerMeasures, validate);
       }
-      else {
-        if (registerPoints == "IGNORED") wantToRegister = false;
+      catch (IException &) {
+        registering.waitForFinished();
+        delete batch;
+        throw;
       }
 
-      // Check if this is a point we wish to disregard.
-      if (!wantToRegister) {
-        // Keep track of how many ignored points we didn't register.
-        if (outPoint->IsIgnored()) {
-          ignored++;
+      registering.waitForFinished();
 
-          // If the point is ignored and the user doesn't want them, delete it
-          if (!outputIgnored) {
-            outNet.DeletePoint(i);
-            continue;
-          }
-        }
-      }
-      else {  // "Ignore" or "valid" point to be registered
-        if (outPoint->IsIgnored()) {
-          outPoint->SetIgnored(false);
-        }
+      // Apply the results to the network in the same order as the points
+      foreach (const PointRegistration &pointRegistration, batch->points) {
+        progress.CheckStatus();
 
-        ControlMeasure * patternCM = outPoint->GetRefMeasure();
+        ControlPoint *outPoint = pointRegistration.point;
 
-        // In case this is an implicit reference, make it explicit since we'll be
-        // registering measures to it
-        outPoint->SetRefMeasure(patternCM);
+        // Check if this is a point we wish to disregard.
+        if (!pointRegistration.wantToRegister) {
+          // Keep track of how many ignored points we didn't register.
+          if (outPoint->IsIgnored()) {
+            ignored++;
 
-        if (validate != "ONLY") {
-          registerPoint(outPoint, patternCM, registerMeasures, outputFailed);
-        }
-        if (validate != "SKIP") {
-          validatePoint(outPoint, patternCM, ui.GetDouble("SHIFT"));
+            // If the point is ignored and the user doesn't want them, delete it
+            if (!outputIgnored) {
+              outNet.DeletePoint(outPoint->GetId());
+            }
+          }
         }
+        else {  // "Ignore" or "valid" point to be registered
+          ControlMeasure *patternCM = pointRegistration.patternCM;
 
-        // Check to see if the control point has now been assigned
-        // to "ignore".  If not, add it to the network. If so, only
-        // add it to the output if the OUTPUTIGNORED parameter is selected
-        // 2008-11-14 Jeannie Walldren
-        if (outPoint->IsIgnored()) {
-          ignored++;
-          if (!outputIgnored) {
-            outNet.DeletePoint(i);
-            continue;
+          if (validate != "ONLY") {
+            registerPoint(outPoint, patternCM, *batch, pointRegistration, outputFailed);
+          }
+          if (validate != "SKIP") {
+            validatePoint(outPoint, patternCM, ui.GetDouble("SHIFT"));
+          }
+
+          // Check to see if the control point has now been assigned
+          // to "ignore".  If not, add it to the network. If so, only
+          // add it to the output if the OUTPUTIGNORED parameter is selected
+          // 2008-11-14 Jeannie Walldren
+          if (outPoint->IsIgnored()) {
+            ignored++;
+            if (!outputIgnored) {
+              outNet.DeletePoint(outPoint->GetId());
+            }
           }
         }
       }
 
-      // The point wasn't deleted, so the network size is the same and we should
-      // increment our index.
-      i++;
+      delete batch;
+      batch = nextBatch;
     }
+    delete batch;
+    batch = NULL;
+
+    // Combine the registration statistics of the workers
+    foreach (AutoReg *worker, workers) {
+      ar->AddStatistics(*worker);
+    }
+    qDeleteAll(workers);
+    workers.clear();
 
     // If flatfile was entered, create the flatfile
     // The flatfile is comma seperated and can be imported into an excel
@@ -520,6 +626,9 @@ namespace Isis {
     delete cubeMgr;
     cubeMgr = NULL;
 
+    delete transformCache;
+    transformCache = NULL;
+
     delete files;
     files = NULL;
 
@@ -528,147 +637,271 @@ namespace Isis {
   }
 
 
-  void registerPoint(ControlPoint *outPoint, ControlMeasure *patternCM,
-      QString registerMeasures, bool outputFailed) {
+  /**
+   * Prepare the next batch of points for registration. Points that will be
+   * registered are un-ignored and have their reference measure made explicit,
+   * and the pattern and search chips for each of their measures are loaded.
+   *
+   * @param points The points in the network
+   * @param nextPoint The index of the first point in the batch. This is
+   *                  advanced past the points in the batch.
+   * @param batchSize The number of measure registrations after which the
+   *                  batch is ended
+   * @param registerPoints The POINTS parameter
+   * @param registerMeasures The MEASURES parameter
+   * @param validate The VALIDATE parameter
+   *
+   * @return @b RegistrationBatch* The batch. It is empty after the last point.
+   */
+  RegistrationBatch *loadBatch(const QList<ControlPoint *> &points, int &nextPoint,
+      int batchSize, QString registerPoints, QString registerMeasures,
+      QString validate) {
 
-    Cube &patternCube = *cubeMgr->OpenCube(
-        files->fileName(patternCM->GetCubeSerialNumber()));
+    RegistrationBatch *batch = new RegistrationBatch;
 
-    ar->PatternChip()->TackCube(patternCM->GetSample(), patternCM->GetLine());
-    ar->PatternChip()->Load(patternCube);
+    // The cube caches are cleared once for the whole batch, so that the tiles
+    // read for nearby points are only read once
+    QSet<QString> batchCubes;
 
-    if (patternCM->IsEditLocked()) {
-      locked++;
-    }
+    while (nextPoint < points.size() && batch->measures.size() < batchSize) {
+      ControlPoint *outPoint = points[nextPoint++];
 
-    if (outPoint->GetRefMeasure() != patternCM) {
-      outPoint->SetRefMeasure(patternCM);
-    }
+      PointRegistration pointRegistration;
+      pointRegistration.point = outPoint;
+      pointRegistration.patternCM = NULL;
+      pointRegistration.firstMeasure = batch->measures.size();
 
-    // Register all the unlocked measurements
-    int j = 0;
-    while (j < outPoint->GetNumMeasures()) {
-      if (j != outPoint->IndexOfRefMeasure()) {
+      // Establish whether or not we want to attempt to register this point.
+      pointRegistration.wantToRegister = true;
+      if (outPoint->IsIgnored()) {
+        if (registerPoints == "NONIGNORED") pointRegistration.wantToRegister = false;
+      }
+      else {
+        if (registerPoints == "IGNORED") pointRegistration.wantToRegister = false;
+      }
 
-        ControlMeasure * measure = outPoint->GetMeasure(j);
-        if (measure->IsEditLocked()) {
-          // If the measurement is locked, keep it as is and go to next measure
-          locked++;
+      if (pointRegistration.wantToRegister) {
+        if (outPoint->IsIgnored()) {
+          outPoint->SetIgnored(false);
         }
-        else if (!measure->IsMeasured() || registerMeasures != "CANDIDATES") {
 
-          // refresh pattern cube pointer to ensure it stays valid
-          Cube &patternCube = *cubeMgr->OpenCube(files->fileName(
-                patternCM->GetCubeSerialNumber()));
-          Cube &searchCube = *cubeMgr->OpenCube(files->fileName(
-                measure->GetCubeSerialNumber()));
+        ControlMeasure * patternCM = outPoint->GetRefMeasure();
 
-          ar->SearchChip()->TackCube(measure->GetSample(), measure->GetLine());
+        // In case this is an implicit reference, make it explicit since we'll be
+        // registering measures to it
+        outPoint->SetRefMeasure(patternCM);
+        pointRegistration.patternCM = patternCM;
 
-          verifyCube(patternCube);
-          verifyCube(searchCube);
+        if (validate != "ONLY") {
+          Cube &patternCube = *cubeMgr->OpenCube(
+              files->fileName(patternCM->GetCubeSerialNumber()));
 
-          try {
-            ar->SearchChip()->Load(searchCube, *(ar->PatternChip()), patternCube);
+          ar->PatternChip()->TackCube(patternCM->GetSample(), patternCM->GetLine());
+          ar->PatternChip()->Load(patternCube);
 
-            // If the measurements were correctly registered
-            // Write them to the new ControlNet
-            AutoReg::RegisterStatus res = ar->Register();
-            searchCube.clearIoCache();
-            patternCube.clearIoCache();
+          if (patternCM->IsEditLocked()) {
+            locked++;
+          }
 
-            double score1, score2;
-            ar->ZScores(score1, score2);
+          // Load the chips for all the unlocked measurements
+          for (int j = 0; j < outPoint->GetNumMeasures(); j++) {
+            if (j == outPoint->IndexOfRefMeasure()) {
+              continue;
+            }
 
-            // Set the minimum and maximum z-score values for the measure
-            measure->SetLogData(ControlMeasureLogData(
-                  ControlMeasureLogData::MinimumPixelZScore, score1));
-            measure->SetLogData(ControlMeasureLogData(
-                  ControlMeasureLogData::MaximumPixelZScore, score2));
-
-            if (ar->Success()) {
-              // Check to make sure the newly calculated measure position is on
-              // the surface of the planet
-              Camera *cam = searchCube.camera();
-              bool foundLatLon = cam->SetImage(ar->CubeSample(), ar->CubeLine());
-
-              if (foundLatLon) {
-                registered++;
-
-                if (res == AutoReg::SuccessSubPixel) {
-                  measure->SetType(ControlMeasure::RegisteredSubPixel);
-                }
-                else {
-                  measure->SetType(ControlMeasure::RegisteredPixel);
-                }
-
-                measure->SetLogData(ControlMeasureLogData(
-                      ControlMeasureLogData::GoodnessOfFit,
-                      ar->GoodnessOfFit()));
-
-                measure->SetAprioriSample(measure->GetSample());
-                measure->SetAprioriLine(measure->GetLine());
-                measure->SetCoordinate(ar->CubeSample(), ar->CubeLine());
-                measure->SetIgnored(false);
-
-                // We successfully registered the current measure to the
-                // reference, and since we set the current measure to be
-                // unignored, it follows that its reference should also be made
-                // unignored.
-                patternCM->SetIgnored(false);
+            ControlMeasure * measure = outPoint->GetMeasure(j);
+            if (measure->IsEditLocked()) {
+              // If the measurement is locked, keep it as is and go to next measure
+              locked++;
+            }
+            else if (!measure->IsMeasured() || registerMeasures != "CANDIDATES") {
+
+              // refresh pattern cube pointer to ensure it stays valid
+              Cube &patternCube = *cubeMgr->OpenCube(files->fileName(
+                    patternCM->GetCubeSerialNumber()));
+              Cube &searchCube = *cubeMgr->OpenCube(files->fileName(
+                    measure->GetCubeSerialNumber()));
+
+              ar->SearchChip()->TackCube(measure->GetSample(), measure->GetLine());
+
+              verifyCube(patternCube);
+              verifyCube(searchCube);
+
+              MeasureRegistration *registration = new MeasureRegistration;
+              registration->measure = measure;
+              registration->loaded = false;
+              registration->registered = false;
+              batch->measures.append(registration);
+
+              try {
+                ar->SearchChip()->Load(searchCube, *(ar->PatternChip()), patternCube);
+                registration->patternChip = *(ar->PatternChip());
+                registration->searchChip = *(ar->SearchChip());
+                registration->loaded = true;
               }
-              else {
-                notintersected++;
-
-                if (outputFailed) {
-                  measure->SetType(ControlMeasure::Candidate);
-                  measure->SetIgnored(true);
-                }
-                else {
-                  outPoint->Delete(j);
-                  continue;
-                }
+              catch (IException &) {
+                // A chip that fails to load leaves loaded false, which skips the measure
               }
+
+              batchCubes.insert(files->fileName(patternCM->GetCubeSerialNumber()));
+              batchCubes.insert(files->fileName(measure->GetCubeSerialNumber()));
             }
-            // Else use the original marked as "Candidate"
-            else {
-              unregistered++;
+          }
+        }
+      }
 
-              if (outputFailed) {
-                measure->SetType(ControlMeasure::Candidate);
+      pointRegistration.endMeasure = batch->measures.size();
+      batch->points.append(pointRegistration);
+    }
 
-                if (res == AutoReg::FitChipToleranceNotMet) {
-                  measure->SetLogData(ControlMeasureLogData(
-                        ControlMeasureLogData::GoodnessOfFit,
-                        ar->GoodnessOfFit()));
-                }
-                measure->SetIgnored(true);
-              }
-              else {
-                outPoint->Delete(j);
-                continue;
-              }
+    foreach (QString cubeFile, batchCubes) {
+      cubeMgr->OpenCube(cubeFile)->clearIoCache();
+    }
+
+    return batch;
+  }
+
+
+  /**
+   * Register the chips for a measure. This is run by the workers, so it must
+   * not use the cubes, cameras or network.
+   *
+   * @param worker The worker's AutoReg
+   * @param registration The measure registration, which receives the results
+   */
+  void registerMeasure(AutoReg &worker, MeasureRegistration &registration) {
+    if (!registration.loaded) {
+      return;
+    }
+
+    try {
+      *worker.PatternChip() = registration.patternChip;
+      *worker.SearchChip() = registration.searchChip;
+
+      registration.status = worker.Register();
+      registration.success = worker.Success();
+      worker.ZScores(registration.zScoreMin, registration.zScoreMax);
+      registration.goodnessOfFit = worker.GoodnessOfFit();
+      registration.cubeSample = worker.CubeSample();
+      registration.cubeLine = worker.CubeLine();
+      registration.registered = true;
+    }
+    catch (IException &e) {
+    }
+  }
+
+
+  /**
+   * Update a point's measures with the results of their registrations.
+   *
+   * @param outPoint The point
+   * @param patternCM The point's reference measure
+   * @param batch The batch containing the point
+   * @param pointRegistration The point's entry in the batch
+   * @param outputFailed If measures that fail to register are kept
+   */
+  void registerPoint(ControlPoint *outPoint, ControlMeasure *patternCM,
+      const RegistrationBatch &batch, const PointRegistration &pointRegistration,
+      bool outputFailed) {
+
+    if (outPoint->GetRefMeasure() != patternCM) {
+      outPoint->SetRefMeasure(patternCM);
+    }
+
+    for (int m = pointRegistration.firstMeasure; m < pointRegistration.endMeasure; m++) {
+      const MeasureRegistration &registration = *batch.measures[m];
+      ControlMeasure * measure = registration.measure;
+
+      try {
+        if (!registration.registered) {
+          throw IException(IException::Unknown, "Registration failed", _FILEINFO_);
+        }
+
+        // If the measurements were correctly registered
+        // Write them to the new ControlNet
+        AutoReg::RegisterStatus res = registration.status;
+
+        // Set the minimum and maximum z-score values for the measure
+        measure->SetLogData(ControlMeasureLogData(
+              ControlMeasureLogData::MinimumPixelZScore, registration.zScoreMin));
+        measure->SetLogData(ControlMeasureLogData(
+              ControlMeasureLogData::MaximumPixelZScore, registration.zScoreMax));
+
+        if (registration.success) {
+          // Check to make sure the newly calculated measure position is on
+          // the surface of the planet
+          Cube &searchCube = *cubeMgr->OpenCube(files->fileName(
+                measure->GetCubeSerialNumber()));
+          Camera *cam = searchCube.camera();
+          bool foundLatLon = cam->SetImage(registration.cubeSample, registration.cubeLine);
+
+          if (foundLatLon) {
+            registered++;
+
+            if (res == AutoReg::SuccessSubPixel) {
+              measure->SetType(ControlMeasure::RegisteredSubPixel);
             }
+            else {
+              measure->SetType(ControlMeasure::RegisteredPixel);
+            }
+
+            measure->SetLogData(ControlMeasureLogData(
+                  ControlMeasureLogData::GoodnessOfFit,
+                  registration.goodnessOfFit));
+
+            measure->SetAprioriSample(measure->GetSample());
+            measure->SetAprioriLine(measure->GetLine());
+            measure->SetCoordinate(registration.cubeSample, registration.cubeLine);
+            measure->SetIgnored(false);
+
+            // We successfully registered the current measure to the
+            // reference, and since we set the current measure to be
+            // unignored, it follows that its reference should also be made
+            // unignored.
+            patternCM->SetIgnored(false);
           }
-          catch (IException &e) {
-            unregistered++;
+          else {
+            notintersected++;
 
             if (outputFailed) {
               measure->SetType(ControlMeasure::Candidate);
               measure->SetIgnored(true);
             }
             else {
-              outPoint->Delete(j);
-              continue;
+              outPoint->Delete(measure);
             }
           }
         }
+        // Else use the original marked as "Candidate"
+        else {
+          unregistered++;
+
+          if (outputFailed) {
+            measure->SetType(ControlMeasure::Candidate);
+
+            if (res == AutoReg::FitChipToleranceNotMet) {
+              measure->SetLogData(ControlMeasureLogData(
+                    ControlMeasureLogData::GoodnessOfFit,
+                    registration.goodnessOfFit));
+            }
+            measure->SetIgnored(true);
+          }
+          else {
+            outPoint->Delete(measure);
+          }
+        }
       }
+      catch (IException &e) {
+        unregistered++;
 
-      // If we made it here (without continuing on to the next measure),
-      // then the measure wasn't deleted and we should therefore increment
-      // the index of the measure we're looking at.
-      j++;
+        if (outputFailed) {
+          measure->SetType(ControlMeasure::Candidate);
+          measure->SetIgnored(true);
+        }
+        else {
+          outPoint->Delete(measure);
+        }
+      }
     }
 
     // Jeff Anderson put in this test (Dec 2, 2008) to allow for control
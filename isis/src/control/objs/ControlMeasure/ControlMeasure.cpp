@@ -278,8 +278,22 @@ namespace Isis {
   }
 
 
+  /**
+   * Set the edit lock of the measure. The parent network is notified of the change so
+   * observers such as ControlNetStatistics can keep their counts of locked measures.
+   *
+   * @param editLock True to lock the measure
+   *
+   * @return Status Success
+   */
   ControlMeasure::Status ControlMeasure::SetEditLock(bool editLock) {
+    bool oldLock = p_editLock;
     p_editLock = editLock;
+
+    if (Parent()) {
+      Parent()->emitMeasureModified(this, EditLockModified, oldLock, p_editLock);
+    }
+
     return Success;
   }
 
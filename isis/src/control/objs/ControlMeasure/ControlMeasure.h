@@ -228,9 +228,12 @@ namespace Isis {
        *
        * IgnoredModified means that the Control Measure had it's IGNORED flag changed.
        *
+       * EditLockModified means that the Control Measure had it's EDITLOCK flag changed.
+       *
        */
       enum ModType {
-        IgnoredModified
+        IgnoredModified,
+        EditLockModified
       };
 
       enum DataField {
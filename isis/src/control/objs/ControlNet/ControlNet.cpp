@@ -270,6 +270,42 @@ namespace Isis {
 
     FileName cnetFileName(filename);
     ControlNetVersioner versionedReader(cnetFileName, progress);
+    readVersioner(versionedReader, progress);
+  }
+
+
+  /**
+   * Reads in the control points from the given file that pass a filter. For binary control
+   * networks, points that fail the filter are skipped while the file is read, so they are
+   * never fully created.
+   *
+   * @param filename Name of the control network file
+   * @param filter The filter that points must pass to be added to the network
+   * @param rejectedPoints If not NULL, the ID, properties, number of measures and filtered
+   *                       fields of the points that failed the filter are returned here, in
+   *                       file order
+   * @param progress A pointer to the progress of reading in the control points
+   */
+  void ControlNet::ReadControl(const QString &filename, const ControlNetPointFilter &filter,
+                               QList<ControlNetPointFilter::PointFields> *rejectedPoints,
+                               Progress *progress) {
+    FileName cnetFileName(filename);
+    ControlNetVersioner versionedReader(cnetFileName, filter, progress);
+    if (rejectedPoints) {
+      *rejectedPoints = versionedReader.rejectedPoints();
+    }
+    readVersioner(versionedReader, progress);
+  }
+
+
+  /**
+   * Take the network information and control points from a versioner that has read a
+   * control network file.
+   *
+   * @param versionedReader The versioner that read the control network file
+   * @param progress A pointer to the progress of adding the control points
+   */
+  void ControlNet::readVersioner(ControlNetVersioner &versionedReader, Progress *progress) {
     SetTarget( versionedReader.targetName() );
     p_networkId   = versionedReader.netId();
     p_userName    = versionedReader.userName();
@@ -905,8 +941,10 @@ namespace Isis {
 
     bool wasIgnored = point->IsIgnored();
 
-    // notify CubeSerialNumbers of the loss of this point
+    // notify CubeSerialNumbers of the loss of this point. Locked measures are unlocked
+    // first so they are removed with the point.
     foreach(ControlMeasure * measure, point->getMeasures()) {
+      measure->SetEditLock(false);
       point->Delete(measure);
     }
 
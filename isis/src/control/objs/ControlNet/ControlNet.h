@@ -27,6 +27,7 @@ find files of those names at the top level of this repository. **/
 #include <boost/graph/connected_components.hpp>
 
 #include "ControlMeasure.h"
+#include "ControlNetPointFilter.h"
 #include "ControlPoint.h"
 
 template< typename A, typename B > class QHash;
@@ -40,6 +41,7 @@ class QString;
 namespace Isis {
   class Camera;
   class ControlMeasure;
+  class ControlNetVersioner;
   class ControlPoint;
   class Distance;
   class Progress;
@@ -288,6 +290,9 @@ namespace Isis {
       QList< ControlPoint * > take();
 
       void ReadControl(const QString &filename, Progress *progress = 0);
+      void ReadControl(const QString &filename, const ControlNetPointFilter &filter,
+                       QList<ControlNetPointFilter::PointFields> *rejectedPoints = 0,
+                       Progress *progress = 0);
       void Write(const QString &filename, bool pvl = false);
 
       void AddPoint(ControlPoint *point);
@@ -380,6 +385,7 @@ namespace Isis {
 
     private:
       void nullify();
+      void readVersioner(ControlNetVersioner &versionedReader, Progress *progress);
       bool ValidateSerialNumber(QString serialNumber) const;
       void measureAdded(ControlMeasure *measure);
       void measureDeleted(ControlMeasure *measure);
@@ -16,6 +16,7 @@ find files of those names at the top level of this repository. **/
 #include "ControlMeasure.h"
 #include "ControlMeasureLogData.h"
 #include "ControlNet.h"
+#include "ControlNetPointFilter.h"
 #include "ControlPoint.h"
 #include "FileName.h"
 #include "IString.h"
@@ -329,10 +330,14 @@ namespace Isis {
       mOstm << endl;
     }
 
+    ControlNetPointFilter pointFilter;
+    pointFilter.setEditLocked(editLock);
+    QVector<bool> accepted = pointFilter.evaluate(mCNet->GetPoints());
+
     int iNumPoints = mCNet->GetNumPoints();
     for (int i = (iNumPoints - 1); i >= 0; i--) {
       ControlPoint *cPoint = mCNet->GetPoint(i);
-      if (cPoint->IsEditLocked() != editLock) {
+      if (!accepted[i]) {
         FilterOutPoint(i);
         continue;
       }
@@ -522,12 +527,16 @@ namespace Isis {
       mOstm << "FileName, SerialNum, MeasureType, MeasureIgnore, MeasureEditLock, Reference" << endl;
     }
 
+    ControlNetPointFilter pointFilter;
+    pointFilter.setNumMeasuresRange(iGreater, iLesser);
+    QVector<bool> accepted = pointFilter.evaluate(mCNet->GetPoints());
+
     int iNumPoints = mCNet->GetNumPoints();
 
     for (int i = (iNumPoints - 1); i >= 0; i--) {
       const ControlPoint *cPoint = mCNet->GetPoint(i);
       int iNumMeasures = cPoint->GetNumMeasures();
-      if (iNumMeasures > iLesser || iNumMeasures < iGreater) {
+      if (!accepted[i]) {
         FilterOutPoint(i);
         continue;
       }
@@ -584,32 +593,31 @@ namespace Isis {
       mOstm << endl;
     }
 
+    ControlNetPointFilter pointFilter;
+    if (iSetIgnoreFlag) {
+      pointFilter.setIgnored(bIgnoredFlag);
+    }
+    if (sType != "all" && sType != "") {
+      // An unknown point type does not match any points
+      QList<ControlPoint::PointType> types;
+      if (sType == "fixed") {
+        types.append(ControlPoint::Fixed);
+      }
+      else if (sType == "constrained") {
+        types.append(ControlPoint::Constrained);
+      }
+      else if (sType == "free") {
+        types.append(ControlPoint::Free);
+      }
+      pointFilter.setPointTypes(types);
+    }
+    QVector<bool> accepted = pointFilter.evaluate(mCNet->GetPoints());
+
     int iNumPoints = mCNet->GetNumPoints();
 
     for (int i = (iNumPoints - 1); i >= 0; i--) {
       const ControlPoint *cPoint = mCNet->GetPoint(i);
-      bool bPointFound = false;
-      bool bIgnored = cPoint->IsIgnored();
-      bool bFixed       = (cPoint->GetType() == ControlPoint::Fixed       ? true : false);
-      bool bConstrained = (cPoint->GetType() == ControlPoint::Constrained ? true : false);
-      bool bFree        = (cPoint->GetType() == ControlPoint::Free        ? true : false);
-
-      if (!iSetIgnoreFlag || bIgnoredFlag == bIgnored) {
-        if (sType == "all" || sType=="") {
-          bPointFound = true;
-        }
-        else if (sType == "fixed" && bFixed) {
-          bPointFound = true;
-        }
-        else if (sType == "constrained" && bConstrained) {
-          bPointFound = true;
-        }
-        else if (sType == "free" && bFree) {
-          bPointFound = true;
-        }
-      }
-
-      if(!bPointFound) {
+      if (!accepted[i]) {
         FilterOutPoint(i);
         continue;
       }
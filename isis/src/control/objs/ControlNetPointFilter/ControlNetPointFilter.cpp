@@ -0,0 +1,398 @@
+/** This is free and unencumbered software released into the public domain.
+
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include "ControlNetPointFilter.h"
+
+#include <QPair>
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include "ControlMeasure.h"
+#include "IException.h"
+#include "IString.h"
+#include "SpecialPixel.h"
+#include "SurfacePoint.h"
+
+namespace Isis {
+
+  /**
+   * Construct an empty set of point fields.
+   */
+  ControlNetPointFilter::PointFields::PointFields() {
+    ignored = false;
+    type = ControlPoint::Free;
+    editLocked = false;
+    numMeasures = 0;
+    maxResidual = Null;
+    hasSurfacePoint = false;
+  }
+
+
+  /**
+   * Construct a filter with no predicates. Every point passes an empty filter.
+   */
+  ControlNetPointFilter::ControlNetPointFilter() {
+    m_filterIgnored = false;
+    m_ignored = false;
+    m_filterTypes = false;
+    m_filterEditLocked = false;
+    m_editLocked = false;
+    m_filterNumMeasures = false;
+    m_minMeasures = 0;
+    m_maxMeasures = 0;
+    m_filterPointIds = false;
+    m_pointIdCaseSensitivity = Qt::CaseSensitive;
+    m_filterSerialNumbers = false;
+    m_filterResidual = false;
+    m_minResidual = 0.0;
+    m_filterLatLon = false;
+    m_acceptEditLocked = false;
+  }
+
+
+  /**
+   * Destroy the filter.
+   */
+  ControlNetPointFilter::~ControlNetPointFilter() {
+  }
+
+
+  /**
+   * Only accept points with an ignored flag.
+   *
+   * @param ignored The ignored flag that points must have.
+   */
+  void ControlNetPointFilter::setIgnored(bool ignored) {
+    m_filterIgnored = true;
+    m_ignored = ignored;
+  }
+
+
+  /**
+   * Only accept points of some types.
+   *
+   * @param types The point types that are accepted.
+   */
+  void ControlNetPointFilter::setPointTypes(const QList<ControlPoint::PointType> &types) {
+    m_filterTypes = true;
+    m_types = types;
+  }
+
+
+  /**
+   * Only accept points with an edit lock flag.
+   *
+   * @param editLocked The edit lock flag that points must have.
+   */
+  void ControlNetPointFilter::setEditLocked(bool editLocked) {
+    m_filterEditLocked = true;
+    m_editLocked = editLocked;
+  }
+
+
+  /**
+   * Only accept points with a number of measures in a range.
+   *
+   * @param minimum The minimum number of measures, inclusive.
+   * @param maximum The maximum number of measures, inclusive.
+   */
+  void ControlNetPointFilter::setNumMeasuresRange(int minimum, int maximum) {
+    if (minimum > maximum) {
+      QString msg = "The minimum number of measures [" + toString(minimum)
+                    + "] is greater than the maximum number of measures ["
+                    + toString(maximum) + "].";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_filterNumMeasures = true;
+    m_minMeasures = minimum;
+    m_maxMeasures = maximum;
+  }
+
+
+  /**
+   * Only accept points with an ID in a list.
+   *
+   * @param pointIds The point IDs that are accepted.
+   * @param caseSensitivity If the point IDs are compared by case.
+   */
+  void ControlNetPointFilter::setPointIds(const QList<QString> &pointIds,
+                                          Qt::CaseSensitivity caseSensitivity) {
+    m_filterPointIds = true;
+    m_pointIdCaseSensitivity = caseSensitivity;
+    m_pointIds.clear();
+    foreach (const QString &pointId, pointIds) {
+      m_pointIds.insert(caseSensitivity == Qt::CaseSensitive ? pointId : pointId.toLower());
+    }
+  }
+
+
+  /**
+   * Only accept points that have a measure on at least one cube in a list.
+   *
+   * @param serialNumbers The serial numbers of the cubes.
+   */
+  void ControlNetPointFilter::setCubeSerialNumbers(const QList<QString> &serialNumbers) {
+    m_filterSerialNumbers = true;
+    m_serialNumbers = QSet<QString>::fromList(serialNumbers);
+  }
+
+
+  /**
+   * Only accept points that have a measure with a sample or line residual at least as large
+   * as a tolerance.
+   *
+   * @param tolerance The residual tolerance in pixels.
+   */
+  void ControlNetPointFilter::setMinimumResidual(double tolerance) {
+    m_filterResidual = true;
+    m_minResidual = tolerance;
+  }
+
+
+  /**
+   * Only accept points whose best surface point is within a latitude and longitude range.
+   * Points without a surface point are not accepted.
+   *
+   * @param minLat The minimum latitude.
+   * @param maxLat The maximum latitude.
+   * @param minLon The minimum longitude.
+   * @param maxLon The maximum longitude. This may be less than the minimum longitude for
+   *               ranges that cross the longitude domain boundary.
+   */
+  void ControlNetPointFilter::setLatLonRange(Latitude minLat, Latitude maxLat,
+                                             Longitude minLon, Longitude maxLon) {
+    if ( !minLat.isValid() || !maxLat.isValid() || !minLon.isValid() || !maxLon.isValid() ) {
+      QString msg = "The latitude and longitude range must be valid.";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+    if (minLat > maxLat) {
+      QString msg = "The minimum latitude [" + minLat.toString()
+                    + "] is greater than the maximum latitude [" + maxLat.toString() + "].";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_filterLatLon = true;
+    m_minLat = minLat;
+    m_maxLat = maxLat;
+    m_minLon = minLon;
+    m_maxLon = maxLon;
+  }
+
+
+  /**
+   * Accept edit locked points without testing the other predicates. This selects the points
+   * that an edit may remove, since edit locked points must be kept as they are.
+   *
+   * @param accept If edit locked points are always accepted.
+   */
+  void ControlNetPointFilter::setAcceptEditLocked(bool accept) {
+    m_acceptEditLocked = accept;
+  }
+
+
+  /**
+   * @return @b bool If the filter has no predicates.
+   */
+  bool ControlNetPointFilter::isEmpty() const {
+    return requiredFields() == NoFields;
+  }
+
+
+  /**
+   * Returns the point fields that the active predicates use.
+   *
+   * @return @b int A combination of Field flags.
+   */
+  int ControlNetPointFilter::requiredFields() const {
+    int fields = NoFields;
+    if (m_filterPointIds) {
+      fields |= IdField;
+    }
+    if (m_filterIgnored || m_filterTypes || m_filterEditLocked) {
+      fields |= PropertyFields;
+    }
+    if (m_filterNumMeasures) {
+      fields |= MeasureCountField;
+    }
+    if (m_filterSerialNumbers) {
+      fields |= SerialNumberFields;
+    }
+    if (m_filterResidual) {
+      fields |= ResidualField;
+    }
+    if (m_filterLatLon) {
+      fields |= SurfacePointFields;
+    }
+    if (m_acceptEditLocked && fields != NoFields) {
+      fields |= PropertyFields;
+    }
+    return fields;
+  }
+
+
+  /**
+   * Test if a point passes the filter. The cheapest predicates are tested first.
+   *
+   * @param fields The point's fields. At least the requiredFields must be filled in.
+   *
+   * @return @b bool If the point passes every predicate.
+   */
+  bool ControlNetPointFilter::accepts(const PointFields &fields) const {
+    if (m_acceptEditLocked && fields.editLocked) {
+      return true;
+    }
+    if (m_filterIgnored && fields.ignored != m_ignored) {
+      return false;
+    }
+    if (m_filterEditLocked && fields.editLocked != m_editLocked) {
+      return false;
+    }
+    if (m_filterTypes && !m_types.contains(fields.type)) {
+      return false;
+    }
+    if ( m_filterNumMeasures &&
+         (fields.numMeasures < m_minMeasures || fields.numMeasures > m_maxMeasures) ) {
+      return false;
+    }
+    if ( m_filterResidual &&
+         (IsSpecial(fields.maxResidual) || fields.maxResidual < m_minResidual) ) {
+      return false;
+    }
+    if (m_filterPointIds) {
+      QString id = (m_pointIdCaseSensitivity == Qt::CaseSensitive) ? fields.id
+                                                                   : fields.id.toLower();
+      if ( !m_pointIds.contains(id) ) {
+        return false;
+      }
+    }
+    if (m_filterSerialNumbers) {
+      bool hasSerialNumber = false;
+      foreach (const QString &serialNumber, fields.serialNumbers) {
+        if ( m_serialNumbers.contains(serialNumber) ) {
+          hasSerialNumber = true;
+          break;
+        }
+      }
+      if (!hasSerialNumber) {
+        return false;
+      }
+    }
+    if (m_filterLatLon) {
+      if ( !fields.hasSurfacePoint ||
+           !fields.latitude.inRange(m_minLat, m_maxLat) ||
+           !fields.longitude.inRange(m_minLon, m_maxLon) ) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+
+  /**
+   * Test if a point passes the filter.
+   *
+   * @param point The point to test.
+   *
+   * @return @b bool If the point passes every predicate.
+   */
+  bool ControlNetPointFilter::accepts(const ControlPoint &point) const {
+    return accepts( pointFields(point, requiredFields()) );
+  }
+
+
+  /**
+   * Test a list of points against the filter. The points are split into contiguous chunks
+   * that are tested concurrently. The points must not be modified while they are tested.
+   *
+   * @param points The points to test.
+   *
+   * @return @b QVector<bool> If each point passes the filter, in the same order as the points.
+   */
+  QVector<bool> ControlNetPointFilter::evaluate(const QList<ControlPoint *> &points) const {
+    QVector<bool> accepted(points.size(), true);
+    if ( isEmpty() || points.isEmpty() ) {
+      return accepted;
+    }
+
+    int fields = requiredFields();
+    int numPoints = points.size();
+    int numChunks = qMax(1, qMin(numPoints, QThread::idealThreadCount() * 4));
+
+    QVector< QPair<int, int> > chunks;
+    for (int i = 0; i < numChunks; i++) {
+      chunks.append( qMakePair((int)((qint64)numPoints * i / numChunks),
+                               (int)((qint64)numPoints * (i + 1) / numChunks)) );
+    }
+
+    bool *acceptedData = accepted.data();
+    QtConcurrent::blockingMap(chunks, [&](const QPair<int, int> &chunk) {
+      for (int i = chunk.first; i < chunk.second; i++) {
+        acceptedData[i] = accepts( pointFields(*points[i], fields) );
+      }
+    });
+
+    return accepted;
+  }
+
+
+  /**
+   * Gather the fields of a control point that the predicates use.
+   *
+   * @param point The point to gather fields from.
+   * @param fields The Field flags for the fields to gather.
+   *
+   * @return @b PointFields The point's fields.
+   */
+  ControlNetPointFilter::PointFields ControlNetPointFilter::pointFields(const ControlPoint &point,
+                                                                        int fields) {
+    PointFields result;
+
+    if (fields & IdField) {
+      result.id = point.GetId();
+    }
+
+    if (fields & PropertyFields) {
+      result.ignored = point.IsIgnored();
+      result.type = point.GetType();
+      result.editLocked = point.IsEditLocked();
+    }
+
+    if (fields & MeasureCountField) {
+      result.numMeasures = point.GetNumMeasures();
+    }
+
+    if (fields & SerialNumberFields) {
+      result.serialNumbers = point.getCubeSerialNumbers();
+    }
+
+    if (fields & ResidualField) {
+      for (int i = 0; i < point.GetNumMeasures(); i++) {
+        const ControlMeasure *measure = point.GetMeasure(i);
+        double residuals[2] = { measure->GetSampleResidual(), measure->GetLineResidual() };
+        for (int j = 0; j < 2; j++) {
+          if ( !IsSpecial(residuals[j]) &&
+               (IsSpecial(result.maxResidual) || residuals[j] > result.maxResidual) ) {
+            result.maxResidual = residuals[j];
+          }
+        }
+      }
+    }
+
+    if (fields & SurfacePointFields) {
+      SurfacePoint surfacePoint = point.GetBestSurfacePoint();
+      if ( surfacePoint.Valid() ) {
+        result.hasSurfacePoint = true;
+        result.latitude = surfacePoint.GetLatitude();
+        result.longitude = surfacePoint.GetLongitude();
+      }
+    }
+
+    return result;
+  }
+}
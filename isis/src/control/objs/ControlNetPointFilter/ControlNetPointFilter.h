@@ -0,0 +1,126 @@
+#ifndef ControlNetPointFilter_h
+#define ControlNetPointFilter_h
+
+/** This is free and unencumbered software released into the public domain.
+
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include "ControlPoint.h"
+#include "Latitude.h"
+#include "Longitude.h"
+
+namespace Isis {
+
+  /**
+   * @brief Simple predicates that select control points
+   *
+   * A ControlNetPointFilter is a set of simple predicates on control point fields, such as
+   * the ignored flag, the point type, the number of measures, or the cubes that a point is
+   * measured on. A point passes the filter if it passes every predicate that has been set.
+   *
+   * The predicates only look at a few fields of each point, which are gathered into a
+   * PointFields record. This allows the same filter to be evaluated in two places:
+   * <ul>
+   *   <li>Over the points of a loaded network with evaluate, which splits the points into
+   *       chunks and evaluates the chunks concurrently.</li>
+   *   <li>Inside of the ControlNetVersioner while a binary network is being read. The
+   *       fields are taken directly from each protobuf point message, so points that fail
+   *       the filter are never converted into ControlPoints.</li>
+   * </ul>
+   *
+   * @ingroup ControlNetwork
+   */
+  class ControlNetPointFilter {
+    public:
+      /**
+       * The point fields that the predicates use. Only the fields that the active predicates
+       * need are filled in, see requiredFields.
+       */
+      struct PointFields {
+        PointFields();
+
+        QString id;                   //!< The point ID.
+        bool ignored;                 //!< If the point is ignored.
+        ControlPoint::PointType type; //!< The point type.
+        bool editLocked;              //!< If the point is edit locked.
+        int numMeasures;              //!< The number of measures in the point.
+        QList<QString> serialNumbers; //!< The serial numbers of the measured cubes.
+        double maxResidual;           /**< The largest sample or line residual of the point's
+                                           measures, Null if no measure has a residual.*/
+        bool hasSurfacePoint;         //!< If the point has a valid surface point.
+        Latitude latitude;            //!< The latitude of the best surface point.
+        Longitude longitude;          //!< The longitude of the best surface point.
+      };
+
+      /**
+       * Flags for each group of fields in PointFields.
+       */
+      enum Field {
+        NoFields           = 0,
+        IdField            = 1,
+        PropertyFields     = 2,  //!< ignored, type, and editLocked
+        MeasureCountField  = 4,
+        SerialNumberFields = 8,
+        ResidualField      = 16,
+        SurfacePointFields = 32
+      };
+
+      ControlNetPointFilter();
+      ~ControlNetPointFilter();
+
+      void setIgnored(bool ignored);
+      void setPointTypes(const QList<ControlPoint::PointType> &types);
+      void setEditLocked(bool editLocked);
+      void setNumMeasuresRange(int minimum, int maximum);
+      void setPointIds(const QList<QString> &pointIds,
+                       Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive);
+      void setCubeSerialNumbers(const QList<QString> &serialNumbers);
+      void setMinimumResidual(double tolerance);
+      void setLatLonRange(Latitude minLat, Latitude maxLat, Longitude minLon, Longitude maxLon);
+      void setAcceptEditLocked(bool accept);
+
+      bool isEmpty() const;
+      int requiredFields() const;
+
+      bool accepts(const PointFields &fields) const;
+      bool accepts(const ControlPoint &point) const;
+      QVector<bool> evaluate(const QList<ControlPoint *> &points) const;
+
+      static PointFields pointFields(const ControlPoint &point, int fields);
+
+    private:
+      bool m_filterIgnored;        //!< If points are filtered by their ignored flag.
+      bool m_ignored;              //!< The ignored flag that points must have.
+      bool m_filterTypes;          //!< If points are filtered by type.
+      QList<ControlPoint::PointType> m_types; //!< The point types that are accepted.
+      bool m_filterEditLocked;     //!< If points are filtered by their edit lock flag.
+      bool m_editLocked;           //!< The edit lock flag that points must have.
+      bool m_filterNumMeasures;    //!< If points are filtered by their number of measures.
+      int m_minMeasures;           //!< The minimum number of measures, inclusive.
+      int m_maxMeasures;           //!< The maximum number of measures, inclusive.
+      bool m_filterPointIds;       //!< If points are filtered by ID.
+      QSet<QString> m_pointIds;    //!< The point IDs that are accepted.
+      Qt::CaseSensitivity m_pointIdCaseSensitivity; //!< If point IDs are compared by case.
+      bool m_filterSerialNumbers;  //!< If points are filtered by measured cubes.
+      QSet<QString> m_serialNumbers; //!< Points must be measured on one of these cubes.
+      bool m_filterResidual;       //!< If points are filtered by their residuals.
+      double m_minResidual;        //!< A measure residual must be at least this large.
+      bool m_filterLatLon;         //!< If points are filtered by location.
+      Latitude m_minLat;           //!< The minimum latitude.
+      Latitude m_maxLat;           //!< The maximum latitude.
+      Longitude m_minLon;          //!< The minimum longitude.
+      Longitude m_maxLon;          //!< The maximum longitude.
+      bool m_acceptEditLocked;     //!< If edit locked points pass without testing predicates.
+  };
+}
+
+#endif
@@ -60,8 +60,9 @@ namespace Isis {
     mProgress = pProgress;
 
     GetPointIntStats();
-    GetPointDoubleStats();
+    mPointDoubleStatsModified = true;
     GenerateImageStats();
+    ConnectNetwork();
   }
 
   /**
@@ -77,7 +78,8 @@ namespace Isis {
     mProgress = pProgress;
 
     GetPointIntStats();
-    GetPointDoubleStats();
+    mPointDoubleStatsModified = true;
+    ConnectNetwork();
   }
 
   /**
@@ -89,6 +91,31 @@ namespace Isis {
     mCNet = NULL;
   }
 
+  /**
+   * Listen for changes to the network so that the point stats can be kept up to date.
+   */
+  void ControlNetStatistics::ConnectNetwork() {
+    connect(mCNet, SIGNAL(networkModified(ControlNet::ModType)),
+            this, SLOT(networkModified(ControlNet::ModType)));
+
+    connect(mCNet, SIGNAL(newPoint(ControlPoint*)),
+            this, SLOT(addPoint(ControlPoint*)));
+    connect(mCNet, SIGNAL(pointModified(ControlPoint *, ControlPoint::ModType, QVariant, QVariant)),
+            this, SLOT(pointModified(ControlPoint *, ControlPoint::ModType, QVariant, QVariant)));
+    connect(mCNet, SIGNAL(pointDeleted(ControlPoint*)),
+            this, SLOT(deletePoint(ControlPoint*)));
+
+    connect(mCNet, SIGNAL(newMeasure(ControlMeasure*)),
+            this, SLOT(addMeasure(ControlMeasure*)));
+    connect(mCNet,
+            SIGNAL(measureModified(ControlMeasure *, ControlMeasure::ModType, QVariant, QVariant)),
+            this,
+            SLOT(measureModified(ControlMeasure *, ControlMeasure::ModType, QVariant, QVariant)));
+    connect(mCNet, SIGNAL(measureRemoved(ControlMeasure*)),
+            this, SLOT(deleteMeasure(ControlMeasure*)));
+  }
+
+
   /**
    * Init SerialNum map
    *
@@ -128,7 +155,7 @@ namespace Isis {
     pStatsGrp += PvlKeyword("FixedPoints",       toString(NumFixedPoints()));
     pStatsGrp += PvlKeyword("ConstrainedPoints", toString(NumConstrainedPoints()));
     pStatsGrp += PvlKeyword("FreePoints",        toString(NumFreePoints()));
-    pStatsGrp += PvlKeyword("EditLockPoints",    toString(mCNet->GetNumEditLockPoints()));
+    pStatsGrp += PvlKeyword("EditLockPoints",    toString(NumEditLockedPoints()));
 
     pStatsGrp += PvlKeyword("TotalMeasures",     toString(NumMeasures()));
     pStatsGrp += PvlKeyword("ValidMeasures",     toString(NumValidMeasures()));
@@ -178,22 +205,22 @@ namespace Isis {
     dValue = GetMaxPixelShift();
     pStatsGrp += PvlKeyword("MaxPixelShift",     (dValue == Null ? "NA" : toString(dValue)));
 
-    dValue = mPointDoubleStats[minGFit];
+    dValue = PointDoubleStat(minGFit);
     pStatsGrp += PvlKeyword("MinGoodnessOfFit",  (dValue == Null ? "NA" : toString(dValue)));
 
-    dValue = mPointDoubleStats[maxGFit];
+    dValue = PointDoubleStat(maxGFit);
     pStatsGrp += PvlKeyword("MaxGoodnessOfFit",  (dValue == Null ? "NA" : toString(dValue)));
 
-    dValue = mPointDoubleStats[minEccentricity];
+    dValue = PointDoubleStat(minEccentricity);
     pStatsGrp += PvlKeyword("MinEccentricity",   (dValue == Null ? "NA" : toString(dValue)));
 
-    dValue = mPointDoubleStats[maxEccentricity];
+    dValue = PointDoubleStat(maxEccentricity);
     pStatsGrp += PvlKeyword("MaxEccentricity",   (dValue == Null ? "NA" : toString(dValue)));
 
-    dValue = mPointDoubleStats[minPixelZScore];
+    dValue = PointDoubleStat(minPixelZScore);
     pStatsGrp += PvlKeyword("MinPixelZScore",    (dValue == Null ? "NA" : toString(dValue)));
 
-    dValue = mPointDoubleStats[maxPixelZScore];
+    dValue = PointDoubleStat(maxPixelZScore);
     pStatsGrp += PvlKeyword("MaxPixelZScore",    (dValue == Null ? "NA" : toString(dValue)));
 
     // Convex Hull
@@ -215,6 +242,11 @@ namespace Isis {
    *  imgSamples, imgLines, imgTotalPoints, imgIgnoredPoints, imgFixedPoints, imgLockedPoints,
    *  imgLocked, imgConstrainedPoints, imgFreePoints, imgConvexHullArea, imgConvexHullRatio
    *
+   * Unlike the point stats, the image stats are not kept up to date as the network is
+   * edited. They are generated once, when the statistics are created with a serial number
+   * list. Each image needs its cube opened for its dimensions and the convex hull of all of
+   * its measures, which can not be updated one measure at a time.
+   *
    * @author Sharmila Prasad (11/1/2011)
    */
   void ControlNetStatistics::GenerateImageStats() {
@@ -502,7 +534,7 @@ namespace Isis {
    *
    * @author Sharmila Prasad (1/3/2012)
    */
-  void ControlNetStatistics::InitPointDoubleStats() {
+  void ControlNetStatistics::InitPointDoubleStats() const {
     for (int i = 0; i < numPointDblStats; i++) {
       mPointDoubleStats[i] = Null;
     }
@@ -515,7 +547,7 @@ namespace Isis {
    *
    * @author Sharmila Prasad (7/19/2011)
    */
-  void ControlNetStatistics::GetPointDoubleStats() {
+  void ControlNetStatistics::GetPointDoubleStats() const {
     InitPointDoubleStats();
 
     int iNumPoints = mCNet->GetNumPoints();
@@ -592,11 +624,29 @@ namespace Isis {
 
     // Average Shift
     mPointDoubleStats[avgPixelShift] = pixelShiftStats.Average();
+
+    mPointDoubleStatsModified = false;
+  }
+
+
+  /**
+   * Returns one of the point double stats, recomputing them if the network was modified
+   * since they were last computed.
+   *
+   * @param stat The stat to get
+   *
+   * @return @b double The value of the stat
+   */
+  double ControlNetStatistics::PointDoubleStat(ePointDoubleStats stat) const {
+    if (mPointDoubleStatsModified) {
+      GetPointDoubleStats();
+    }
+    return (*mPointDoubleStats.find(stat));
   }
 
 
   void ControlNetStatistics::UpdateMinMaxStats(const Statistics & stats,
-      ePointDoubleStats min, ePointDoubleStats max) {
+      ePointDoubleStats min, ePointDoubleStats max) const {
     if (stats.ValidPixels()) {
       if (mPointDoubleStats[min] != Null) {
         mPointDoubleStats[min] = qMin(
@@ -615,4 +665,179 @@ namespace Isis {
       }
     }
   }
+
+
+  /**
+   * Update the point stats for a point added to the network. The network does not emit
+   * separate newMeasure signals for the point's measures, so they are counted here.
+   *
+   * @param point The point added to the network
+   */
+  void ControlNetStatistics::addPoint(ControlPoint *point) {
+    mPointIntStats[totalPoints]++;
+    if (point->IsIgnored())
+      mPointIntStats[ignoredPoints]++;
+    else
+      mPointIntStats[validPoints]++;
+
+    if (point->GetType() == ControlPoint::Fixed)
+      mPointIntStats[fixedPoints]++;
+    if (point->GetType() == ControlPoint::Constrained)
+      mPointIntStats[constrainedPoints]++;
+    if (point->GetType() == ControlPoint::Free)
+      mPointIntStats[freePoints]++;
+    if (point->IsEditLocked())
+      mPointIntStats[editLockedPoints]++;
+
+    mPointIntStats[totalMeasures] += point->GetNumMeasures();
+    mPointIntStats[validMeasures] += point->GetNumValidMeasures();
+    mPointIntStats[editLockedMeasures] += point->GetNumLockedMeasures();
+    mPointIntStats[ignoredMeasures] = mPointIntStats[totalMeasures] - mPointIntStats[validMeasures];
+
+    mPointDoubleStatsModified = true;
+  }
+
+
+  /**
+   * Update the point stats for a modified point.
+   *
+   * @param point The modified point
+   * @param type The type of modification
+   * @param oldValue The value before the modification
+   * @param newValue The value after the modification
+   */
+  void ControlNetStatistics::pointModified(ControlPoint *point, ControlPoint::ModType type,
+                                           QVariant oldValue, QVariant newValue) {
+    if (oldValue == newValue) {
+      return;
+    }
+
+    switch (type) {
+      case ControlPoint::EditLockModified:
+        mPointIntStats[editLockedPoints] += newValue.toBool() ? 1 : -1;
+        break;
+
+      case ControlPoint::IgnoredModified:
+        if (newValue.toBool()) {
+          mPointIntStats[ignoredPoints]++;
+          mPointIntStats[validPoints]--;
+        }
+        else {
+          mPointIntStats[ignoredPoints]--;
+          mPointIntStats[validPoints]++;
+        }
+        break;
+
+      case ControlPoint::TypeModified: {
+        int typeStats[] = { fixedPoints, constrainedPoints, freePoints };
+        mPointIntStats[typeStats[oldValue.toInt()]]--;
+        mPointIntStats[typeStats[newValue.toInt()]]++;
+        break;
+      }
+    }
+
+    mPointDoubleStatsModified = true;
+  }
+
+
+  /**
+   * Update the point stats for a point being deleted from the network. The point's measures
+   * are removed, and emit their own signals, before the point is deleted.
+   *
+   * @param point The point being deleted
+   */
+  void ControlNetStatistics::deletePoint(ControlPoint *point) {
+    mPointIntStats[totalPoints]--;
+    if (point->IsIgnored())
+      mPointIntStats[ignoredPoints]--;
+    else
+      mPointIntStats[validPoints]--;
+
+    if (point->GetType() == ControlPoint::Fixed)
+      mPointIntStats[fixedPoints]--;
+    if (point->GetType() == ControlPoint::Constrained)
+      mPointIntStats[constrainedPoints]--;
+    if (point->GetType() == ControlPoint::Free)
+      mPointIntStats[freePoints]--;
+    if (point->IsEditLocked())
+      mPointIntStats[editLockedPoints]--;
+
+    mPointDoubleStatsModified = true;
+  }
+
+
+  /**
+   * Update the measure stats for a measure added to a point in the network.
+   *
+   * @param measure The measure added
+   */
+  void ControlNetStatistics::addMeasure(ControlMeasure *measure) {
+    mPointIntStats[totalMeasures]++;
+    if (!measure->IsIgnored())
+      mPointIntStats[validMeasures]++;
+    if (measure->IsEditLocked())
+      mPointIntStats[editLockedMeasures]++;
+    mPointIntStats[ignoredMeasures] = mPointIntStats[totalMeasures] - mPointIntStats[validMeasures];
+
+    mPointDoubleStatsModified = true;
+  }
+
+
+  /**
+   * Update the measure stats for a modified measure.
+   *
+   * @param measure The modified measure
+   * @param type The type of modification
+   * @param oldValue The value before the modification
+   * @param newValue The value after the modification
+   */
+  void ControlNetStatistics::measureModified(ControlMeasure *measure, ControlMeasure::ModType type,
+                                             QVariant oldValue, QVariant newValue) {
+    if (oldValue.toBool() == newValue.toBool()) {
+      return;
+    }
+
+    switch (type) {
+      case ControlMeasure::IgnoredModified:
+        mPointIntStats[validMeasures] += newValue.toBool() ? -1 : 1;
+        mPointIntStats[ignoredMeasures] =
+            mPointIntStats[totalMeasures] - mPointIntStats[validMeasures];
+        mPointDoubleStatsModified = true;
+        break;
+
+      case ControlMeasure::EditLockModified:
+        mPointIntStats[editLockedMeasures] += newValue.toBool() ? 1 : -1;
+        break;
+    }
+  }
+
+
+  /**
+   * Update the measure stats for a measure being removed from the network.
+   *
+   * @param measure The measure being removed
+   */
+  void ControlNetStatistics::deleteMeasure(ControlMeasure *measure) {
+    mPointIntStats[totalMeasures]--;
+    if (!measure->IsIgnored())
+      mPointIntStats[validMeasures]--;
+    if (measure->IsEditLocked())
+      mPointIntStats[editLockedMeasures]--;
+    mPointIntStats[ignoredMeasures] = mPointIntStats[totalMeasures] - mPointIntStats[validMeasures];
+
+    mPointDoubleStatsModified = true;
+  }
+
+
+  /**
+   * Recompute the point stats if the network's contents were swapped with another network.
+   *
+   * @param type The type of modification
+   */
+  void ControlNetStatistics::networkModified(ControlNet::ModType type) {
+    if (type == ControlNet::Swapped) {
+      GetPointIntStats();
+      mPointDoubleStatsModified = true;
+    }
+  }
 }
@@ -10,8 +10,13 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 
 #include <QMap>
+#include <QObject>
+#include <QVariant>
 #include <QVector>
 
+#include "ControlMeasure.h"
+#include "ControlNet.h"
+#include "ControlPoint.h"
 #include "Progress.h"
 #include "PvlGroup.h"
 #include "SerialNumberList.h"
@@ -27,6 +32,12 @@ namespace Isis {
    *
    * This class is used to get statistics of Control Network by Image or by Point
    *
+   * The point and measure counts are kept up to date as the network is edited by listening
+   * to the network's change signals, so each edit only costs a constant amount of work.
+   * The residual and shift statistics cannot be updated that way, so an edit only marks them
+   * as modified and they are recomputed the next time that one of them is requested. The
+   * image statistics require opening the cubes and are only computed by GenerateImageStats.
+   *
    * @ingroup ControlNetwork
    *
    * @author 2010-08-24 Sharmila Prasad
@@ -60,7 +71,9 @@ namespace Isis {
    *  @history 2017-12-12 Kristin Berry - Updated std::map to QMap and std::vector to QVector. Fixes
    *                           #5259.
    */
-  class ControlNetStatistics {
+  class ControlNetStatistics : public QObject {
+      Q_OBJECT
+
     public:
       //! Constructor
       ControlNetStatistics(ControlNet *pCNet, const QString &psSerialNumFile, Progress *pProgress = 0);
@@ -158,74 +171,85 @@ namespace Isis {
 
       //! Determine the average error of all points in the network
       double GetAverageResidual() const {
-        return (*mPointDoubleStats.find(avgResidual));
+        return PointDoubleStat(avgResidual);
       }
 
       //! Determine the minimum error of all points in the network
       double GetMinimumResidual() const {
-        return (*mPointDoubleStats.find(minResidual));
+        return PointDoubleStat(minResidual);
       }
 
       //! Determine the maximum error of all points in the network
       double GetMaximumResidual() const {
-        return (*mPointDoubleStats.find(maxResidual));
+        return PointDoubleStat(maxResidual);
       }
 
       //! Determine the minimum line error of all points in the network
       double GetMinLineResidual() const {
-        return (*mPointDoubleStats.find(minLineResidual));
+        return PointDoubleStat(minLineResidual);
       }
 
       //! Determine the minimum sample error of all points in the network
       double GetMinSampleResidual() const {
-        return (*mPointDoubleStats.find(minSampleResidual));
+        return PointDoubleStat(minSampleResidual);
       }
 
       //! Determine the maximum line error of all points in the network
       double GetMaxLineResidual() const {
-        return (*mPointDoubleStats.find(maxLineResidual));
+        return PointDoubleStat(maxLineResidual);
       }
 
       //! Determine the maximum sample error of all points in the network
       double GetMaxSampleResidual() const {
-        return (*mPointDoubleStats.find(maxSampleResidual));
+        return PointDoubleStat(maxSampleResidual);
       }
 
       //! Get Min and Max LineShift
       double GetMinLineShift() const {
-        return (*mPointDoubleStats.find(minLineShift));
+        return PointDoubleStat(minLineShift);
       }
 
       //! Get network Max LineShift
       double GetMaxLineShift() const {
-        return (*mPointDoubleStats.find(maxLineShift));
+        return PointDoubleStat(maxLineShift);
       }
 
       //! Get network Min SampleShift
       double GetMinSampleShift() const {
-        return (*mPointDoubleStats.find(minSampleShift));
+        return PointDoubleStat(minSampleShift);
       }
 
       //! Get network Max SampleShift
       double GetMaxSampleShift() const {
-        return (*mPointDoubleStats.find(maxSampleShift));
+        return PointDoubleStat(maxSampleShift);
       }
 
       //! Get network Min PixelShift
       double GetMinPixelShift() const {
-        return (*mPointDoubleStats.find(minPixelShift));
+        return PointDoubleStat(minPixelShift);
       }
 
       //! Get network Max PixelShift
       double GetMaxPixelShift() const {
-        return (*mPointDoubleStats.find(maxPixelShift));
+        return PointDoubleStat(maxPixelShift);
       }
 
       //! Get network Avg PixelShift
       double GetAvgPixelShift() const {
-        return (*mPointDoubleStats.find(avgPixelShift));
+        return PointDoubleStat(avgPixelShift);
       }
 
+    public slots:
+      void addPoint(ControlPoint *point);
+      void pointModified(ControlPoint *point, ControlPoint::ModType type,
+                         QVariant oldValue, QVariant newValue);
+      void deletePoint(ControlPoint *point);
+      void addMeasure(ControlMeasure *measure);
+      void measureModified(ControlMeasure *measure, ControlMeasure::ModType type,
+                           QVariant oldValue, QVariant newValue);
+      void deleteMeasure(ControlMeasure *measure);
+      void networkModified(ControlNet::ModType type);
+
     protected:
       SerialNumberList mSerialNumList;           //!< Serial Number List
       ControlNet *mCNet;                         //!< Control Network
@@ -233,22 +257,28 @@ namespace Isis {
 
     private:
       QMap<int, int> mPointIntStats;           //!< Contains QMap of different count stats
-      QMap<int, double> mPointDoubleStats;     //!< Contains QMap of different computed stats
+      mutable QMap<int, double> mPointDoubleStats; //!< Contains QMap of different computed stats
+      //! If the network was modified since the point double stats were computed
+      mutable bool mPointDoubleStatsModified;
       QMap<QString, QVector<double> > mImageMap; //!< Contains stats by Image/Serial Num
       QMap<QString, bool> mSerialNumMap;        //!< Whether serial# is part of ControlNet
 
       //! Get point count stats
       void GetPointIntStats();
 
+      void ConnectNetwork();
+
       //! Get Point stats for Residuals and Shifts
-      void GetPointDoubleStats();
+      void GetPointDoubleStats() const;
+
+      double PointDoubleStat(ePointDoubleStats stat) const;
 
       void UpdateMinMaxStats(const Statistics & stats,
                              ePointDoubleStats min,
-                             ePointDoubleStats max);
+                             ePointDoubleStats max) const;
 
       //! Init Pointstats std::vector
-      void InitPointDoubleStats();
+      void InitPointDoubleStats() const;
 
       //! Init SerialNum std::map
       void InitSerialNumMap();
@@ -11,12 +11,21 @@ find files of those names at the top level of this repository. **/
 #include <boost/numeric/ublas/symmetric.hpp>
 #include <boost/numeric/ublas/io.hpp>
 
+#include <cstring>
+
+#include <QAtomicInt>
 #include <QDebug>
+#include <QFile>
+#include <QFuture>
+#include <QMap>
 #include <QString>
+#include <QThread>
+#include <QtConcurrentMap>
 
 #include "ControlNetFileHeaderV0002.pb.h"
 #include "ControlNetFileHeaderV0005.pb.h"
 #include "ControlNetLogDataProtoV0001.pb.h"
+#include "ControlNetPointIndexV0005.pb.h"
 #include "ControlPointFileEntryV0002.pb.h"
 
 #include "ControlMeasure.h"
@@ -61,7 +70,13 @@ namespace Isis {
    * @param net A pointer to the network that will be written out.
    */
   ControlNetVersioner::ControlNetVersioner(ControlNet *net)
-      : m_ownsPoints(false) {
+      : m_ownsPoints(false),
+        m_readMode(ReadAllPoints),
+        m_pointData(NULL),
+        m_pointDataLength(0),
+        m_hasPointIndex(false),
+        m_pointFilter(NULL),
+        m_pointsFiltered(false) {
     // Populate the internal list of points.
     m_points.append( net->GetPoints() );
 
@@ -88,11 +103,87 @@ namespace Isis {
    * @see ControlNetVersioner::Read
    */
   ControlNetVersioner::ControlNetVersioner(const FileName netFile, Progress *progress)
-      : m_ownsPoints(true) {
+      : m_ownsPoints(true),
+        m_readMode(ReadAllPoints),
+        m_pointData(NULL),
+        m_pointDataLength(0),
+        m_hasPointIndex(false),
+        m_pointFilter(NULL),
+        m_pointsFiltered(false) {
     read(netFile, progress);
   }
 
 
+  /**
+   * Construct a ControlNetVersioner from a file with a choice of how the control points are
+   * read. When reading points on demand, only the general network information and the point
+   * index are read. Individual points can then be decoded with readPoint. If the file does not
+   * contain a point index, all of the points are read and the index is built from them.
+   *
+   * @param netFile The control network file to read in.
+   * @param mode How the control points are read.
+   * @param progress The progress object to track reading points.
+   */
+  ControlNetVersioner::ControlNetVersioner(const FileName netFile, ReadMode mode,
+                                           Progress *progress)
+      : m_ownsPoints(true),
+        m_readMode(mode),
+        m_pointData(NULL),
+        m_pointDataLength(0),
+        m_hasPointIndex(false),
+        m_pointFilter(NULL),
+        m_pointsFiltered(false) {
+    read(netFile, progress);
+
+    if ( m_readMode == ReadPointsOnDemand && !m_hasPointIndex ) {
+      buildPointIndex();
+    }
+  }
+
+
+  /**
+   * Construct a ControlNetVersioner from a file, only keeping the control points that pass a
+   * filter. For version 5 binary networks, the filter is tested against each protobuf point
+   * message before it is converted, so points that fail the filter are never created. Points
+   * from other formats are tested after they are read.
+   *
+   * @param netFile The control network file to read in.
+   * @param filter The filter that points must pass.
+   * @param progress The progress object to track reading points.
+   */
+  ControlNetVersioner::ControlNetVersioner(const FileName netFile,
+                                           const ControlNetPointFilter &filter,
+                                           Progress *progress)
+      : m_ownsPoints(true),
+        m_readMode(ReadAllPoints),
+        m_pointData(NULL),
+        m_pointDataLength(0),
+        m_hasPointIndex(false),
+        m_pointFilter(&filter),
+        m_pointsFiltered(false) {
+    read(netFile, progress);
+
+    if ( !m_pointsFiltered && !filter.isEmpty() ) {
+      QVector<bool> accepted = filter.evaluate(m_points);
+      QList<ControlPoint *> acceptedPoints;
+      for (int i = 0; i < m_points.size(); i++) {
+        if (accepted[i]) {
+          acceptedPoints.append(m_points[i]);
+        }
+        else {
+          m_rejectedPoints.append(
+              ControlNetPointFilter::pointFields(*m_points[i], rejectedFields()) );
+          delete m_points[i];
+        }
+      }
+      m_points = acceptedPoints;
+    }
+
+    // The filter is only guaranteed to exist during construction
+    m_pointFilter = NULL;
+  }
+
+
   /**
    * Destroy a ControlNetVersioner. If the versioner owns the control points stored in it,
    * they will also be deleted.
@@ -168,16 +259,116 @@ namespace Isis {
   }
 
 
+  /**
+   * Returns the points that failed the point filter the network was read with. Only their
+   * ID, properties, number of measures and the fields the filter uses are filled in.
+   *
+   * @return @b QList<ControlNetPointFilter::PointFields> The rejected points, in file order.
+   */
+  QList<ControlNetPointFilter::PointFields> ControlNetVersioner::rejectedPoints() const {
+    return m_rejectedPoints;
+  }
+
+
   /**
    * Returns the number of points that have been read in or are ready to write out.
    *
    * @return @b int The number of control points stored internally.
    */
   int ControlNetVersioner::numPoints() const {
+    if (m_hasPointIndex) {
+      return m_pointMessages.size();
+    }
     return m_points.size();
   }
 
 
+  /**
+   * Returns if the points are being read from a point index section in the file. If they
+   * are not, the points were all read in when the versioner was constructed.
+   *
+   * @return @b bool If the network file contained a point index.
+   */
+  bool ControlNetVersioner::hasPointIndex() const {
+    return m_hasPointIndex;
+  }
+
+
+  /**
+   * Returns the IDs of the points in the network, in file order. This is only available when
+   * reading points on demand.
+   *
+   * @return @b QList<QString> The point IDs.
+   */
+  QList<QString> ControlNetVersioner::pointIds() const {
+    return m_pointIds;
+  }
+
+
+  /**
+   * Returns the index of a point in the network. This is only available when reading points
+   * on demand.
+   *
+   * @param pointId The ID of the point.
+   *
+   * @return @b int The index of the point or -1 if there is no point with that ID.
+   */
+  int ControlNetVersioner::pointIndex(const QString &pointId) const {
+    return m_pointIndices.value(pointId, -1);
+  }
+
+
+  /**
+   * Returns the serial numbers of the cubes that are measured in the network. This is only
+   * available when reading points on demand.
+   *
+   * @return @b QList<QString> The cube serial numbers, sorted.
+   */
+  QList<QString> ControlNetVersioner::cubeSerialNumbers() const {
+    return m_cubePointIndices.keys();
+  }
+
+
+  /**
+   * Returns the indices of the points that have a measure on a cube. This is only available
+   * when reading points on demand.
+   *
+   * @param serialNumber The serial number of the cube.
+   *
+   * @return @b QList<int> The indices of the points measured on the cube.
+   */
+  QList<int> ControlNetVersioner::pointIndicesInCube(const QString &serialNumber) const {
+    return m_cubePointIndices.value(serialNumber);
+  }
+
+
+  /**
+   * Read a single point from the network. This is only available when reading points on
+   * demand. If the file contains a point index, only the requested point is decoded.
+   *
+   * @param index The index of the point in the network.
+   *
+   * @return @b ControlPoint* The point. The caller assumes ownership of the ControlPoint
+   *                          and is expected to delete it when done.
+   */
+  ControlPoint *ControlNetVersioner::readPoint(int index) {
+    if ( m_readMode != ReadPointsOnDemand ) {
+      QString msg = "Individual control points can only be read when reading points on demand.";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if ( index < 0 || index >= numPoints() ) {
+      QString msg = "Control point index [" + toString(index) + "] is out of range.";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (m_hasPointIndex) {
+      return readPointMessage(m_pointData, m_pointMessages[index], index, NULL);
+    }
+    return new ControlPoint(*m_points[index]);
+  }
+
+
   /**
    * Returns the first point stored in the versioner's internal list. This method passes ownership
    * of the point to the caller who is expected to delete it when done with it.
@@ -1046,7 +1237,7 @@ namespace Isis {
 
     fstream input(netFile.expanded().toLatin1().data(), ios::in | ios::binary);
     if ( !input.is_open() ) {
-      QString msg = "Failed to open control network file" + netFile.name();
+      QString msg = "Failed to open control network file [" + netFile.name() + "]";
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
@@ -1155,17 +1346,59 @@ namespace Isis {
                                               const FileName netFile,
                                               Progress *progress) {
 
+    const PvlObject &protoBufferInfo = header.findObject("ProtoBuffer");
+    const PvlObject &protoBufferCore = protoBufferInfo.findObject("Core");
+
+    BigInt pointsStartByte = readProtobufHeaderV0005(header, netFile);
+    BigInt pointsLength = protoBufferCore["PointsBytes"];
+
+    // The Protobuf Core is a block of consecutive length-prefixed point messages. Map the
+    // block into memory so the message boundaries can be found without parsing anything and
+    // the points can then be decoded independently of each other.
+    mapPointData(netFile, pointsStartByte, pointsLength);
+
+    if ( m_readMode == ReadPointsOnDemand && protoBufferCore.hasKeyword("PointIndexStartByte") ) {
+      readPointIndexV0005(header, netFile);
+      return;
+    }
+
+    QVector<PointMessage> pointMessages = scanPointMessages(m_pointData, m_pointDataLength);
+    m_pointsFiltered = (m_pointFilter != NULL);
+
+    if (progress && !pointMessages.isEmpty()) {
+      progress->SetText("Reading Control Points...");
+      progress->SetMaximumSteps( pointMessages.size() );
+      progress->CheckStatus();
+    }
+
+    readPointMessages(m_pointData, pointMessages, progress);
+
+    unmapPointData();
+  }
+
+
+  /**
+   * Read the protobuf header of a version 5 binary control network and store the general
+   * network information in the versioner.
+   *
+   * @param header The Pvl file header that contains byte offsets for the protobuf messages
+   * @param netFile The filename of the control network file.
+   *
+   * @return @b BigInt The byte offset of the Protobuf Core in the file.
+   */
+  BigInt ControlNetVersioner::readProtobufHeaderV0005(const Pvl &header,
+                                                      const FileName netFile) {
+
     // read the header protobuf object
     const PvlObject &protoBufferInfo = header.findObject("ProtoBuffer");
     const PvlObject &protoBufferCore = protoBufferInfo.findObject("Core");
 
     BigInt headerStartPos = protoBufferCore["HeaderStartByte"];
     BigInt headerLength = protoBufferCore["HeaderBytes"];
-    BigInt pointsLength = protoBufferCore["PointsBytes"];
 
     fstream input(netFile.expanded().toLatin1().data(), ios::in | ios::binary);
     if ( !input.is_open() ) {
-      QString msg = "Failed to open control network file" + netFile.name();
+      QString msg = "Failed to open control network file [" + netFile.name() + "]";
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
@@ -1219,79 +1452,449 @@ namespace Isis {
       throw IException(e, IException::Io, msg, _FILEINFO_);
     }
 
-    // read each protobuf control point and then initialize it
-    // For some reason, reading the header causes the input stream to fail so reopen the file
-    input.close();
-    input.open(netFile.expanded().toLatin1().data(), ios::in | ios::binary);
-    input.seekg(filePos, ios::beg);
+    return static_cast<BigInt>(filePos);
+  }
 
-    IstreamInputStream pointInStream(&input);
 
-    BigInt numberOfPoints = 0;
+  /**
+   * Map the Protobuf Core of a binary control network into memory. If the file cannot be
+   * mapped, the Protobuf Core is read into a buffer instead.
+   *
+   * @param netFile The filename of the control network file.
+   * @param startByte The byte offset of the Protobuf Core in the file.
+   * @param length The size of the Protobuf Core in bytes.
+   */
+  void ControlNetVersioner::mapPointData(const FileName netFile,
+                                         BigInt startByte,
+                                         BigInt length) {
+    unmapPointData();
+
+    m_pointFile = QSharedPointer<QFile>( new QFile(netFile.expanded()) );
+    if ( !m_pointFile->open(QIODevice::ReadOnly) ) {
+      QString msg = "Failed to open control network file [" + netFile.name() + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
 
-    if ( protoBufferInfo.hasGroup("ControlNetworkInfo") ) {
-      const PvlGroup &networkInfo = protoBufferInfo.findGroup("ControlNetworkInfo");
+    if ( startByte + length > m_pointFile->size() ) {
+      QString msg = "The control network file [" + netFile.name() + "] is truncated. Expected ["
+                    + toString(length) + "] bytes of control points starting at byte ["
+                    + toString(startByte) + "].";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
 
-      if ( networkInfo.hasKeyword("NumberOfPoints") ) {
-        try {
-          numberOfPoints = networkInfo["NumberOfPoints"];
-        }
-        catch (...) {
-          numberOfPoints = 0;
-        }
+    m_pointDataLength = length;
+    if (length == 0) {
+      return;
+    }
+
+    m_pointData = reinterpret_cast<const char *>( m_pointFile->map(startByte, length) );
+
+    // Not every file system supports mapping, so fall back on reading the block
+    if (!m_pointData) {
+      m_pointFile->seek(startByte);
+      m_pointBuffer = m_pointFile->read(length);
+      if (m_pointBuffer.size() != length) {
+        QString msg = "Failed to read the control points from control network file ["
+                      + netFile.name() + "].";
+        throw IException(IException::Io, msg, _FILEINFO_);
       }
+      m_pointData = m_pointBuffer.constData();
     }
+  }
 
-    if (progress && numberOfPoints != 0) {
-      progress->SetText("Reading Control Points...");
-      progress->SetMaximumSteps(numberOfPoints);
-      progress->CheckStatus();
+
+  /**
+   * Release the memory mapped or buffered Protobuf Core.
+   */
+  void ControlNetVersioner::unmapPointData() {
+    m_pointData = NULL;
+    m_pointDataLength = 0;
+    m_pointBuffer.clear();
+    // Closing the file also unmaps it
+    m_pointFile.clear();
+  }
+
+
+  /**
+   * Read the point index section of a version 5 binary control network. The index
+   * contains the location of each point message in the Protobuf Core and the points that
+   * are measured on each image.
+   *
+   * @param header The Pvl file header that contains byte offsets for the protobuf messages
+   * @param netFile The filename of the control network file.
+   */
+  void ControlNetVersioner::readPointIndexV0005(const Pvl &header, const FileName netFile) {
+    const PvlObject &protoBufferCore = header.findObject("ProtoBuffer").findObject("Core");
+
+    BigInt indexStartPos = protoBufferCore["PointIndexStartByte"];
+    BigInt indexLength = protoBufferCore["PointIndexBytes"];
+
+    m_pointFile->seek(indexStartPos);
+    QByteArray indexBuffer = m_pointFile->read(indexLength);
+    if (indexBuffer.size() != indexLength) {
+      QString msg = "Failed to read the point index from control network file ["
+                    + netFile.name() + "].";
+      throw IException(IException::Io, msg, _FILEINFO_);
     }
 
-    Isis::EndianSwapper lsb("LSB");
-    int pointIndex = -1;
-    while (pointInStream.ByteCount() < pointsLength) {
-      pointIndex += 1;
-      QSharedPointer<ControlPointFileEntryV0002> newPoint(new ControlPointFileEntryV0002);
+    ControlNetPointIndexV0005 protoIndex;
+    CodedInputStream indexCodedInStream(
+        reinterpret_cast<const uint8_t *>( indexBuffer.constData() ), indexBuffer.size() );
+    indexCodedInStream.SetTotalBytesLimit(1024 * 1024 * 512);
+    if ( !protoIndex.ParseFromCodedStream(&indexCodedInStream) ) {
+      QString msg = "Failed to parse the point index from control network file ["
+                    + netFile.name() + "].";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
 
-      try {
+    m_pointMessages.clear();
+    m_pointMessages.reserve( protoIndex.points_size() );
+    for (int i = 0; i < protoIndex.points_size(); i++) {
+      const ControlNetPointIndexV0005_PointEntry &entry = protoIndex.points(i);
 
-        CodedInputStream pointCodedInStream(&pointInStream);
-        pointCodedInStream.SetTotalBytesLimit(1024 * 1024 * 512);
+      if ( entry.offset() < 0 || entry.offset() + entry.size() > m_pointDataLength ) {
+        QString msg = "The point index entry for control point [" + QString(entry.id().c_str())
+                      + "] is outside of the control points in control network file ["
+                      + netFile.name() + "].";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
 
-        uint32_t size;
-        pointCodedInStream.ReadRaw(reinterpret_cast<char *>(&size), sizeof(size));
+      PointMessage message;
+      message.offset = entry.offset();
+      message.size = entry.size();
+      m_pointMessages.append(message);
 
-        size = lsb.Uint32_t(&size);
+      QString pointId(entry.id().c_str());
+      m_pointIds.append(pointId);
+      m_pointIndices.insert(pointId, i);
+    }
 
-        CodedInputStream::Limit oldPointLimit = pointCodedInStream.PushLimit(size);
-        newPoint->ParseFromCodedStream(&pointCodedInStream);
-        pointCodedInStream.PopLimit(oldPointLimit);
+    for (int i = 0; i < protoIndex.cubes_size(); i++) {
+      const ControlNetPointIndexV0005_CubeEntry &entry = protoIndex.cubes(i);
+
+      QList<int> &pointIndices = m_cubePointIndices[QString(entry.serialnumber().c_str())];
+      for (int j = 0; j < entry.pointindices_size(); j++) {
+        pointIndices.append( entry.pointindices(j) );
       }
-      catch (...) {
+    }
+
+    m_hasPointIndex = true;
+  }
+
+
+  /**
+   * Build the point index from the points that were read in, for networks that do not
+   * contain a point index section.
+   */
+  void ControlNetVersioner::buildPointIndex() {
+    for (int i = 0; i < m_points.size(); i++) {
+      QString pointId = m_points[i]->GetId();
+      m_pointIds.append(pointId);
+      m_pointIndices.insert(pointId, i);
+
+      foreach (QString serialNumber, m_points[i]->getCubeSerialNumbers()) {
+        m_cubePointIndices[serialNumber].append(i);
+      }
+    }
+  }
+
+
+  /**
+   * Find the location of every control point message in the Protobuf Core of a version 5
+   * binary control network. Each message is prepended by its size as an unsigned, 32 bit,
+   * LSB integer, so the messages can be located by hopping from prefix to prefix without
+   * parsing any of them.
+   *
+   * @param data The start of the Protobuf Core in memory.
+   * @param length The size of the Protobuf Core in bytes.
+   *
+   * @return @b QVector<PointMessage> The location of each point message, in file order.
+   */
+  QVector<ControlNetVersioner::PointMessage> ControlNetVersioner::scanPointMessages(
+                                                     const char *data, BigInt length) {
+    QVector<PointMessage> messages;
+    Isis::EndianSwapper lsb("LSB");
+
+    BigInt position = 0;
+    while (position < length) {
+      if ( length - position < (BigInt)sizeof(uint32_t) ) {
         QString msg = "Failed to read protobuf version 2 control point at index ["
-                      + toString(pointIndex) + "].";
+                      + toString(messages.size()) + "]. The size of the point is truncated.";
         throw IException(IException::Io, msg, _FILEINFO_);
       }
 
-      try {
-        ControlPointV0005 point(newPoint);
-        m_points.append( createPoint(point) );
+      uint32_t size;
+      memcpy(&size, data + position, sizeof(size));
+      size = lsb.Uint32_t(&size);
+      position += sizeof(size);
+
+      if ( (BigInt)size > length - position ) {
+        QString msg = "Failed to read protobuf version 2 control point at index ["
+                      + toString(messages.size()) + "]. The point extends past the end of "
+                      "the control points.";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      PointMessage message;
+      message.offset = position;
+      message.size = size;
+      messages.append(message);
 
-        if (progress && numberOfPoints != 0) {
+      position += size;
+    }
+
+    return messages;
+  }
+
+
+  /**
+   * Decode a set of version 5 control point messages into ControlPoints. The messages are
+   * split into contiguous chunks that are decoded concurrently into a pre-sized list, so
+   * the points are stored in the same order that they are in the file.
+   *
+   * @param data The start of the Protobuf Core in memory.
+   * @param messages The location of each point message in the Protobuf Core.
+   * @param progress The progress object to track reading points.
+   */
+  void ControlNetVersioner::readPointMessages(const char *data,
+                                              const QVector<PointMessage> &messages,
+                                              Progress *progress) {
+    int numMessages = messages.size();
+    if (numMessages == 0) {
+      return;
+    }
+
+    // Use several chunks per thread so that a few large points do not stall one thread
+    int numChunks = qMin(numMessages, QThread::idealThreadCount() * 4);
+    numChunks = qMax(numChunks, 1);
+
+    QVector<PointChunk> chunks(numChunks);
+    for (int i = 0; i < numChunks; i++) {
+      chunks[i].begin = (BigInt)numMessages * i / numChunks;
+      chunks[i].end = (BigInt)numMessages * (i + 1) / numChunks;
+      chunks[i].failedIndex = -1;
+    }
+
+    QVector<ControlPoint *> points(numMessages, NULL);
+    QVector<ControlNetPointFilter::PointFields> rejected;
+    if (m_pointFilter) {
+      rejected.resize(numMessages);
+    }
+    QAtomicInt pointsRead(0);
+
+    auto readChunk = [&](PointChunk &chunk) -> void {
+      for (int i = chunk.begin; i < chunk.end; i++) {
+        try {
+          points[i] = readPointMessage(data, messages[i], i,
+                                       m_pointFilter ? &rejected[i] : NULL);
+        }
+        catch (IException &e) {
+          chunk.failedIndex = i;
+          chunk.error = e;
+          return;
+        }
+
+        pointsRead.fetchAndAddRelaxed(1);
+      }
+    };
+
+    QFuture<void> future = QtConcurrent::map(chunks, readChunk);
+
+    // Progress is not thread safe, so report it from this thread while the workers decode
+    int pointsReported = 0;
+    while ( !future.isFinished() ) {
+      if (progress) {
+        int read = pointsRead.load();
+        for ( ; pointsReported < read; pointsReported++) {
           progress->CheckStatus();
         }
+      }
+      QThread::msleep(10);
+    }
+    future.waitForFinished();
 
+    // Report the failure with the lowest index so errors match a serial read
+    foreach (const PointChunk &chunk, chunks) {
+      if (chunk.failedIndex != -1) {
+        foreach (ControlPoint *point, points) {
+          delete point;
+        }
+        throw chunk.error;
       }
-      catch (IException &e) {
-        QString msg = "Failed to convert protobuf version 2 control point at index ["
-                      + toString(pointIndex) + "] into a ControlPoint.";
-        throw IException(e, IException::Io, msg, _FILEINFO_);
+    }
+
+    if (progress) {
+      for ( ; pointsReported < numMessages; pointsReported++) {
+        progress->CheckStatus();
+      }
+    }
+
+    m_points.reserve(m_points.size() + numMessages);
+    for (int i = 0; i < numMessages; i++) {
+      // Points that failed the point filter were not created
+      if (points[i]) {
+        m_points.append(points[i]);
+      }
+      else {
+        m_rejectedPoints.append(rejected[i]);
       }
     }
   }
 
 
+  /**
+   * Decode a single version 5 control point message into a ControlPoint.
+   *
+   * @param data The start of the Protobuf Core in memory.
+   * @param message The location of the point message in the Protobuf Core.
+   * @param index The index of the point in the network, used for error reporting.
+   * @param rejected If the point fails the point filter, its fields are stored here.
+   *
+   * @return @b ControlPoint* The decoded point. The caller assumes ownership of it. If the
+   *                          point fails the point filter, NULL is returned.
+   */
+  ControlPoint *ControlNetVersioner::readPointMessage(const char *data,
+                                                      const PointMessage &message,
+                                                      int index,
+                                                      ControlNetPointFilter::PointFields *rejected) {
+    QSharedPointer<ControlPointFileEntryV0002> newPoint(new ControlPointFileEntryV0002);
+
+    const uint8_t *messageData = reinterpret_cast<const uint8_t *>(data + message.offset);
+    CodedInputStream pointCodedInStream(messageData, message.size);
+    pointCodedInStream.SetTotalBytesLimit(1024 * 1024 * 512);
+
+    if ( !newPoint->ParseFromCodedStream(&pointCodedInStream) ) {
+      QString msg = "Failed to read protobuf version 2 control point at index ["
+                    + toString(index) + "].";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    if (m_pointFilter) {
+      ControlNetPointFilter::PointFields fields = pointFields(*newPoint, rejectedFields());
+      if ( !m_pointFilter->accepts(fields) ) {
+        if (rejected) {
+          *rejected = fields;
+        }
+        return NULL;
+      }
+    }
+
+    try {
+      ControlPointV0005 point(newPoint);
+      return createPoint(point);
+    }
+    catch (IException &e) {
+      QString msg = "Failed to convert protobuf version 2 control point at index ["
+                    + toString(index) + "] into a ControlPoint.";
+      throw IException(e, IException::Io, msg, _FILEINFO_);
+    }
+  }
+
+
+  /**
+   * Returns the fields that are kept for the points that fail the point filter. These are the
+   * point ID, properties and number of measures, and the fields that the filter uses.
+   *
+   * @return @b int A combination of ControlNetPointFilter::Field flags.
+   */
+  int ControlNetVersioner::rejectedFields() const {
+    int fields = ControlNetPointFilter::IdField | ControlNetPointFilter::PropertyFields |
+                 ControlNetPointFilter::MeasureCountField;
+    if (m_pointFilter) {
+      fields |= m_pointFilter->requiredFields();
+    }
+    return fields;
+  }
+
+
+  /**
+   * Gather the fields of a protobuf control point message that a ControlNetPointFilter uses,
+   * without converting the message into a ControlPoint.
+   *
+   * @param protoPoint The protobuf point message.
+   * @param fields The ControlNetPointFilter::Field flags for the fields to gather.
+   *
+   * @return @b ControlNetPointFilter::PointFields The point's fields.
+   */
+  ControlNetPointFilter::PointFields ControlNetVersioner::pointFields(
+                                             const ControlPointFileEntryV0002 &protoPoint,
+                                             int fields) {
+    ControlNetPointFilter::PointFields result;
+
+    if (fields & ControlNetPointFilter::IdField) {
+      result.id = QString(protoPoint.id().c_str());
+    }
+
+    if (fields & ControlNetPointFilter::PropertyFields) {
+      result.ignored = protoPoint.has_ignore() && protoPoint.ignore();
+      result.editLocked = protoPoint.has_editlock() && protoPoint.editlock();
+      switch ( protoPoint.type() ) {
+        case ControlPointFileEntryV0002_PointType_Constrained:
+          result.type = ControlPoint::Constrained;
+          break;
+        case ControlPointFileEntryV0002_PointType_obsolete_Ground:
+        case ControlPointFileEntryV0002_PointType_Fixed:
+          result.type = ControlPoint::Fixed;
+          break;
+        default:
+          result.type = ControlPoint::Free;
+          break;
+      }
+    }
+
+    if (fields & ControlNetPointFilter::MeasureCountField) {
+      result.numMeasures = protoPoint.measures_size();
+    }
+
+    if (fields & ControlNetPointFilter::SerialNumberFields) {
+      for (int m = 0; m < protoPoint.measures_size(); m++) {
+        result.serialNumbers.append( QString(protoPoint.measures(m).serialnumber().c_str()) );
+      }
+    }
+
+    if (fields & ControlNetPointFilter::ResidualField) {
+      for (int m = 0; m < protoPoint.measures_size(); m++) {
+        const ControlPointFileEntryV0002_Measure &measure = protoPoint.measures(m);
+        if ( measure.has_sampleresidual() &&
+             (IsSpecial(result.maxResidual) || measure.sampleresidual() > result.maxResidual) ) {
+          result.maxResidual = measure.sampleresidual();
+        }
+        if ( measure.has_lineresidual() &&
+             (IsSpecial(result.maxResidual) || measure.lineresidual() > result.maxResidual) ) {
+          result.maxResidual = measure.lineresidual();
+        }
+      }
+    }
+
+    if (fields & ControlNetPointFilter::SurfacePointFields) {
+      // Match ControlPoint::GetBestSurfacePoint, adjusted is preferred over a priori
+      SurfacePoint surfacePoint;
+      if ( protoPoint.has_adjustedx()
+          && protoPoint.has_adjustedy()
+          && protoPoint.has_adjustedz() ) {
+        surfacePoint = SurfacePoint(Displacement(protoPoint.adjustedx(), Displacement::Meters),
+                                    Displacement(protoPoint.adjustedy(), Displacement::Meters),
+                                    Displacement(protoPoint.adjustedz(), Displacement::Meters));
+      }
+      else if ( protoPoint.has_apriorix()
+               && protoPoint.has_aprioriy()
+               && protoPoint.has_aprioriz() ) {
+        surfacePoint = SurfacePoint(Displacement(protoPoint.apriorix(), Displacement::Meters),
+                                    Displacement(protoPoint.aprioriy(), Displacement::Meters),
+                                    Displacement(protoPoint.aprioriz(), Displacement::Meters));
+      }
+
+      if ( surfacePoint.Valid() ) {
+        result.hasSurfacePoint = true;
+        result.latitude = surfacePoint.GetLatitude();
+        result.longitude = surfacePoint.GetLongitude();
+      }
+    }
+
+    return result;
+  }
+
+
   /**
    * Create a pointer to a latest version ControlPoint from an
    * object in a V0001 control net file. This method converts a
@@ -1674,11 +2277,47 @@ namespace Isis {
 
       writeHeader(&output);
 
+      // Record where each point is written and which cubes it is measured on so that
+      // readers can find individual points without reading the whole network.
+      ControlNetPointIndexV0005 protoIndex;
+      QMap< QString, QList<int> > cubePointIndices;
+
       BigInt pointByteTotal = 0;
       while ( !m_points.isEmpty() ) {
-         pointByteTotal += writeFirstPoint(&output);
+        ControlPoint *point = m_points.first();
+        int index = protoIndex.points_size();
+
+        ControlNetPointIndexV0005_PointEntry *indexEntry = protoIndex.add_points();
+        indexEntry->set_id(point->GetId().toLatin1().data());
+        foreach (QString serialNumber, point->getCubeSerialNumbers()) {
+          cubePointIndices[serialNumber].append(index);
+        }
+
+        int pointBytes = writeFirstPoint(&output);
+
+        // The index points past the size prefix to the start of the message
+        indexEntry->set_offset(pointByteTotal + sizeof(uint32_t));
+        indexEntry->set_size(pointBytes - sizeof(uint32_t));
+        pointByteTotal += pointBytes;
+      }
+
+      QMapIterator< QString, QList<int> > cubeIt(cubePointIndices);
+      while ( cubeIt.hasNext() ) {
+        cubeIt.next();
+        ControlNetPointIndexV0005_CubeEntry *cubeEntry = protoIndex.add_cubes();
+        cubeEntry->set_serialnumber(cubeIt.key().toLatin1().data());
+        foreach (int index, cubeIt.value()) {
+          cubeEntry->add_pointindices(index);
+        }
       }
 
+      BigInt indexStartByte = output.tellp();
+      if ( !protoIndex.SerializeToOstream(&output) ) {
+        QString msg = "Failed to write the point index to the output control network file.";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+      BigInt indexByteTotal = (BigInt)output.tellp() - indexStartByte;
+
       // Insert header at the beginning of the file once writing is done.
       ControlNetFileHeaderV0005 protobufHeader;
 
@@ -1706,6 +2345,9 @@ namespace Isis {
 
       protoCore.addKeyword(PvlKeyword("PointsBytes",
                            toString(pointByteTotal)));
+
+      protoCore.addKeyword(PvlKeyword("PointIndexStartByte", toString(indexStartByte)));
+      protoCore.addKeyword(PvlKeyword("PointIndexBytes", toString(indexByteTotal)));
       protoObj.addObject(protoCore);
 
       PvlGroup netInfo("ControlNetworkInfo");
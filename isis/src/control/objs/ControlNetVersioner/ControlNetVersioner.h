@@ -11,15 +11,22 @@ find files of those names at the top level of this repository. **/
 
 #include <QString>
 
+#include <QByteArray>
+#include <QHash>
 #include <QList>
+#include <QMap>
 #include <QSharedPointer>
 #include <QVector>
 
+#include "Constants.h"
+#include "ControlNetPointFilter.h"
 #include "ControlPoint.h"
 #include "ControlPointV0001.h"
 #include "ControlPointV0002.h"
 #include "ControlPointV0003.h"
+#include "IException.h"
 
+class QFile;
 class QString;
 
 namespace Isis {
@@ -342,6 +349,15 @@ namespace Isis {
    *   <em>ControlNetFileHeaderV0005.proto</em> instead of
    *   <em>ControlNetFileHeaderV0003.proto</em>.
    *
+   *   Version 5 binary control network files may also contain a Point Index
+   *   immediately after the Protobuf Core. The Point Index contains the offset
+   *   and size of each control point message and the points that are measured
+   *   on each cube, so single points can be read without reading the whole
+   *   network. Its location is stored in the PointIndexStartByte and
+   *   PointIndexBytes keywords of the Pvl File Header. Files without a Point
+   *   Index are still valid version 5 files. The structure of the Point Index
+   *   is defined by <em>ControlNetPointIndexV0005.proto</em>.
+   *
    * @ingroup ControlNetwork
    *
    * @author 2011-04-05 Steven Lambright
@@ -412,8 +428,19 @@ namespace Isis {
   class ControlNetVersioner {
 
     public:
+      /**
+       * How the control points are read from a control network file.
+       */
+      enum ReadMode {
+        ReadAllPoints,     //!< Read every point when the versioner is constructed.
+        ReadPointsOnDemand //!< Only read the point index. Points are read with readPoint.
+      };
+
       ControlNetVersioner(ControlNet *net);
       ControlNetVersioner(const FileName netFile, Progress *progress=NULL);
+      ControlNetVersioner(const FileName netFile, ReadMode mode, Progress *progress=NULL);
+      ControlNetVersioner(const FileName netFile, const ControlNetPointFilter &filter,
+                          Progress *progress=NULL);
       ~ControlNetVersioner();
 
       QString netId() const;
@@ -425,6 +452,14 @@ namespace Isis {
 
       int numPoints() const;
       ControlPoint *takeFirstPoint();
+      QList<ControlNetPointFilter::PointFields> rejectedPoints() const;
+
+      bool hasPointIndex() const;
+      QList<QString> pointIds() const;
+      int pointIndex(const QString &pointId) const;
+      QList<QString> cubeSerialNumbers() const;
+      QList<int> pointIndicesInCube(const QString &serialNumber) const;
+      ControlPoint *readPoint(int index);
 
       void write(FileName netFile);
       Pvl toPvl();
@@ -483,6 +518,25 @@ namespace Isis {
       //! Typedef for consistent naming of containers for version 5
       typedef ControlNetHeaderV0001 ControlNetHeaderV0005;
 
+      /**
+       * Location of a single size-prefixed control point message within the Protobuf Core
+       * of a version 5 binary control network.
+       */
+      struct PointMessage {
+        BigInt offset; //!< Byte offset of the message from the start of the Protobuf Core.
+        uint32_t size; //!< Size of the message in bytes, not including the size prefix.
+      };
+
+      /**
+       * A contiguous range of point messages that is decoded by a single thread.
+       */
+      struct PointChunk {
+        int begin;         //!< Index of the first point message in the chunk.
+        int end;           //!< Index one past the last point message in the chunk.
+        int failedIndex;   //!< Index of the point that failed to decode, -1 if none did.
+        IException error;  //!< The error that occurred when a point failed to decode.
+      };
+
       //! Typedef for consistent naming of containers for version 4
       typedef ControlPointV0003 ControlPointV0004;
       //! Typedef for consistent naming of containers for version 5
@@ -502,6 +556,22 @@ namespace Isis {
       void readProtobufV0002(const Pvl &header, const FileName netFile, Progress *progress=NULL);
       void readProtobufV0005(const Pvl &header, const FileName netFile, Progress *progress=NULL);
 
+      BigInt readProtobufHeaderV0005(const Pvl &header, const FileName netFile);
+      void readPointIndexV0005(const Pvl &header, const FileName netFile);
+      void buildPointIndex();
+
+      void mapPointData(const FileName netFile, BigInt startByte, BigInt length);
+      void unmapPointData();
+
+      QVector<PointMessage> scanPointMessages(const char *data, BigInt length);
+      void readPointMessages(const char *data, const QVector<PointMessage> &messages,
+                             Progress *progress=NULL);
+      ControlPoint *readPointMessage(const char *data, const PointMessage &message, int index,
+                                     ControlNetPointFilter::PointFields *rejected);
+      int rejectedFields() const;
+      ControlNetPointFilter::PointFields pointFields(const ControlPointFileEntryV0002 &protoPoint,
+                                                     int fields);
+
       ControlPoint *createPoint(ControlPointV0001 &point);
       ControlPoint *createPoint(ControlPointV0002 &point);
       ControlPoint *createPoint(ControlPointV0003 &point);
@@ -521,6 +591,29 @@ namespace Isis {
                              This will be true when the versioner created the points from a file.
                              This will be false when the versioner copied the points from an
                              esiting control network.*/
+      ReadMode m_readMode; //!< How the control points are read from the file.
+
+      QSharedPointer<QFile> m_pointFile; /**< The control network file while its Protobuf Core
+                                              is mapped into memory.*/
+      QByteArray m_pointBuffer; /**< The Protobuf Core when the file could not be mapped.*/
+      const char *m_pointData;  //!< The start of the mapped or buffered Protobuf Core.
+      BigInt m_pointDataLength; //!< The size of the Protobuf Core in bytes.
+
+      bool m_hasPointIndex; //!< If the points are being read through a point index.
+      QVector<PointMessage> m_pointMessages; //!< The location of each indexed point message.
+      QList<QString> m_pointIds; //!< The point IDs in file order.
+      QHash<QString, int> m_pointIndices; //!< Map from point ID to point index.
+      QMap< QString, QList<int> > m_cubePointIndices; /**< Map from cube serial number to the
+                                                           indices of the points measured on
+                                                           that cube.*/
+
+      const ControlNetPointFilter *m_pointFilter; /**< Points that fail this filter are not
+                                                       created while reading. This is only
+                                                       set during construction.*/
+      bool m_pointsFiltered; //!< If the point filter was applied while reading the points.
+      QList<ControlNetPointFilter::PointFields> m_rejectedPoints; /**< The fields of the points
+                                                                       that failed the point
+                                                                       filter, in file order.*/
 
   };
 }
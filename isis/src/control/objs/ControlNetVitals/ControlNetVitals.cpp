@@ -24,8 +24,8 @@ namespace Isis {
 
   /**
    *  Constructs a ControlNetVitals object from a ControlNet.
-   *  once complete, it calls the validate() method to evaluate the current status
-   *  of the newly ingested Control Network.
+   *  once complete, the status of the newly ingested Control Network is evaluated the
+   *  first time it is requested.
    *
    *  @param cnet The Control Network that we will be tracking vitals for.
    */
@@ -62,33 +62,30 @@ namespace Isis {
    */
   void ControlNetVitals::initializeVitals() {
 
-    m_islandList = m_controlNet->GetSerialConnections();
+    m_islandsModified = true;
+    m_statusModified = true;
 
     m_numPoints = 0;
     m_numPointsIgnored = 0;
     m_numPointsLocked = 0;
-    m_numMeasures = m_controlNet->GetNumMeasures();
+    m_numMeasures = 0;
 
     m_pointMeasureCounts.clear();
     m_imageMeasureCounts.clear();
+    m_imageValidMeasures.clear();
     m_pointTypeCounts.clear();
 
     m_pointTypeCounts.insert(ControlPoint::Free, 0);
     m_pointTypeCounts.insert(ControlPoint::Constrained, 0);
     m_pointTypeCounts.insert(ControlPoint::Fixed, 0);
 
-    foreach(ControlPoint* point, m_controlNet->GetPoints()) {
-      addPoint(point);
+    // Images without any measures still need to be counted
+    foreach(QString serial, m_controlNet->GetCubeSerials()) {
+      changeImageMeasureCount(serial, 0);
     }
 
-    foreach(QString serial, m_controlNet->GetCubeSerials()) {
-      int numValidMeasures = m_controlNet->GetNumberOfValidMeasuresInImage(serial);
-      if ( !m_imageMeasureCounts.contains(numValidMeasures) ) {
-        m_imageMeasureCounts.insert(numValidMeasures, 1);
-      }
-      else {
-        m_imageMeasureCounts[numValidMeasures]++;
-      }
+    foreach(ControlPoint* point, m_controlNet->GetPoints()) {
+      addPointToCounts(point);
     }
   }
 
@@ -129,7 +126,25 @@ namespace Isis {
   void ControlNetVitals::addPoint(ControlPoint *point) {
 
     emitHistoryEntry("Control Point Added", point->GetId(), "", "");
+
+    addPointToCounts(point);
+
+    validate();
+  }
+
+
+  /**
+   *  Add a point and all of its measures to the internal counters.
+   *
+   *  @param point The ControlPoint being counted.
+   */
+  void ControlNetVitals::addPointToCounts(ControlPoint *point) {
     m_numPoints++;
+    m_numMeasures += point->GetNumMeasures();
+
+    foreach(ControlMeasure *measure, point->getMeasures()) {
+      changeImageMeasureCount(measure->GetCubeSerialNumber(), measure->IsIgnored() ? 0 : 1);
+    }
 
     if (point->IsIgnored()) {
       m_numPointsIgnored++;
@@ -142,17 +157,7 @@ namespace Isis {
 
     m_pointTypeCounts[point->GetType()]++;
 
-    int numValidMeasures = point->GetNumValidMeasures();
-    if ( !m_pointMeasureCounts.contains(numValidMeasures) ) {
-      m_pointMeasureCounts.insert(numValidMeasures, 1);
-    }
-
-    else {
-      m_pointMeasureCounts[numValidMeasures]++;
-    }
-
-    m_numMeasures = m_controlNet->GetNumMeasures();
-    validate();
+    changePointMeasureCount(-1, point->GetNumValidMeasures());
   }
 
 
@@ -206,13 +211,7 @@ namespace Isis {
             m_numPointsLocked++;
           }
           m_pointTypeCounts[point->GetType()]++;
-          int numValidMeasures = point->GetNumValidMeasures();
-          if ( !m_pointMeasureCounts.contains(numValidMeasures) ) {
-            m_pointMeasureCounts.insert(numValidMeasures, 1);
-          }
-          else {
-            m_pointMeasureCounts[numValidMeasures]++;
-          }
+          changePointMeasureCount(-1, point->GetNumValidMeasures());
         }
 
         if (newValue.toBool()) {
@@ -221,10 +220,7 @@ namespace Isis {
             m_numPointsLocked--;
           }
           m_pointTypeCounts[point->GetType()]--;
-          int numValidMeasures = point->GetNumValidMeasures();
-          if ( --m_pointMeasureCounts[numValidMeasures] < 1 ) {
-            m_pointMeasureCounts.remove(numValidMeasures);
-          }
+          changePointMeasureCount(point->GetNumValidMeasures(), -1);
         }
 
         emitHistoryEntry( historyEntry, point->GetId(),
@@ -298,10 +294,7 @@ namespace Isis {
 
     m_pointTypeCounts[point->GetType()]--;
 
-    int numValidMeasures= point->GetNumValidMeasures();
-    if ( --m_pointMeasureCounts[numValidMeasures] < 1 ) {
-      m_pointMeasureCounts.remove(numValidMeasures);
-    }
+    changePointMeasureCount(point->GetNumValidMeasures(), -1);
 
     validate();
   }
@@ -329,7 +322,14 @@ namespace Isis {
 
     m_numMeasures++;
 
-    addMeasureToCounts(measure);
+    changeImageMeasureCount(measure->GetCubeSerialNumber(), measure->IsIgnored() ? 0 : 1);
+
+    // By this time, the measure has been added to its parent point.
+    ControlPoint *point = measure->Parent();
+    if (point && !point->IsIgnored() && !measure->IsIgnored()) {
+      int numValidMeasures = point->GetNumValidMeasures();
+      changePointMeasureCount(numValidMeasures - 1, numValidMeasures);
+    }
 
     validate();
   }
@@ -359,14 +359,23 @@ namespace Isis {
 
         historyEntry = "Measure Ignored Modified";
 
-        if ( !oldValue.toBool() && newValue.toBool() ) {
-          return removeMeasureFromCounts(measure);
-        }
-        else if ( oldValue.toBool() && !newValue.toBool() ) {
-          return addMeasureToCounts(measure);
+        if ( oldValue.toBool() != newValue.toBool() ) {
+          // By this time, the measure's ignored flag has already been changed.
+          int change = newValue.toBool() ? -1 : 1;
+          changeImageMeasureCount(measure->GetCubeSerialNumber(), change);
+
+          ControlPoint *point = measure->Parent();
+          if (point && !point->IsIgnored()) {
+            int numValidMeasures = point->GetNumValidMeasures();
+            changePointMeasureCount(numValidMeasures - change, numValidMeasures);
+          }
         }
         break;
 
+      case ControlMeasure::EditLockModified:
+        historyEntry = "Measure Edit Lock Modified";
+        break;
+
       default:
         // No operation.
         break;
@@ -393,84 +402,68 @@ namespace Isis {
 
     m_numMeasures--;
 
-    removeMeasureFromCounts(measure);
+    if (!measure->IsIgnored()) {
+      changeImageMeasureCount(measure->GetCubeSerialNumber(), -1);
+    }
+
+    // By this time, the measure is still in its parent point.
+    ControlPoint *point = measure->Parent();
+    if (point && !point->IsIgnored() && !measure->IsIgnored()) {
+      int numValidMeasures = point->GetNumValidMeasures();
+      changePointMeasureCount(numValidMeasures, numValidMeasures - 1);
+    }
 
     validate();
   }
 
 
   /**
-   * Add a measure to the internal counters
-   *
-   * @param measure The measure to add
-   */
-   void ControlNetVitals::addMeasureToCounts(ControlMeasure *measure) {
-     ControlPoint *point = measure->Parent();
-     if (point) {
-       // By this time, the measure has been added to its parent point, so the
-       // old count is the current count minus one.
-       int numValidMeasures = point->GetNumValidMeasures();
-       if ( --m_pointMeasureCounts[numValidMeasures] < 1 ) {
-         m_pointMeasureCounts.remove(numValidMeasures);
-       }
-       if ( !m_pointMeasureCounts.contains(numValidMeasures + 1) ) {
-         m_pointMeasureCounts.insert(numValidMeasures + 1, 1);
-       }
-       else {
-         m_pointMeasureCounts[numValidMeasures + 1]++;
-       }
-     }
-
-     QString serial = measure->GetCubeSerialNumber();
-     int numValidMeasures = m_controlNet->GetNumberOfValidMeasuresInImage(serial);
-     if ( --m_imageMeasureCounts[numValidMeasures - 1] < 1 ) {
-       m_imageMeasureCounts.remove(numValidMeasures);
-     }
-     if ( !m_imageMeasureCounts.contains(numValidMeasures) ) {
-       m_imageMeasureCounts.insert(numValidMeasures, 1);
-     }
-     else {
-       m_imageMeasureCounts[numValidMeasures]++;
-     }
-   }
-
-
-   /**
-    * Remove a measure from the internal counters
-    *
-    * @param measure The measure to remove
-    */
-    void ControlNetVitals::removeMeasureFromCounts(ControlMeasure *measure) {
-      ControlPoint *point = measure->Parent();
-      if (point) {
-        // By this time, the measure is still a valid measure in the parent control point.
-        int numValidMeasures = point->GetNumValidMeasures();
-
-        if ( --m_pointMeasureCounts[numValidMeasures] < 1 ) {
-          m_pointMeasureCounts.remove(numValidMeasures);
-        }
-        if ( !m_pointMeasureCounts.contains(numValidMeasures - 1) ) {
-          m_pointMeasureCounts.insert(numValidMeasures - 1, 1);
-        }
-        else {
-          m_pointMeasureCounts[numValidMeasures - 1]++;
-        }
-      }
+   * Move a point from one valid measure count to another in the internal counters.
+   *
+   * @param oldCount The point's old number of valid measures, or -1 if it was not counted.
+   * @param newCount The point's new number of valid measures, or -1 if it is no longer counted.
+   */
+  void ControlNetVitals::changePointMeasureCount(int oldCount, int newCount) {
+    if ( oldCount >= 0 && --m_pointMeasureCounts[oldCount] < 1 ) {
+      m_pointMeasureCounts.remove(oldCount);
+    }
+    if (newCount >= 0) {
+      m_pointMeasureCounts[newCount]++;
+    }
+  }
 
-      QString serial = measure->GetCubeSerialNumber();
-      int numValidMeasures = m_controlNet->GetNumberOfValidMeasuresInImage(serial);
 
+  /**
+   * Change the number of valid measures in an image in the internal counters.
+   *
+   * @param serial The cube serial number of the image.
+   * @param change The change in the number of valid measures in the image.
+   */
+  void ControlNetVitals::changeImageMeasureCount(QString serial, int change) {
+    int numValidMeasures = 0;
+    if ( m_imageValidMeasures.contains(serial) ) {
+      numValidMeasures = m_imageValidMeasures[serial];
       if ( --m_imageMeasureCounts[numValidMeasures] < 1 ) {
         m_imageMeasureCounts.remove(numValidMeasures);
       }
+    }
 
-      if ( !m_imageMeasureCounts.contains(numValidMeasures - 1) ) {
-        m_imageMeasureCounts.insert(numValidMeasures - 1, 1);
-      }
-      else {
-        m_imageMeasureCounts[numValidMeasures - 1]++;
-      }
+    numValidMeasures += change;
+    m_imageValidMeasures.insert(serial, numValidMeasures);
+    m_imageMeasureCounts[numValidMeasures]++;
+  }
+
+
+  /**
+   * Recompute the islands in the network if the network graph was modified since they
+   * were last computed.
+   */
+  void ControlNetVitals::updateIslands() {
+    if (m_islandsModified) {
+      m_islandList = m_controlNet->GetSerialConnections();
+      m_islandsModified = false;
     }
+  }
 
 
   /**
@@ -495,7 +488,7 @@ namespace Isis {
         break;
       case ControlNet::GraphModified:
         emitHistoryEntry("Control Net Graph Modified", m_controlNet->GetNetworkId(), "", "");
-        m_islandList = m_controlNet->GetSerialConnections();
+        m_islandsModified = true;
         break;
       default:
         // No operation.
@@ -530,6 +523,7 @@ namespace Isis {
    *  @return The number of islands present in the ControlNet Graph.
    */
   int ControlNetVitals::numIslands() {
+    updateIslands();
     return m_islandList.size();
   }
 
@@ -542,6 +536,7 @@ namespace Isis {
    *  @return A QList containing a QList of cube serials for each island present in the Control Net.
    */
   const QList< QList<QString> > &ControlNetVitals::getIslands() {
+    updateIslands();
     return m_islandList;
   }
 
@@ -806,7 +801,7 @@ namespace Isis {
   QList<QString> ControlNetVitals::getImagesBelowMeasureThreshold(int num) {
     QList<QString> imagesBelowThreshold;
     foreach(QString serial, m_controlNet->GetCubeSerials()) {
-      if (m_controlNet->GetValidMeasuresInCube(serial).size() < num) {
+      if (m_imageValidMeasures.value(serial, 0) < num) {
         imagesBelowThreshold.append(serial);
       }
     }
@@ -837,6 +832,7 @@ namespace Isis {
    *  @return A QString indicating the status of the Control Network.
    */
   QString ControlNetVitals::getStatus() {
+    updateStatus();
     return m_status;
   }
 
@@ -851,6 +847,7 @@ namespace Isis {
    *  @return A QString containing details for the status of the Control Network.
    */
   QString ControlNetVitals::getStatusDetails() {
+    updateStatus();
     return m_statusDetails;
   }
 
@@ -867,9 +864,21 @@ namespace Isis {
   }
 
 
+  /**
+   *  This method is designed to be called whenever the vitals of the network change. It marks
+   *  the status of the network as modified and notifies any listeners. The status itself is
+   *  evaluated the next time it is requested, so edits do not recompute the islands.
+   */
+  void ControlNetVitals::validate() {
+    m_statusModified = true;
+    emit networkChanged();
+  }
+
+
   /**
    *  This method is designed to evaluate the current vitals of the network to determine
-   *  if any weaknesses are present and update the status of the network.
+   *  if any weaknesses are present and update the status of the network if the vitals
+   *  changed since it was last evaluated.
    *
    *  The network status is split into 3 states: Healthy, Weak, and Broken.
    *
@@ -879,7 +888,10 @@ namespace Isis {
    *            A network is weak if it has images that fall below a Convex Hull tolerance.
    *  Broken  - A network is broken if it has more than 1 island.
    */
-  void ControlNetVitals::validate() {
+  void ControlNetVitals::updateStatus() {
+    if (!m_statusModified) {
+      return;
+    }
 
     QString status = "";
     QString details = "";
@@ -911,7 +923,7 @@ namespace Isis {
     }
     m_status = status;
     m_statusDetails = details;
-    emit networkChanged();
+    m_statusModified = false;
   }
 
 }
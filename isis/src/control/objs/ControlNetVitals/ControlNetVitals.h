@@ -9,6 +9,7 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 
+#include <QHash>
 #include <QStringList>
 
 #include "ControlMeasure.h"
@@ -36,6 +37,11 @@ namespace Isis {
   *  It then listens for specific signals to be emitted whenever a change is made to the network
   *  to update it's internal counters with respect to that change.
   *
+  *  Each edit only updates the counters that it affects, so it costs a constant amount of work.
+  *  The islands are the exception, because removing a connection can split an island. Changes
+  *  to the network graph only mark the islands as modified, and they are recomputed the next
+  *  time that they are needed.
+  *
   *  @author 2018-05-28 Adam Goins
   *
   *  @internal
@@ -110,8 +116,11 @@ namespace Isis {
 
 
     private:
-      void addMeasureToCounts(ControlMeasure *measure);
-      void removeMeasureFromCounts(ControlMeasure *measure);
+      void addPointToCounts(ControlPoint *point);
+      void changePointMeasureCount(int oldCount, int newCount);
+      void changeImageMeasureCount(QString serial, int change);
+      void updateIslands();
+      void updateStatus();
 
       //! The Control Network that the vitals class is observing.
       ControlNet *m_controlNet;
@@ -120,10 +129,14 @@ namespace Isis {
       QString m_status;
       //! The string providing details into the status of the network.
       QString m_statusDetails;
+      //! If the vitals were modified since the status was evaluated.
+      bool m_statusModified;
 
       //! A QList containing every island in the net. Each island consists of a QList containing
       //! All cube serials for that island.
       QList< QList< QString > > m_islandList;
+      //! If the network graph was modified since the islands were computed.
+      bool m_islandsModified;
 
       //! The measureCount maps track how many points/images have how many measures.
       //! For instance, if I wanted to know how many points have 3 measures I would query
@@ -132,6 +145,8 @@ namespace Isis {
       QMap<int, int> m_pointMeasureCounts;
       //! The same is true for imageMeasureCounts, except for images.
       QMap<int, int> m_imageMeasureCounts;
+      //! The number of valid measures in each image, by cube serial number.
+      QHash<QString, int> m_imageValidMeasures;
 
       //! The pointTypeCounts operates in the same fashion as the above two, except
       //! that the key would be the ControlPoint::PointType you're searching for.
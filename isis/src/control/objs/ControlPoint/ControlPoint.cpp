@@ -290,6 +290,11 @@ namespace Isis {
     ValidateMeasure(serialNumber);
     ControlMeasure *cm = (*measures)[serialNumber];
 
+    // A locked measure stays in the point, so the network is not told it was removed
+    if (cm->IsEditLocked()) {
+      return ControlMeasure::MeasureLocked;
+    }
+
     // notify parent network of the change
     if (parentNetwork) {
       parentNetwork->measureDeleted(cm);
@@ -299,10 +304,6 @@ namespace Isis {
       }
     }
 
-    if (cm->IsEditLocked()) {
-      return ControlMeasure::MeasureLocked;
-    }
-
     // remove measure from the point's data structures
     measures->remove(serialNumber);
     cubeSerials->removeAt(cubeSerials->indexOf(serialNumber));
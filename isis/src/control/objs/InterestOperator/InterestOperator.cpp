@@ -6,7 +6,11 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 
+#include <algorithm>
+
+#include "Buffer.h"
 #include "Chip.h"
+#include "Portal.h"
 #include "Pvl.h"
 #include "InterestOperator.h"
 #include "Plugin.h"
@@ -178,6 +182,9 @@ namespace Isis {
       chip.SetClipPolygon(*p_clipPolygon);
     chip.Load(pCube);
 
+    Chip interestChip(2 * p_deltaSamp + 1, 2 * p_deltaLine + 1);
+    SearchInterest(chip, interestChip);
+
     // Walk the search chip and find the best interest
     int iBestSamp = 0;
     int iBestLine = 0;
@@ -201,8 +208,7 @@ namespace Isis {
         }
 
         if (bCalculateInterest) {
-          Chip subChip = chip.Extract(p_samples + pad, p_lines + pad, samp, lin);
-          double interest = Interest(subChip);
+          double interest = interestChip.GetValue(samp - p_samples / 2, lin - p_lines / 2);
           if (interest != Isis::Null) {
             if ((dBestInterest == Isis::Null) || CompareInterests(interest, dBestInterest)) {
               double dist = std::sqrt(std::pow(piSample - samp, 2.0) + std::pow(piLine - lin, 2.0));
@@ -238,6 +244,220 @@ namespace Isis {
     return true;
   }
 
+  /**
+   * Calculate the interest of every pixel of a buffer. The interest of a pixel is the same
+   * as the InterestAmount after calling Operate(pCube, pUnivGrndMap, sample, line) for it, and
+   * the pixels are visited in the same order, but the windows of all of the pixels are read
+   * from the cube at once and their interests are calculated with InterestImage. The operator
+   * must have a DeltaSamp and DeltaLine of zero. Pixels outside of the clip polygon are Null,
+   * like they are in the chips that Operate loads.
+   *
+   * @param pCube        The cube to calculate the interest of
+   * @param pUnivGrndMap Reference to the Universal Ground map of this image
+   * @param pInterest    Buffer to put the interest of each pixel into. Pixels that are off of
+   *                     the cube are set to Null.
+   */
+  void InterestOperator::Operate(Cube &pCube, UniversalGroundMap &pUnivGrndMap,
+                                 Buffer &pInterest) {
+    if (!pUnivGrndMap.HasCamera()) {
+      QString msg = "Cannot run interest on images with no camera. Image " +
+                        pCube.fileName() + " has no Camera";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (p_deltaSamp != 0 || p_deltaLine != 0) {
+      QString msg = "The interest of every pixel of a buffer can only be calculated when "
+                    "DeltaSamp and DeltaLine are zero";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // Operate tacks a chip the size of the window on the pixel, then takes the window from the
+    // first search position of the chip. That position can be shifted from the chip tack, in
+    // which case the part of the window that is off of the chip is Null.
+    int pad = Padding();
+    int windowSamples = p_samples + pad;
+    int windowLines = p_lines + pad;
+    int tackSample = (windowSamples - 1) / 2 + 1;
+    int tackLine = (windowLines - 1) / 2 + 1;
+    int sampleShift = p_samples / 2 + 1 - tackSample;
+    int lineShift = p_lines / 2 + 1 - tackLine;
+
+    Chip interest(pInterest.SampleDimension(), pInterest.LineDimension());
+    Chip area(interest.Samples() + windowSamples - 1, interest.Lines() + windowLines - 1);
+
+    Portal portal(area.Samples(), area.Lines(), pCube.pixelType(), 0.0, 0.0);
+    portal.SetPosition(pInterest.Sample() - tackSample + 1 + sampleShift,
+                       pInterest.Line() - tackLine + 1 + lineShift, 1);
+    pCube.read(portal);
+    for (int line = 1; line <= area.Lines(); line++) {
+      const double *row = portal.DoubleBuffer() + (line - 1) * area.Samples();
+      std::copy(row, row + area.Samples(), area.Row(line));
+    }
+
+    if (p_clipPolygon != NULL) {
+      for (int line = 1; line <= area.Lines(); line++) {
+        for (int samp = 1; samp <= area.Samples(); samp++) {
+          geos::geom::Point *pnt = globalFactory->createPoint(
+                                     geos::geom::Coordinate(portal.Sample() + samp - 1,
+                                                            portal.Line() + line - 1));
+          bool inside = pnt->within(p_clipPolygon);
+          delete pnt;
+          if (!inside) {
+            area.SetValue(samp, line, Isis::Null);
+          }
+        }
+      }
+    }
+
+    InterestImage(area, interest, sampleShift, lineShift);
+
+    for (int i = 0; i < pInterest.size(); i++) {
+      int sample = pInterest.Sample(i);
+      int line = pInterest.Line(i);
+      if (sample > pCube.sampleCount() || line > pCube.lineCount()) {
+        pInterest[i] = Isis::Null;
+        continue;
+      }
+
+      double dInterest = Isis::Null;
+      MeasureValidationResults results =
+        ValidStandardOptions(sample + sampleShift, line + lineShift, &pCube);
+      if (results.isValid()) {
+        dInterest = interest.GetValue(sample - pInterest.Sample() + 1,
+                                      line - pInterest.Line() + 1);
+      }
+
+      if (dInterest == Isis::Null || dInterest < p_minimumInterest) {
+        if (pUnivGrndMap.SetImage(sample, line)) {
+          p_interestAmount = dInterest;
+        }
+      }
+      else {
+        p_interestAmount = dInterest;
+      }
+      pInterest[i] = p_interestAmount;
+    }
+  }
+
+
+  /**
+   * Calculate the interest of every window position in a search chip that Operate and
+   * InterestByMeasure walk. The interest of the search position (samp, line) of the chip is
+   * put at (samp - Samples / 2, line - Lines / 2) of the interest chip, which must be
+   * (2 * DeltaSamp + 1) by (2 * DeltaLine + 1) pixels.
+   *
+   * @param pSearchChip The loaded search chip
+   * @param pInterest   Chip to put the interest of each search position into
+   */
+  void InterestOperator::SearchInterest(Chip &pSearchChip, Chip &pInterest) {
+    int pad = Padding();
+    int sampleShift = p_samples / 2 + 1 - ((p_samples + pad - 1) / 2 + 1);
+    int lineShift = p_lines / 2 + 1 - ((p_lines + pad - 1) / 2 + 1);
+
+    // Line the first window up with the first pixel of the area. The windows that hang off
+    // of the search chip get Nulls, just like when they are extracted one at a time.
+    Chip area(pSearchChip.Samples(), pSearchChip.Lines());
+    pSearchChip.Extract(pSearchChip.TackSample() + sampleShift,
+                        pSearchChip.TackLine() + lineShift, area);
+
+    InterestImage(area, pInterest, 0, 0);
+  }
+
+
+  /**
+   * Calculate the interest of every window position in an area. The interest of the window
+   * whose first pixel is at (samp, line) of the area is put at (samp, line) of the interest
+   * chip, so the area must be (Samples + Padding - 1) samples and (Lines + Padding - 1) lines
+   * larger than the interest chip.
+   *
+   * The shifts treat part of every window as Null. Sample i of a window is Null if
+   * i + piSampleShift is outside of the window, and likewise for lines.
+   *
+   * This implementation extracts each window and calls Interest. Operators that can
+   * calculate their interest with box filters override it.
+   *
+   * @param pArea         The area to calculate the interest of
+   * @param pInterest     Chip to put the interest of each window position into
+   * @param piSampleShift The sample shift of the Null part of each window
+   * @param piLineShift   The line shift of the Null part of each window
+   */
+  void InterestOperator::InterestImage(Chip &pArea, Chip &pInterest, int piSampleShift,
+                                       int piLineShift) {
+    int windowSamples = pArea.Samples() - pInterest.Samples() + 1;
+    int windowLines = pArea.Lines() - pInterest.Lines() + 1;
+    int firstSamp = std::max(1, 1 - piSampleShift);
+    int lastSamp = std::min(windowSamples, windowSamples - piSampleShift);
+    int firstLine = std::max(1, 1 - piLineShift);
+    int lastLine = std::min(windowLines, windowLines - piLineShift);
+
+    Chip window(windowSamples, windowLines);
+    for (int line = 1; line <= pInterest.Lines(); line++) {
+      for (int samp = 1; samp <= pInterest.Samples(); samp++) {
+        pArea.Extract(samp + (windowSamples - 1) / 2, line + (windowLines - 1) / 2, window);
+
+        for (int wline = 1; wline <= windowLines; wline++) {
+          double *row = window.Row(wline);
+          if (wline < firstLine || wline > lastLine) {
+            std::fill(row, row + windowSamples, Isis::Null);
+            continue;
+          }
+          std::fill(row, row + (firstSamp - 1), Isis::Null);
+          std::fill(row + lastSamp, row + windowSamples, Isis::Null);
+        }
+
+        pInterest.SetValue(samp, line, Interest(window));
+      }
+    }
+  }
+
+
+  /**
+   * Sum the pixels of every box position in an image. The sum of the box whose first pixel is
+   * at (samp, line) is put at index (line * (piSamples - piBoxSamples + 1) + samp) of the sums,
+   * where samp and line start at zero. Each output line sums the columns of the box lines and
+   * then slides the box along them, so the loops run over contiguous pixels.
+   *
+   * @param pImage       The image pixels in line order
+   * @param piSamples    The number of samples in the image
+   * @param piLines      The number of lines in the image
+   * @param piBoxSamples The number of samples in the box
+   * @param piBoxLines   The number of lines in the box
+   * @param pSums        Output sums of every box position
+   */
+  void InterestOperator::BoxSum(const std::vector<double> &pImage, int piSamples, int piLines,
+                                int piBoxSamples, int piBoxLines, std::vector<double> &pSums) {
+    int outSamples = piSamples - piBoxSamples + 1;
+    int outLines = piLines - piBoxLines + 1;
+    if (piBoxSamples < 1 || piBoxLines < 1 || outSamples < 1 || outLines < 1) {
+      pSums.assign(std::max(outSamples, 0) * std::max(outLines, 0), 0.0);
+      return;
+    }
+    pSums.resize(outSamples * outLines);
+
+    std::vector<double> columns(piSamples);
+    for (int line = 0; line < outLines; line++) {
+      std::fill(columns.begin(), columns.end(), 0.0);
+      for (int boxLine = 0; boxLine < piBoxLines; boxLine++) {
+        const double *row = &pImage[(line + boxLine) * piSamples];
+        for (int samp = 0; samp < piSamples; samp++) {
+          columns[samp] += row[samp];
+        }
+      }
+
+      double *sums = &pSums[line * outSamples];
+      double sum = 0.0;
+      for (int samp = 0; samp < piBoxSamples; samp++) {
+        sum += columns[samp];
+      }
+      sums[0] = sum;
+      for (int samp = 1; samp < outSamples; samp++) {
+        sum += columns[samp + piBoxSamples - 1] - columns[samp - 1];
+        sums[samp] = sum;
+      }
+    }
+  }
+
+
   /**
    * Read the Serial#'s and overlaplist if any and call API to find the reference
    * for all the points in the network
@@ -743,6 +963,9 @@ namespace Isis {
       chip.SetClipPolygon(*p_clipPolygon);
     chip.Load(pCube);
 
+    Chip interestChip(2 * p_deltaSamp + 1, 2 * p_deltaLine + 1);
+    SearchInterest(chip, interestChip);
+
     // Walk the search chip and find the best interest
     int iBestSamp = 0;
     int iBestLine = 0;
@@ -766,8 +989,7 @@ namespace Isis {
         }
 
         if (bCalculateInterest) {
-          Chip subChip = chip.Extract(p_samples + pad, p_lines + pad, samp, lin);
-          double interest = Interest(subChip);
+          double interest = interestChip.GetValue(samp - p_samples / 2, lin - p_lines / 2);
 
           if (interest != Isis::Null) {
             if ((dBestInterest == Isis::Null) || CompareInterests(interest, dBestInterest)) {
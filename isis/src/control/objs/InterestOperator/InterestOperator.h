@@ -23,6 +23,7 @@ find files of those names at the top level of this repository. **/
 #include "geos/util/GEOSException.h"
 
 namespace Isis {
+  class Buffer;
   class Chip;
   class Pvl;
   class Cube;
@@ -128,6 +129,9 @@ namespace Isis {
       //! Operate used by the app interestcube- to calculate interest by sample,line
       bool Operate(Cube &pCube, UniversalGroundMap &pUnivGrndMap, int piSample, int piLine);
 
+      //! Operate used by the app interestcube- to calculate interest for every pixel of a buffer
+      void Operate(Cube &pCube, UniversalGroundMap &pUnivGrndMap, Buffer &pInterest);
+
       //! Operate - to calculate interest for entire control net to get better reference
       void Operate(ControlNet &pNewNet, QString psSerialNumFile, QString psOverlapListFile = "");
 
@@ -168,6 +172,17 @@ namespace Isis {
       //! Calculate the interest
       virtual double Interest(Chip &subCube) = 0;
 
+      //! Calculate the interest of every window position in an area
+      virtual void InterestImage(Chip &pArea, Chip &pInterest, int piSampleShift,
+                                 int piLineShift);
+
+      //! Calculate the interest of every window position in a search chip
+      void SearchInterest(Chip &pSearchChip, Chip &pInterest);
+
+      //! Sum the pixels of every box position in an image
+      static void BoxSum(const std::vector<double> &pImage, int piSamples, int piLines,
+                         int piBoxSamples, int piBoxLines, std::vector<double> &pSums);
+
       //! Find if a point is in the overlap
       const geos::geom::MultiPolygon *FindOverlap(Isis::ControlPoint &pCnetPoint);
 
@@ -0,0 +1,247 @@
+/** This is free and unencumbered software released into the public domain.
+
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include "LazyControlNet.h"
+
+#include "ControlMeasure.h"
+#include "ControlNetVersioner.h"
+#include "ControlPoint.h"
+#include "FileName.h"
+#include "IException.h"
+#include "IString.h"
+#include "Progress.h"
+
+namespace Isis {
+
+  /**
+   * Open a control network file. Only the general network information and the point index
+   * are read.
+   *
+   * @param filename The control network file to open.
+   * @param progress The progress object to track reading points. This is only used if the
+   *                 file does not contain a point index and every point must be read.
+   */
+  LazyControlNet::LazyControlNet(const QString &filename, Progress *progress)
+      : m_numLoadedPoints(0) {
+    m_versioner.reset( new ControlNetVersioner(FileName(filename),
+                                               ControlNetVersioner::ReadPointsOnDemand,
+                                               progress) );
+    m_points.fill(NULL, m_versioner->numPoints());
+
+    // Each cube in the index lists the points it has a measure in
+    m_numMeasures.fill(0, m_points.size());
+    foreach (QString serialNumber, m_versioner->cubeSerialNumbers()) {
+      foreach (int index, m_versioner->pointIndicesInCube(serialNumber)) {
+        m_numMeasures[index]++;
+      }
+    }
+  }
+
+
+  /**
+   * Destroy the LazyControlNet and all of the points that were read.
+   */
+  LazyControlNet::~LazyControlNet() {
+    foreach (ControlPoint *point, m_points) {
+      delete point;
+    }
+  }
+
+
+  /**
+   * Returns if the points are being read through a point index in the file. If not, every
+   * point was read when the network was opened.
+   *
+   * @return @b bool If the file contains a point index.
+   */
+  bool LazyControlNet::HasPointIndex() const {
+    return m_versioner->hasPointIndex();
+  }
+
+
+  /**
+   * @return @b QString The network ID.
+   */
+  QString LazyControlNet::GetNetworkId() const {
+    return m_versioner->netId();
+  }
+
+
+  /**
+   * @return @b QString The target name.
+   */
+  QString LazyControlNet::GetTarget() const {
+    return m_versioner->targetName();
+  }
+
+
+  /**
+   * @return @b QString The name of the user that last modified the network.
+   */
+  QString LazyControlNet::GetUserName() const {
+    return m_versioner->userName();
+  }
+
+
+  /**
+   * @return @b QString The network creation date.
+   */
+  QString LazyControlNet::CreatedDate() const {
+    return m_versioner->creationDate();
+  }
+
+
+  /**
+   * @return @b QString The network last modified date.
+   */
+  QString LazyControlNet::GetLastModified() const {
+    return m_versioner->lastModificationDate();
+  }
+
+
+  /**
+   * @return @b QString The network description.
+   */
+  QString LazyControlNet::Description() const {
+    return m_versioner->description();
+  }
+
+
+  /**
+   * @return @b int The number of points in the network.
+   */
+  int LazyControlNet::GetNumPoints() const {
+    return m_points.size();
+  }
+
+
+  /**
+   * @return @b int The number of points that have been read from the file.
+   */
+  int LazyControlNet::GetNumLoadedPoints() const {
+    return m_numLoadedPoints;
+  }
+
+
+  /**
+   * @return @b QList<QString> The IDs of the points in the network, in file order.
+   */
+  QList< QString > LazyControlNet::GetPointIds() const {
+    return m_versioner->pointIds();
+  }
+
+
+  /**
+   * @return @b QList<QString> The serial numbers of the cubes measured in the network.
+   */
+  QList< QString > LazyControlNet::GetCubeSerials() const {
+    return m_versioner->cubeSerialNumbers();
+  }
+
+
+  /**
+   * @param pointId The ID of the point to check for.
+   *
+   * @return @b bool If the network contains a point with the ID.
+   */
+  bool LazyControlNet::ContainsPoint(QString pointId) const {
+    return m_versioner->pointIndex(pointId) != -1;
+  }
+
+
+  /**
+   * Get the number of measures in a point without reading it from the file.
+   *
+   * @param index The index of the point in the network.
+   *
+   * @return @b int The number of measures in the point.
+   */
+  int LazyControlNet::GetNumMeasures(int index) const {
+    if (index < 0 || index >= m_numMeasures.size()) {
+      IString msg = "Index [" + IString(index) + "] out of range";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    return m_numMeasures[index];
+  }
+
+
+  /**
+   * Get a point by its ID, reading it from the file if it has not been read yet.
+   *
+   * @param pointId The ID of the point.
+   *
+   * @return @b ControlPoint* The point. It is owned by the LazyControlNet.
+   */
+  ControlPoint *LazyControlNet::GetPoint(QString pointId) {
+    int index = m_versioner->pointIndex(pointId);
+    if (index == -1) {
+      IString msg = "The control network has no control points with an ID "
+          "equal to [" + pointId + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    return GetPoint(index);
+  }
+
+
+  /**
+   * Get a point by its index, reading it from the file if it has not been read yet.
+   *
+   * @param index The index of the point in the network.
+   *
+   * @return @b ControlPoint* The point. It is owned by the LazyControlNet.
+   */
+  ControlPoint *LazyControlNet::GetPoint(int index) {
+    if (index < 0 || index >= m_points.size()) {
+      IString msg = "Index [" + IString(index) + "] out of range";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (!m_points[index]) {
+      m_points[index] = m_versioner->readPoint(index);
+      m_numLoadedPoints++;
+    }
+
+    return m_points[index];
+  }
+
+
+  /**
+   * Get all of the points that have a measure on a cube. Only these points are read from
+   * the file.
+   *
+   * @param serialNumber The serial number of the cube.
+   *
+   * @return @b QList<ControlPoint*> The points measured on the cube, in file order.
+   */
+  QList< ControlPoint * > LazyControlNet::GetPointsInCube(QString serialNumber) {
+    QList< ControlPoint * > points;
+    foreach (int index, m_versioner->pointIndicesInCube(serialNumber)) {
+      points.append( GetPoint(index) );
+    }
+    return points;
+  }
+
+
+  /**
+   * Get all of the measures on a cube. Only the points measured on the cube are read from
+   * the file.
+   *
+   * @param serialNumber The serial number of the cube.
+   *
+   * @return @b QList<ControlMeasure*> The measures on the cube, in point file order.
+   */
+  QList< ControlMeasure * > LazyControlNet::GetMeasuresInCube(QString serialNumber) {
+    QList< ControlMeasure * > measures;
+    foreach (ControlPoint *point, GetPointsInCube(serialNumber)) {
+      measures.append( point->GetMeasure(serialNumber) );
+    }
+    return measures;
+  }
+}
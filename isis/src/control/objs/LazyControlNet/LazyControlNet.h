@@ -0,0 +1,81 @@
+#ifndef LazyControlNet_h
+#define LazyControlNet_h
+
+/** This is free and unencumbered software released into the public domain.
+
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include <QList>
+#include <QScopedPointer>
+#include <QString>
+#include <QVector>
+
+namespace Isis {
+  class ControlMeasure;
+  class ControlNetVersioner;
+  class ControlPoint;
+  class Progress;
+
+  /**
+   * @brief Read only view of a control network file that reads points on first access
+   *
+   * A LazyControlNet opens a control network file, but only reads the general network
+   * information and the point index. Control points are decoded from the file the first
+   * time they are accessed and are then kept until the LazyControlNet is destroyed. This
+   * allows queries such as "this point" or "all of the measures on this cube" to be answered
+   * without reading the entire network.
+   *
+   * Binary control networks written with a point index (see ControlNetVersioner) support
+   * random access. For all other networks, every point is read when the LazyControlNet is
+   * constructed, and the point index is built from them.
+   *
+   * The points returned are owned by the LazyControlNet. They are not part of a ControlNet,
+   * so they do not have a parent network. If the network needs to be modified, read it into
+   * a ControlNet instead.
+   *
+   * cnetextract reads the points in a POINTLIST through a LazyControlNet when no other
+   * filter has to look at the points it does not extract.
+   *
+   * @ingroup ControlNetwork
+   */
+  class LazyControlNet {
+    public:
+      LazyControlNet(const QString &filename, Progress *progress = 0);
+      ~LazyControlNet();
+
+      bool HasPointIndex() const;
+
+      QString GetNetworkId() const;
+      QString GetTarget() const;
+      QString GetUserName() const;
+      QString CreatedDate() const;
+      QString GetLastModified() const;
+      QString Description() const;
+
+      int GetNumPoints() const;
+      int GetNumLoadedPoints() const;
+      QList< QString > GetPointIds() const;
+      QList< QString > GetCubeSerials() const;
+      bool ContainsPoint(QString pointId) const;
+      int GetNumMeasures(int index) const;
+
+      ControlPoint *GetPoint(QString pointId);
+      ControlPoint *GetPoint(int index);
+      QList< ControlPoint * > GetPointsInCube(QString serialNumber);
+      QList< ControlMeasure * > GetMeasuresInCube(QString serialNumber);
+
+    private:
+      Q_DISABLE_COPY(LazyControlNet)
+
+      QScopedPointer<ControlNetVersioner> m_versioner; //!< Reads points from the file.
+      QVector<ControlPoint *> m_points; //!< Points that have been read, NULL if not read yet.
+      int m_numLoadedPoints; //!< The number of points that have been read.
+      QVector<int> m_numMeasures; //!< The number of measures in each point, from the index.
+  };
+}
+
+#endif
@@ -0,0 +1,106 @@
+#include <cmath>
+
+#include "AutoReg.h"
+#include "AutoRegFactory.h"
+#include "Chip.h"
+#include "IException.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlObject.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+static Pvl pyramidPvl(QString pyramidLevels, QString reductionFactor = "1") {
+  PvlGroup alg("Algorithm");
+  alg += PvlKeyword("Name", "MaximumCorrelation");
+  alg += PvlKeyword("Tolerance", "0.3");
+  alg += PvlKeyword("SubpixelAccuracy", "True");
+  alg += PvlKeyword("ReductionFactor", reductionFactor);
+  alg += PvlKeyword("PyramidLevels", pyramidLevels);
+  alg += PvlKeyword("PyramidCandidates", "3");
+
+  PvlGroup pchip("PatternChip");
+  pchip += PvlKeyword("Samples", "15");
+  pchip += PvlKeyword("Lines", "13");
+
+  PvlGroup schip("SearchChip");
+  schip += PvlKeyword("Samples", "61");
+  schip += PvlKeyword("Lines", "57");
+
+  PvlObject o("AutoRegistration");
+  o.addGroup(alg);
+  o.addGroup(pchip);
+  o.addGroup(schip);
+
+  Pvl pvl;
+  pvl.addObject(o);
+  return pvl;
+}
+
+
+static void loadChips(AutoReg &ar) {
+  Chip &search = *ar.SearchChip();
+  for (int line = 1; line <= search.Lines(); line++) {
+    for (int samp = 1; samp <= search.Samples(); samp++) {
+      double dn = 500.0 + 80.0 * sin(0.21 * samp) * cos(0.17 * line) +
+                  40.0 * cos(0.05 * samp * line / 10.0);
+      search.SetValue(samp, line, dn);
+    }
+  }
+
+  // The pattern is a copy of part of the search chip
+  Chip &pattern = *ar.PatternChip();
+  for (int line = 1; line <= pattern.Lines(); line++) {
+    for (int samp = 1; samp <= pattern.Samples(); samp++) {
+      pattern.SetValue(samp, line, search.GetValue(samp + 37, line + 11));
+    }
+  }
+}
+
+
+TEST(AutoRegPyramid, MatchesSingleLevel) {
+  Pvl singlePvl = pyramidPvl("1");
+  Pvl pyramidPvl3 = pyramidPvl("3");
+  AutoReg *single = AutoRegFactory::Create(singlePvl);
+  AutoReg *pyramid = AutoRegFactory::Create(pyramidPvl3);
+  EXPECT_EQ(pyramid->PyramidLevels(), 3);
+  EXPECT_EQ(pyramid->PyramidCandidates(), 3);
+
+  loadChips(*single);
+  loadChips(*pyramid);
+
+  EXPECT_EQ(single->Register(), AutoReg::SuccessSubPixel);
+  EXPECT_EQ(pyramid->Register(), AutoReg::SuccessSubPixel);
+  EXPECT_EQ(pyramid->GoodnessOfFit(), single->GoodnessOfFit());
+  EXPECT_EQ(pyramid->ChipSample(), single->ChipSample());
+  EXPECT_EQ(pyramid->ChipLine(), single->ChipLine());
+
+  PvlGroup reg = pyramid->RegTemplate();
+  EXPECT_EQ(int(reg["PyramidLevels"]), 3);
+  EXPECT_EQ(int(reg["PyramidCandidates"]), 3);
+
+  delete single;
+  delete pyramid;
+}
+
+
+TEST(AutoRegPyramid, InvalidSettings) {
+  Pvl pvl = pyramidPvl("1");
+  AutoReg *ar = AutoRegFactory::Create(pvl);
+  EXPECT_THROW(ar->SetPyramidLevels(0), IException);
+  EXPECT_THROW(ar->SetPyramidCandidates(0), IException);
+
+  // The 15x13 pattern chip can only be halved twice
+  ar->SetPyramidLevels(4);
+  loadChips(*ar);
+  EXPECT_THROW(ar->Register(), IException);
+  delete ar;
+
+  Pvl reducedPvl = pyramidPvl("2", "2");
+  AutoReg *reduced = AutoRegFactory::Create(reducedPvl);
+  loadChips(*reduced);
+  EXPECT_THROW(reduced->Register(), IException);
+  delete reduced;
+}
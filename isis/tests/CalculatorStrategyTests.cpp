@@ -0,0 +1,142 @@
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "CalculatorStrategy.h"
+#include "IString.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "Resource.h"
+#include "ResourceColumns.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// Resources with numbers, a value that is not a number and a value only found in the globals
+static ResourceList resources() {
+  QStringList emissions;
+  emissions << "10.0" << "22.5" << "abc" << "" << "-3.0" << "1e2";
+
+  ResourceList list;
+  for (int i = 0; i < emissions.size(); i++) {
+    SharedResource resource(new Resource("Image" + QString::number(i)));
+    if (!emissions[i].isEmpty()) {
+      resource->add("Emission", emissions[i]);
+    }
+    if (i % 2) {
+      resource->add("Offset", QString::number(i));
+    }
+    list.append(resource);
+  }
+  return list;
+}
+
+
+static ResourceList globals() {
+  ResourceList list;
+  SharedResource first(new Resource("Globals"));
+  first->add("Emission", "45.0");
+  first->add("Offset", "0.5");
+  list.append(first);
+
+  SharedResource second(new Resource("MoreGlobals"));
+  second->add("Emission", "60.0");
+  second->add("Scale", "3.0");
+  list.append(second);
+  return list;
+}
+
+
+static PvlObject calculatorDefinition() {
+  PvlObject definition("Strategy");
+  definition += PvlKeyword("Name", "TestCalculator");
+  definition += PvlKeyword("Type", "Calculator");
+
+  PvlGroup initializers("Initializers");
+  initializers += PvlKeyword("Base", "2.0");
+  definition.addGroup(initializers);
+
+  // The second equation uses the result of the first
+  PvlGroup equations("Equations");
+  equations += PvlKeyword("Scaled", "Emission * Scale + Offset");
+  equations += PvlKeyword("Total", "Scaled + Base");
+  definition.addGroup(equations);
+  return definition;
+}
+
+
+// The results and disposition of each Resource
+static QString summary(const ResourceList &list) {
+  QStringList lines;
+  foreach (SharedResource resource, list) {
+    lines.append(resource->name() + " " + resource->value("Scaled", "none") + " " +
+                 resource->value("Total", "none") +
+                 (resource->isDiscarded() ? " discarded" : ""));
+  }
+  return lines.join("\n");
+}
+
+
+TEST(CalculatorStrategy, ColumnsMatchPerResource) {
+  ResourceList globalList = globals();
+
+  // One Resource at a time, with the variables looked up in each Resource
+  ResourceList perResource = resources();
+  CalculatorStrategy perResourceStrategy(calculatorDefinition(), globalList);
+  int perResourceCount = 0;
+  foreach (SharedResource resource, perResource) {
+    perResourceCount += perResourceStrategy.apply(resource, globalList);
+  }
+
+  // The whole list, with the variables converted to columns
+  ResourceList columnar = resources();
+  CalculatorStrategy columnarStrategy(calculatorDefinition(), globalList);
+  int columnarCount = columnarStrategy.apply(columnar, globalList);
+
+  EXPECT_EQ(columnarCount, perResourceCount);
+  EXPECT_EQ(summary(columnar).toStdString(), summary(perResource).toStdString());
+
+  // The value that is not a number is discarded, the missing one comes from the globals
+  EXPECT_TRUE(columnar[2]->isDiscarded());
+  EXPECT_FALSE(columnar[3]->isDiscarded());
+  EXPECT_DOUBLE_EQ(toDouble(columnar[3]->value("Scaled")), 45.0 * 3.0 + 3.0);
+  EXPECT_DOUBLE_EQ(toDouble(columnar[0]->value("Total")), 10.0 * 3.0 + 0.5 + 2.0);
+  EXPECT_EQ(columnarCount, 5);
+}
+
+
+TEST(CalculatorStrategy, ColumnVariableLookupOrder) {
+  ResourceList list = resources();
+  ResourceList globalList = globals();
+  ResourceColumns columns(list);
+
+  // The Resource is searched first
+  ResourceColumnsCalculatorVariablePool image0(columns, 0, globalList);
+  ASSERT_TRUE(image0.exists("Emission"));
+  ASSERT_EQ(image0.value("Emission").size(), 1);
+  EXPECT_DOUBLE_EQ(image0.value("Emission")[0], 10.0);
+
+  // Then the globals, in order
+  ResourceColumnsCalculatorVariablePool image3(columns, 3, globalList);
+  ASSERT_TRUE(image3.exists("Emission"));
+  EXPECT_DOUBLE_EQ(image3.value("Emission")[0], 45.0);
+  ASSERT_TRUE(image3.exists("Scale"));
+  EXPECT_DOUBLE_EQ(image3.value("Scale")[0], 3.0);
+  EXPECT_DOUBLE_EQ(image3.value("Offset")[0], 3.0);
+  EXPECT_DOUBLE_EQ(image0.value("Offset")[0], 0.5);
+
+  // Variables found nowhere do not exist and have no value
+  EXPECT_FALSE(image0.exists("Incidence"));
+  EXPECT_TRUE(image0.value("Incidence").isEmpty());
+
+  // The same order as the per-resource variables
+  SharedResource resource = list[3];
+  ResourceList variables;
+  variables.append(resource);
+  variables.append(globalList);
+  ResourceCalculatorVariablePool perResource(variables);
+  EXPECT_EQ(image3.value("Emission"), perResource.value("Emission"));
+  EXPECT_EQ(image3.value("Offset"), perResource.value("Offset"));
+}
@@ -0,0 +1,155 @@
+#include <cmath>
+
+#include "Chip.h"
+#include "Cube.h"
+#include "Interpolator.h"
+#include "LineManager.h"
+#include "Portal.h"
+#include "SpecialPixel.h"
+#include "Statistics.h"
+#include "TempFixtures.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+static void fillChip(Chip &chip) {
+  for (int line = 1; line <= chip.Lines(); line++) {
+    for (int samp = 1; samp <= chip.Samples(); samp++) {
+      chip.SetValue(samp, line, 100.0 * line + samp);
+    }
+  }
+}
+
+
+TEST(Chip, RowsAreContiguous) {
+  Chip chip(7, 4);
+  fillChip(chip);
+
+  for (int line = 1; line <= chip.Lines(); line++) {
+    const double *row = chip.Row(line);
+    for (int samp = 1; samp <= chip.Samples(); samp++) {
+      EXPECT_EQ(row[samp - 1], chip.GetValue(samp, line));
+    }
+  }
+}
+
+
+TEST(Chip, ExtractPastEdges) {
+  Chip chip(6, 5);
+  fillChip(chip);
+
+  // A 5x3 sub-chip centered on sample 1, line 5 hangs off the left and bottom
+  Chip subchip(5, 3);
+  chip.Extract(1, 5, subchip);
+
+  for (int line = 1; line <= subchip.Lines(); line++) {
+    for (int samp = 1; samp <= subchip.Samples(); samp++) {
+      int chipSamp = 1 + samp - 3;
+      int chipLine = 5 + line - 2;
+      if (chipSamp < 1 || chipLine > 5) {
+        EXPECT_EQ(subchip.GetValue(samp, line), Null);
+      }
+      else {
+        EXPECT_EQ(subchip.GetValue(samp, line), chip.GetValue(chipSamp, chipLine));
+      }
+    }
+  }
+
+  // Entirely outside of the chip
+  chip.Extract(20, 20, subchip);
+  EXPECT_FALSE(subchip.IsValid(0.1));
+}
+
+
+TEST(Chip, ValidPercentAndStatistics) {
+  Chip chip(5, 2);
+  fillChip(chip);
+  chip.SetValue(2, 1, Null);
+  chip.SetValue(4, 2, Lrs);
+
+  EXPECT_TRUE(chip.IsValid(80.0));
+  EXPECT_FALSE(chip.IsValid(80.1));
+
+  Statistics *stats = chip.Statistics();
+  EXPECT_EQ(stats->TotalPixels(), 10);
+  EXPECT_EQ(stats->ValidPixels(), 8);
+  EXPECT_EQ(stats->Minimum(), 101.0);
+  EXPECT_EQ(stats->Maximum(), 205.0);
+  delete stats;
+}
+
+
+/**
+ * Reads a loaded chip from the cube one interpolator window at a time, as Chip::Read did
+ * before it read the area under the chip at once, and compares the pixels.
+ */
+static void compareWindowRead(Chip &chip, Cube &cube) {
+  Interpolator interp(chip.GetReadInterpolator());
+  Portal port(interp.Samples(), interp.Lines(), cube.pixelType(),
+              interp.HotSample(), interp.HotLine());
+
+  for (int line = 1; line <= chip.Lines(); line++) {
+    for (int samp = 1; samp <= chip.Samples(); samp++) {
+      chip.SetChipPosition(samp, line);
+      double expected = Isis::Null;
+      if (chip.CubeSample() >= 0.5 && chip.CubeLine() >= 0.5 &&
+          chip.CubeSample() <= cube.sampleCount() + 0.5 &&
+          chip.CubeLine() <= cube.lineCount() + 0.5) {
+        port.SetPosition(chip.CubeSample(), chip.CubeLine(), 1);
+        cube.read(port);
+        expected = interp.Interpolate(chip.CubeSample(), chip.CubeLine(), port.DoubleBuffer());
+      }
+
+      double value = chip.GetValue(samp, line);
+      if (IsSpecial(expected)) {
+        EXPECT_EQ(value, expected) << samp << ", " << line;
+      }
+      else {
+        EXPECT_DOUBLE_EQ(value, expected) << samp << ", " << line;
+      }
+    }
+  }
+}
+
+
+TEST_F(TempTestingFiles, ChipReadMatchesWindowRead) {
+  Cube cube;
+  cube.setDimensions(60, 50, 1);
+  cube.create(tempDir.path() + "/chipRead.cub");
+
+  LineManager lineManager(cube);
+  for (lineManager.begin(); !lineManager.end(); lineManager++) {
+    for (int i = 0; i < lineManager.size(); i++) {
+      int samp = i + 1;
+      int line = lineManager.Line();
+      lineManager[i] = 100.0 + 1.5 * samp + 0.25 * line + 10.0 * sin(0.3 * samp) * cos(0.2 * line);
+    }
+    cube.write(lineManager);
+  }
+
+  // Inside the cube
+  Chip inside(21, 17);
+  inside.TackCube(30.0, 25.0);
+  inside.Load(cube, 30.0, 1.0);
+  compareWindowRead(inside, cube);
+
+  // Partly off the edge of the cube
+  Chip edge(21, 17);
+  edge.TackCube(3.0, 4.0);
+  edge.Load(cube, 10.0, 1.2);
+  compareWindowRead(edge, cube);
+
+  // Scaled so the area under the chip is too large to read at once
+  Chip scaled(21, 17);
+  scaled.TackCube(30.0, 25.0);
+  scaled.Load(cube, 0.0, 4.0);
+  compareWindowRead(scaled, cube);
+
+  // With another interpolator
+  Chip bilinear(21, 17);
+  bilinear.SetReadInterpolator(Interpolator::BiLinearType);
+  bilinear.TackCube(30.5, 24.25);
+  bilinear.Load(cube, 45.0, 0.8);
+  compareWindowRead(bilinear, cube);
+}
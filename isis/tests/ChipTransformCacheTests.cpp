@@ -0,0 +1,52 @@
+#include "Affine.h"
+#include "ChipTransformCache.h"
+#include "IException.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+TEST(ChipTransformCache, FindsTransformsInTheSameCell) {
+  ChipTransformCache cache(32.0);
+  EXPECT_EQ(cache.cellSize(), 32.0);
+
+  Affine affine;
+  affine.Rotate(15.0);
+  affine.Scale(2.0);
+  cache.insert("search.cub|pattern.cub", 40.0, 70.0, affine.Forward());
+
+  Affine::AMatrix found;
+  EXPECT_TRUE(cache.find("search.cub|pattern.cub", 63.9, 64.0, found));
+  Affine::AMatrix forward = affine.Forward();
+  for (int row = 0; row < 3; row++) {
+    for (int col = 0; col < 3; col++) {
+      EXPECT_EQ(found[row][col], forward[row][col]);
+    }
+  }
+
+  // Another cell and another pair of images
+  EXPECT_FALSE(cache.find("search.cub|pattern.cub", 64.0, 64.0, found));
+  EXPECT_FALSE(cache.find("other.cub|pattern.cub", 40.0, 70.0, found));
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(cache.misses(), 2);
+
+  cache.clear();
+  EXPECT_FALSE(cache.find("search.cub|pattern.cub", 40.0, 70.0, found));
+}
+
+
+TEST(ChipTransformCache, StoresCopies) {
+  ChipTransformCache cache;
+  Affine::AMatrix matrix = Affine::getIdentity();
+  cache.insert("pair", 1.0, 1.0, matrix);
+  matrix[0][0] = 5.0;
+
+  Affine::AMatrix found;
+  ASSERT_TRUE(cache.find("pair", 1.0, 1.0, found));
+  EXPECT_EQ(found[0][0], 1.0);
+}
+
+
+TEST(ChipTransformCache, InvalidCellSize) {
+  EXPECT_THROW(ChipTransformCache(0.0), IException);
+}
@@ -0,0 +1,93 @@
+#include <vector>
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+
+#include "ConcurrentLoop.h"
+#include "IException.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+TEST(ConcurrentLoop, SingleThreadInOrder) {
+  std::vector<int> order;
+  int done = 0;
+  ConcurrentLoop::run(5, 1, [&](int i) {
+    EXPECT_EQ(order.size(), (size_t) done);
+    order.push_back(i);
+  }, [&]() { done++; });
+
+  ASSERT_EQ(order.size(), (size_t) 5);
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(order[i], i);
+  }
+  EXPECT_EQ(done, 5);
+}
+
+
+TEST(ConcurrentLoop, EveryIndexOnce) {
+  std::vector<char> visits(1000, 0);
+  QAtomicInt calls(0);
+  int done = 0;
+  ConcurrentLoop::run(visits.size(), 4, [&](int i) {
+    visits[i]++;
+    calls.fetchAndAddOrdered(1);
+  }, [&]() { done++; });
+
+  EXPECT_EQ(calls.load(), 1000);
+  EXPECT_EQ(done, 1000);
+  for (size_t i = 0; i < visits.size(); i++) {
+    EXPECT_EQ(visits[i], 1) << "Index " << i;
+  }
+}
+
+
+TEST(ConcurrentLoop, UsesUpToThreads) {
+  QMutex mutex;
+  QAtomicInt running(0);
+  int mostRunning = 0;
+  ConcurrentLoop::run(40, 3, [&](int i) {
+    int now = running.fetchAndAddOrdered(1) + 1;
+    {
+      QMutexLocker lock(&mutex);
+      mostRunning = qMax(mostRunning, now);
+    }
+    QThread::msleep(2);
+    running.fetchAndAddOrdered(-1);
+  });
+
+  EXPECT_GE(mostRunning, 1);
+  EXPECT_LE(mostRunning, 3);
+}
+
+
+TEST(ConcurrentLoop, NoIndexes) {
+  int calls = 0;
+  ConcurrentLoop::run(0, 4, [&](int i) { calls++; }, [&]() { calls++; });
+  EXPECT_EQ(calls, 0);
+}
+
+
+TEST(ConcurrentLoop, FirstExceptionRethrown) {
+  for (int threads = 1; threads <= 4; threads += 3) {
+    QAtomicInt calls(0);
+    try {
+      ConcurrentLoop::run(1000, threads, [&](int i) {
+        calls.fetchAndAddOrdered(1);
+        if (i == 10) {
+          throw IException(IException::Programmer, "Index 10 failed", _FILEINFO_);
+        }
+      });
+      FAIL() << "Expected the exception thrown by the work";
+    }
+    catch (IException &e) {
+      EXPECT_TRUE(e.toString().contains("Index 10 failed")) << e.toString().toStdString();
+    }
+
+    // No more indexes are started after the failure
+    EXPECT_LT(calls.load(), 1000);
+  }
+}
@@ -0,0 +1,167 @@
+#include <QList>
+#include <QString>
+#include <QVector>
+
+#include "ControlMeasure.h"
+#include "ControlNet.h"
+#include "ControlNetPointFilter.h"
+#include "ControlPoint.h"
+#include "IException.h"
+#include "TempFixtures.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+class FilterNetwork : public TempTestingFiles {
+  protected:
+    ControlNet *network;
+    QString networkFile;
+
+    void SetUp() override {
+      TempTestingFiles::SetUp();
+
+      network = new ControlNet();
+      network->SetNetworkId("FilterNetwork");
+
+      // Point i has (i % 3) + 1 measures, is ignored if i is odd, and is fixed if i % 4 == 0
+      for (int i = 0; i < 12; i++) {
+        ControlPoint *point = new ControlPoint(QString("Point%1").arg(i));
+        point->SetType(i % 4 == 0 ? ControlPoint::Fixed : ControlPoint::Free);
+        for (int j = 0; j <= i % 3; j++) {
+          ControlMeasure *measure = new ControlMeasure;
+          measure->SetCubeSerialNumber(QString("Image%1").arg(j));
+          measure->SetCoordinate(10.0, 10.0);
+          measure->SetResidual(0.1 * i, 0.0);
+          point->Add(measure);
+        }
+        point->SetIgnored(i % 2 == 1);
+        network->AddPoint(point);
+      }
+
+      networkFile = tempDir.path() + "/filter.net";
+      network->Write(networkFile);
+    }
+
+    void TearDown() override {
+      delete network;
+    }
+};
+
+
+TEST_F(FilterNetwork, EmptyFilterAcceptsAll) {
+  ControlNetPointFilter filter;
+  EXPECT_TRUE(filter.isEmpty());
+
+  QVector<bool> accepted = filter.evaluate(network->GetPoints());
+  ASSERT_EQ(accepted.size(), 12);
+  EXPECT_EQ(accepted.count(true), 12);
+}
+
+
+TEST_F(FilterNetwork, CombinedPredicates) {
+  ControlNetPointFilter filter;
+  filter.setIgnored(false);
+  filter.setPointTypes(QList<ControlPoint::PointType>() << ControlPoint::Free);
+  filter.setNumMeasuresRange(2, 3);
+
+  QVector<bool> accepted = filter.evaluate(network->GetPoints());
+  for (int i = 0; i < 12; i++) {
+    bool expected = (i % 2 == 0) && (i % 4 != 0) && (i % 3 >= 1);
+    EXPECT_EQ(accepted[i], expected) << "Point" << i;
+    EXPECT_EQ(filter.accepts(*network->GetPoint(i)), expected) << "Point" << i;
+  }
+}
+
+
+TEST_F(FilterNetwork, PointIdsAndSerialNumbers) {
+  ControlNetPointFilter idFilter;
+  idFilter.setPointIds(QList<QString>() << "point1" << "POINT5", Qt::CaseInsensitive);
+  QVector<bool> accepted = idFilter.evaluate(network->GetPoints());
+  EXPECT_EQ(accepted.count(true), 2);
+  EXPECT_TRUE(accepted[1]);
+  EXPECT_TRUE(accepted[5]);
+
+  ControlNetPointFilter serialFilter;
+  serialFilter.setCubeSerialNumbers(QList<QString>() << "Image2");
+  accepted = serialFilter.evaluate(network->GetPoints());
+  for (int i = 0; i < 12; i++) {
+    EXPECT_EQ(accepted[i], i % 3 == 2) << "Point" << i;
+  }
+}
+
+
+TEST_F(FilterNetwork, Residuals) {
+  ControlNetPointFilter filter;
+  filter.setMinimumResidual(0.75);
+
+  QVector<bool> accepted = filter.evaluate(network->GetPoints());
+  for (int i = 0; i < 12; i++) {
+    EXPECT_EQ(accepted[i], 0.1 * i >= 0.75) << "Point" << i;
+  }
+}
+
+
+TEST_F(FilterNetwork, FilteredRead) {
+  ControlNetPointFilter filter;
+  filter.setIgnored(false);
+  filter.setCubeSerialNumbers(QList<QString>() << "Image1");
+
+  ControlNet filteredNet;
+  filteredNet.ReadControl(networkFile, filter);
+
+  QList<QString> expectedIds;
+  for (int i = 0; i < 12; i++) {
+    if (i % 2 == 0 && i % 3 >= 1) {
+      expectedIds.append(QString("Point%1").arg(i));
+    }
+  }
+
+  ASSERT_EQ(filteredNet.GetNumPoints(), expectedIds.size());
+  for (int i = 0; i < expectedIds.size(); i++) {
+    EXPECT_EQ(filteredNet.GetPoint(i)->GetId().toStdString(), expectedIds[i].toStdString());
+  }
+}
+
+
+TEST_F(FilterNetwork, AcceptEditLocked) {
+  network->GetPoint(1)->SetEditLock(true);
+
+  ControlNetPointFilter filter;
+  filter.setIgnored(false);
+  filter.setAcceptEditLocked(true);
+
+  QVector<bool> accepted = filter.evaluate(network->GetPoints());
+  for (int i = 0; i < 12; i++) {
+    EXPECT_EQ(accepted[i], i % 2 == 0 || i == 1) << "Point" << i;
+  }
+}
+
+
+TEST_F(FilterNetwork, FilteredReadRejectedPoints) {
+  ControlNetPointFilter filter;
+  filter.setPointTypes(QList<ControlPoint::PointType>() << ControlPoint::Free);
+
+  ControlNet filteredNet;
+  QList<ControlNetPointFilter::PointFields> rejected;
+  filteredNet.ReadControl(networkFile, filter, &rejected);
+
+  // The fixed points, in file order
+  ASSERT_EQ(rejected.size(), 3);
+  for (int i = 0; i < rejected.size(); i++) {
+    EXPECT_EQ(rejected[i].id.toStdString(), QString("Point%1").arg(4 * i).toStdString());
+    EXPECT_EQ(rejected[i].type, ControlPoint::Fixed);
+    EXPECT_EQ(rejected[i].numMeasures, (4 * i) % 3 + 1);
+    EXPECT_FALSE(rejected[i].ignored);
+  }
+  EXPECT_EQ(filteredNet.GetNumPoints(), 9);
+}
+
+
+TEST(ControlNetPointFilter, InvalidRanges) {
+  ControlNetPointFilter filter;
+  EXPECT_THROW(filter.setNumMeasuresRange(3, 2), IException);
+  EXPECT_THROW(filter.setLatLonRange(Latitude(10, Angle::Degrees), Latitude(0, Angle::Degrees),
+                                     Longitude(0, Angle::Degrees), Longitude(10, Angle::Degrees)),
+               IException);
+}
@@ -0,0 +1,173 @@
+#include <QString>
+
+#include "ControlMeasure.h"
+#include "ControlNet.h"
+#include "ControlNetStatistics.h"
+#include "ControlNetVitals.h"
+#include "ControlPoint.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+class EditedNetwork : public ::testing::Test {
+  protected:
+    ControlNet *network;
+
+    void SetUp() override {
+      network = new ControlNet();
+      network->SetNetworkId("EditedNetwork");
+
+      for (int i = 0; i < 10; i++) {
+        network->AddPoint( createPoint(QString("Point%1").arg(i), i % 3 + 1) );
+      }
+    }
+
+    void TearDown() override {
+      delete network;
+    }
+
+    ControlPoint *createPoint(QString id, int numMeasures) {
+      ControlPoint *point = new ControlPoint(id);
+      point->SetType(ControlPoint::Free);
+      for (int j = 0; j < numMeasures; j++) {
+        ControlMeasure *measure = new ControlMeasure;
+        measure->SetCubeSerialNumber(QString("Image%1").arg(j));
+        measure->SetCoordinate(10.0 * j, 20.0);
+        measure->SetResidual(0.5 * j, 0.25);
+        point->Add(measure);
+      }
+      return point;
+    }
+
+    void editNetwork() {
+      network->GetPoint("Point0")->SetIgnored(true);
+      network->GetPoint("Point1")->SetType(ControlPoint::Fixed);
+      network->GetPoint("Point2")->GetMeasure(0)->SetIgnored(true);
+      network->GetPoint("Point3")->SetEditLock(true);
+
+      ControlMeasure *measure = new ControlMeasure;
+      measure->SetCubeSerialNumber("Image3");
+      measure->SetCoordinate(5.0, 5.0);
+      measure->SetResidual(3.0, 4.0);
+      network->GetPoint("Point4")->Add(measure);
+
+      network->GetPoint("Point5")->Delete("Image1");
+      network->DeletePoint("Point8");
+      network->AddPoint( createPoint("NewPoint", 4) );
+    }
+};
+
+
+TEST_F(EditedNetwork, StatisticsFollowEdits) {
+  ControlNetStatistics trackedStats(network);
+  double originalMaxResidual = trackedStats.GetMaximumResidual();
+
+  editNetwork();
+
+  ControlNetStatistics freshStats(network);
+
+  EXPECT_EQ(trackedStats.NumValidPoints(), freshStats.NumValidPoints());
+  EXPECT_EQ(trackedStats.NumIgnoredPoints(), freshStats.NumIgnoredPoints());
+  EXPECT_EQ(trackedStats.NumFixedPoints(), freshStats.NumFixedPoints());
+  EXPECT_EQ(trackedStats.NumConstrainedPoints(), freshStats.NumConstrainedPoints());
+  EXPECT_EQ(trackedStats.NumFreePoints(), freshStats.NumFreePoints());
+  EXPECT_EQ(trackedStats.NumEditLockedPoints(), freshStats.NumEditLockedPoints());
+  EXPECT_EQ(trackedStats.NumMeasures(), freshStats.NumMeasures());
+  EXPECT_EQ(trackedStats.NumValidMeasures(), freshStats.NumValidMeasures());
+  EXPECT_EQ(trackedStats.NumIgnoredMeasures(), freshStats.NumIgnoredMeasures());
+
+  EXPECT_EQ(trackedStats.NumFixedPoints(), 1);
+  EXPECT_EQ(trackedStats.NumIgnoredPoints(), 1);
+  EXPECT_EQ(trackedStats.NumEditLockedPoints(), 1);
+
+  EXPECT_DOUBLE_EQ(trackedStats.GetMaximumResidual(), 5.0);
+  EXPECT_DOUBLE_EQ(trackedStats.GetMaximumResidual(), freshStats.GetMaximumResidual());
+  EXPECT_NE(trackedStats.GetMaximumResidual(), originalMaxResidual);
+}
+
+
+TEST_F(EditedNetwork, StatisticsFollowMeasureLocks) {
+  ControlNetStatistics trackedStats(network);
+  EXPECT_EQ(trackedStats.NumEditLockedMeasures(), 0);
+
+  // Point5 has measures on Image0, Image1 and Image2, Point7 on Image0 and Image1
+  network->GetPoint("Point5")->GetMeasure("Image0")->SetEditLock(true);
+  network->GetPoint("Point5")->GetMeasure("Image2")->SetEditLock(true);
+  network->GetPoint("Point7")->GetMeasure("Image1")->SetEditLock(true);
+  EXPECT_EQ(trackedStats.NumEditLockedMeasures(), 3);
+
+  network->GetPoint("Point5")->GetMeasure("Image0")->SetEditLock(false);
+  network->GetPoint("Point5")->GetMeasure("Image0")->SetEditLock(false);
+  EXPECT_EQ(trackedStats.NumEditLockedMeasures(), 2);
+
+  // A locked measure can not be deleted, so nothing changes
+  EXPECT_EQ(network->GetPoint("Point5")->Delete("Image2"), ControlMeasure::MeasureLocked);
+  EXPECT_EQ(network->GetPoint("Point5")->GetNumMeasures(), 3);
+  EXPECT_EQ(trackedStats.NumEditLockedMeasures(), 2);
+  EXPECT_EQ(trackedStats.NumMeasures(), ControlNetStatistics(network).NumMeasures());
+
+  // Once unlocked it is deleted and no longer counted
+  network->GetPoint("Point5")->GetMeasure("Image2")->SetEditLock(false);
+  EXPECT_EQ(network->GetPoint("Point5")->Delete("Image2"), ControlMeasure::Success);
+  EXPECT_EQ(trackedStats.NumEditLockedMeasures(), 1);
+
+  // Deleting a point removes its locked measures
+  network->DeletePoint("Point7");
+
+  ControlNetStatistics freshStats(network);
+  EXPECT_EQ(trackedStats.NumEditLockedMeasures(), 0);
+  EXPECT_EQ(trackedStats.NumEditLockedMeasures(), freshStats.NumEditLockedMeasures());
+  EXPECT_EQ(trackedStats.NumMeasures(), freshStats.NumMeasures());
+  EXPECT_EQ(trackedStats.NumValidMeasures(), freshStats.NumValidMeasures());
+  EXPECT_EQ(trackedStats.NumIgnoredMeasures(), freshStats.NumIgnoredMeasures());
+}
+
+
+TEST_F(EditedNetwork, VitalsFollowEdits) {
+  ControlNetVitals trackedVitals(network);
+
+  editNetwork();
+
+  ControlNetVitals freshVitals(network);
+
+  EXPECT_EQ(trackedVitals.numPoints(), freshVitals.numPoints());
+  EXPECT_EQ(trackedVitals.numIgnoredPoints(), freshVitals.numIgnoredPoints());
+  EXPECT_EQ(trackedVitals.numLockedPoints(), freshVitals.numLockedPoints());
+  EXPECT_EQ(trackedVitals.numFixedPoints(), freshVitals.numFixedPoints());
+  EXPECT_EQ(trackedVitals.numFreePoints(), freshVitals.numFreePoints());
+  EXPECT_EQ(trackedVitals.numMeasures(), freshVitals.numMeasures());
+  EXPECT_EQ(trackedVitals.numIslands(), freshVitals.numIslands());
+  for (int threshold = 1; threshold < 6; threshold++) {
+    EXPECT_EQ(trackedVitals.numPointsBelowMeasureThreshold(threshold),
+              freshVitals.numPointsBelowMeasureThreshold(threshold)) << threshold;
+    EXPECT_EQ(trackedVitals.numImagesBelowMeasureThreshold(threshold),
+              freshVitals.numImagesBelowMeasureThreshold(threshold)) << threshold;
+    EXPECT_EQ(trackedVitals.numImagesBelowMeasureThreshold(threshold),
+              trackedVitals.getImagesBelowMeasureThreshold(threshold).size()) << threshold;
+  }
+  EXPECT_EQ(trackedVitals.getStatus().toStdString(), freshVitals.getStatus().toStdString());
+}
+
+
+TEST_F(EditedNetwork, VitalsStatusFollowsIslands) {
+  ControlNetVitals vitals(network);
+  EXPECT_EQ(vitals.numIslands(), 1);
+  EXPECT_NE(vitals.getStatus().toStdString(), "Broken!");
+
+  ControlPoint *isolatedPoint = new ControlPoint("IsolatedPoint");
+  ControlMeasure *measure = new ControlMeasure;
+  measure->SetCubeSerialNumber("IsolatedImage");
+  isolatedPoint->Add(measure);
+  network->AddPoint(isolatedPoint);
+
+  EXPECT_EQ(vitals.numIslands(), 2);
+  EXPECT_EQ(vitals.getIslands().size(), 2);
+  EXPECT_EQ(vitals.getStatus().toStdString(), "Broken!");
+  EXPECT_EQ(vitals.getStatusDetails().toStdString(), "This network has 2 islands.");
+
+  ControlNetVitals freshVitals(network);
+  EXPECT_EQ(vitals.getStatus().toStdString(), freshVitals.getStatus().toStdString());
+  EXPECT_EQ(vitals.getStatusDetails().toStdString(),
+            freshVitals.getStatusDetails().toStdString());
+}
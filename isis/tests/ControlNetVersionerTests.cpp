@@ -0,0 +1,58 @@
+#include <QString>
+
+#include "ControlMeasure.h"
+#include "ControlNet.h"
+#include "ControlPoint.h"
+#include "TempFixtures.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+TEST_F(TempTestingFiles, ControlNetVersionerReadPreservesPointOrder) {
+  ControlNet net;
+  net.SetNetworkId("ReadOrder");
+  net.SetUserName("TestUser");
+
+  // Use enough points that the read is split into several chunks
+  int numPoints = 1000;
+  for (int i = 0; i < numPoints; i++) {
+    ControlPoint *point = new ControlPoint(QString("Point%1").arg(i, 4, 10, QChar('0')));
+    point->SetType(ControlPoint::Free);
+    for (int j = 0; j < 3; j++) {
+      ControlMeasure *measure = new ControlMeasure;
+      measure->SetCubeSerialNumber(QString("Image%1").arg(j));
+      measure->SetCoordinate(i + 0.5, j + 0.25);
+      point->Add(measure);
+    }
+    net.AddPoint(point);
+  }
+
+  QString netFile = tempDir.path() + "/readOrder.net";
+  net.Write(netFile);
+
+  ControlNet readNet(netFile);
+  ASSERT_EQ(readNet.GetNumPoints(), numPoints);
+  EXPECT_EQ(readNet.GetNetworkId().toStdString(), "ReadOrder");
+
+  for (int i = 0; i < numPoints; i++) {
+    ControlPoint *point = readNet.GetPoint(i);
+    EXPECT_EQ(point->GetId().toStdString(),
+              QString("Point%1").arg(i, 4, 10, QChar('0')).toStdString());
+    ASSERT_EQ(point->GetNumMeasures(), 3);
+    EXPECT_DOUBLE_EQ(point->GetMeasure(0)->GetSample(), i + 0.5);
+    EXPECT_DOUBLE_EQ(point->GetMeasure(2)->GetLine(), 2.25);
+  }
+}
+
+
+TEST_F(TempTestingFiles, ControlNetVersionerReadEmptyNetwork) {
+  ControlNet net;
+  net.SetNetworkId("Empty");
+
+  QString netFile = tempDir.path() + "/empty.net";
+  net.Write(netFile);
+
+  ControlNet readNet(netFile);
+  EXPECT_EQ(readNet.GetNumPoints(), 0);
+}
@@ -0,0 +1,172 @@
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include "Brick.h"
+#include "Cube.h"
+#include "Equalization.h"
+#include "FileList.h"
+#include "FileName.h"
+#include "IException.h"
+#include "LeastSquares.h"
+#include "OverlapNormalization.h"
+#include "OverlapStatistics.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "TempFixtures.h"
+#include "TestUtilities.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// Create a 20x20 projected cube whose upper left corner is at the given projection x, with
+// DNs offset by the given base
+static QString createMappedCube(QString path, double upperLeftX, double base) {
+  Cube cube;
+  cube.setDimensions(20, 20, 1);
+  cube.create(path);
+
+  PvlGroup mapping("Mapping");
+  mapping += PvlKeyword("ProjectionName", "Equirectangular");
+  mapping += PvlKeyword("CenterLongitude", "0.0", "degrees");
+  mapping += PvlKeyword("CenterLatitude", "0.0", "degrees");
+  mapping += PvlKeyword("TargetName", "Mars");
+  mapping += PvlKeyword("EquatorialRadius", "3396190.0", "meters");
+  mapping += PvlKeyword("PolarRadius", "3376200.0", "meters");
+  mapping += PvlKeyword("LatitudeType", "Planetocentric");
+  mapping += PvlKeyword("LongitudeDirection", "PositiveEast");
+  mapping += PvlKeyword("LongitudeDomain", "180", "degrees");
+  mapping += PvlKeyword("MinimumLatitude", "-10.0", "degrees");
+  mapping += PvlKeyword("MaximumLatitude", "10.0", "degrees");
+  mapping += PvlKeyword("MinimumLongitude", "-10.0", "degrees");
+  mapping += PvlKeyword("MaximumLongitude", "10.0", "degrees");
+  mapping += PvlKeyword("UpperLeftCornerX", toString(upperLeftX), "meters");
+  mapping += PvlKeyword("UpperLeftCornerY", "0.0", "meters");
+  mapping += PvlKeyword("PixelResolution", "1000.0", "meters/pixel");
+  cube.putGroup(mapping);
+
+  Brick brick(20, 20, 1, cube.pixelType());
+  brick.SetBasePosition(1, 1, 1);
+  for (int i = 0; i < brick.size(); i++) {
+    brick[i] = base + (i % 7);
+  }
+  cube.write(brick);
+  cube.close();
+
+  return path;
+}
+
+
+// Write the list of cubes and return its path
+static QString writeCubeList(QString path, const QStringList &cubes) {
+  FileList list;
+  foreach (QString cube, cubes) {
+    list.append(FileName(cube));
+  }
+  list.write(path);
+  return path;
+}
+
+
+// Calculate the equalization statistics with the given number of threads and return the
+// written statistics
+static QString calculate(QString cubeListPath, QString outStatsPath, int threads) {
+  int originalThreads = QThreadPool::globalInstance()->maxThreadCount();
+  QThreadPool::globalInstance()->setMaxThreadCount(threads);
+
+  try {
+    Equalization equalizer(OverlapNormalization::Both, cubeListPath);
+    equalizer.calculateStatistics(100.0, 10, false, LeastSquares::SPARSE);
+    equalizer.write(outStatsPath);
+  }
+  catch (IException &) {
+    QThreadPool::globalInstance()->setMaxThreadCount(originalThreads);
+    throw;
+  }
+  QThreadPool::globalInstance()->setMaxThreadCount(originalThreads);
+
+  QFile stats(outStatsPath);
+  stats.open(QIODevice::ReadOnly);
+  return QString(stats.readAll());
+}
+
+
+TEST_F(TempTestingFiles, EqualizationParallelOverlapsMatchSerial) {
+  // A strip of images where each image only overlaps its neighbors, so most pairs have
+  // disjoint extents
+  QStringList cubes;
+  for (int i = 0; i < 5; i++) {
+    cubes.append(createMappedCube(tempDir.path() + "/strip" + toString(i) + ".cub",
+                                  i * 15000.0, 100.0 + 10.0 * i));
+  }
+  QString cubeListPath = writeCubeList(tempDir.path() + "/cubes.lis", cubes);
+
+  QString serial = calculate(cubeListPath, tempDir.path() + "/serial.pvl", 1);
+  QString parallel = calculate(cubeListPath, tempDir.path() + "/parallel.pvl", 4);
+  EXPECT_EQ(serial.toStdString(), parallel.toStdString());
+
+  // Every pair that overlaps is gathered, even though the disjoint pairs are skipped
+  QStringList expectedPairs;
+  for (int i = 0; i < cubes.size(); i++) {
+    for (int j = i + 1; j < cubes.size(); j++) {
+      Cube cube1(cubes[i]);
+      Cube cube2(cubes[j]);
+      OverlapStatistics oStats(cube1, cube2, "", 100.0, false);
+      if (oStats.HasOverlap()) {
+        expectedPairs.append(FileName(cubes[i]).name() + " " + FileName(cubes[j]).name());
+      }
+    }
+  }
+  ASSERT_EQ(expectedPairs.size(), 4);
+
+  Pvl results(tempDir.path() + "/parallel.pvl");
+  QStringList pairs;
+  for (int o = 0; o < results.objects(); o++) {
+    PvlObject &oStats = results.object(o);
+    if (oStats.isNamed("OverlapStatistics")) {
+      pairs.append(oStats["File1"][0] + " " + oStats["File2"][0]);
+    }
+  }
+  EXPECT_PRED_FORMAT2(AssertQStringsEqual, pairs.join(", "), expectedPairs.join(", "));
+
+  PvlGroup &general = results.findObject("EqualizationInformation").findGroup("General");
+  EXPECT_EQ(toInt(general["TotalOverlaps"][0]), 4);
+  EXPECT_EQ(toInt(general["ValidOverlaps"][0]), 4);
+  EXPECT_EQ(general["NonOverlaps"].size(), 0);
+  EXPECT_PRED_FORMAT2(AssertQStringsEqual, general["HasCorrections"][0], "true");
+}
+
+
+TEST_F(TempTestingFiles, EqualizationDisjointImageReported) {
+  // Two overlapping images and one far away from both
+  QStringList cubes;
+  cubes.append(createMappedCube(tempDir.path() + "/left.cub", 0.0, 100.0));
+  cubes.append(createMappedCube(tempDir.path() + "/right.cub", 15000.0, 110.0));
+  cubes.append(createMappedCube(tempDir.path() + "/far.cub", 200000.0, 120.0));
+  QString cubeListPath = writeCubeList(tempDir.path() + "/cubes.lis", cubes);
+
+  for (int threads = 1; threads <= 4; threads += 3) {
+    Equalization equalizer(OverlapNormalization::Both, cubeListPath);
+    int originalThreads = QThreadPool::globalInstance()->maxThreadCount();
+    QThreadPool::globalInstance()->setMaxThreadCount(threads);
+    try {
+      equalizer.calculateStatistics(100.0, 10, false, LeastSquares::SPARSE);
+      QThreadPool::globalInstance()->setMaxThreadCount(originalThreads);
+      FAIL() << "Expected an exception for the non-overlapping image";
+    }
+    catch (IException &e) {
+      QThreadPool::globalInstance()->setMaxThreadCount(originalThreads);
+      EXPECT_TRUE(e.toString().contains("do not overlap")) << e.toString().toStdString();
+    }
+
+    // The disjoint image is still reported as a non-overlap
+    PvlGroup general = equalizer.getResults();
+    ASSERT_EQ(general["NonOverlaps"].size(), 1);
+    EXPECT_PRED_FORMAT2(AssertQStringsEqual, general["NonOverlaps"][0], cubes[2]);
+    EXPECT_EQ(toInt(general["TotalOverlaps"][0]), 1);
+  }
+}
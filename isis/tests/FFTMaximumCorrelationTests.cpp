@@ -0,0 +1,109 @@
+#include <cmath>
+
+#include "AutoReg.h"
+#include "AutoRegFactory.h"
+#include "Chip.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+static Pvl registrationPvl(QString algorithm, QString reductionFactor) {
+  PvlGroup alg("Algorithm");
+  alg += PvlKeyword("Name", algorithm);
+  alg += PvlKeyword("Tolerance", "0.3");
+  alg += PvlKeyword("SubpixelAccuracy", "True");
+  alg += PvlKeyword("ReductionFactor", reductionFactor);
+
+  PvlGroup pchip("PatternChip");
+  pchip += PvlKeyword("Samples", "15");
+  pchip += PvlKeyword("Lines", "13");
+  pchip += PvlKeyword("ValidPercent", "60");
+
+  PvlGroup schip("SearchChip");
+  schip += PvlKeyword("Samples", "41");
+  schip += PvlKeyword("Lines", "37");
+  schip += PvlKeyword("SubchipValidPercent", "70");
+
+  PvlObject o("AutoRegistration");
+  o.addGroup(alg);
+  o.addGroup(pchip);
+  o.addGroup(schip);
+
+  Pvl pvl;
+  pvl.addObject(o);
+  return pvl;
+}
+
+
+static void loadChips(AutoReg &ar, bool specialPixels) {
+  Chip &search = *ar.SearchChip();
+  for (int line = 1; line <= search.Lines(); line++) {
+    for (int samp = 1; samp <= search.Samples(); samp++) {
+      double dn = 500.0 + 80.0 * sin(0.37 * samp) * cos(0.23 * line) +
+                  ((samp * 7 + line * 13) % 11);
+      search.SetValue(samp, line, dn);
+    }
+  }
+
+  // The pattern is a brightened copy of part of the search chip
+  Chip &pattern = *ar.PatternChip();
+  for (int line = 1; line <= pattern.Lines(); line++) {
+    for (int samp = 1; samp <= pattern.Samples(); samp++) {
+      pattern.SetValue(samp, line, 2.0 * search.GetValue(samp + 17, line + 9) + 3.0);
+    }
+  }
+
+  if (specialPixels) {
+    pattern.SetValue(3, 4, Null);
+    pattern.SetValue(11, 2, Lrs);
+    for (int line = 1; line <= 6; line++) {
+      for (int samp = 30; samp <= 36; samp++) {
+        search.SetValue(samp, line, Null);
+      }
+    }
+    search.SetValue(20, 15, His);
+  }
+}
+
+
+static void compareRegistrations(QString reductionFactor, bool specialPixels) {
+  Pvl directPvl = registrationPvl("MaximumCorrelation", reductionFactor);
+  Pvl fftPvl = registrationPvl("FFTMaximumCorrelation", reductionFactor);
+  AutoReg *direct = AutoRegFactory::Create(directPvl);
+  AutoReg *fft = AutoRegFactory::Create(fftPvl);
+
+  loadChips(*direct, specialPixels);
+  loadChips(*fft, specialPixels);
+
+  AutoReg::RegisterStatus directStatus = direct->Register();
+  AutoReg::RegisterStatus fftStatus = fft->Register();
+
+  EXPECT_EQ(fftStatus, directStatus);
+  EXPECT_EQ(fft->GoodnessOfFit(), direct->GoodnessOfFit());
+  EXPECT_EQ(fft->ChipSample(), direct->ChipSample());
+  EXPECT_EQ(fft->ChipLine(), direct->ChipLine());
+  EXPECT_EQ(fft->AlgorithmName().toStdString(), "FFTMaximumCorrelation");
+
+  delete direct;
+  delete fft;
+}
+
+
+TEST(FFTMaximumCorrelation, MatchesMaximumCorrelation) {
+  compareRegistrations("1", false);
+}
+
+
+TEST(FFTMaximumCorrelation, MatchesMaximumCorrelationWithSpecialPixels) {
+  compareRegistrations("1", true);
+}
+
+
+TEST(FFTMaximumCorrelation, MatchesMaximumCorrelationWithReduction) {
+  compareRegistrations("2", true);
+}
@@ -0,0 +1,118 @@
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+
+#include <opencv2/opencv.hpp>
+
+#include "FeatureCache.h"
+#include "ImageSource.h"
+#include "MatchImage.h"
+#include "TempFixtures.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+static Keypoints testKeypoints(int count) {
+  Keypoints keypoints;
+  for (int i = 0; i < count; i++) {
+    keypoints.push_back(cv::KeyPoint(1.5f * i, 100.25f - i, 7.0f + i, 10.0f * i,
+                                     0.01f * i, i % 4, i));
+  }
+  return keypoints;
+}
+
+
+static void writeFile(const QString &name, const QByteArray &contents) {
+  QFile file(name);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+  ASSERT_EQ(file.write(contents), contents.size());
+}
+
+
+TEST_F(TempTestingFiles, FeatureCacheRoundTrip) {
+  FeatureCache cache(tempDir.path() + "/features");
+
+  Keypoints keypoints = testKeypoints(20);
+  Descriptors floatDescriptors(20, 128, CV_32F);
+  cv::randu(floatDescriptors, 0.0, 1.0);
+  Descriptors binaryDescriptors(20, 64, CV_8U);
+  cv::randu(binaryDescriptors, 0, 256);
+
+  cache.save("float", keypoints, floatDescriptors);
+  cache.save("binary", keypoints, binaryDescriptors);
+
+  // Only complete entries are left in the cache
+  QDir cacheDir(cache.path());
+  EXPECT_EQ(cacheDir.entryList(QStringList("*.ffkd"), QDir::Files).size(), 2);
+  EXPECT_TRUE(cacheDir.entryList(QStringList("*.tmp"), QDir::Files).isEmpty());
+
+  QList<Descriptors> saved;
+  saved << floatDescriptors << binaryDescriptors;
+  QStringList keys;
+  keys << "float" << "binary";
+  for (int k = 0; k < keys.size(); k++) {
+    Keypoints loadedKeypoints;
+    Descriptors loadedDescriptors;
+    ASSERT_TRUE(cache.load(keys[k], loadedKeypoints, loadedDescriptors)) << keys[k].toStdString();
+
+    ASSERT_EQ(loadedKeypoints.size(), keypoints.size());
+    for (unsigned int i = 0; i < keypoints.size(); i++) {
+      EXPECT_EQ(loadedKeypoints[i].pt.x, keypoints[i].pt.x);
+      EXPECT_EQ(loadedKeypoints[i].pt.y, keypoints[i].pt.y);
+      EXPECT_EQ(loadedKeypoints[i].size, keypoints[i].size);
+      EXPECT_EQ(loadedKeypoints[i].angle, keypoints[i].angle);
+      EXPECT_EQ(loadedKeypoints[i].response, keypoints[i].response);
+      EXPECT_EQ(loadedKeypoints[i].octave, keypoints[i].octave);
+      EXPECT_EQ(loadedKeypoints[i].class_id, keypoints[i].class_id);
+    }
+
+    ASSERT_EQ(loadedDescriptors.type(), saved[k].type());
+    ASSERT_EQ(loadedDescriptors.rows, saved[k].rows);
+    ASSERT_EQ(loadedDescriptors.cols, saved[k].cols);
+    EXPECT_EQ(cv::countNonZero(loadedDescriptors.reshape(1) != saved[k].reshape(1)), 0);
+  }
+
+  Keypoints missingKeypoints;
+  Descriptors missingDescriptors;
+  EXPECT_FALSE(cache.load("missing", missingKeypoints, missingDescriptors));
+}
+
+
+TEST_F(TempTestingFiles, FeatureCacheIgnoresTruncatedEntries) {
+  FeatureCache cache(tempDir.path() + "/features");
+
+  Keypoints keypoints = testKeypoints(5);
+  Descriptors descriptors(5, 32, CV_8U, cv::Scalar(7));
+  cache.save("entry", keypoints, descriptors);
+
+  QDir cacheDir(cache.path());
+  QStringList entries = cacheDir.entryList(QStringList("*.ffkd"), QDir::Files);
+  ASSERT_EQ(entries.size(), 1);
+
+  QFile entry(cacheDir.filePath(entries.first()));
+  ASSERT_TRUE(entry.resize(entry.size() - 1));
+
+  Keypoints loadedKeypoints;
+  Descriptors loadedDescriptors;
+  EXPECT_FALSE(cache.load("entry", loadedKeypoints, loadedDescriptors));
+}
+
+
+TEST_F(TempTestingFiles, FeatureCacheKeyFollowsImageFile) {
+  FeatureCache cache(tempDir.path() + "/features");
+
+  QString imageFile = tempDir.path() + "/image.png";
+  writeFile(imageFile, "first image contents");
+
+  cv::Mat pixels(10, 12, CV_8U, cv::Scalar(3));
+  MatchImage image( ImageSource(imageFile, pixels, "ImageSerial") );
+
+  QString key = cache.key(image, pixels, "brisk/brisk");
+  EXPECT_EQ(cache.key(image, pixels, "brisk/brisk"), key);
+  EXPECT_NE(cache.key(image, pixels, "orb/orb"), key);
+
+  // Rewriting the image changes the key even though its serial number is the same
+  writeFile(imageFile, "second, longer image contents");
+  EXPECT_NE(cache.key(image, pixels, "brisk/brisk"), key);
+}
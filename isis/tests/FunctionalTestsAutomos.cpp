@@ -5,6 +5,7 @@
 #include "TestUtilities.h"
 #include "UserInterface.h"
 #include "Histogram.h"
+#include "LineManager.h"
 
 #include "gmock/gmock.h"
 
@@ -185,3 +186,45 @@ TEST_F(DefaultCube, FunctionalTestAutomosBandSelect) {
   EXPECT_EQ(oCubeStats->ValidPixels(), 36);
   EXPECT_DOUBLE_EQ(oCubeStats->StandardDeviation(), 79.757668686375951);
 }
+
+
+TEST_F(DefaultCube, FunctionalTestAutomosTileLines) {
+  QString cubeListPath = tempDir.path() + "/newCubeList.lis";
+  FileList cubeList;
+  cubeList.append(projTestCube->fileName());
+  cubeList.append(projTestCube->fileName());
+  cubeList.write(cubeListPath);
+
+  QString linesPath = tempDir.path() + "/lines.cub";
+  QVector<QString> linesArgs = {"fromlist=" + cubeListPath, "mosaic=" + linesPath,
+                                "priority=average"};
+  UserInterface linesOptions(APP_XML, linesArgs);
+  automos(linesOptions);
+
+  QString tilesPath = tempDir.path() + "/tiles.cub";
+  QVector<QString> tilesArgs = {"fromlist=" + cubeListPath, "mosaic=" + tilesPath,
+                                "priority=average", "tilelines=4"};
+  UserInterface tilesOptions(APP_XML, tilesArgs);
+  automos(tilesOptions);
+
+  // The mosaic and its count bands are the same when the lines are placed in tiles
+  Cube linesMosaic(linesPath);
+  Cube tilesMosaic(tilesPath);
+  ASSERT_EQ(tilesMosaic.bandCount(), linesMosaic.bandCount());
+  ASSERT_EQ(tilesMosaic.lineCount(), linesMosaic.lineCount());
+
+  LineManager linesLine(linesMosaic);
+  LineManager tilesLine(tilesMosaic);
+  for (linesLine.begin(), tilesLine.begin(); !linesLine.end(); linesLine++, tilesLine++) {
+    linesMosaic.read(linesLine);
+    tilesMosaic.read(tilesLine);
+    for (int i = 0; i < linesLine.size(); i++) {
+      EXPECT_EQ(tilesLine[i], linesLine[i]) << "line " << linesLine.Line() << " band "
+                                            << linesLine.Band() << " sample " << i + 1;
+    }
+  }
+
+  std::unique_ptr<Histogram> oCubeStats(tilesMosaic.histogram());
+  EXPECT_DOUBLE_EQ(oCubeStats->Average(), 123.5);
+  EXPECT_EQ(oCubeStats->ValidPixels(), 36);
+}
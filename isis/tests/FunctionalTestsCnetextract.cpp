@@ -1,3 +1,4 @@
+#include <QFile>
 #include <QTextStream>
 #include <QStringList>
 #include <QTemporaryFile>
@@ -440,3 +441,110 @@ TEST_F(ThreeImageNetwork, FunctionalTestCnetextractLatlon) {
   FileName noLatLonPointsFile(options.GetAsString("prefix") + "NoLatLonPoints.txt");
   EXPECT_FALSE(noLatLonPointsFile.fileExists());
 }
+
+/**
+ * Runs cnetextract on a network in memory and on the same network read from a file, where
+ * the first filters are tested while the network is read, and checks that the results match.
+ */
+static void compareFilteredRead(ControlNet &network, QString directory,
+                                QVector<QString> filterArgs, QStringList reports) {
+  QString networkFile = directory + "/filteredRead.net";
+  network.Write(networkFile);
+
+  QVector<QString> memoryArgs = filterArgs;
+  memoryArgs << "prefix=" + directory + "/memory_" << "onet=" + directory + "/memory.net";
+  UserInterface memoryOptions(APP_XML, memoryArgs);
+  Pvl memoryLog;
+  cnetextract(network, memoryOptions, &memoryLog);
+
+  QVector<QString> fileArgs = filterArgs;
+  fileArgs << "cnet=" + networkFile << "prefix=" + directory + "/file_"
+           << "onet=" + directory + "/file.net";
+  UserInterface fileOptions(APP_XML, fileArgs);
+  Pvl fileLog;
+  cnetextract(fileOptions, &fileLog);
+
+  PvlGroup &memorySummary = memoryLog.findGroup("ResultSummary");
+  PvlGroup &fileSummary = fileLog.findGroup("ResultSummary");
+  ASSERT_EQ(memorySummary.keywords(), fileSummary.keywords());
+  for (int i = 0; i < memorySummary.keywords(); i++) {
+    EXPECT_EQ(memorySummary[i].name(), fileSummary[i].name());
+    EXPECT_EQ(memorySummary[i][0], fileSummary[i][0]) << memorySummary[i].name();
+  }
+
+  ControlNet memoryNet(directory + "/memory.net");
+  ControlNet fileNet(directory + "/file.net");
+  EXPECT_EQ(memoryNet.GetPointIds(), fileNet.GetPointIds());
+  EXPECT_EQ(memoryNet.GetNumMeasures(), fileNet.GetNumMeasures());
+
+  foreach (QString report, reports) {
+    QFile memoryReport(directory + "/memory_" + report);
+    QFile fileReport(directory + "/file_" + report);
+    ASSERT_TRUE(memoryReport.open(QIODevice::ReadOnly)) << report;
+    ASSERT_TRUE(fileReport.open(QIODevice::ReadOnly)) << report;
+    EXPECT_EQ(memoryReport.readAll(), fileReport.readAll()) << report;
+  }
+}
+
+TEST_F(ThreeImageNetwork, FunctionalTestCnetextractFilteredReadPointlist) {
+  QString pointListFile = tempDir.path() + "/pointList.lis";
+  FileList pointList;
+  pointList.append("TEST0001");
+  pointList.append("test0004");
+  pointList.append("test0005");
+  pointList.write(pointListFile);
+
+  network->GetPoints()[8]->SetType(ControlPoint::Fixed);
+  network->GetPoints()[3]->SetType(ControlPoint::Fixed);
+  network->GetPoints()[0]->SetIgnored(true);
+
+  compareFilteredRead(*network, tempDir.path(),
+                      {"pointlist=" + pointListFile, "fixed=true"},
+                      {"NonListedPoints.txt", "NonFixedPoints.txt"});
+}
+
+TEST_F(ThreeImageNetwork, FunctionalTestCnetextractFilteredReadNoIgnore) {
+  QList<ControlPoint *> points = network->GetPoints();
+  points[0]->SetIgnored(true);
+  points[5]->SetIgnored(true);
+  points[1]->SetEditLock(true);
+  points[2]->SetEditLock(true);
+  points[5]->SetEditLock(true);
+  points[1]->GetMeasure(1)->SetIgnored(true);
+
+  compareFilteredRead(*network, tempDir.path(),
+                      {"noignore=true", "editlock=true"},
+                      {"IgnoredPoints.txt", "IgnoredMeasures.txt"});
+}
+
+TEST_F(ThreeImageNetwork, FunctionalTestCnetextractFilteredReadCubes) {
+  QString reducedCubeList = tempDir.path() + "/reducedCubes.lis";
+  cubeList->pop_back();
+  cubeList->pop_back();
+  cubeList->write(reducedCubeList);
+
+  compareFilteredRead(*network, tempDir.path(),
+                      {"cubes=true", "cubelist=" + reducedCubeList, "nomeasureless=true"},
+                      {"NonCubePoints.txt"});
+}
+
+TEST_F(ThreeImageNetwork, FunctionalTestCnetextractLazyReadSinglePoint) {
+  // Only the point list is tested while reading, so only the listed point is read
+  QString pointListFile = tempDir.path() + "/pointList.lis";
+  FileList pointList;
+  pointList.append("TEST0003");
+  pointList.write(pointListFile);
+
+  network->SetNetworkId("LazyExtract");
+
+  compareFilteredRead(*network, tempDir.path(),
+                      {"pointlist=" + pointListFile},
+                      {"NonListedPoints.txt"});
+
+  ControlNet fileNet(tempDir.path() + "/file.net");
+  ASSERT_EQ(fileNet.GetNumPoints(), 1);
+  EXPECT_EQ(fileNet.GetPoint(0)->GetId(), network->GetPoint("test0003")->GetId());
+  EXPECT_EQ(fileNet.GetPoint(0)->GetNumMeasures(),
+            network->GetPoint("test0003")->GetNumMeasures());
+  EXPECT_EQ(fileNet.GetNetworkId(), "LazyExtract");
+}
@@ -1,5 +1,6 @@
 #include "findfeatures.h"
 
+#include <QDir>
 #include <QTemporaryFile>
 #include <QTextStream>
 #include <QStringList>
@@ -179,6 +180,107 @@ TEST_F(ThreeImageNetwork, FunctionalTestFindfeaturesMaxPoints) {
 }
 
 
+TEST_F(ThreeImageNetwork, FunctionalTestFindfeaturesFeatureCache) {
+  QString cacheDir = tempDir.path() + "/features";
+  QVector<QString> args = {"algorithm=brisk/brisk",
+                           "match=" + tempDir.path() + "/cube3.cub",
+                           "fromlist=" + twoCubeListFile,
+                           "maxpoints=5000",
+                           "epitolerance=1.0",
+                           "ratio=.65",
+                           "hmgtolerance=3.0",
+                           "featurecache=" + cacheDir,
+                           "networkid=new",
+                           "pointid=test_network_????",
+                           "target=MARS",
+                           "description=new",
+                           "debug=false"};
+
+  // The first run detects the features and saves them in the cache
+  QVector<QString> coldArgs = args;
+  coldArgs.append("onet=" + tempDir.path() + "/cold.net");
+  UserInterface coldOptions(APP_XML, coldArgs);
+  findfeatures(coldOptions);
+
+  QDir cache(cacheDir);
+  EXPECT_EQ(cache.entryList(QStringList("*.ffkd"), QDir::Files).size(), 3);
+  EXPECT_TRUE(cache.entryList(QStringList("*.tmp"), QDir::Files).isEmpty());
+
+  // The second run reads them from the cache
+  QVector<QString> cachedArgs = args;
+  cachedArgs.append("onet=" + tempDir.path() + "/cached.net");
+  UserInterface cachedOptions(APP_XML, cachedArgs);
+  findfeatures(cachedOptions);
+  EXPECT_EQ(cache.entryList(QStringList("*.ffkd"), QDir::Files).size(), 3);
+
+  ControlNet coldNetwork(coldOptions.GetFileName("ONET"));
+  ControlNet cachedNetwork(cachedOptions.GetFileName("ONET"));
+  ASSERT_EQ(coldNetwork.GetNumPoints(), 50);
+  ASSERT_EQ(cachedNetwork.GetNumPoints(), coldNetwork.GetNumPoints());
+  for (int i = 0; i < coldNetwork.GetNumPoints(); i++) {
+    ControlPoint *coldPoint = coldNetwork.GetPoint(i);
+    ControlPoint *cachedPoint = cachedNetwork.GetPoint(i);
+    EXPECT_EQ(cachedPoint->GetId().toStdString(), coldPoint->GetId().toStdString());
+    ASSERT_EQ(cachedPoint->GetNumMeasures(), coldPoint->GetNumMeasures());
+    for (int j = 0; j < coldPoint->GetNumMeasures(); j++) {
+      const ControlMeasure *coldMeasure = coldPoint->GetMeasure(j);
+      const ControlMeasure *cachedMeasure = cachedPoint->GetMeasure(j);
+      EXPECT_EQ(cachedMeasure->GetCubeSerialNumber().toStdString(),
+                coldMeasure->GetCubeSerialNumber().toStdString());
+      EXPECT_DOUBLE_EQ(cachedMeasure->GetSample(), coldMeasure->GetSample());
+      EXPECT_DOUBLE_EQ(cachedMeasure->GetLine(), coldMeasure->GetLine());
+    }
+  }
+}
+
+
+TEST_F(ThreeImageNetwork, FunctionalTestFindfeaturesThreadsMatchSerial) {
+  // Each thread detects and extracts with its own algorithms, so the
+  // network must not depend on the number of threads
+  QVector<QString> args = {"algorithm=brisk/brisk",
+                           "match=" + tempDir.path() + "/cube3.cub",
+                           "fromlist=" + twoCubeListFile,
+                           "maxpoints=5000",
+                           "epitolerance=1.0",
+                           "ratio=.65",
+                           "hmgtolerance=3.0",
+                           "networkid=new",
+                           "pointid=test_network_????",
+                           "target=MARS",
+                           "description=new",
+                           "debug=false"};
+
+  QVector<QString> serialArgs = args;
+  serialArgs.append("maxthreads=1");
+  serialArgs.append("onet=" + tempDir.path() + "/serial.net");
+  UserInterface serialOptions(APP_XML, serialArgs);
+  findfeatures(serialOptions);
+
+  QVector<QString> threadedArgs = args;
+  threadedArgs.append("maxthreads=2");
+  threadedArgs.append("onet=" + tempDir.path() + "/threaded.net");
+  UserInterface threadedOptions(APP_XML, threadedArgs);
+  findfeatures(threadedOptions);
+
+  ControlNet serialNetwork(serialOptions.GetFileName("ONET"));
+  ControlNet threadedNetwork(threadedOptions.GetFileName("ONET"));
+  ASSERT_EQ(threadedNetwork.GetNumPoints(), serialNetwork.GetNumPoints());
+  for (int i = 0; i < serialNetwork.GetNumPoints(); i++) {
+    ControlPoint *serialPoint = serialNetwork.GetPoint(i);
+    ControlPoint *threadedPoint = threadedNetwork.GetPoint(i);
+    ASSERT_EQ(threadedPoint->GetNumMeasures(), serialPoint->GetNumMeasures());
+    for (int j = 0; j < serialPoint->GetNumMeasures(); j++) {
+      const ControlMeasure *serialMeasure = serialPoint->GetMeasure(j);
+      const ControlMeasure *threadedMeasure = threadedPoint->GetMeasure(j);
+      EXPECT_EQ(threadedMeasure->GetCubeSerialNumber().toStdString(),
+                serialMeasure->GetCubeSerialNumber().toStdString());
+      EXPECT_DOUBLE_EQ(threadedMeasure->GetSample(), serialMeasure->GetSample());
+      EXPECT_DOUBLE_EQ(threadedMeasure->GetLine(), serialMeasure->GetLine());
+    }
+  }
+}
+
+
 TEST_F(ThreeImageNetwork, FunctionalTestFindfeaturesErrorListspecNoAlg) {
   QVector<QString> args = {"listspec=yes"};
   UserInterface options(APP_XML, args);
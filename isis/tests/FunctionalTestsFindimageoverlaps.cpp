@@ -1,4 +1,5 @@
 #include <iostream>
+#include <QMap>
 #include <QTemporaryFile>
 
 #include "findimageoverlaps.h"
@@ -146,3 +147,33 @@ TEST_F(ThreeImageNetwork, FunctionalTestFindimageoverlapsFullOverlap) {
   ASSERT_EQ((*poi)[0], "MGS/691204200:96/MOC-WA/RED");
   ASSERT_EQ((*poi)[1], "MGS/688540926:0/MOC-WA/RED");
 }
+
+TEST_F(ThreeImageNetwork, FunctionalTestFindimageoverlapsTiles) {
+
+  QVector<QString> args = {"OVERLAPLIST=" + tempDir.path() + "/overlaps.txt", "tiles=3"};
+  UserInterface ui(APP_XML, args);
+  FileList images;
+  images.append(FileName(cube1->fileName()));
+  images.append(FileName(cube2->fileName()));
+  findimageoverlaps(images, ui, false, nullptr);
+
+  // The overlaps are joined across the tiles, so they are the same as without tiles
+  ImageOverlapSet overlaps;
+  overlaps.ReadImageOverlaps(ui.GetFileName("OVERLAPLIST"));
+  ASSERT_EQ(overlaps.Size(), 3);
+
+  QMap<QString, double> areas;
+  for (int i = 0; i < overlaps.Size(); i++) {
+    QStringList serialNumbers;
+    for (int sn = 0; sn < overlaps[i]->Size(); sn++) {
+      serialNumbers.append((*overlaps[i])[sn]);
+    }
+    serialNumbers.sort();
+    areas.insert(serialNumbers.join(","), overlaps[i]->Polygon()->getArea());
+  }
+
+  ASSERT_EQ(areas.size(), 3);
+  EXPECT_NEAR(areas.value("MGS/688540926:0/MOC-WA/RED"), 14, 1e-10);
+  EXPECT_NEAR(areas.value("MGS/691204200:96/MOC-WA/RED"), 14, 1e-10);
+  EXPECT_NEAR(areas.value("MGS/688540926:0/MOC-WA/RED,MGS/691204200:96/MOC-WA/RED"), 36, 1e-10);
+}
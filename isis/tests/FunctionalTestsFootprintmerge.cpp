@@ -0,0 +1,73 @@
+#include <QString>
+#include <QVector>
+
+#include "footprintmerge.h"
+
+#include "FileList.h"
+#include "FileName.h"
+#include "ImagePolygon.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlObject.h"
+#include "UserInterface.h"
+
+#include "NetworkFixtures.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/footprintmerge.xml").expanded();
+
+TEST_F(ThreeImageNetwork, FunctionalTestFootprintmergeIslands) {
+  ImagePolygon poly;
+  coords = {{50, 20},
+            {50, 25},
+            {55, 25},
+            {55, 20},
+            {50, 20}};
+  poly.Create(coords);
+  cube3->write(poly);
+  cube3->reopen("rw");
+
+  QString islandsFile = tempDir.path() + "/islands.pvl";
+  QVector<QString> args = {"FROMLIST=" + cubeListFile, "MODE=FULL", "TO=" + islandsFile,
+                           "MAXTHREADS=2"};
+  UserInterface ui(APP_XML, args);
+  footprintmerge(ui);
+
+  // cube1 and cube2 overlap, cube3 is off by itself
+  Pvl islands(islandsFile);
+  PvlObject &results = islands.findObject("Results");
+  ASSERT_EQ(results.groups(), 2);
+
+  PvlGroup &first = results.findGroup("FootprintIsland_1");
+  EXPECT_EQ(int(first["NumberFiles"]), 2);
+  EXPECT_EQ(first["Files"][0], cube1->fileName());
+  EXPECT_EQ(first["Files"][1], cube2->fileName());
+
+  PvlGroup &second = results.findGroup("FootprintIsland_2");
+  EXPECT_EQ(int(second["NumberFiles"]), 1);
+  EXPECT_EQ(second["Files"][0], cube3->fileName());
+}
+
+
+TEST_F(ThreeImageNetwork, FunctionalTestFootprintmergeBrief) {
+  ImagePolygon poly;
+  coords = {{35, 10},
+            {35, 15},
+            {40, 15},
+            {40, 10},
+            {35, 10}};
+  poly.Create(coords);
+  cube3->write(poly);
+  cube3->reopen("rw");
+
+  QVector<QString> args = {"FROMLIST=" + cubeListFile};
+  UserInterface ui(APP_XML, args);
+  Pvl log;
+  footprintmerge(ui, &log);
+
+  // cube3 overlaps the corner of cube2, so every cube is in one island
+  EXPECT_FALSE(log.hasGroup("Results"));
+}
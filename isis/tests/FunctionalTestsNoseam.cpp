@@ -0,0 +1,230 @@
+#include "noseam.h"
+
+#include <cfloat>
+
+#include <QStringList>
+
+#include "automos.h"
+
+#include "Brick.h"
+#include "CameraFixtures.h"
+#include "CubeAttribute.h"
+#include "FileList.h"
+#include "Histogram.h"
+#include "LineManager.h"
+#include "ProcessByQuickFilter.h"
+#include "QuickFilter.h"
+#include "SpecialPixel.h"
+#include "TestUtilities.h"
+#include "UserInterface.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/noseam.xml").expanded();
+static QString AUTOMOS_XML = FileName("$ISISROOT/bin/xml/automos.xml").expanded();
+
+// Create a 30x30 projected cube with its upper left corner at the given projection x and y,
+// with DNs offset by the given base
+static QString createMappedCube(QString path, double upperLeftX, double upperLeftY,
+                                double base) {
+  Cube cube;
+  cube.setDimensions(30, 30, 1);
+  cube.create(path);
+
+  PvlGroup mapping("Mapping");
+  mapping += PvlKeyword("ProjectionName", "Equirectangular");
+  mapping += PvlKeyword("CenterLongitude", "0.0", "degrees");
+  mapping += PvlKeyword("CenterLatitude", "0.0", "degrees");
+  mapping += PvlKeyword("TargetName", "Mars");
+  mapping += PvlKeyword("EquatorialRadius", "3396190.0", "meters");
+  mapping += PvlKeyword("PolarRadius", "3376200.0", "meters");
+  mapping += PvlKeyword("LatitudeType", "Planetocentric");
+  mapping += PvlKeyword("LongitudeDirection", "PositiveEast");
+  mapping += PvlKeyword("LongitudeDomain", "180", "degrees");
+  mapping += PvlKeyword("UpperLeftCornerX", toString(upperLeftX), "meters");
+  mapping += PvlKeyword("UpperLeftCornerY", toString(upperLeftY), "meters");
+  mapping += PvlKeyword("PixelResolution", "1000.0", "meters/pixel");
+  cube.putGroup(mapping);
+
+  Brick brick(30, 30, 1, cube.pixelType());
+  brick.SetBasePosition(1, 1, 1);
+  for (int i = 0; i < brick.size(); i++) {
+    brick[i] = base + ((i * 7) % 11);
+  }
+  cube.write(brick);
+  cube.close();
+
+  return path;
+}
+
+
+// highpass with its default parameters
+static void highpassLine(Buffer &in, Buffer &out, QuickFilter &filter) {
+  for (int i = 0; i < filter.Samples(); i++) {
+    if (IsSpecial(in[i])) {
+      out[i] = in[i];
+    }
+    else {
+      out[i] = filter.Average(i);
+      if (!IsSpecial(out[i])) out[i] = in[i] - out[i];
+    }
+  }
+}
+
+
+// lowpass with its default parameters
+static void lowpassLine(Buffer &in, Buffer &out, QuickFilter &filter) {
+  for (int i = 0; i < filter.Samples(); i++) {
+    out[i] = (filter.Count(i) >= filter.MinimumPixels()) ? filter.Average(i) : in[i];
+  }
+}
+
+
+// Filter a cube into a new cube with a 5x5 boxcar
+static void filterCube(QString from, QString to,
+                       void filter(Buffer &in, Buffer &out, QuickFilter &boxcar)) {
+  ProcessByQuickFilter p;
+  CubeAttributeInput inAtt;
+  Cube *icube = p.SetInputCube(from, inAtt);
+  CubeAttributeOutput outAtt;
+  p.SetOutputCube(to, outAtt, icube->sampleCount(), icube->lineCount(), icube->bandCount());
+  p.SetFilterParameters(5, 5, -DBL_MAX, DBL_MAX, 1);
+  p.StartProcess(filter);
+  p.EndProcess();
+}
+
+
+// Mosaic a list of cubes with the automos defaults
+static void mosaicCubes(QString cubeListPath, QString mosaicPath) {
+  QVector<QString> args = {"fromlist=" + cubeListPath, "mosaic=" + mosaicPath,
+                           "matchbandbin=false"};
+  UserInterface options(AUTOMOS_XML, args);
+  automos(options);
+}
+
+TEST_F(DefaultCube, FunctionalTestNoseamSingleCube) {
+  QString cubeListPath = tempDir.path() + "/cubeList.lis";
+  FileList cubeList;
+  cubeList.append(projTestCube->fileName());
+  cubeList.write(cubeListPath);
+  QString outPath = tempDir.path() + "/noseam.cub";
+
+  QVector<QString> args = {"fromlist=" + cubeListPath, "to=" + outPath,
+                           "samples=3", "lines=3"};
+  UserInterface options(APP_XML, args);
+  noseam(options);
+
+  // With one cube, the highpass and lowpass add back up to the original mosaic
+  Cube mos(outPath);
+  EXPECT_EQ(mos.sampleCount(), 6);
+  EXPECT_EQ(mos.lineCount(), 6);
+
+  std::unique_ptr<Histogram> oCubeStats(mos.histogram());
+  EXPECT_NEAR(oCubeStats->Average(), 123.5, 1.0e-6);
+  EXPECT_NEAR(oCubeStats->Sum(), 4446, 1.0e-4);
+  EXPECT_EQ(oCubeStats->ValidPixels(), 36);
+}
+
+
+TEST_F(DefaultCube, FunctionalTestNoseamBoxcarTooBig) {
+  QString cubeListPath = tempDir.path() + "/cubeList.lis";
+  FileList cubeList;
+  cubeList.append(projTestCube->fileName());
+  cubeList.write(cubeListPath);
+  QString outPath = tempDir.path() + "/noseam.cub";
+
+  QVector<QString> args = {"fromlist=" + cubeListPath, "to=" + outPath,
+                           "samples=13", "lines=3"};
+  UserInterface options(APP_XML, args);
+
+  try {
+    noseam(options);
+    FAIL() << "Expected an exception for a boxcar wider than the cube";
+  }
+  catch (IException &e) {
+    EXPECT_THAT(e.what(), testing::HasSubstr("Boxcar width is too big"));
+  }
+}
+
+
+TEST_F(TempTestingFiles, FunctionalTestNoseamMatchesChainedApplications) {
+  // Three overlapping cubes at different brightnesses, leaving a gap in the mosaic
+  QStringList cubes;
+  cubes.append(createMappedCube(tempDir.path() + "/cube1.cub", 0.0, 0.0, 100.0));
+  cubes.append(createMappedCube(tempDir.path() + "/cube2.cub", 20000.0, -10000.0, 150.0));
+  cubes.append(createMappedCube(tempDir.path() + "/cube3.cub", 10000.0, -25000.0, 80.0));
+
+  QString cubeListPath = tempDir.path() + "/cubeList.lis";
+  FileList cubeList;
+  foreach (QString cube, cubes) {
+    cubeList.append(FileName(cube));
+  }
+  cubeList.write(cubeListPath);
+
+  QString outPath = tempDir.path() + "/noseam.cub";
+  QVector<QString> args = {"fromlist=" + cubeListPath, "to=" + outPath,
+                           "samples=5", "lines=5", "matchbandbin=false"};
+  UserInterface options(APP_XML, args);
+  noseam(options);
+
+  // The result of the automos, highpass, lowpass and algebra applications noseam used to run
+  QString originalPath = tempDir.path() + "/original.cub";
+  mosaicCubes(cubeListPath, originalPath);
+
+  QString highpassListPath = tempDir.path() + "/highpassList.lis";
+  FileList highpassList;
+  for (int i = 0; i < cubes.size(); i++) {
+    QString highpassPath = tempDir.path() + "/highpass" + toString(i + 1) + ".cub";
+    filterCube(cubes[i], highpassPath, highpassLine);
+    highpassList.append(FileName(highpassPath));
+  }
+  highpassList.write(highpassListPath);
+
+  QString highpassMosaicPath = tempDir.path() + "/highpassMosaic.cub";
+  mosaicCubes(highpassListPath, highpassMosaicPath);
+
+  QString lowpassPath = tempDir.path() + "/lowpass.cub";
+  filterCube(originalPath, lowpassPath, lowpassLine);
+
+  Cube mos(outPath);
+  Cube highpassMosaic(highpassMosaicPath);
+  Cube lowpass(lowpassPath);
+  ASSERT_EQ(mos.sampleCount(), 50);
+  ASSERT_EQ(mos.lineCount(), 55);
+  ASSERT_EQ(highpassMosaic.sampleCount(), mos.sampleCount());
+  ASSERT_EQ(highpassMosaic.lineCount(), mos.lineCount());
+
+  LineManager outLine(mos);
+  LineManager highpassBuffer(highpassMosaic);
+  LineManager lowpassBuffer(lowpass);
+  int validPixels = 0;
+  for (int line = 1; line <= mos.lineCount(); line++) {
+    outLine.SetLine(line);
+    highpassBuffer.SetLine(line);
+    lowpassBuffer.SetLine(line);
+    mos.read(outLine);
+    highpassMosaic.read(highpassBuffer);
+    lowpass.read(lowpassBuffer);
+
+    for (int i = 0; i < outLine.size(); i++) {
+      // algebra OPERATOR=add
+      double expected = highpassBuffer[i];
+      if (!IsSpecial(expected)) {
+        expected = IsSpecial(lowpassBuffer[i]) ? Null : expected + lowpassBuffer[i];
+      }
+
+      if (IsSpecial(expected)) {
+        EXPECT_EQ(outLine[i], expected) << "line " << line << " sample " << i + 1;
+      }
+      else {
+        EXPECT_NEAR(outLine[i], expected, 1.0e-3) << "line " << line << " sample " << i + 1;
+        validPixels++;
+      }
+    }
+  }
+
+  // All three cubes are in the mosaic, less the overlaps and the gap
+  EXPECT_EQ(validPixels, 2150);
+}
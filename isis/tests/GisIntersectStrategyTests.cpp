@@ -0,0 +1,88 @@
+#include <QString>
+#include <QStringList>
+
+#include "GisGeometry.h"
+#include "GisIntersectStrategy.h"
+#include "IString.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "Resource.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// A 4x4 grid of squares of different sizes, each overlapping its neighbors
+static ResourceList footprints() {
+  ResourceList resources;
+  for (int row = 0; row < 4; row++) {
+    for (int col = 0; col < 4; col++) {
+      double x = col * 7.0;
+      double y = row * 7.0;
+      double size = 10.0 + ((row * 4 + col) % 3);
+      QString wkt = "POLYGON ((" + toString(x) + " " + toString(y) + ", " +
+                    toString(x + size) + " " + toString(y) + ", " +
+                    toString(x + size) + " " + toString(y + size) + ", " +
+                    toString(x) + " " + toString(y + size) + ", " +
+                    toString(x) + " " + toString(y) + "))";
+      SharedResource resource(new Resource("Square" + toString(row * 4 + col)));
+      resource->add(new GisGeometry(wkt, GisGeometry::WKT));
+      resources.append(resource);
+    }
+  }
+  return resources;
+}
+
+
+static PvlObject intersectDefinition(int maxThreads, QString method) {
+  PvlObject definition("Strategy");
+  definition += PvlKeyword("Name", "TestIntersect");
+  definition += PvlKeyword("Type", "GisIntersect");
+  definition += PvlKeyword("GisType", "WKT");
+  definition += PvlKeyword("GisGeometry", "POLYGON ((5 5, 20 5, 20 15, 5 15, 5 5))");
+  definition += PvlKeyword("GisMethod", method);
+  definition += PvlKeyword("ComputeRatio", "true");
+  definition += PvlKeyword("RatioRef", "IntersectRatio");
+  definition += PvlKeyword("MaxThreads", toString(maxThreads));
+  return definition;
+}
+
+
+// The intersection ratio of each Resource and whether it was discarded
+static QString intersectSummary(const ResourceList &resources) {
+  QStringList summary;
+  foreach (SharedResource resource, resources) {
+    summary.append(resource->name() + " " + resource->value("IntersectRatio", "none") +
+                   (resource->isDiscarded() ? " discarded" : ""));
+  }
+  return summary.join("\n");
+}
+
+
+TEST(GisIntersectStrategy, MaxThreadsMatchesSerial) {
+  ResourceList globals;
+  QStringList methods;
+  methods << "direct" << "indexed";
+
+  foreach (QString method, methods) {
+    ResourceList serial = footprints();
+    GisIntersectStrategy serialStrategy(intersectDefinition(1, method), globals);
+    int serialCount = serialStrategy.apply(serial, globals);
+
+    ResourceList threaded = footprints();
+    GisIntersectStrategy threadedStrategy(intersectDefinition(4, method), globals);
+    int threadedCount = threadedStrategy.apply(threaded, globals);
+
+    EXPECT_EQ(threadedCount, serialCount) << method.toStdString();
+    EXPECT_EQ(intersectSummary(threaded).toStdString(), intersectSummary(serial).toStdString())
+        << method.toStdString();
+
+    // Only the squares near the intersect geometry are kept
+    int discarded = 0;
+    foreach (SharedResource resource, serial) {
+      if (resource->isDiscarded()) discarded++;
+    }
+    EXPECT_GT(discarded, 0) << method.toStdString();
+    EXPECT_LT(discarded, serial.size()) << method.toStdString();
+  }
+}
@@ -0,0 +1,168 @@
+#include <QString>
+#include <QStringList>
+
+#include "GisGeometry.h"
+#include "GisOverlapStrategy.h"
+#include "IString.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "Resource.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// A 4x4 grid of squares of different sizes, each overlapping its neighbors
+static ResourceList footprints() {
+  ResourceList resources;
+  for (int row = 0; row < 4; row++) {
+    for (int col = 0; col < 4; col++) {
+      double x = col * 7.0;
+      double y = row * 7.0;
+      double size = 10.0 + ((row * 4 + col) % 3);
+      QString wkt = "POLYGON ((" + toString(x) + " " + toString(y) + ", " +
+                    toString(x + size) + " " + toString(y) + ", " +
+                    toString(x + size) + " " + toString(y + size) + ", " +
+                    toString(x) + " " + toString(y + size) + ", " +
+                    toString(x) + " " + toString(y) + "))";
+      SharedResource resource(new Resource("Square" + toString(row * 4 + col)));
+      resource->add(new GisGeometry(wkt, GisGeometry::WKT));
+      resources.append(resource);
+    }
+  }
+  return resources;
+}
+
+
+static PvlObject overlapDefinition(int maxThreads) {
+  PvlObject definition("Strategy");
+  definition += PvlKeyword("Name", "TestOverlap");
+  definition += PvlKeyword("Type", "GisOverlap");
+  definition += PvlKeyword("OverlapMinimum", "0.1");
+  definition += PvlKeyword("OverlapMerge", "Intersection");
+  definition += PvlKeyword("MaxThreads", toString(maxThreads));
+  return definition;
+}
+
+
+// The overlaps found for each Resource, with their ratios and merged geometry areas
+static QString overlapSummary(const ResourceList &resources) {
+  QStringList summary;
+  foreach (SharedResource resource, resources) {
+    QString line = resource->name();
+    if (resource->hasAsset("GisOverlap")) {
+      ResourceList pairs = resource->asset("GisOverlap").value<ResourceList>();
+      foreach (SharedResource pair, pairs) {
+        line += " " + pair->name() + "=" + pair->value("OverlapRatioA") + "," +
+                pair->value("OverlapRatioB") + "," + toString(pair->geometry()->area());
+      }
+    }
+    summary.append(line);
+  }
+  return summary.join("\n");
+}
+
+
+/**
+ * GisOverlapStrategy that records the calls to its processing methods. It can also replace the
+ * geometry of the candidate while an overlap is processed.
+ */
+class RecordingOverlapStrategy : public GisOverlapStrategy {
+  public:
+    RecordingOverlapStrategy(const PvlObject &definition, const ResourceList &globals) :
+        GisOverlapStrategy(definition, globals), m_moveCandidates(false) { }
+
+    QStringList processed;  //!< Resources passed to processOverlaps, in order
+    QStringList ratios;     //!< The pairs and ratios passed to processOverlap, in order
+
+    void moveCandidates() {
+      m_moveCandidates = true;
+    }
+
+  protected:
+    ResourceList processOverlaps(SharedResource &resource, ResourceList &overlaps,
+                                 const ResourceList &globals) {
+      processed.append(resource->name());
+      return GisOverlapStrategy::processOverlaps(resource, overlaps, globals);
+    }
+
+    SharedResource processOverlap(SharedResource &resourceA, SharedResource &resourceB,
+                                  const double &ovrRatioA, const double &ovrRatioB,
+                                  const ResourceList &globals) {
+      ratios.append(resourceA->name() + "_" + resourceB->name() + "=" +
+                    toString(ovrRatioA) + "," + toString(ovrRatioB));
+      SharedResource merged = GisOverlapStrategy::processOverlap(resourceA, resourceB,
+                                                                 ovrRatioA, ovrRatioB, globals);
+      if (m_moveCandidates) {
+        resourceB->add(new GisGeometry("POLYGON ((1000 1000, 1001 1000, 1001 1001, "
+                                       "1000 1001, 1000 1000))", GisGeometry::WKT));
+      }
+      return merged;
+    }
+
+  private:
+    bool m_moveCandidates;
+};
+
+
+TEST(GisOverlapStrategy, MaxThreadsMatchesSerial) {
+  ResourceList globals;
+
+  ResourceList serial = footprints();
+  GisOverlapStrategy serialStrategy(overlapDefinition(1), globals);
+  int serialPairs = serialStrategy.apply(serial, globals);
+
+  ResourceList threaded = footprints();
+  GisOverlapStrategy threadedStrategy(overlapDefinition(4), globals);
+  int threadedPairs = threadedStrategy.apply(threaded, globals);
+
+  EXPECT_EQ(serialPairs, 16);
+  EXPECT_EQ(threadedPairs, serialPairs);
+  EXPECT_EQ(overlapSummary(threaded).toStdString(), overlapSummary(serial).toStdString());
+}
+
+
+TEST(GisOverlapStrategy, ProcessOverlapsHook) {
+  ResourceList globals;
+
+  ResourceList resources = footprints();
+  RecordingOverlapStrategy strategy(overlapDefinition(4), globals);
+  strategy.apply(resources, globals);
+
+  // Every active Resource goes through processOverlaps, in order
+  QStringList expected;
+  foreach (SharedResource resource, resources) {
+    expected.append(resource->name());
+  }
+  EXPECT_EQ(strategy.processed.join(" ").toStdString(), expected.join(" ").toStdString());
+
+  // The overlaps are the same as without the hook
+  ResourceList plain = footprints();
+  GisOverlapStrategy plainStrategy(overlapDefinition(4), globals);
+  plainStrategy.apply(plain, globals);
+  EXPECT_EQ(overlapSummary(resources).toStdString(), overlapSummary(plain).toStdString());
+}
+
+
+TEST(GisOverlapStrategy, RatiosComputedBeforeProcessing) {
+  ResourceList globals;
+
+  // Two squares with the same area, so the ratios of the pair are the same both ways
+  ResourceList resources;
+  SharedResource first(new Resource("First"));
+  first->add(new GisGeometry("POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))", GisGeometry::WKT));
+  resources.append(first);
+  SharedResource second(new Resource("Second"));
+  second->add(new GisGeometry("POLYGON ((5 0, 15 0, 15 10, 5 10, 5 0))", GisGeometry::WKT));
+  resources.append(second);
+
+  // Processing the first overlap moves the second square away from the first. The ratios of
+  // the second square were already computed, so it still overlaps the first.
+  RecordingOverlapStrategy strategy(overlapDefinition(1), globals);
+  strategy.moveCandidates();
+  EXPECT_EQ(strategy.apply(resources, globals), 2);
+
+  ASSERT_EQ(strategy.ratios.size(), 2);
+  EXPECT_EQ(strategy.ratios[0].toStdString(), "First_Second=0.5,0.5");
+  EXPECT_EQ(strategy.ratios[1].toStdString(), "Second_First=0.5,0.5");
+}
@@ -0,0 +1,101 @@
+#include <vector>
+
+#include <QFuture>
+#include <QList>
+#include <QAtomicInt>
+#include <QScopedPointer>
+#include <QString>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include "GisGeometry.h"
+#include "GisTopology.h"
+#include "IString.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// A square with its lower left corner at x, y
+static QString square(double x, double y, double size) {
+  return "POLYGON ((" + toString(x) + " " + toString(y) + ", " +
+         toString(x + size) + " " + toString(y) + ", " +
+         toString(x + size) + " " + toString(y + size) + ", " +
+         toString(x) + " " + toString(y + size) + ", " +
+         toString(x) + " " + toString(y) + "))";
+}
+
+
+TEST(GisTopology, ContextPerThread) {
+  GisTopology *gis = GisTopology::instance();
+  GEOSContextHandle_t mainContext = gis->context();
+  ASSERT_NE(mainContext, (GEOSContextHandle_t) 0);
+  EXPECT_EQ(gis->context(), mainContext);
+
+  QThreadPool pool;
+  pool.setMaxThreadCount(2);
+  std::vector<GEOSContextHandle_t> contexts(2, (GEOSContextHandle_t) 0);
+  std::vector<char> repeated(2, 0);
+  QAtomicInt started(0);
+  QList< QFuture<void> > futures;
+  for (int t = 0; t < 2; t++) {
+    futures.append(QtConcurrent::run(&pool, [&, t]() {
+      contexts[t] = gis->context();
+      repeated[t] = (gis->context() == contexts[t]);
+
+      // Hold the thread until both have their context, so they are different threads
+      started.fetchAndAddOrdered(1);
+      while (started.loadAcquire() < 2) {
+        QThread::yieldCurrentThread();
+      }
+    }));
+  }
+  foreach (QFuture<void> future, futures) {
+    future.waitForFinished();
+  }
+
+  EXPECT_TRUE(repeated[0]);
+  EXPECT_TRUE(repeated[1]);
+  EXPECT_NE(contexts[0], mainContext);
+  EXPECT_NE(contexts[1], mainContext);
+  EXPECT_NE(contexts[0], contexts[1]);
+}
+
+
+TEST(GisTopology, ConcurrentOperationsMatchSerial) {
+  // A row of overlapping squares
+  QList<GisGeometry *> geometries;
+  for (int i = 0; i < 50; i++) {
+    geometries.append(new GisGeometry(square(i * 3.0, (i % 5) * 2.0, 5.0 + (i % 4)),
+                                      GisGeometry::WKT));
+  }
+
+  // The intersection of each square with the next one, one at a time and on several threads
+  std::vector<double> serial(geometries.size() - 1);
+  for (int i = 0; i < geometries.size() - 1; i++) {
+    QScopedPointer<GisGeometry> common(geometries[i]->intersection(*geometries[i + 1]));
+    serial[i] = common->area() + geometries[i]->intersectRatio(*geometries[i + 1]);
+  }
+
+  QThreadPool pool;
+  pool.setMaxThreadCount(4);
+  std::vector<double> threaded(geometries.size() - 1);
+  QList< QFuture<void> > futures;
+  for (int i = 0; i < geometries.size() - 1; i++) {
+    futures.append(QtConcurrent::run(&pool, [&, i]() {
+      QScopedPointer<GisGeometry> common(geometries[i]->intersection(*geometries[i + 1]));
+      threaded[i] = common->area() + geometries[i]->intersectRatio(*geometries[i + 1]);
+    }));
+  }
+  foreach (QFuture<void> future, futures) {
+    future.waitForFinished();
+  }
+
+  for (int i = 0; i < geometries.size() - 1; i++) {
+    EXPECT_EQ(threaded[i], serial[i]) << "pair " << i;
+    EXPECT_GT(serial[i], 0.0) << "pair " << i;
+  }
+
+  qDeleteAll(geometries);
+}
@@ -0,0 +1,104 @@
+#include <QString>
+#include <QStringList>
+
+#include "GisGeometry.h"
+#include "GisUnionStrategy.h"
+#include "IString.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "Resource.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// A 4x4 grid of squares of different sizes, each overlapping its neighbors
+static ResourceList footprints() {
+  ResourceList resources;
+  for (int row = 0; row < 4; row++) {
+    for (int col = 0; col < 4; col++) {
+      double x = col * 7.0;
+      double y = row * 7.0;
+      double size = 10.0 + ((row * 4 + col) % 3);
+      QString wkt = "POLYGON ((" + toString(x) + " " + toString(y) + ", " +
+                    toString(x + size) + " " + toString(y) + ", " +
+                    toString(x + size) + " " + toString(y + size) + ", " +
+                    toString(x) + " " + toString(y + size) + ", " +
+                    toString(x) + " " + toString(y) + "))";
+      SharedResource resource(new Resource("Square" + toString(row * 4 + col)));
+      resource->add(new GisGeometry(wkt, GisGeometry::WKT));
+      resources.append(resource);
+    }
+  }
+  return resources;
+}
+
+
+static PvlObject unionDefinition(int maxThreads) {
+  PvlObject definition("Strategy");
+  definition += PvlKeyword("Name", "TestUnion");
+  definition += PvlKeyword("Type", "GisUnion");
+  definition += PvlKeyword("OverlapMaximum", "0.4");
+  definition += PvlKeyword("MaxThreads", toString(maxThreads));
+  return definition;
+}
+
+
+// The ratio of each Resource and whether it was left out of the union
+static QString unionSummary(const ResourceList &resources) {
+  QStringList summary;
+  foreach (SharedResource resource, resources) {
+    summary.append(resource->name() + " " + resource->value("UnionOverlapRatio") +
+                   (resource->isDiscarded() ? " discarded" : ""));
+  }
+  return summary.join("\n");
+}
+
+
+TEST(GisUnionStrategy, MaxThreadsMatchesSerial) {
+  ResourceList globals;
+
+  ResourceList serial = footprints();
+  GisUnionStrategy serialStrategy(unionDefinition(1), globals);
+  serialStrategy.apply(serial, globals);
+
+  ResourceList threaded = footprints();
+  GisUnionStrategy threadedStrategy(unionDefinition(4), globals);
+  threadedStrategy.apply(threaded, globals);
+
+  EXPECT_EQ(unionSummary(threaded).toStdString(), unionSummary(serial).toStdString());
+
+  // Some squares overlap the union too much, so which ones are kept depends on the order
+  int discarded = 0;
+  foreach (SharedResource resource, serial) {
+    if (resource->isDiscarded()) discarded++;
+  }
+  EXPECT_GT(discarded, 0);
+  EXPECT_LT(discarded, serial.size());
+}
+
+
+TEST(GisUnionStrategy, RatioCountsOverlapsOnce) {
+  ResourceList globals;
+
+  // The third square is covered by both of the first two, which overlap each other over it
+  ResourceList resources;
+  QStringList wkts;
+  wkts << "POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))"
+       << "POLYGON ((0 5, 10 5, 10 15, 0 15, 0 5))"
+       << "POLYGON ((0 0, 10 0, 10 20, 0 20, 0 0))";
+  for (int i = 0; i < wkts.size(); i++) {
+    SharedResource resource(new Resource("Square" + toString(i)));
+    resource->add(new GisGeometry(wkts[i], GisGeometry::WKT));
+    resources.append(resource);
+  }
+
+  PvlObject definition = unionDefinition(4);
+  definition.findKeyword("OverlapMaximum").setValue("1.0");
+  GisUnionStrategy strategy(definition, globals);
+  strategy.apply(resources, globals);
+
+  EXPECT_EQ(resources[0]->value("UnionOverlapRatio").toStdString(), "1.0");
+  EXPECT_DOUBLE_EQ(toDouble(resources[1]->value("UnionOverlapRatio")), 0.5);
+  EXPECT_DOUBLE_EQ(toDouble(resources[2]->value("UnionOverlapRatio")), 0.75);
+}
@@ -0,0 +1,173 @@
+#include <cmath>
+
+#include "Chip.h"
+#include "Gruen.h"
+#include "GruenTypes.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// Exposes the protected least squares step of the Gruen algorithm
+class TestGruen : public Gruen {
+  public:
+    TestGruen(Pvl &pvl) : Gruen(pvl) { }
+
+    int solve(Chip &pattern, Chip &subsearch, BigInt &npts, double &resid,
+              GMatrix &atai, AffineRadio &affrad) {
+      return algorithm(pattern, subsearch, Radiometric(0.0, 0.0), npts, resid,
+                       atai, affrad);
+    }
+};
+
+
+static Pvl gruenPvl() {
+  PvlGroup alg("Algorithm");
+  alg += PvlKeyword("Name", "Gruen");
+  alg += PvlKeyword("Tolerance", "100.0");
+  alg += PvlKeyword("AffineTranslationTolerance", "0.15");
+  alg += PvlKeyword("AffineScaleTolerance", "0.3");
+  alg += PvlKeyword("MaximumIterations", "30");
+
+  PvlGroup pchip("PatternChip");
+  pchip += PvlKeyword("Samples", "15");
+  pchip += PvlKeyword("Lines", "15");
+
+  PvlGroup schip("SearchChip");
+  schip += PvlKeyword("Samples", "25");
+  schip += PvlKeyword("Lines", "25");
+
+  PvlObject o("AutoRegistration");
+  o.addGroup(alg);
+  o.addGroup(pchip);
+  o.addGroup(schip);
+
+  Pvl pvl;
+  pvl.addObject(o);
+  return pvl;
+}
+
+
+static double surface(double samp, double line) {
+  return 500.0 + 60.0 * sin(0.31 * samp) * cos(0.27 * line) + 0.5 * samp * line;
+}
+
+
+// The subsearch chip is the pattern chip shifted by a fraction of a pixel
+static void fillChips(Chip &pattern, Chip &subsearch) {
+  for (int line = 1; line <= pattern.Lines(); line++) {
+    for (int samp = 1; samp <= pattern.Samples(); samp++) {
+      pattern.SetValue(samp, line, surface(samp, line));
+      subsearch.SetValue(samp, line, surface(samp + 0.2, line - 0.1));
+    }
+  }
+}
+
+
+TEST(Gruen, WorkspaceIsReusedAcrossChipSizes) {
+  Pvl pvl = gruenPvl();
+  TestGruen gruen(pvl);
+
+  Chip pattern(15, 15), subsearch(15, 15);
+  fillChips(pattern, subsearch);
+  BigInt npts1;
+  double resid1;
+  GMatrix atai1;
+  AffineRadio affrad1;
+  ASSERT_EQ(gruen.solve(pattern, subsearch, npts1, resid1, atai1, affrad1), 0);
+
+  Chip smallPattern(9, 7), smallSubsearch(9, 7);
+  fillChips(smallPattern, smallSubsearch);
+  BigInt npts2;
+  double resid2;
+  GMatrix atai2;
+  AffineRadio affrad2;
+  ASSERT_EQ(gruen.solve(smallPattern, smallSubsearch, npts2, resid2, atai2, affrad2), 0);
+  EXPECT_EQ(npts2, 7 * 5);
+
+  BigInt npts3;
+  double resid3;
+  GMatrix atai3;
+  AffineRadio affrad3;
+  ASSERT_EQ(gruen.solve(pattern, subsearch, npts3, resid3, atai3, affrad3), 0);
+
+  EXPECT_EQ(npts3, npts1);
+  EXPECT_EQ(resid3, resid1);
+  for (int i = 0; i < NCONSTR; i++) {
+    for (int j = 0; j < NCONSTR; j++) {
+      EXPECT_EQ(atai3[i][j], atai1[i][j]);
+    }
+  }
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_EQ(affrad3.m_affine[i][j], affrad1.m_affine[i][j]);
+    }
+  }
+}
+
+
+TEST(Gruen, InverseOfNormalMatrix) {
+  Pvl pvl = gruenPvl();
+  TestGruen gruen(pvl);
+
+  Chip pattern(15, 15), subsearch(15, 15);
+  fillChips(pattern, subsearch);
+  BigInt npts;
+  double resid;
+  GMatrix atai;
+  AffineRadio affrad;
+  ASSERT_EQ(gruen.solve(pattern, subsearch, npts, resid, atai, affrad), 0);
+  EXPECT_EQ(npts, 13 * 13);
+
+  // Build the normal matrix from the design matrix
+  double ata[NCONSTR][NCONSTR] = { { 0.0 } };
+  for (int line = 2; line < pattern.Lines(); line++) {
+    for (int samp = 2; samp < pattern.Samples(); samp++) {
+      double x0 = samp - pattern.TackSample();
+      double y0 = line - pattern.TackLine();
+      double gx = subsearch.GetValue(samp + 1, line) - subsearch.GetValue(samp - 1, line);
+      double gy = subsearch.GetValue(samp, line + 1) - subsearch.GetValue(samp, line - 1);
+      double a[NCONSTR] = { gx, gx * x0, gx * y0, gy, gy * x0, gy * y0, 1.0,
+                            subsearch.GetValue(samp, line) };
+      for (int i = 0; i < NCONSTR; i++) {
+        for (int j = 0; j < NCONSTR; j++) {
+          ata[i][j] += a[i] * a[j];
+        }
+      }
+    }
+  }
+
+  for (int i = 0; i < NCONSTR; i++) {
+    for (int j = 0; j < NCONSTR; j++) {
+      double product = 0.0;
+      for (int k = 0; k < NCONSTR; k++) {
+        product += atai[i][k] * ata[k][j];
+      }
+      EXPECT_NEAR(product, (i == j) ? 1.0 : 0.0, 1.0e-5);
+    }
+  }
+}
+
+
+TEST(Gruen, SkipsInvalidPixels) {
+  Pvl pvl = gruenPvl();
+  TestGruen gruen(pvl);
+
+  Chip pattern(15, 15), subsearch(15, 15);
+  fillChips(pattern, subsearch);
+  pattern.SetValue(4, 4, Null);
+  subsearch.SetValue(10, 10, Lrs);
+
+  BigInt npts;
+  double resid;
+  GMatrix atai;
+  AffineRadio affrad;
+  ASSERT_EQ(gruen.solve(pattern, subsearch, npts, resid, atai, affrad), 0);
+
+  // The invalid subsearch pixel removes itself and its four neighbors
+  EXPECT_EQ(npts, 13 * 13 - 1 - 5);
+}
@@ -0,0 +1,151 @@
+#include <memory>
+#include <vector>
+
+#include <QMap>
+#include <QStringList>
+
+#include "geos/geom/CoordinateArraySequence.h"
+#include "geos/geom/LinearRing.h"
+#include "geos/geom/MultiPolygon.h"
+#include "geos/geom/Polygon.h"
+
+#include "ImageOverlap.h"
+#include "ImageOverlapSet.h"
+#include "PolygonTools.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+static geos::geom::MultiPolygon *square(double lon, double lat, double size) {
+  geos::geom::CoordinateArraySequence *pts = new geos::geom::CoordinateArraySequence();
+  pts->add(geos::geom::Coordinate(lon, lat));
+  pts->add(geos::geom::Coordinate(lon + size, lat));
+  pts->add(geos::geom::Coordinate(lon + size, lat + size));
+  pts->add(geos::geom::Coordinate(lon, lat + size));
+  pts->add(geos::geom::Coordinate(lon, lat));
+
+  std::vector<geos::geom::Geometry *> *polys = new std::vector<geos::geom::Geometry *>;
+  polys->push_back(globalFactory->createPolygon(globalFactory->createLinearRing(pts), nullptr));
+  return globalFactory->createMultiPolygon(polys);
+}
+
+
+// A block of overlapping footprints, a pair that only overlap each other, and footprints that are
+// disjoint from everything
+class OverlappingFootprints : public ::testing::Test {
+  protected:
+    std::vector<QString> serialNumbers;
+    std::vector<geos::geom::MultiPolygon *> footprints;
+
+    void SetUp() override {
+      for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+          add(QString("Block%1%2").arg(row).arg(col), square(col * 1.0, row * 1.25, 1.5));
+        }
+      }
+      add("Pair1", square(5.5, 0.0, 1.0));
+      add("Pair2", square(6.0, 0.5, 1.0));
+      for (int i = 0; i < 3; i++) {
+        add(QString("Disjoint%1").arg(i), square(20.0 + 3.0 * i, 10.0, 2.0));
+      }
+    }
+
+    void TearDown() override {
+      for (unsigned int i = 0; i < footprints.size(); i++) {
+        delete footprints[i];
+      }
+    }
+
+    void add(QString serialNumber, geos::geom::MultiPolygon *footprint) {
+      serialNumbers.push_back(serialNumber);
+      footprints.push_back(footprint);
+    }
+
+    // The area covered by exactly the images of each overlap, keyed by their serial numbers
+    QMap<QString, double> overlapAreas(ImageOverlapSet &overlaps) {
+      QMap<QString, double> areas;
+      for (int i = 0; i < overlaps.Size(); i++) {
+        QStringList overlapSerials;
+        for (int sn = 0; sn < overlaps[i]->Size(); sn++) {
+          overlapSerials.append((*overlaps[i])[sn]);
+        }
+        overlapSerials.sort();
+        areas[overlapSerials.join(",")] += overlaps[i]->Polygon()->getArea();
+      }
+      return areas;
+    }
+
+    // The area covered by exactly the images with some serial numbers, from the footprints
+    double exactArea(QStringList overlapSerials) {
+      std::unique_ptr<geos::geom::Geometry> area;
+      for (unsigned int i = 0; i < footprints.size(); i++) {
+        if (overlapSerials.contains(serialNumbers[i])) {
+          area.reset(area ? area->intersection(footprints[i]) : footprints[i]->clone());
+        }
+      }
+      for (unsigned int i = 0; i < footprints.size(); i++) {
+        if (!overlapSerials.contains(serialNumbers[i])) {
+          area.reset(area->difference(footprints[i]));
+        }
+      }
+      return area->getArea();
+    }
+};
+
+
+TEST_F(OverlappingFootprints, IndexedOverlapsMatchFootprints) {
+  ImageOverlapSet overlaps(false, false);
+  overlaps.FindImageOverlaps(serialNumbers, footprints);
+
+  QMap<QString, double> areas = overlapAreas(overlaps);
+  ASSERT_FALSE(areas.isEmpty());
+
+  double totalArea = 0.0;
+  QMapIterator<QString, double> it(areas);
+  while (it.hasNext()) {
+    it.next();
+    EXPECT_NEAR(it.value(), exactArea(it.key().split(",")), 1e-10) << it.key().toStdString();
+    totalArea += it.value();
+  }
+
+  // Every footprint is covered, and the disjoint footprints are overlaps of their own
+  std::unique_ptr<geos::geom::Geometry> coverage(footprints[0]->clone());
+  for (unsigned int i = 1; i < footprints.size(); i++) {
+    coverage.reset(coverage->Union(footprints[i]));
+  }
+  EXPECT_NEAR(totalArea, coverage->getArea(), 1e-10);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(areas.value(QString("Disjoint%1").arg(i)), 4.0, 1e-10);
+  }
+  EXPECT_TRUE(areas.contains("Pair1,Pair2"));
+}
+
+
+TEST_F(OverlappingFootprints, TiledOverlapsMatchSerialOverlaps) {
+  ImageOverlapSet serialOverlaps(false, false);
+  serialOverlaps.FindImageOverlaps(serialNumbers, footprints);
+  QMap<QString, double> serialAreas = overlapAreas(serialOverlaps);
+  ASSERT_FALSE(serialAreas.isEmpty());
+
+  for (int tiles = 2; tiles <= 4; tiles++) {
+    ImageOverlapSet tiledOverlaps(false, false);
+    tiledOverlaps.SetTiles(tiles);
+    tiledOverlaps.FindImageOverlaps(serialNumbers, footprints);
+
+    QMap<QString, double> tiledAreas = overlapAreas(tiledOverlaps);
+    ASSERT_EQ(tiledAreas.keys(), serialAreas.keys()) << tiles << " tiles";
+    QMapIterator<QString, double> it(serialAreas);
+    while (it.hasNext()) {
+      it.next();
+      EXPECT_NEAR(tiledAreas.value(it.key()), it.value(), 1e-10)
+          << tiles << " tiles, " << it.key().toStdString();
+    }
+
+    // The joined overlaps do not keep the factories of the tiles
+    for (int i = 0; i < tiledOverlaps.Size(); i++) {
+      EXPECT_EQ(tiledOverlaps[i]->Polygon()->getFactory(),
+                serialOverlaps[0]->Polygon()->getFactory());
+    }
+  }
+}
@@ -0,0 +1,198 @@
+#include <QScopedPointer>
+
+#include "geos/geom/CoordinateArraySequence.h"
+#include "geos/geom/LinearRing.h"
+#include "geos/geom/MultiPolygon.h"
+#include "geos/geom/Polygon.h"
+
+#include "Brick.h"
+#include "Chip.h"
+#include "InterestOperator.h"
+#include "InterestOperatorFactory.h"
+#include "MoravecOperator.h"
+#include "NetworkFixtures.h"
+#include "PolygonTools.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+#include "StandardDeviationOperator.h"
+#include "UniversalGroundMap.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// Exposes the window by window and the box filter interest images of an operator
+template <class Operator>
+class TestOperator : public Operator {
+  public:
+    TestOperator(Pvl &pvl) : Operator(pvl) { }
+
+    void interestImage(Chip &area, Chip &interest, int sampleShift, int lineShift) {
+      this->InterestImage(area, interest, sampleShift, lineShift);
+    }
+
+    void windowInterestImage(Chip &area, Chip &interest, int sampleShift, int lineShift) {
+      this->InterestOperator::InterestImage(area, interest, sampleShift, lineShift);
+    }
+};
+
+
+static Pvl operatorPvl(QString name, int samples, int lines) {
+  PvlGroup op("Operator");
+  op += PvlKeyword("Name", name);
+  op += PvlKeyword("Samples", toString(samples));
+  op += PvlKeyword("Lines", toString(lines));
+  op += PvlKeyword("DeltaLine", "0");
+  op += PvlKeyword("DeltaSamp", "0");
+  op += PvlKeyword("MinimumInterest", "0.0");
+
+  PvlGroup valid("ValidMeasure");
+  valid += PvlKeyword("MinDN", "10.0");
+  valid += PvlKeyword("MaxDN", "250.0");
+
+  PvlObject o("InterestOperator");
+  o.addGroup(op);
+  o.addGroup(valid);
+
+  Pvl pvl;
+  pvl.addObject(o);
+  return pvl;
+}
+
+
+// Integer pixels, so the window sums are exact in any order
+static void fillArea(Chip &area) {
+  for (int line = 1; line <= area.Lines(); line++) {
+    for (int samp = 1; samp <= area.Samples(); samp++) {
+      area.SetValue(samp, line, (samp * samp * 7 + line * 13 + samp * line) % 257);
+    }
+  }
+  area.SetValue(5, 6, Null);
+  area.SetValue(12, 3, Lrs);
+  for (int samp = 14; samp <= 19; samp++) {
+    area.SetValue(samp, 11, His);
+  }
+}
+
+
+template <class Operator>
+static void compareInterestImages(QString name, int samples, int lines, int pad) {
+  Pvl pvl = operatorPvl(name, samples, lines);
+  TestOperator<Operator> op(pvl);
+
+  Chip interest(17, 12), windowInterest(17, 12);
+  Chip area(interest.Samples() + samples + pad - 1, interest.Lines() + lines + pad - 1);
+  fillArea(area);
+
+  for (int lineShift = -1; lineShift <= 1; lineShift++) {
+    for (int sampleShift = -1; sampleShift <= 1; sampleShift++) {
+      op.interestImage(area, interest, sampleShift, lineShift);
+      op.windowInterestImage(area, windowInterest, sampleShift, lineShift);
+      for (int line = 1; line <= interest.Lines(); line++) {
+        for (int samp = 1; samp <= interest.Samples(); samp++) {
+          EXPECT_EQ(interest.GetValue(samp, line), windowInterest.GetValue(samp, line))
+              << "sample " << samp << " line " << line << " shift " << sampleShift << ", "
+              << lineShift;
+        }
+      }
+    }
+  }
+}
+
+
+TEST(InterestOperator, StandardDeviationInterestImage) {
+  compareInterestImages<StandardDeviationOperator>("StandardDeviation", 5, 4, 0);
+}
+
+
+TEST(InterestOperator, MoravecInterestImage) {
+  compareInterestImages<MoravecOperator>("Moravec", 5, 4, 2);
+}
+
+
+TEST(InterestOperator, InterestImageOfAllNullArea) {
+  Pvl pvl = operatorPvl("StandardDeviation", 3, 3);
+  TestOperator<StandardDeviationOperator> op(pvl);
+
+  Chip area(6, 6), interest(4, 4);
+  for (int line = 1; line <= area.Lines(); line++) {
+    for (int samp = 1; samp <= area.Samples(); samp++) {
+      area.SetValue(samp, line, Null);
+    }
+  }
+
+  op.interestImage(area, interest, 0, 0);
+  for (int line = 1; line <= interest.Lines(); line++) {
+    for (int samp = 1; samp <= interest.Samples(); samp++) {
+      EXPECT_EQ(interest.GetValue(samp, line), Null);
+    }
+  }
+}
+
+
+// Calculates the interest of bricks of a cube at once and compares it with the interest of
+// each pixel from the window by window Operate, visited in the same order
+static void compareOperateBuffer(QString name, Cube &cube,
+                                 const geos::geom::MultiPolygon *clipPolygon = NULL) {
+  Pvl pvl = operatorPvl(name, 5, 4);
+  QScopedPointer<InterestOperator> denseOperator(InterestOperatorFactory::Create(pvl));
+  QScopedPointer<InterestOperator> windowOperator(InterestOperatorFactory::Create(pvl));
+  if (clipPolygon) {
+    denseOperator->SetClipPolygon(*clipPolygon);
+    windowOperator->SetClipPolygon(*clipPolygon);
+  }
+  UniversalGroundMap groundMap(cube);
+
+  // A brick inside the cube, one on its first sample and line and one hanging off of its
+  // last sample and line
+  QList< QPair<int, int> > starts;
+  starts << qMakePair(cube.sampleCount() / 2, cube.lineCount() / 2)
+         << qMakePair(1, 1)
+         << qMakePair(cube.sampleCount() - 9, cube.lineCount() - 7);
+
+  Brick interest(20, 16, 1, cube.pixelType());
+  for (int s = 0; s < starts.size(); s++) {
+    interest.SetBasePosition(starts[s].first, starts[s].second, 1);
+    denseOperator->Operate(cube, groundMap, interest);
+
+    for (int i = 0; i < interest.size(); i++) {
+      int sample = interest.Sample(i);
+      int line = interest.Line(i);
+      if (sample > cube.sampleCount() || line > cube.lineCount()) {
+        EXPECT_EQ(interest[i], Null) << name.toStdString() << " " << sample << ", " << line;
+        continue;
+      }
+
+      windowOperator->Operate(cube, groundMap, sample, line);
+      EXPECT_EQ(interest[i], windowOperator->InterestAmount())
+          << name.toStdString() << " " << sample << ", " << line;
+    }
+  }
+}
+
+
+TEST_F(ThreeImageNetwork, InterestOperatorOperateBufferMatchesWindows) {
+  compareOperateBuffer("StandardDeviation", *cube1);
+  compareOperateBuffer("Moravec", *cube1);
+}
+
+
+TEST_F(ThreeImageNetwork, InterestOperatorOperateBufferMatchesClippedWindows) {
+  // A triangle (sample, line) whose long side goes through the center of the brick inside the
+  // cube and that covers the brick on its first sample and line
+  double samples = 2 * (cube1->sampleCount() / 2 + 10);
+  double lines = 2 * (cube1->lineCount() / 2 + 8);
+  geos::geom::CoordinateArraySequence *pts = new geos::geom::CoordinateArraySequence();
+  pts->add(geos::geom::Coordinate(0.0, 0.0));
+  pts->add(geos::geom::Coordinate(samples, 0.0));
+  pts->add(geos::geom::Coordinate(0.0, lines));
+  pts->add(geos::geom::Coordinate(0.0, 0.0));
+  std::vector<geos::geom::Geometry *> *polys = new std::vector<geos::geom::Geometry *>;
+  polys->push_back(globalFactory->createPolygon(globalFactory->createLinearRing(pts), NULL));
+  QScopedPointer<geos::geom::MultiPolygon> clipPolygon(globalFactory->createMultiPolygon(polys));
+
+  compareOperateBuffer("StandardDeviation", *cube1, clipPolygon.data());
+  compareOperateBuffer("Moravec", *cube1, clipPolygon.data());
+}
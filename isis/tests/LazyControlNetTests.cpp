@@ -0,0 +1,114 @@
+#include <QString>
+
+#include "ControlMeasure.h"
+#include "ControlNet.h"
+#include "ControlPoint.h"
+#include "IException.h"
+#include "LazyControlNet.h"
+#include "TempFixtures.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+class LazyNetwork : public TempTestingFiles {
+  protected:
+    QString binaryNetFile;
+    QString pvlNetFile;
+
+    void SetUp() override {
+      TempTestingFiles::SetUp();
+
+      ControlNet net;
+      net.SetNetworkId("LazyNetwork");
+      net.SetTarget("Mars");
+      net.SetUserName("TestUser");
+
+      // Point i is measured on Image0, and on Image1 if i is even
+      for (int i = 0; i < 20; i++) {
+        ControlPoint *point = new ControlPoint(QString("Point%1").arg(i, 2, 10, QChar('0')));
+        point->SetType(ControlPoint::Free);
+
+        ControlMeasure *measure = new ControlMeasure;
+        measure->SetCubeSerialNumber("Image0");
+        measure->SetCoordinate(i, i);
+        point->Add(measure);
+
+        if (i % 2 == 0) {
+          measure = new ControlMeasure;
+          measure->SetCubeSerialNumber("Image1");
+          measure->SetCoordinate(i + 100, i + 100);
+          point->Add(measure);
+        }
+        net.AddPoint(point);
+      }
+
+      binaryNetFile = tempDir.path() + "/lazy.net";
+      pvlNetFile = tempDir.path() + "/lazy.pvl";
+      net.Write(binaryNetFile);
+      net.Write(pvlNetFile, true);
+    }
+};
+
+
+TEST_F(LazyNetwork, ReadsPointsOnDemand) {
+  LazyControlNet net(binaryNetFile);
+
+  EXPECT_TRUE(net.HasPointIndex());
+  EXPECT_EQ(net.GetNetworkId().toStdString(), "LazyNetwork");
+  EXPECT_EQ(net.GetNumPoints(), 20);
+  EXPECT_EQ(net.GetNumLoadedPoints(), 0);
+  EXPECT_TRUE(net.ContainsPoint("Point07"));
+  EXPECT_FALSE(net.ContainsPoint("Point20"));
+
+  // The measure counts come from the index
+  EXPECT_EQ(net.GetNumMeasures(4), 2);
+  EXPECT_EQ(net.GetNumMeasures(7), 1);
+  EXPECT_EQ(net.GetNumLoadedPoints(), 0);
+
+  ControlPoint *point = net.GetPoint("Point07");
+  EXPECT_EQ(point->GetId().toStdString(), "Point07");
+  EXPECT_EQ(point->GetNumMeasures(), 1);
+  EXPECT_EQ(net.GetNumLoadedPoints(), 1);
+
+  // Reading the same point again does not decode it again
+  EXPECT_EQ(net.GetPoint(7), point);
+  EXPECT_EQ(net.GetNumLoadedPoints(), 1);
+}
+
+
+TEST_F(LazyNetwork, MeasuresInCube) {
+  LazyControlNet net(binaryNetFile);
+
+  QList<QString> serials = net.GetCubeSerials();
+  ASSERT_EQ(serials.size(), 2);
+  EXPECT_EQ(serials[0].toStdString(), "Image0");
+  EXPECT_EQ(serials[1].toStdString(), "Image1");
+
+  QList<ControlMeasure *> measures = net.GetMeasuresInCube("Image1");
+  ASSERT_EQ(measures.size(), 10);
+  EXPECT_EQ(net.GetNumLoadedPoints(), 10);
+  for (int i = 0; i < measures.size(); i++) {
+    EXPECT_EQ(measures[i]->GetCubeSerialNumber().toStdString(), "Image1");
+    EXPECT_DOUBLE_EQ(measures[i]->GetSample(), 2 * i + 100);
+  }
+}
+
+
+TEST_F(LazyNetwork, PvlNetworkFallsBackToFullRead) {
+  LazyControlNet net(pvlNetFile);
+
+  EXPECT_FALSE(net.HasPointIndex());
+  EXPECT_EQ(net.GetNumPoints(), 20);
+  EXPECT_EQ(net.GetPointIds().size(), 20);
+  EXPECT_EQ(net.GetMeasuresInCube("Image0").size(), 20);
+  EXPECT_EQ(net.GetPoint("Point04")->GetNumMeasures(), 2);
+}
+
+
+TEST_F(LazyNetwork, InvalidPoint) {
+  LazyControlNet net(binaryNetFile);
+
+  EXPECT_THROW(net.GetPoint("NotAPoint"), IException);
+  EXPECT_THROW(net.GetPoint(20), IException);
+}
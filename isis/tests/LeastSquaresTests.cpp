@@ -0,0 +1,83 @@
+#include <vector>
+
+#include <armadillo>
+
+#include "BasisFunction.h"
+#include "IException.h"
+#include "LeastSquares.h"
+#include "TestUtilities.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// Adds points on the plane z = 2x - 3y to a least squares of a linear basis
+static void addPlane(LeastSquares &lsq) {
+  for (int i = 0; i < 10; i++) {
+    std::vector<double> input;
+    input.push_back(i % 4);
+    input.push_back(i / 3 + 0.5 * i);
+    lsq.AddKnown(input, 2.0 * input[0] - 3.0 * input[1]);
+  }
+}
+
+
+TEST(LeastSquares, ConjugateGradientMatchesSparse) {
+  BasisFunction sparseBasis("Linear", 2, 2);
+  BasisFunction cgBasis("Linear", 2, 2);
+  LeastSquares sparse(sparseBasis, true, 10, 2);
+  LeastSquares cg(cgBasis, true, 10, 2);
+  addPlane(sparse);
+  addPlane(cg);
+
+  sparse.Solve(LeastSquares::SPARSE);
+  cg.Solve(LeastSquares::CG);
+  EXPECT_NEAR(sparseBasis.Coefficient(0), 2.0, 1.0e-10);
+  EXPECT_NEAR(sparseBasis.Coefficient(1), -3.0, 1.0e-10);
+  EXPECT_NEAR(cgBasis.Coefficient(0), sparseBasis.Coefficient(0), 1.0e-10);
+  EXPECT_NEAR(cgBasis.Coefficient(1), sparseBasis.Coefficient(1), 1.0e-10);
+}
+
+
+TEST(LeastSquares, ConjugateGradient) {
+  // A symmetric positive definite tridiagonal system with solution 1, 2, ..., 5
+  arma::SpMat<double> normals(5, 5);
+  for (int i = 0; i < 5; i++) {
+    normals(i, i) = 4.0;
+    if (i > 0) {
+      normals(i, i - 1) = -1.0;
+      normals(i - 1, i) = -1.0;
+    }
+  }
+  arma::vec expected = arma::linspace<arma::vec>(1.0, 5.0, 5);
+  arma::vec rhs = normals * expected;
+
+  arma::vec solution;
+  ASSERT_TRUE(LeastSquares::ConjugateGradient(normals, rhs, solution));
+  ASSERT_EQ(solution.n_elem, (arma::uword) 5);
+  for (int i = 0; i < 5; i++) {
+    EXPECT_NEAR(solution(i), expected(i), 1.0e-10);
+  }
+
+  // The diagonal preconditioner needs a positive diagonal
+  normals(2, 2) = 0.0;
+  EXPECT_FALSE(LeastSquares::ConjugateGradient(normals, rhs, solution));
+}
+
+
+TEST(LeastSquares, SparseMethodsNeedSparseObject) {
+  BasisFunction basis("Linear", 2, 2);
+  LeastSquares lsq(basis);
+  addPlane(lsq);
+
+  try {
+    lsq.Solve(LeastSquares::CG);
+    FAIL() << "Expected an exception";
+  }
+  catch (IException &e) {
+    EXPECT_PRED_FORMAT2(AssertIExceptionMessage, e,
+                        "The SPARSE and CG solve methods require a LeastSquares "
+                        "constructed with sparse set to true");
+  }
+  EXPECT_THROW(lsq.Solve(LeastSquares::SPARSE), IException);
+}
@@ -0,0 +1,165 @@
+#include <cmath>
+
+#include "Chip.h"
+#include "MinimumDifference.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+/**
+ * Exposes the MinimumDifference match algorithm to the tests.
+ */
+class TestMinimumDifference : public MinimumDifference {
+  public:
+    TestMinimumDifference(Pvl &pvl) : MinimumDifference(pvl) {}
+
+    double Match(Chip &pattern, Chip &subsearch) {
+      return MatchAlgorithm(pattern, subsearch);
+    }
+};
+
+
+/**
+ * MinimumDifference with the sample by sample match algorithm it used before
+ * it read the chips a row at a time.
+ */
+class ReferenceMinimumDifference : public MinimumDifference {
+  public:
+    ReferenceMinimumDifference(Pvl &pvl) : MinimumDifference(pvl) {}
+
+  protected:
+    double MatchAlgorithm(Chip &pattern, Chip &subsearch) {
+      double diff = 0.0;
+      double count = 0;
+      for(double l = 1.0; l <= pattern.Lines(); l++) {
+        for(double s = 1.0; s <= pattern.Samples(); s++) {
+          int line = (int)l;
+          int samp = (int)s;
+
+          double pdn = pattern.GetValue(samp, line);
+          double sdn = subsearch.GetValue(samp, line);
+          if(IsSpecial(pdn)) continue;
+          if(IsSpecial(sdn)) continue;
+          diff += fabs(pdn - sdn);
+          count++;
+        }
+      }
+
+      return diff / count;
+    }
+};
+
+
+static Pvl minimumDifferencePvl() {
+  PvlGroup alg("Algorithm");
+  alg += PvlKeyword("Name", "MinimumDifference");
+  alg += PvlKeyword("Tolerance", "25.0");
+  alg += PvlKeyword("SubpixelAccuracy", "False");
+
+  PvlGroup pchip("PatternChip");
+  pchip += PvlKeyword("Samples", "15");
+  pchip += PvlKeyword("Lines", "13");
+  pchip += PvlKeyword("ValidPercent", "60");
+
+  PvlGroup schip("SearchChip");
+  schip += PvlKeyword("Samples", "41");
+  schip += PvlKeyword("Lines", "37");
+  schip += PvlKeyword("SubchipValidPercent", "60");
+
+  PvlObject o("AutoRegistration");
+  o.addGroup(alg);
+  o.addGroup(pchip);
+  o.addGroup(schip);
+
+  Pvl pvl;
+  pvl.addObject(o);
+  return pvl;
+}
+
+
+/**
+ * Fills the search chip with a textured image containing a few special
+ * pixels and copies part of it, with noise, into the pattern chip.
+ */
+static void loadChips(AutoReg &ar) {
+  Chip &search = *ar.SearchChip();
+  for (int line = 1; line <= search.Lines(); line++) {
+    for (int samp = 1; samp <= search.Samples(); samp++) {
+      double dn = 500.0 + 80.0 * sin(0.21 * samp) * cos(0.17 * line) +
+                  40.0 * cos(0.05 * samp * line / 10.0) + 0.1 * ((samp * 7 + line * 3) % 11);
+      if ((samp * 13 + line * 5) % 29 == 0) {
+        dn = Isis::Null;
+      }
+      search.SetValue(samp, line, dn);
+    }
+  }
+
+  Chip &pattern = *ar.PatternChip();
+  for (int line = 1; line <= pattern.Lines(); line++) {
+    for (int samp = 1; samp <= pattern.Samples(); samp++) {
+      double dn = search.GetValue(samp + 17, line + 9);
+      if (!IsSpecial(dn)) {
+        dn += 0.3 * sin(1.3 * samp + 0.7 * line);
+      }
+      if ((samp + line) % 17 == 0) {
+        dn = Isis::Lrs;
+      }
+      pattern.SetValue(samp, line, dn);
+    }
+  }
+}
+
+
+TEST(MinimumDifference, MatchesSampleBySampleSum) {
+  Pvl pvl = minimumDifferencePvl();
+  TestMinimumDifference ar(pvl);
+  loadChips(ar);
+
+  Chip &pattern = *ar.PatternChip();
+  Chip &search = *ar.SearchChip();
+  Chip subsearch(pattern.Samples(), pattern.Lines());
+
+  for (int line = 1; line <= search.Lines() - pattern.Lines() + 1; line++) {
+    for (int samp = 1; samp <= search.Samples() - pattern.Samples() + 1; samp++) {
+      int centerSamp = samp + (pattern.Samples() - 1) / 2;
+      int centerLine = line + (pattern.Lines() - 1) / 2;
+      search.Extract(centerSamp, centerLine, subsearch);
+
+      double expected = 0.0;
+      double count = 0;
+      for (int l = 1; l <= pattern.Lines(); l++) {
+        for (int s = 1; s <= pattern.Samples(); s++) {
+          double pdn = pattern.GetValue(s, l);
+          double sdn = subsearch.GetValue(s, l);
+          if (IsSpecial(pdn) || IsSpecial(sdn)) continue;
+          expected += fabs(pdn - sdn);
+          count++;
+        }
+      }
+
+      EXPECT_EQ(ar.Match(pattern, subsearch), expected / count) << samp << ", " << line;
+    }
+  }
+}
+
+
+TEST(MinimumDifference, RegistersLikeSampleBySampleSum) {
+  Pvl pvl = minimumDifferencePvl();
+  MinimumDifference ar(pvl);
+  ReferenceMinimumDifference reference(pvl);
+  loadChips(ar);
+  loadChips(reference);
+
+  EXPECT_EQ(ar.Register(), AutoReg::SuccessPixel);
+  EXPECT_EQ(reference.Register(), AutoReg::SuccessPixel);
+  EXPECT_EQ(ar.GoodnessOfFit(), reference.GoodnessOfFit());
+  EXPECT_EQ(ar.ChipSample(), reference.ChipSample());
+  EXPECT_EQ(ar.ChipLine(), reference.ChipLine());
+  EXPECT_EQ(ar.ChipSample(), 25.0);
+  EXPECT_EQ(ar.ChipLine(), 16.0);
+}
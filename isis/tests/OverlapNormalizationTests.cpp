@@ -0,0 +1,115 @@
+#include <cmath>
+#include <vector>
+
+#include "IException.h"
+#include "LeastSquares.h"
+#include "OverlapNormalization.h"
+#include "Statistics.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// Statistics of two pixels with the given average and spread
+static Statistics pixels(double average, double spread) {
+  Statistics stats;
+  stats.AddData(average - spread);
+  stats.AddData(average + spread);
+  return stats;
+}
+
+
+// A chain of images where each image is 1 brighter and 1% more contrasty than the previous one
+static OverlapNormalization *chain(int images) {
+  std::vector<Statistics *> statsList;
+  for (int i = 0; i < images; i++) {
+    statsList.push_back(new Statistics(pixels(100.0 + i, 10.0)));
+  }
+
+  OverlapNormalization *oNorm = new OverlapNormalization(statsList);
+  for (int i = 0; i < images - 1; i++) {
+    oNorm->AddOverlap(pixels(100.0 + i, 10.0 * pow(1.01, i)), i,
+                      pixels(101.0 + i, 10.0 * pow(1.01, i + 1)), i + 1, 1000.0);
+  }
+  oNorm->AddHold(0);
+  return oNorm;
+}
+
+
+TEST(OverlapNormalization, SparseMatchesDense) {
+  OverlapNormalization *dense = chain(6);
+  OverlapNormalization *sparse = chain(6);
+  OverlapNormalization *cg = chain(6);
+  dense->Solve(OverlapNormalization::Both, LeastSquares::QRD);
+  sparse->Solve(OverlapNormalization::Both, LeastSquares::SPARSE);
+  cg->Solve(OverlapNormalization::Both, LeastSquares::CG);
+
+  for (int i = 0; i < 6; i++) {
+    EXPECT_NEAR(dense->Offset(i), -i, 1.0e-8);
+    EXPECT_NEAR(dense->Gain(i), pow(1.01, -i), 1.0e-8);
+
+    // The sparse methods weight every parameter a little
+    EXPECT_NEAR(sparse->Offset(i), dense->Offset(i), 1.0e-4);
+    EXPECT_NEAR(sparse->Gain(i), dense->Gain(i), 1.0e-4);
+    EXPECT_NEAR(cg->Offset(i), sparse->Offset(i), 1.0e-8);
+    EXPECT_NEAR(cg->Gain(i), sparse->Gain(i), 1.0e-8);
+  }
+
+  delete dense;
+  delete sparse;
+  delete cg;
+}
+
+
+TEST(OverlapNormalization, LargeDenseSetUsesNormalEquations) {
+  int images = OverlapNormalization::MaxDenseSize + 200;
+  OverlapNormalization *oNorm = chain(images);
+  oNorm->Solve(OverlapNormalization::Both, LeastSquares::QRD);
+
+  for (int i = 0; i < images; i += 100) {
+    EXPECT_NEAR(oNorm->Offset(i), -i, 1.0e-6);
+    EXPECT_NEAR(oNorm->Gain(i), pow(1.01, -i), 1.0e-8);
+  }
+  delete oNorm;
+}
+
+
+TEST(OverlapNormalization, SparseWithoutHolds) {
+  // A ring of images, so every image has two overlaps
+  std::vector<Statistics *> sparseStats, cgStats;
+  for (int i = 0; i < 8; i++) {
+    sparseStats.push_back(new Statistics(pixels(50.0 + 3 * i, 5.0)));
+    cgStats.push_back(new Statistics(pixels(50.0 + 3 * i, 5.0)));
+  }
+  OverlapNormalization sparse(sparseStats);
+  OverlapNormalization cg(cgStats);
+  for (int i = 0; i < 8; i++) {
+    int j = (i + 1) % 8;
+    double weight = 100.0 * (i + 1);
+    sparse.AddOverlap(pixels(50.0 + i, 5.0 + i), i, pixels(52.0 + j, 5.0 + j), j, weight);
+    cg.AddOverlap(pixels(50.0 + i, 5.0 + i), i, pixels(52.0 + j, 5.0 + j), j, weight);
+  }
+
+  sparse.Solve(OverlapNormalization::Both, LeastSquares::SPARSE);
+  cg.Solve(OverlapNormalization::Both, LeastSquares::CG);
+  for (int i = 0; i < 8; i++) {
+    EXPECT_NEAR(cg.Offset(i), sparse.Offset(i), 1.0e-8);
+    EXPECT_NEAR(cg.Gain(i), sparse.Gain(i), 1.0e-8);
+  }
+}
+
+
+TEST(OverlapNormalization, CgImageWithoutOverlaps) {
+  std::vector<Statistics *> statsList;
+  for (int i = 0; i < 3; i++) {
+    statsList.push_back(new Statistics(pixels(100.0, 10.0)));
+  }
+  OverlapNormalization oNorm(statsList);
+  oNorm.AddOverlap(pixels(100.0, 10.0), 0, pixels(101.0, 10.0), 1);
+  oNorm.AddOverlap(pixels(100.0, 10.0), 0, pixels(102.0, 10.0), 1);
+  oNorm.AddOverlap(pixels(100.0, 10.0), 1, pixels(102.0, 10.0), 0);
+
+  // Image 2 has no overlaps, but the parameter weight still makes the system solvable
+  oNorm.Solve(OverlapNormalization::Offsets, LeastSquares::CG);
+  EXPECT_NEAR(oNorm.Offset(2), 0.0, 1.0e-12);
+}
@@ -0,0 +1,341 @@
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include <QString>
+#include <QThreadPool>
+
+#include "geos/geom/CoordinateArraySequence.h"
+#include "geos/geom/Envelope.h"
+#include "geos/geom/Geometry.h"
+#include "geos/geom/LinearRing.h"
+#include "geos/geom/Point.h"
+#include "geos/geom/Polygon.h"
+
+#include "Brick.h"
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "IString.h"
+#include "PolygonTools.h"
+#include "ProcessPolygons.h"
+#include "SpecialPixel.h"
+#include "TempFixtures.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// The vertices of an input pixel and the value rasterized into it
+struct TestPolygon {
+  std::vector<double> samples;
+  std::vector<double> lines;
+  double value;
+};
+
+
+static TestPolygon makePolygon(std::vector<double> samples, std::vector<double> lines,
+                               double value) {
+  TestPolygon poly;
+  poly.samples = samples;
+  poly.lines = lines;
+  poly.value = value;
+  return poly;
+}
+
+
+static geos::geom::Polygon *makeGeosPolygon(const std::vector<double> &samples,
+                                            const std::vector<double> &lines) {
+  geos::geom::CoordinateSequence *pts = new geos::geom::CoordinateArraySequence();
+  for (unsigned int i = 0; i < samples.size(); i++) {
+    pts->add(geos::geom::Coordinate(samples[i], lines[i]));
+  }
+  pts->add(geos::geom::Coordinate(samples[0], lines[0]));
+  return globalFactory->createPolygon(globalFactory->createLinearRing(pts), NULL);
+}
+
+
+// Polygons that cross the seams between the 128x128 output tiles of a 300x300 image, some
+// partly outside of it, with special pixels overlapping valid ones
+static std::vector<TestPolygon> seamPolygons() {
+  std::vector<TestPolygon> polys;
+  // A diamond around the first sample and line seam
+  polys.push_back(makePolygon({128.4, 188.7, 128.4, 68.1}, {68.1, 128.4, 188.7, 128.4}, 10.0));
+  // A strip across every tile column and the second line seam
+  polys.push_back(makePolygon({10.25, 290.75, 290.75, 10.25}, {250.4, 250.4, 262.6, 262.6},
+                              20.0));
+  // A triangle across a corner of four tiles, clipped by the right side of the image
+  polys.push_back(makePolygon({200.3, 310.7, 240.1}, {100.2, 140.9, 190.6}, 30.0));
+  // A triangle clipped by the upper left corner of the image
+  polys.push_back(makePolygon({-20.5, 40.3, 30.7}, {-10.2, -5.1, 35.9}, 40.0));
+  // Special pixels over the diamond and the strip, followed by valid pixels over them
+  polys.push_back(makePolygon({110.3, 150.6, 150.6, 110.3}, {110.2, 110.2, 150.8, 150.8},
+                              Lrs));
+  polys.push_back(makePolygon({120.1, 140.2, 140.2, 120.1}, {240.3, 240.3, 270.7, 270.7},
+                              Null));
+  polys.push_back(makePolygon({100.6, 160.4, 130.2}, {100.3, 120.9, 170.4}, 50.0));
+  polys.push_back(makePolygon({125.3, 135.9, 135.9, 125.3}, {245.1, 245.1, 265.2, 265.2},
+                              60.0));
+  return polys;
+}
+
+
+// Adds a value to the average and count of an output pixel the same way ProcessPolygons does
+static void addReferenceValue(double inputDn, double &average, double &count) {
+  if (IsValidPixel(inputDn)) {
+    if (IsValidPixel(average)) {
+      double currentCount = count++;
+      average = ((average * currentCount) + inputDn) / count;
+    }
+    else {
+      average = inputDn;
+      count = 1;
+    }
+  }
+  else if (average == Null || inputDn != Null) {
+    average = inputDn;
+  }
+}
+
+
+// Rasterizes the polygons one output pixel at a time with GEOS, the way ProcessPolygons
+// used to, into averages and counts that start out as Null
+static void referenceRasterize(const std::vector<TestPolygon> &polys, int samples, int lines,
+                               bool useCenter, std::vector<double> &average,
+                               std::vector<double> &count) {
+  if (average.empty()) {
+    average.assign(samples * lines, Null);
+    count.assign(samples * lines, Null);
+  }
+
+  geos::geom::Polygon *image = makeGeosPolygon({0.0, (double) samples, (double) samples, 0.0},
+                                               {0.0, 0.0, (double) lines, (double) lines});
+  for (unsigned int p = 0; p < polys.size(); p++) {
+    geos::geom::Polygon *poly = makeGeosPolygon(polys[p].samples, polys[p].lines);
+    geos::geom::Geometry *clipped = image->intersection(poly);
+    if (clipped->getArea() - DBL_EPSILON > DBL_EPSILON) {
+      const geos::geom::Envelope *envelope = clipped->getEnvelopeInternal();
+      for (int y = std::max(1, (int) floor(envelope->getMinY()));
+           y <= std::min(lines, (int) ceil(envelope->getMaxY())); y++) {
+        for (int x = std::max(1, (int) floor(envelope->getMinX()));
+             x <= std::min(samples, (int) ceil(envelope->getMaxX())); x++) {
+          bool covered;
+          if (useCenter) {
+            geos::geom::Point *center = globalFactory->createPoint(geos::geom::Coordinate(x, y));
+            covered = clipped->contains(center);
+            delete center;
+          }
+          else {
+            geos::geom::Polygon *pixel = makeGeosPolygon({x - 0.5, x + 0.5, x + 0.5, x - 0.5},
+                                                         {y - 0.5, y - 0.5, y + 0.5, y + 0.5});
+            covered = clipped->intersects(pixel);
+            delete pixel;
+          }
+          if (covered) {
+            int index = (y - 1) * samples + (x - 1);
+            addReferenceValue(polys[p].value, average[index], count[index]);
+          }
+        }
+      }
+    }
+    delete clipped;
+    delete poly;
+  }
+  delete image;
+}
+
+
+static void rasterize(ProcessPolygons &process, const std::vector<TestPolygon> &polys) {
+  for (unsigned int p = 0; p < polys.size(); p++) {
+    std::vector<double> samples = polys[p].samples;
+    std::vector<double> lines = polys[p].lines;
+    std::vector<double> values(1, polys[p].value);
+    process.Rasterize(samples, lines, values);
+  }
+}
+
+
+// Rasterizes the polygons into new average and count cubes
+static void rasterizeToCubes(const std::vector<TestPolygon> &polys, int samples, int lines,
+                             bool useCenter, QString averagePath, QString countPath) {
+  ProcessPolygons process;
+  CubeAttributeOutput atts;
+  atts.setPixelType(Real);
+  process.SetStatCubes(averagePath, countPath, atts, samples, lines, 1);
+  process.SetIntersectAlgorithm(useCenter);
+  rasterize(process, polys);
+  process.Finalize();
+}
+
+
+static std::vector<double> readCube(QString path) {
+  Cube cube(path);
+  Brick brick(cube.sampleCount(), cube.lineCount(), cube.bandCount(), cube.pixelType());
+  brick.SetBasePosition(1, 1, 1);
+  cube.read(brick);
+  return std::vector<double>(brick.DoubleBuffer(), brick.DoubleBuffer() + brick.size());
+}
+
+
+// Counts the pixels that differ from the expected ones, describing the first one
+static int countDifferences(const std::vector<double> &actual,
+                            const std::vector<double> &expected, int samples,
+                            QString &first) {
+  int differences = 0;
+  for (unsigned int i = 0; i < expected.size(); i++) {
+    bool same = (IsSpecial(expected[i]) || IsSpecial(actual[i])) ?
+                (actual[i] == expected[i]) : (fabs(actual[i] - expected[i]) < 1.0e-4);
+    if (!same) {
+      if (differences == 0) {
+        first = "sample " + toString((int) (i % samples) + 1) + " line " +
+                toString((int) (i / samples) + 1) + " is " + toString(actual[i]) +
+                " instead of " + toString(expected[i]);
+      }
+      differences++;
+    }
+  }
+  return differences;
+}
+
+
+static void expectSameAsReference(QString averagePath, QString countPath,
+                                  const std::vector<double> &average,
+                                  const std::vector<double> &count, int samples) {
+  QString first;
+  EXPECT_EQ(countDifferences(readCube(averagePath), average, samples, first), 0)
+      << "Average " << first.toStdString();
+  EXPECT_EQ(countDifferences(readCube(countPath), count, samples, first), 0)
+      << "Count " << first.toStdString();
+}
+
+
+TEST_F(TempTestingFiles, ProcessPolygonsCentersAcrossTileSeams) {
+  std::vector<TestPolygon> polys = seamPolygons();
+  QString averagePath = tempDir.path() + "/average.cub";
+  QString countPath = tempDir.path() + "/count.cub";
+  rasterizeToCubes(polys, 300, 300, true, averagePath, countPath);
+
+  std::vector<double> average, count;
+  referenceRasterize(polys, 300, 300, true, average, count);
+  expectSameAsReference(averagePath, countPath, average, count, 300);
+
+  // The pixels on both sides of the first sample seam in the diamond are covered
+  std::vector<double> written = readCube(countPath);
+  EXPECT_EQ(written[(99 - 1) * 300 + (128 - 1)], 1.0);
+  EXPECT_EQ(written[(99 - 1) * 300 + (129 - 1)], 1.0);
+}
+
+
+TEST_F(TempTestingFiles, ProcessPolygonsTouchesAcrossTileSeams) {
+  std::vector<TestPolygon> polys = seamPolygons();
+  QString averagePath = tempDir.path() + "/average.cub";
+  QString countPath = tempDir.path() + "/count.cub";
+  rasterizeToCubes(polys, 300, 300, false, averagePath, countPath);
+
+  std::vector<double> average, count;
+  referenceRasterize(polys, 300, 300, false, average, count);
+  expectSameAsReference(averagePath, countPath, average, count, 300);
+
+  // Touching the pixel covers more of them than using their centers
+  std::vector<double> centerAverage, centerCount;
+  referenceRasterize(polys, 300, 300, true, centerAverage, centerCount);
+  int touched = 0, centers = 0;
+  for (unsigned int i = 0; i < count.size(); i++) {
+    if (count[i] != Null) touched++;
+    if (centerCount[i] != Null) centers++;
+  }
+  EXPECT_GT(touched, centers);
+}
+
+
+TEST_F(TempTestingFiles, ProcessPolygonsFlushesPendingPolygons) {
+  // More polygons than are buffered before they are rasterized, each over one pixel center
+  int samples = 100, lines = 100;
+  int polygons = 101000;
+  std::vector<double> sums(samples * lines, 0.0);
+  std::vector<double> expectedCount(samples * lines, Null);
+
+  ProcessPolygons process;
+  CubeAttributeOutput atts;
+  atts.setPixelType(Real);
+  QString averagePath = tempDir.path() + "/average.cub";
+  QString countPath = tempDir.path() + "/count.cub";
+  process.SetStatCubes(averagePath, countPath, atts, samples, lines, 1);
+  for (int i = 0; i < polygons; i++) {
+    int pixel = i % (samples * lines);
+    double sample = pixel % samples + 1;
+    double line = pixel / samples + 1;
+    std::vector<double> pixelSamples = {sample - 0.3, sample + 0.3, sample + 0.3, sample - 0.3};
+    std::vector<double> pixelLines = {line - 0.3, line - 0.3, line + 0.3, line + 0.3};
+    std::vector<double> values(1, i % 13);
+    process.Rasterize(pixelSamples, pixelLines, values);
+
+    sums[pixel] += i % 13;
+    expectedCount[pixel] = (expectedCount[pixel] == Null) ? 1 : expectedCount[pixel] + 1;
+  }
+  process.Finalize();
+
+  std::vector<double> expectedAverage(samples * lines);
+  for (unsigned int i = 0; i < sums.size(); i++) {
+    expectedAverage[i] = sums[i] / expectedCount[i];
+  }
+  expectSameAsReference(averagePath, countPath, expectedAverage, expectedCount, samples);
+}
+
+
+TEST_F(TempTestingFiles, ProcessPolygonsAppendOutputCube) {
+  std::vector<TestPolygon> first = seamPolygons();
+  std::vector<TestPolygon> second;
+  second.push_back(makePolygon({90.2, 210.8, 150.5}, {60.4, 80.1, 230.7}, 70.0));
+  second.push_back(makePolygon({5.6, 295.3, 295.3, 5.6}, {255.2, 255.2, 258.9, 258.9}, Hrs));
+  second.push_back(makePolygon({130.4, 170.9, 170.9, 130.4}, {115.6, 115.6, 145.3, 145.3},
+                               80.0));
+
+  QString averagePath = tempDir.path() + "/average.cub";
+  QString countPath = tempDir.path() + "/count.cub";
+  rasterizeToCubes(first, 300, 300, true, averagePath, countPath);
+
+  ProcessPolygons process;
+  process.AppendOutputCube(averagePath, countPath);
+  rasterize(process, second);
+  process.Finalize();
+
+  std::vector<double> average, count;
+  referenceRasterize(first, 300, 300, true, average, count);
+  referenceRasterize(second, 300, 300, true, average, count);
+  expectSameAsReference(averagePath, countPath, average, count, 300);
+}
+
+
+TEST_F(TempTestingFiles, ProcessPolygonsThreadsMatchSerial) {
+  // Overlapping polygons spread over every tile, with some special pixels
+  std::vector<TestPolygon> polys = seamPolygons();
+  unsigned int seed = 12345;
+  for (int i = 0; i < 400; i++) {
+    std::vector<double> coords;
+    for (int c = 0; c < 3; c++) {
+      seed = seed * 1103515245 + 12345;
+      coords.push_back(((seed >> 8) % 30000) / 100.0 + 0.013);
+    }
+    double size = 3.0 + (i % 17) * 2.7;
+    double value = (i % 23 == 0) ? Lis : 1.0 + (i % 11);
+    polys.push_back(makePolygon({coords[0], coords[0] + size, coords[1]},
+                                {coords[2], coords[2] + size / 3.0, coords[2] + size}, value));
+  }
+
+  int originalThreads = QThreadPool::globalInstance()->maxThreadCount();
+  for (int mode = 0; mode < 2; mode++) {
+    bool useCenter = (mode == 0);
+    QString prefix = tempDir.path() + (useCenter ? "/center" : "/touch");
+
+    QThreadPool::globalInstance()->setMaxThreadCount(1);
+    rasterizeToCubes(polys, 300, 300, useCenter, prefix + "Serial.cub",
+                     prefix + "SerialCount.cub");
+    QThreadPool::globalInstance()->setMaxThreadCount(4);
+    rasterizeToCubes(polys, 300, 300, useCenter, prefix + "Threaded.cub",
+                     prefix + "ThreadedCount.cub");
+    QThreadPool::globalInstance()->setMaxThreadCount(originalThreads);
+
+    EXPECT_EQ(readCube(prefix + "Threaded.cub"), readCube(prefix + "Serial.cub"));
+    EXPECT_EQ(readCube(prefix + "ThreadedCount.cub"), readCube(prefix + "SerialCount.cub"));
+  }
+}
@@ -0,0 +1,111 @@
+#include <QString>
+
+#include "IException.h"
+#include "IString.h"
+#include "PvlKeyword.h"
+#include "Resource.h"
+#include "ResourceColumns.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+// Resources with a number, a value that is not a number, a missing value and two values
+static ResourceList resources() {
+  ResourceList list;
+
+  SharedResource number(new Resource("Number"));
+  number->add("Value", "1.5");
+  list.append(number);
+
+  SharedResource text(new Resource("Text"));
+  text->add("Value", "abc");
+  list.append(text);
+
+  SharedResource missing(new Resource("Missing"));
+  missing->add("Other", "2.0");
+  list.append(missing);
+
+  SharedResource array(new Resource("Array"));
+  PvlKeyword values("Value");
+  values.addValue("3.0");
+  values.addValue("4.5");
+  array->add(values);
+  list.append(array);
+
+  return list;
+}
+
+
+TEST(ResourceColumns, ConvertsValues) {
+  ResourceList list = resources();
+  ResourceColumns columns(list);
+  ASSERT_EQ(columns.size(), 4);
+  EXPECT_EQ(columns.resource(2)->name().toStdString(), "Missing");
+
+  EXPECT_TRUE(columns.exists(0, "Value"));
+  EXPECT_DOUBLE_EQ(columns.value(0, "Value"), 1.5);
+  EXPECT_TRUE(columns.exists(3, "Value"));
+  EXPECT_DOUBLE_EQ(columns.value(3, "Value"), 3.0);
+  EXPECT_DOUBLE_EQ(columns.value(3, "Value", 1), 4.5);
+
+  // Keyword names are not case sensitive, as in the Resources
+  EXPECT_DOUBLE_EQ(columns.value(0, "VALUE"), 1.5);
+  EXPECT_DOUBLE_EQ(columns.column("value").value(3), 3.0);
+}
+
+
+TEST(ResourceColumns, UnusableValuesThrowConversionError) {
+  ResourceList list = resources();
+  ResourceColumns columns(list);
+
+  // A value that is not a number exists, but throws the error converting it does
+  EXPECT_TRUE(columns.exists(1, "Value"));
+  try {
+    columns.value(1, "Value");
+    FAIL() << "Expected an exception for a value that is not a number";
+  }
+  catch (IException &e) {
+    try {
+      toDouble(list[1]->value("Value"));
+      FAIL() << "Expected the conversion to throw";
+    }
+    catch (IException &expected) {
+      EXPECT_EQ(e.toString().toStdString(), expected.toString().toStdString());
+    }
+  }
+
+  // A missing keyword does not exist and throws
+  EXPECT_FALSE(columns.exists(2, "Value"));
+  EXPECT_THROW(columns.value(2, "Value"), IException);
+
+  // So does an index past the values of the keyword
+  EXPECT_TRUE(columns.exists(0, "Value", 1));
+  EXPECT_THROW(columns.value(0, "Value", 1), IException);
+}
+
+
+TEST(ResourceColumns, Update) {
+  ResourceList list = resources();
+  ResourceColumns columns(list);
+  EXPECT_DOUBLE_EQ(columns.value(0, "Value"), 1.5);
+  EXPECT_FALSE(columns.exists(2, "Value"));
+
+  // The columns keep the values they converted until they are updated
+  list[0]->add("Value", "7.0");
+  list[1]->add("Value", "8.0");
+  list[2]->add("Value", "9.0");
+  EXPECT_DOUBLE_EQ(columns.value(0, "Value"), 1.5);
+
+  columns.update(0, "Value");
+  columns.update(1, "value");
+  columns.update(2, "VALUE");
+  EXPECT_DOUBLE_EQ(columns.value(0, "Value"), 7.0);
+  EXPECT_DOUBLE_EQ(columns.value(1, "Value"), 8.0);
+  EXPECT_TRUE(columns.exists(2, "Value"));
+  EXPECT_DOUBLE_EQ(columns.value(2, "Value"), 9.0);
+
+  // Columns asked for after a change read the current values
+  list[3]->add("Other", "5.0");
+  EXPECT_DOUBLE_EQ(columns.value(3, "Other"), 5.0);
+}
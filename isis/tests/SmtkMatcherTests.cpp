@@ -0,0 +1,107 @@
+#include <QFile>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QVector>
+
+#include "NetworkFixtures.h"
+#include "SmtkMatcher.h"
+#include "SmtkPoint.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+static QString writeRegDef(const QString &dir) {
+  QString regdef = dir + "/smtk.def";
+  QFile file(regdef);
+  file.open(QIODevice::WriteOnly | QIODevice::Text);
+  QTextStream stream(&file);
+  stream << "Object = AutoRegistration\n"
+            "  Group = Algorithm\n"
+            "    Name                       = AdaptiveGruen\n"
+            "    Tolerance                  = 0.9\n"
+            "    MaximumIterations          = 30\n"
+            "    AffineTolerance            = 4.5\n"
+            "    SpiceTolerance             = 5.0\n"
+            "    AffineTranslationTolerance = 0.1\n"
+            "    AffineScaleTolerance       = 0.3\n"
+            "    AffineShearTolerance       = 0.3\n"
+            "  EndGroup\n"
+            "  Group = PatternChip\n"
+            "    Samples = 21\n"
+            "    Lines   = 21\n"
+            "  EndGroup\n"
+            "  Group = SearchChip\n"
+            "    Samples = 31\n"
+            "    Lines   = 31\n"
+            "  EndGroup\n"
+            "EndObject\n";
+  return regdef;
+}
+
+
+static void expectSamePoints(const QVector<SmtkPoint> &serial,
+                             const QVector<SmtkPoint> &parallel) {
+  ASSERT_EQ(parallel.size(), serial.size());
+  for (int i = 0; i < serial.size(); i++) {
+    EXPECT_EQ(parallel[i].isValid(), serial[i].isValid()) << i;
+    EXPECT_EQ(parallel[i].isRegistered(), serial[i].isRegistered()) << i;
+    EXPECT_EQ(parallel[i].getLeft().getLine(), serial[i].getLeft().getLine()) << i;
+    EXPECT_EQ(parallel[i].getLeft().getSample(), serial[i].getLeft().getSample()) << i;
+    EXPECT_EQ(parallel[i].getRight().getLine(), serial[i].getRight().getLine()) << i;
+    EXPECT_EQ(parallel[i].getRight().getSample(), serial[i].getRight().getSample()) << i;
+    if (serial[i].isValid() && serial[i].isRegistered()) {
+      EXPECT_EQ(parallel[i].GoodnessOfFit(), serial[i].GoodnessOfFit()) << i;
+    }
+  }
+}
+
+
+TEST_F(ThreeImageNetwork, SmtkMatcherParallelGrowMatchesSerial) {
+  QString regdef = writeRegDef(tempDir.path());
+  SmtkMatcher serialMatcher(regdef, cube1, cube2);
+  SmtkMatcher parallelMatcher(regdef, cube1, cube2);
+
+  int originalThreads = QThreadPool::globalInstance()->maxThreadCount();
+  QThreadPool::globalInstance()->setMaxThreadCount(4);
+
+  // Register a grid of seeds one at a time and in a concurrent batch
+  QVector<Coordinate> seeds;
+  for (int line = 1; line <= 5; line++) {
+    for (int samp = 1; samp <= 5; samp++) {
+      seeds.append(Coordinate(line * cube1->lineCount() / 6.0,
+                              samp * cube1->sampleCount() / 6.0));
+    }
+  }
+
+  QVector<SmtkPoint> serialSeeds;
+  foreach (const Coordinate &seed, seeds) {
+    serialSeeds.append(serialMatcher.Register(seed));
+  }
+  QVector<SmtkPoint> parallelSeeds = parallelMatcher.Register(seeds);
+  expectSamePoints(serialSeeds, parallelSeeds);
+
+  // Grow each seed to its neighbors as smtk does, one at a time and in a
+  // concurrent batch
+  QVector<SmtkPoint> grown;
+  int spacing = 3;
+  foreach (const SmtkPoint &seed, serialSeeds) {
+    if (!seed.isValid()) continue;
+    for (int dline = -spacing; dline <= spacing; dline += spacing) {
+      for (int dsamp = -spacing; dsamp <= spacing; dsamp += spacing) {
+        if (dline == 0 && dsamp == 0) continue;
+        Coordinate left = seed.getLeft() + Coordinate(dline, dsamp);
+        grown.append(serialMatcher.Clone(seed, left));
+      }
+    }
+  }
+
+  QVector<SmtkPoint> serialGrown;
+  foreach (const SmtkPoint &point, grown) {
+    serialGrown.append(serialMatcher.Register(point, point.getAffine()));
+  }
+  QVector<SmtkPoint> parallelGrown = parallelMatcher.Register(grown);
+  expectSamePoints(serialGrown, parallelGrown);
+
+  QThreadPool::globalInstance()->setMaxThreadCount(originalThreads);
+}
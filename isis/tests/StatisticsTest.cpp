@@ -203,6 +203,43 @@ TEST(Statistics,ValidRange) {
 
 
 
+TEST(Statistics,AddStatistics) {
+
+    double a[6] = {1.0, 2.0, Null, 3.0, 10.0, Lrs};
+
+    Statistics all;
+    all.SetValidRange(1.0,6.0);
+    all.AddData(a,6);
+
+    Statistics first;
+    first.SetValidRange(1.0,6.0);
+    first.AddData(a,3);
+
+    Statistics second;
+    second.SetValidRange(1.0,6.0);
+    second.AddData(a + 3,3);
+
+    Statistics empty;
+    empty.SetValidRange(1.0,6.0);
+
+    first.AddStatistics(empty);
+    first.AddStatistics(second);
+
+    EXPECT_DOUBLE_EQ(first.Sum(),all.Sum());
+    EXPECT_DOUBLE_EQ(first.SumSquare(),all.SumSquare());
+    EXPECT_DOUBLE_EQ(first.Average(),all.Average());
+    EXPECT_DOUBLE_EQ(first.Variance(),all.Variance());
+    EXPECT_DOUBLE_EQ(first.Minimum(),1.0);
+    EXPECT_DOUBLE_EQ(first.Maximum(),3.0);
+    EXPECT_DOUBLE_EQ(first.TotalPixels(),all.TotalPixels());
+    EXPECT_DOUBLE_EQ(first.ValidPixels(),all.ValidPixels());
+    EXPECT_DOUBLE_EQ(first.NullPixels(),1.0);
+    EXPECT_DOUBLE_EQ(first.LrsPixels(),1.0);
+    EXPECT_DOUBLE_EQ(first.OverRangePixels(),1.0);
+
+}
+
+
 TEST(Statistics,XMLReadWrite) {
 
     Statistics s;
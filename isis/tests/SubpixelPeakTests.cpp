@@ -0,0 +1,249 @@
+#include <cmath>
+#include <vector>
+
+#include "AutoReg.h"
+#include "AutoRegFactory.h"
+#include "Chip.h"
+#include "IException.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+#include "SubpixelPeak.h"
+
+#include "gtest/gtest.h"
+
+using namespace Isis;
+
+// A quadratic surface with its maximum at (peakSamp, peakLine)
+static std::vector<double> quadraticSurface(int samples, int lines,
+                                            double peakSamp, double peakLine) {
+  std::vector<double> surface(samples * lines);
+  for (int line = 0; line < lines; line++) {
+    for (int samp = 0; samp < samples; samp++) {
+      double x = samp - peakSamp;
+      double y = line - peakLine;
+      surface[line * samples + samp] = 10.0 - 2.0 * x * x - 0.5 * x * y - y * y;
+    }
+  }
+  return surface;
+}
+
+
+// A correlation like Gaussian peak at (peakSamp, peakLine)
+static void gaussianSurface(std::vector<double> &surface, int samples, int lines,
+                            double peakSamp, double peakLine) {
+  surface.resize(samples * lines);
+  for (int line = 0; line < lines; line++) {
+    for (int samp = 0; samp < samples; samp++) {
+      double x = samp - peakSamp;
+      double y = line - peakLine;
+      surface[line * samples + samp] = exp(-(x * x + y * y) / 4.5);
+    }
+  }
+}
+
+
+TEST(SubpixelPeak, ParaboloidOfQuadratic) {
+  std::vector<double> surface = quadraticSurface(9, 7, 4.3, 2.8);
+
+  double sampleOffset, lineOffset;
+  ASSERT_TRUE(SubpixelPeak::Paraboloid(&surface[0], 9, 7, 4, 3, 5, sampleOffset, lineOffset));
+  EXPECT_NEAR(sampleOffset, 0.3, 1.0e-10);
+  EXPECT_NEAR(lineOffset, -0.2, 1.0e-10);
+
+  // Minima are found as well
+  for (unsigned int i = 0; i < surface.size(); i++) {
+    surface[i] = -surface[i];
+  }
+  ASSERT_TRUE(SubpixelPeak::Paraboloid(&surface[0], 9, 7, 4, 3, 5, sampleOffset, lineOffset));
+  EXPECT_NEAR(sampleOffset, 0.3, 1.0e-10);
+  EXPECT_NEAR(lineOffset, -0.2, 1.0e-10);
+}
+
+
+TEST(SubpixelPeak, ParaboloidSkipsSpecialPixels) {
+  std::vector<double> surface = quadraticSurface(7, 7, 3.25, 3.4);
+  surface[2 * 7 + 2] = Null;
+  surface[4 * 7 + 3] = Lrs;
+  surface[3 * 7 + 5] = His;
+
+  double sampleOffset, lineOffset;
+  ASSERT_TRUE(SubpixelPeak::Paraboloid(&surface[0], 7, 7, 3, 3, 5, sampleOffset, lineOffset));
+  EXPECT_NEAR(sampleOffset, 0.25, 1.0e-10);
+  EXPECT_NEAR(lineOffset, 0.4, 1.0e-10);
+
+  // Too few valid pixels
+  for (unsigned int i = 0; i < surface.size(); i++) {
+    if (i != 3 * 7 + 3) surface[i] = Null;
+  }
+  EXPECT_FALSE(SubpixelPeak::Paraboloid(&surface[0], 7, 7, 3, 3, 5, sampleOffset, lineOffset));
+}
+
+
+TEST(SubpixelPeak, ParaboloidClipsWindowToSurface) {
+  std::vector<double> surface = quadraticSurface(6, 5, 0.4, 0.1);
+
+  double sampleOffset, lineOffset;
+  ASSERT_TRUE(SubpixelPeak::Paraboloid(&surface[0], 6, 5, 0, 0, 5, sampleOffset, lineOffset));
+  EXPECT_NEAR(sampleOffset, 0.4, 1.0e-10);
+  EXPECT_NEAR(lineOffset, 0.1, 1.0e-10);
+}
+
+
+TEST(SubpixelPeak, ParaboloidRejectsSaddle) {
+  std::vector<double> surface(25);
+  for (int line = 0; line < 5; line++) {
+    for (int samp = 0; samp < 5; samp++) {
+      double x = samp - 2;
+      double y = line - 2;
+      surface[line * 5 + samp] = x * x - y * y;
+    }
+  }
+
+  double sampleOffset, lineOffset;
+  EXPECT_FALSE(SubpixelPeak::Paraboloid(&surface[0], 5, 5, 2, 2, 5, sampleOffset, lineOffset));
+}
+
+
+TEST(SubpixelPeak, Parabola) {
+  std::vector<double> surface(25);
+  for (int line = 0; line < 5; line++) {
+    for (int samp = 0; samp < 5; samp++) {
+      double x = samp - 2.35;
+      double y = line - 1.9;
+      surface[line * 5 + samp] = 1.0 - x * x - 3.0 * y * y;
+    }
+  }
+
+  double sampleOffset, lineOffset;
+  ASSERT_TRUE(SubpixelPeak::Parabola(&surface[0], 5, 5, 2, 2, sampleOffset, lineOffset));
+  EXPECT_NEAR(sampleOffset, 0.35, 1.0e-12);
+  EXPECT_NEAR(lineOffset, -0.1, 1.0e-12);
+
+  // On the edge of the surface
+  EXPECT_FALSE(SubpixelPeak::Parabola(&surface[0], 5, 5, 0, 2, sampleOffset, lineOffset));
+  EXPECT_FALSE(SubpixelPeak::Parabola(&surface[0], 5, 5, 2, 4, sampleOffset, lineOffset));
+
+  // Invalid neighbor
+  surface[1 * 5 + 2] = Null;
+  EXPECT_FALSE(SubpixelPeak::Parabola(&surface[0], 5, 5, 2, 2, sampleOffset, lineOffset));
+}
+
+
+// The phase correlation surface of two periodic signals of a period shifted by (shiftSamp,
+// shiftLine). Its peak is a Dirichlet kernel, which is a sinc for a long period.
+static std::vector<double> phaseCorrelationSurface(int samples, int lines, int period,
+                                                   double shiftSamp, double shiftLine) {
+  std::vector<double> surface(samples * lines);
+  for (int line = 0; line < lines; line++) {
+    for (int samp = 0; samp < samples; samp++) {
+      double x = M_PI * (samp - shiftSamp);
+      double y = M_PI * (line - shiftLine);
+      double cx = (fabs(x) < 1.0e-12) ? 1.0 : sin(x) / (period * sin(x / period));
+      double cy = (fabs(y) < 1.0e-12) ? 1.0 : sin(y) / (period * sin(y / period));
+      surface[line * samples + samp] = cx * cy;
+    }
+  }
+  return surface;
+}
+
+
+TEST(SubpixelPeak, PhaseCorrelation) {
+  // Shifts toward both neighbors of the peak at (3, 2)
+  std::vector<double> surface = phaseCorrelationSurface(7, 5, 4096, 3.3, 1.75);
+
+  double sampleOffset, lineOffset;
+  ASSERT_TRUE(SubpixelPeak::PhaseCorrelation(&surface[0], 7, 5, 3, 2, sampleOffset, lineOffset));
+  EXPECT_NEAR(sampleOffset, 0.3, 1.0e-6);
+  EXPECT_NEAR(lineOffset, -0.25, 1.0e-6);
+
+  // A short period is not quite a sinc
+  surface = phaseCorrelationSurface(7, 5, 32, 3.3, 1.75);
+  ASSERT_TRUE(SubpixelPeak::PhaseCorrelation(&surface[0], 7, 5, 3, 2, sampleOffset, lineOffset));
+  EXPECT_NEAR(sampleOffset, 0.3, 0.01);
+  EXPECT_NEAR(lineOffset, -0.25, 0.01);
+
+  // No shift
+  surface = phaseCorrelationSurface(7, 5, 4096, 3.0, 2.0);
+  ASSERT_TRUE(SubpixelPeak::PhaseCorrelation(&surface[0], 7, 5, 3, 2, sampleOffset, lineOffset));
+  EXPECT_NEAR(sampleOffset, 0.0, 1.0e-12);
+  EXPECT_NEAR(lineOffset, 0.0, 1.0e-12);
+
+  // Not the maximum, on the edge of the surface and an invalid neighbor
+  surface = phaseCorrelationSurface(7, 5, 4096, 3.3, 1.75);
+  EXPECT_FALSE(SubpixelPeak::PhaseCorrelation(&surface[0], 7, 5, 2, 2, sampleOffset, lineOffset));
+  EXPECT_FALSE(SubpixelPeak::PhaseCorrelation(&surface[0], 7, 5, 3, 0, sampleOffset, lineOffset));
+  surface[2 * 7 + 4] = Null;
+  EXPECT_FALSE(SubpixelPeak::PhaseCorrelation(&surface[0], 7, 5, 3, 2, sampleOffset, lineOffset));
+}
+
+
+static Pvl registrationPvl(QString method) {
+  PvlGroup alg("Algorithm");
+  alg += PvlKeyword("Name", "MaximumCorrelation");
+  alg += PvlKeyword("Tolerance", "0.3");
+  alg += PvlKeyword("SubpixelAccuracy", "True");
+
+  PvlGroup pchip("PatternChip");
+  pchip += PvlKeyword("Samples", "15");
+  pchip += PvlKeyword("Lines", "13");
+
+  PvlGroup schip("SearchChip");
+  schip += PvlKeyword("Samples", "41");
+  schip += PvlKeyword("Lines", "37");
+
+  PvlGroup smodel("SurfaceModel");
+  smodel += PvlKeyword("Method", method);
+
+  PvlObject o("AutoRegistration");
+  o.addGroup(alg);
+  o.addGroup(pchip);
+  o.addGroup(schip);
+  o.addGroup(smodel);
+
+  Pvl pvl;
+  pvl.addObject(o);
+  return pvl;
+}
+
+
+static double scene(double samp, double line) {
+  return 500.0 + 80.0 * sin(0.37 * samp) * cos(0.23 * line) + 20.0 * cos(0.11 * samp * line);
+}
+
+
+TEST(SubpixelPeak, AutoRegSurfaceModelMethods) {
+  QStringList methods;
+  methods << "CenterOfMass" << "Paraboloid" << "Parabola";
+  foreach (QString method, methods) {
+    Pvl pvl = registrationPvl(method);
+    AutoReg *ar = AutoRegFactory::Create(pvl);
+    EXPECT_EQ(ar->SurfaceModelMethodString().toStdString(), method.toStdString());
+
+    // The pattern chip center is at sample 25.3, line 16.6 of the search chip
+    Chip &search = *ar->SearchChip();
+    for (int line = 1; line <= search.Lines(); line++) {
+      for (int samp = 1; samp <= search.Samples(); samp++) {
+        search.SetValue(samp, line, scene(samp, line));
+      }
+    }
+    Chip &pattern = *ar->PatternChip();
+    for (int line = 1; line <= pattern.Lines(); line++) {
+      for (int samp = 1; samp <= pattern.Samples(); samp++) {
+        pattern.SetValue(samp, line, scene(samp + 17.3, line + 9.6));
+      }
+    }
+
+    // The correlation peak is broad, so only the least squares fit is close to it
+    double tolerance = (method == "Paraboloid") ? 0.1 : 0.5;
+    ASSERT_EQ(ar->Register(), AutoReg::SuccessSubPixel) << method.toStdString();
+    EXPECT_NEAR(ar->ChipSample(), 25.3, tolerance) << method.toStdString();
+    EXPECT_NEAR(ar->ChipLine(), 16.6, tolerance) << method.toStdString();
+    delete ar;
+  }
+
+  Pvl pvl = registrationPvl("Spline");
+  EXPECT_THROW(AutoRegFactory::Create(pvl), IException);
+}
+
@@ -0,0 +1,126 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+// Accuracy and time per call of each SubpixelPeak method on noisy synthetic peaks. This is a
+// standalone program, not a test, because its output is timing. Run it from the build with
+//   runSubpixelPeakBenchmark [trials]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "SubpixelPeak.h"
+
+using namespace Isis;
+
+// A correlation like Gaussian peak at (peakSamp, peakLine)
+static void gaussianSurface(std::vector<double> &surface, int size,
+                            double peakSamp, double peakLine) {
+  surface.resize(size * size);
+  for (int line = 0; line < size; line++) {
+    for (int samp = 0; samp < size; samp++) {
+      double x = samp - peakSamp;
+      double y = line - peakLine;
+      surface[line * size + samp] = exp(-(x * x + y * y) / 4.5);
+    }
+  }
+}
+
+
+// A phase correlation sinc peak at (peakSamp, peakLine)
+static void sincSurface(std::vector<double> &surface, int size,
+                        double peakSamp, double peakLine) {
+  surface.resize(size * size);
+  for (int line = 0; line < size; line++) {
+    for (int samp = 0; samp < size; samp++) {
+      double x = M_PI * (samp - peakSamp);
+      double y = M_PI * (line - peakLine);
+      double cx = (fabs(x) < 1.0e-12) ? 1.0 : sin(x) / x;
+      double cy = (fabs(y) < 1.0e-12) ? 1.0 : sin(y) / y;
+      surface[line * size + samp] = cx * cy;
+    }
+  }
+}
+
+
+static void benchmark(const char *surfaceName, bool sinc, int trials) {
+  const int size = 9;
+  const int center = size / 2;
+
+  // Peaks on an 8x8 grid of subpixel positions around the center, with uniform noise
+  std::vector<std::vector<double> > surfaces(64);
+  std::vector<double> peakSamps, peakLines;
+  unsigned int seed = 12345;
+  for (unsigned int i = 0; i < surfaces.size(); i++) {
+    double peakSamp = center + (i % 8) / 8.0 - 0.4375;
+    double peakLine = center + (i / 8) / 8.0 - 0.4375;
+    if (sinc) {
+      sincSurface(surfaces[i], size, peakSamp, peakLine);
+    }
+    else {
+      gaussianSurface(surfaces[i], size, peakSamp, peakLine);
+    }
+    for (unsigned int j = 0; j < surfaces[i].size(); j++) {
+      seed = seed * 1103515245 + 12345;
+      surfaces[i][j] += 0.01 * (((seed >> 16) & 0x7fff) / 32767.0 - 0.5);
+    }
+    peakSamps.push_back(peakSamp);
+    peakLines.push_back(peakLine);
+  }
+
+  const char *names[] = { "Paraboloid 3x3", "Paraboloid 5x5", "Parabola", "PhaseCorrelation" };
+  for (int method = 0; method < 4; method++) {
+    double error = 0.0;
+    int solved = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int trial = 0; trial < trials; trial++) {
+      int i = trial % surfaces.size();
+      double sampleOffset, lineOffset;
+      bool ok;
+      if (method == 3) {
+        ok = SubpixelPeak::PhaseCorrelation(&surfaces[i][0], size, size, center, center,
+                                            sampleOffset, lineOffset);
+      }
+      else if (method == 2) {
+        ok = SubpixelPeak::Parabola(&surfaces[i][0], size, size, center, center,
+                                    sampleOffset, lineOffset);
+      }
+      else {
+        ok = SubpixelPeak::Paraboloid(&surfaces[i][0], size, size, center, center,
+                                      (method == 0) ? 3 : 5, sampleOffset, lineOffset);
+      }
+      if (ok) {
+        double ds = center + sampleOffset - peakSamps[i];
+        double dl = center + lineOffset - peakLines[i];
+        error += sqrt(ds * ds + dl * dl);
+        solved++;
+      }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << surfaceName << " " << names[method] << ": mean error "
+              << error / std::max(solved, 1) << " pixels, "
+              << 1.0e9 * seconds / trials << " ns per call, "
+              << solved << " of " << trials << " solved" << std::endl;
+  }
+}
+
+
+int main(int argc, char *argv[]) {
+  int trials = (argc > 1) ? atoi(argv[1]) : 20000;
+  if (trials <= 0) {
+    std::cerr << "Usage: runSubpixelPeakBenchmark [trials]" << std::endl;
+    return 1;
+  }
+
+  benchmark("Gaussian", false, trials);
+  benchmark("Sinc", true, trials);
+  return 0;
+}